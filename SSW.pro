@@ -10,26 +10,94 @@ VERSION = 2.1.1
 
 SOURCES += \
     appsettings.cpp \
+    bytescan.cpp \
+    capturereader.cpp \
+    capturewriter.cpp \
+    channelparser.cpp \
     databuffer.cpp \
+    datapipeline.cpp \
     dataprocessor.cpp \
+    displayqueue.cpp \
+    fieldtable.cpp \
+    framedecoder.cpp \
+    framepacer.cpp \
+    hexencoder.cpp \
+    highlightstage.cpp \
+    historysearch.cpp \
+    historystore.cpp \
+    iothreadpool.cpp \
     keywordhighlighter.cpp \
+    keywordmatcher.cpp \
+    lineframer.cpp \
+    logfile.cpp \
     main.cpp \
     mycombobox.cpp \
+    portsession.cpp \
+    qtserialtransport.cpp \
+    receiveview.cpp \
+    replaysource.cpp \
+    rxchunk.cpp \
+    serialtransport.cpp \
     serialworker.cpp \
     speedmonitor.cpp \
+    structlayout.cpp \
+    timeseriesstore.cpp \
+    timestampformatter.cpp \
+    waveplot.cpp \
     widget.cpp
 
 HEADERS += \
     appsettings.h \
+    bytescan.h \
+    captureconfig.h \
+    captureformat.h \
+    capturereader.h \
+    capturewriter.h \
+    channelparser.h \
     databuffer.h \
+    datapipeline.h \
     dataprocessor.h \
+    datasource.h \
+    displayqueue.h \
+    fieldtable.h \
+    frameconfig.h \
+    framedecoder.h \
+    framepacer.h \
+    hexencoder.h \
+    highlightstage.h \
+    historysearch.h \
+    historystore.h \
+    iothreadpool.h \
     keywordhighlighter.h \
+    keywordmatcher.h \
+    lineframer.h \
+    linesource.h \
+    logfile.h \
+    minmaxpyramid.h \
     mycombobox.h \
+    portsession.h \
+    qtserialtransport.h \
+    receiveview.h \
+    replayconfig.h \
+    replaysource.h \
+    rxchunk.h \
+    searchquery.h \
     serialconfig.h \
+    serialtransport.h \
     serialworker.h \
     speedmonitor.h \
+    structlayout.h \
+    timeseriesstore.h \
+    timestampformatter.h \
+    waveplot.h \
     widget.h
 
+# Linux 原生串口后端（termios2/epoll）
+linux {
+    SOURCES += nativeserialtransport.cpp
+    HEADERS += nativeserialtransport.h
+}
+
 FORMS += \
     widget.ui
 
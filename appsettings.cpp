@@ -1,5 +1,7 @@
 #include "appsettings.h"
 
+#include <QStandardPaths>
+
 AppSettings* AppSettings::s_instance = nullptr;
 
 AppSettings::AppSettings(QObject *parent)
@@ -39,6 +41,9 @@ void AppSettings::loadSettings()
     m_stopBitsIndex = m_settings->value("stopBitsIndex", 0).toInt();
     m_dataBitsIndex = m_settings->value("dataBitsIndex", 0).toInt();
     m_parityIndex = m_settings->value("parityIndex", 0).toInt();
+    m_serialBackend = qBound(0, m_settings->value("serialBackend", 0).toInt(), 1);
+    m_batchLatencyMs = qBound(0, m_settings->value("batchLatencyMs", 2).toInt(), 1000);
+    m_batchMaxKB = qBound(1, m_settings->value("batchMaxKB", 16).toInt(), 1024);
     
     // Checkbox settings
     m_hexDisplayEnabled = m_settings->value("hexDisplayEnabled", false).toBool();
@@ -46,6 +51,53 @@ void AppSettings::loadSettings()
     m_clearAfterSendEnabled = m_settings->value("clearAfterSendEnabled", false).toBool();
     m_hexSendEnabled = m_settings->value("hexSendEnabled", false).toBool();
     m_newLineEnabled = m_settings->value("newLineEnabled", true).toBool();
+
+    // Display queue settings
+    m_displayQueueBudgetMB = qBound(1, m_settings->value("displayQueueBudgetMB", 64).toInt(), 1024);
+    m_overflowPolicy = static_cast<OverflowPolicy>(
+        qBound(0, m_settings->value("overflowPolicy", DropOldest).toInt(), int(SpillToDisk)));
+    m_lineIdleTimeoutMs = qBound(0, m_settings->value("lineIdleTimeoutMs", 100).toInt(), 10000);
+
+    // Frame decoding settings（无效的组合回退为不分帧）
+    FrameConfig frame;
+    frame.type = static_cast<FrameConfig::Type>(
+        qBound(0, m_settings->value("frameType", FrameConfig::None).toInt(), int(FrameConfig::IdleGap)));
+    frame.delimiter = QByteArray::fromHex(m_settings->value("frameDelimiter", frame.delimiter.toHex()).toByteArray());
+    frame.keepDelimiter = m_settings->value("frameKeepDelimiter", frame.keepDelimiter).toBool();
+    frame.fixedLength = m_settings->value("frameFixedLength", frame.fixedLength).toInt();
+    frame.lengthOffset = m_settings->value("frameLengthOffset", frame.lengthOffset).toInt();
+    frame.lengthSize = m_settings->value("frameLengthSize", frame.lengthSize).toInt();
+    frame.lengthBigEndian = m_settings->value("frameLengthBigEndian", frame.lengthBigEndian).toBool();
+    frame.lengthAdjust = m_settings->value("frameLengthAdjust", frame.lengthAdjust).toInt();
+    frame.idleGapMs = m_settings->value("frameIdleGapMs", frame.idleGapMs).toInt();
+    frame.maxFrameSize = m_settings->value("frameMaxSize", frame.maxFrameSize).toInt();
+    if (frame.isValid()) {
+        m_frameConfig = frame;
+    }
+
+    // Wave channel settings
+    m_channelMode = qBound(0, m_settings->value("channelMode", 0).toInt(), 4);
+    m_waveMemoryMB = qBound(16, m_settings->value("waveMemoryMB", 256).toInt(), 16384);
+    m_waveDiskMB = qBound(0, m_settings->value("waveDiskMB", 4096).toInt(), 262144);
+    m_structLayout = m_settings->value("structLayout").toString();
+
+    // Capture settings（无效的组合回退为默认值）
+    CaptureConfig capture;
+    capture.directory = QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation) + "/SSW-capture";
+    capture.enabled = m_settings->value("captureEnabled", capture.enabled).toBool();
+    capture.directory = m_settings->value("captureDirectory", capture.directory).toString();
+    capture.maxFileBytes = qint64(qBound(0, m_settings->value("captureMaxFileMB", 256).toInt(), 1048576)) << 20;
+    capture.maxFileSeconds = qBound(0, m_settings->value("captureMaxFileMinutes", 60).toInt(), 10080) * 60;
+    capture.syncPolicy = static_cast<CaptureConfig::SyncPolicy>(
+        qBound(0, m_settings->value("captureSyncPolicy", CaptureConfig::PeriodicSync).toInt(), int(CaptureConfig::SyncEveryWrite)));
+    capture.queueBytes = qint64(qBound(1, m_settings->value("captureQueueMB", 64).toInt(), 4096)) << 20;
+    capture.format = static_cast<CaptureConfig::Format>(
+        qBound(0, m_settings->value("captureFormat", CaptureConfig::IndexedFormat).toInt(), int(CaptureConfig::IndexedFormat)));
+    if (capture.isValid()) {
+        m_captureConfig = capture;
+    } else {
+        m_captureConfig.directory = QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation) + "/SSW-capture";
+    }
 }
 
 void AppSettings::saveSettings()
@@ -65,6 +117,9 @@ void AppSettings::saveSettings()
     m_settings->setValue("stopBitsIndex", m_stopBitsIndex);
     m_settings->setValue("dataBitsIndex", m_dataBitsIndex);
     m_settings->setValue("parityIndex", m_parityIndex);
+    m_settings->setValue("serialBackend", m_serialBackend);
+    m_settings->setValue("batchLatencyMs", m_batchLatencyMs);
+    m_settings->setValue("batchMaxKB", m_batchMaxKB);
     
     // Checkbox settings
     m_settings->setValue("hexDisplayEnabled", m_hexDisplayEnabled);
@@ -72,6 +127,38 @@ void AppSettings::saveSettings()
     m_settings->setValue("clearAfterSendEnabled", m_clearAfterSendEnabled);
     m_settings->setValue("hexSendEnabled", m_hexSendEnabled);
     m_settings->setValue("newLineEnabled", m_newLineEnabled);
+
+    // Display queue settings
+    m_settings->setValue("displayQueueBudgetMB", m_displayQueueBudgetMB);
+    m_settings->setValue("overflowPolicy", static_cast<int>(m_overflowPolicy));
+    m_settings->setValue("lineIdleTimeoutMs", m_lineIdleTimeoutMs);
+
+    // Frame decoding settings
+    m_settings->setValue("frameType", static_cast<int>(m_frameConfig.type));
+    m_settings->setValue("frameDelimiter", m_frameConfig.delimiter.toHex());
+    m_settings->setValue("frameKeepDelimiter", m_frameConfig.keepDelimiter);
+    m_settings->setValue("frameFixedLength", m_frameConfig.fixedLength);
+    m_settings->setValue("frameLengthOffset", m_frameConfig.lengthOffset);
+    m_settings->setValue("frameLengthSize", m_frameConfig.lengthSize);
+    m_settings->setValue("frameLengthBigEndian", m_frameConfig.lengthBigEndian);
+    m_settings->setValue("frameLengthAdjust", m_frameConfig.lengthAdjust);
+    m_settings->setValue("frameIdleGapMs", m_frameConfig.idleGapMs);
+    m_settings->setValue("frameMaxSize", m_frameConfig.maxFrameSize);
+
+    // Wave channel settings
+    m_settings->setValue("channelMode", m_channelMode);
+    m_settings->setValue("waveMemoryMB", m_waveMemoryMB);
+    m_settings->setValue("waveDiskMB", m_waveDiskMB);
+    m_settings->setValue("structLayout", m_structLayout);
+
+    // Capture settings
+    m_settings->setValue("captureEnabled", m_captureConfig.enabled);
+    m_settings->setValue("captureDirectory", m_captureConfig.directory);
+    m_settings->setValue("captureMaxFileMB", int(m_captureConfig.maxFileBytes >> 20));
+    m_settings->setValue("captureMaxFileMinutes", m_captureConfig.maxFileSeconds / 60);
+    m_settings->setValue("captureSyncPolicy", static_cast<int>(m_captureConfig.syncPolicy));
+    m_settings->setValue("captureQueueMB", int(m_captureConfig.queueBytes >> 20));
+    m_settings->setValue("captureFormat", static_cast<int>(m_captureConfig.format));
     
     m_settings->sync();
 }
@@ -206,6 +293,9 @@ QString AppSettings::baudRate() const { return m_baudRate; }
 int AppSettings::stopBitsIndex() const { return m_stopBitsIndex; }
 int AppSettings::dataBitsIndex() const { return m_dataBitsIndex; }
 int AppSettings::parityIndex() const { return m_parityIndex; }
+int AppSettings::serialBackend() const { return m_serialBackend; }
+int AppSettings::batchLatencyMs() const { return m_batchLatencyMs; }
+int AppSettings::batchMaxKB() const { return m_batchMaxKB; }
 
 void AppSettings::setBaudRate(const QString &baudRate)
 {
@@ -239,6 +329,33 @@ void AppSettings::setParityIndex(int index)
     }
 }
 
+void AppSettings::setSerialBackend(int backend)
+{
+    backend = qBound(0, backend, 1);
+    if (m_serialBackend != backend) {
+        m_serialBackend = backend;
+        saveSettings();
+    }
+}
+
+void AppSettings::setBatchLatencyMs(int milliseconds)
+{
+    milliseconds = qBound(0, milliseconds, 1000);
+    if (m_batchLatencyMs != milliseconds) {
+        m_batchLatencyMs = milliseconds;
+        saveSettings();
+    }
+}
+
+void AppSettings::setBatchMaxKB(int kilobytes)
+{
+    kilobytes = qBound(1, kilobytes, 1024);
+    if (m_batchMaxKB != kilobytes) {
+        m_batchMaxKB = kilobytes;
+        saveSettings();
+    }
+}
+
 // Checkbox settings
 bool AppSettings::hexDisplayEnabled() const { return m_hexDisplayEnabled; }
 bool AppSettings::timestampEnabled() const { return m_timestampEnabled; }
@@ -285,3 +402,106 @@ void AppSettings::setNewLineEnabled(bool enabled)
         saveSettings();
     }
 }
+
+// Display queue settings
+int AppSettings::displayQueueBudgetMB() const { return m_displayQueueBudgetMB; }
+AppSettings::OverflowPolicy AppSettings::overflowPolicy() const { return m_overflowPolicy; }
+int AppSettings::lineIdleTimeoutMs() const { return m_lineIdleTimeoutMs; }
+
+void AppSettings::setDisplayQueueBudgetMB(int megabytes)
+{
+    megabytes = qBound(1, megabytes, 1024);
+    if (m_displayQueueBudgetMB != megabytes) {
+        m_displayQueueBudgetMB = megabytes;
+        saveSettings();
+        emit displayQueueBudgetMBChanged(m_displayQueueBudgetMB);
+    }
+}
+
+void AppSettings::setOverflowPolicy(OverflowPolicy policy)
+{
+    if (m_overflowPolicy != policy) {
+        m_overflowPolicy = policy;
+        saveSettings();
+        emit overflowPolicyChanged(m_overflowPolicy);
+    }
+}
+
+void AppSettings::setLineIdleTimeoutMs(int milliseconds)
+{
+    milliseconds = qBound(0, milliseconds, 10000);
+    if (m_lineIdleTimeoutMs != milliseconds) {
+        m_lineIdleTimeoutMs = milliseconds;
+        saveSettings();
+        emit lineIdleTimeoutMsChanged(m_lineIdleTimeoutMs);
+    }
+}
+
+// Frame decoding settings
+FrameConfig AppSettings::frameConfig() const { return m_frameConfig; }
+
+void AppSettings::setFrameConfig(const FrameConfig &config)
+{
+    if (config.isValid() && m_frameConfig != config) {
+        m_frameConfig = config;
+        saveSettings();
+        emit frameConfigChanged(m_frameConfig);
+    }
+}
+
+// Wave channel settings
+int AppSettings::channelMode() const { return m_channelMode; }
+int AppSettings::waveMemoryMB() const { return m_waveMemoryMB; }
+int AppSettings::waveDiskMB() const { return m_waveDiskMB; }
+QString AppSettings::structLayout() const { return m_structLayout; }
+
+void AppSettings::setChannelMode(int mode)
+{
+    mode = qBound(0, mode, 4);
+    if (m_channelMode != mode) {
+        m_channelMode = mode;
+        saveSettings();
+        emit channelModeChanged(m_channelMode);
+    }
+}
+
+void AppSettings::setWaveMemoryMB(int megabytes)
+{
+    megabytes = qBound(16, megabytes, 16384);
+    if (m_waveMemoryMB != megabytes) {
+        m_waveMemoryMB = megabytes;
+        saveSettings();
+        emit waveMemoryMBChanged(m_waveMemoryMB);
+    }
+}
+
+void AppSettings::setWaveDiskMB(int megabytes)
+{
+    megabytes = qBound(0, megabytes, 262144);
+    if (m_waveDiskMB != megabytes) {
+        m_waveDiskMB = megabytes;
+        saveSettings();
+        emit waveDiskMBChanged(m_waveDiskMB);
+    }
+}
+
+void AppSettings::setStructLayout(const QString &layout)
+{
+    if (m_structLayout != layout) {
+        m_structLayout = layout;
+        saveSettings();
+        emit structLayoutChanged(m_structLayout);
+    }
+}
+
+// Capture settings
+CaptureConfig AppSettings::captureConfig() const { return m_captureConfig; }
+
+void AppSettings::setCaptureConfig(const CaptureConfig &config)
+{
+    if (config.isValid() && m_captureConfig != config) {
+        m_captureConfig = config;
+        saveSettings();
+        emit captureConfigChanged(m_captureConfig);
+    }
+}
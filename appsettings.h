@@ -5,6 +5,9 @@
 #include <QSettings>
 #include <QSize>
 
+#include "captureconfig.h"
+#include "frameconfig.h"
+
 class AppSettings : public QObject
 {
     Q_OBJECT
@@ -12,6 +15,10 @@ public:
     enum Encoding { ANSI, UTF8, GBK };
     Q_ENUM(Encoding)
 
+    // 显示队列超过上限时的处理方式
+    enum OverflowPolicy { DropOldest, DropNewest, SpillToDisk };
+    Q_ENUM(OverflowPolicy)
+
     static AppSettings* instance();
 
     // Getters
@@ -30,6 +37,9 @@ public:
     int stopBitsIndex() const;
     int dataBitsIndex() const;
     int parityIndex() const;
+    int serialBackend() const;
+    int batchLatencyMs() const;
+    int batchMaxKB() const;
     
     // Checkbox settings getters
     bool hexDisplayEnabled() const;
@@ -38,6 +48,23 @@ public:
     bool hexSendEnabled() const;
     bool newLineEnabled() const;
 
+    // Display queue settings getters
+    int displayQueueBudgetMB() const;
+    OverflowPolicy overflowPolicy() const;
+    int lineIdleTimeoutMs() const;
+
+    // Frame decoding settings getters
+    FrameConfig frameConfig() const;
+
+    // Wave channel settings getters
+    int channelMode() const;
+    int waveMemoryMB() const;
+    int waveDiskMB() const;
+    QString structLayout() const;
+
+    // Capture settings getters
+    CaptureConfig captureConfig() const;
+
     // Setters
     void setEncoding(Encoding encoding);
     void setHexNewlineEnabled(bool enabled);
@@ -54,6 +81,9 @@ public:
     void setStopBitsIndex(int index);
     void setDataBitsIndex(int index);
     void setParityIndex(int index);
+    void setSerialBackend(int backend);
+    void setBatchLatencyMs(int milliseconds);
+    void setBatchMaxKB(int kilobytes);
     
     // Checkbox settings setters
     void setHexDisplayEnabled(bool enabled);
@@ -62,6 +92,23 @@ public:
     void setHexSendEnabled(bool enabled);
     void setNewLineEnabled(bool enabled);
 
+    // Display queue settings setters
+    void setDisplayQueueBudgetMB(int megabytes);
+    void setOverflowPolicy(OverflowPolicy policy);
+    void setLineIdleTimeoutMs(int milliseconds);
+
+    // Frame decoding settings setters
+    void setFrameConfig(const FrameConfig &config);
+
+    // Wave channel settings setters
+    void setChannelMode(int mode);
+    void setWaveMemoryMB(int megabytes);
+    void setWaveDiskMB(int megabytes);
+    void setStructLayout(const QString &layout);
+
+    // Capture settings setters
+    void setCaptureConfig(const CaptureConfig &config);
+
 signals:
     void encodingChanged(AppSettings::Encoding encoding);
     void hexNewlineEnabledChanged(bool enabled);
@@ -69,6 +116,15 @@ signals:
     void fontSizeChanged(int size);
     void fontFamilyChanged(const QString &family);
     void darkModeEnabledChanged(bool enabled);
+    void displayQueueBudgetMBChanged(int megabytes);
+    void overflowPolicyChanged(AppSettings::OverflowPolicy policy);
+    void lineIdleTimeoutMsChanged(int milliseconds);
+    void frameConfigChanged(const FrameConfig &config);
+    void channelModeChanged(int mode);
+    void waveMemoryMBChanged(int megabytes);
+    void waveDiskMBChanged(int megabytes);
+    void structLayoutChanged(const QString &layout);
+    void captureConfigChanged(const CaptureConfig &config);
 
 private:
     explicit AppSettings(QObject *parent = nullptr);
@@ -93,6 +149,9 @@ private:
     int m_stopBitsIndex = 0;
     int m_dataBitsIndex = 0;
     int m_parityIndex = 0;
+    int m_serialBackend = 0;      // SerialConfig::Backend
+    int m_batchLatencyMs = 2;     // 读取合并的最大延迟，0 表示每次读取立即发出
+    int m_batchMaxKB = 16;        // 单个合并批次的最大字节数（KB）
     
     // Checkbox settings
     bool m_hexDisplayEnabled = false;
@@ -100,6 +159,23 @@ private:
     bool m_clearAfterSendEnabled = false;
     bool m_hexSendEnabled = false;
     bool m_newLineEnabled = true;
+
+    // Display queue settings
+    int m_displayQueueBudgetMB = 64;
+    OverflowPolicy m_overflowPolicy = DropOldest;
+    int m_lineIdleTimeoutMs = 100;    // 时间戳模式下未结束的行等待多久后先行显示
+
+    // Frame decoding settings
+    FrameConfig m_frameConfig;
+
+    // Wave channel settings
+    int m_channelMode = 0;        // ChannelParser::Mode
+    int m_waveMemoryMB = 256;     // 波形数据的内存预算
+    int m_waveDiskMB = 4096;      // 超出内存预算后溢出到磁盘的上限，0 表示不溢出
+    QString m_structLayout;       // 帧内结构体布局描述（StructLayout 文本）
+
+    // Capture settings
+    CaptureConfig m_captureConfig;
 };
 
 #endif // APPSETTINGS_H
@@ -0,0 +1,117 @@
+#include "hexencoder.h"
+
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+#include <QTextStream>
+
+/**
+ * @brief 十六进制显示编码的微基准
+ *
+ * 对 1 MiB 随机数据比较原 DataProcessor::toHexString（逐字节 QString::arg）
+ * 与 HexEncoder::encode，分别测试启用和禁用 0A/0D 换行。
+ * 两者的输出先逐字符比较，不一致时返回非零。
+ *
+ * 用法：hexbench [迭代次数]
+ */
+
+namespace {
+
+constexpr qsizetype INPUT_BYTES = 1 << 20;    ///< 每次编码的输入大小
+constexpr int DEFAULT_ITERATIONS = 20;        ///< 默认迭代次数
+
+// 原 DataProcessor::toHexString，作为对照
+QString legacyToHexString(const QByteArray &data, bool hexNewlineEnabled)
+{
+    QString result;
+    result.reserve(data.size() * 4);
+
+    for (int i = 0; i < data.size(); ++i) {
+        quint8 byte = static_cast<quint8>(data.at(i));
+
+        if (hexNewlineEnabled && (byte == 0x0A || byte == 0x0D)) {
+            if (!result.isEmpty() && !result.endsWith('\n')) {
+                result += '\n';
+            }
+
+            QString controlSequence = "[" + QString("%1").arg(byte, 2, 16, QChar('0')).toUpper();
+            while (i + 1 < data.size()) {
+                quint8 nextByte = static_cast<quint8>(data.at(i + 1));
+                if (nextByte == 0x0A || nextByte == 0x0D) {
+                    controlSequence += " " + QString("%1").arg(nextByte, 2, 16, QChar('0')).toUpper();
+                    i++;
+                } else {
+                    break;
+                }
+            }
+
+            controlSequence += "]\n";
+            result += controlSequence;
+        } else {
+            if (!result.isEmpty() && !result.endsWith(' ') && !result.endsWith('\n')) {
+                result += ' ';
+            }
+            result += QString("%1").arg(byte, 2, 16, QChar('0')).toUpper();
+        }
+    }
+
+    if (result.endsWith(' ')) {
+        result.chop(1);
+    }
+
+    return result;
+}
+
+// 每次编码的平均耗时（纳秒）
+template <typename Encode>
+double measure(int iterations, Encode encode)
+{
+    qsizetype sink = 0;
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < iterations; ++i) {
+        sink += encode().size();
+    }
+    const double elapsed = double(timer.nsecsElapsed());
+    // 防止编码结果被优化掉
+    if (sink < 0) {
+        QTextStream(stdout) << sink;
+    }
+    return elapsed / iterations;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    const int iterations = argc > 1 ? qMax(1, QByteArray(argv[1]).toInt()) : DEFAULT_ITERATIONS;
+
+    QByteArray input(INPUT_BYTES, Qt::Uninitialized);
+    QRandomGenerator generator(20250101);
+    generator.fillRange(reinterpret_cast<quint32 *>(input.data()), input.size() / qsizetype(sizeof(quint32)));
+
+    QTextStream out(stdout);
+    out << "input: " << input.size() << " bytes, iterations: " << iterations << "\n";
+
+    int failures = 0;
+    for (bool newline : {false, true}) {
+        if (legacyToHexString(input, newline) != HexEncoder::encode(input, newline)) {
+            out << "output mismatch (newline " << (newline ? "on" : "off") << ")\n";
+            ++failures;
+            continue;
+        }
+
+        const double legacyNs = measure(iterations, [&]() { return legacyToHexString(input, newline); });
+        const double encoderNs = measure(iterations, [&]() { return HexEncoder::encode(input, newline); });
+        auto throughput = [&](double ns) { return double(input.size()) / (1 << 20) / (ns / 1e9); };
+
+        out << "newline " << (newline ? "on " : "off") << ": "
+            << "QString::arg " << QString::number(legacyNs / 1e6, 'f', 2) << " ms ("
+            << QString::number(throughput(legacyNs), 'f', 1) << " MiB/s), "
+            << "HexEncoder " << QString::number(encoderNs / 1e6, 'f', 3) << " ms ("
+            << QString::number(throughput(encoderNs), 'f', 1) << " MiB/s), "
+            << "speedup " << QString::number(legacyNs / encoderNs, 'f', 1) << "x\n";
+    }
+
+    return failures;
+}
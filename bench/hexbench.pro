@@ -0,0 +1,17 @@
+QT = core
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+TARGET = hexbench
+
+INCLUDEPATH += ..
+
+SOURCES += \
+    hexbench.cpp \
+    ../bytescan.cpp \
+    ../hexencoder.cpp
+
+HEADERS += \
+    ../bytescan.h \
+    ../hexencoder.h
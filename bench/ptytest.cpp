@@ -0,0 +1,191 @@
+#include "nativeserialtransport.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QSocketNotifier>
+#include <QTextStream>
+#include <QTimer>
+#include <functional>
+
+#include <asm/ioctls.h>
+#include <asm/termbits.h>
+#include <cerrno>
+#include <cstdlib>
+#include <fcntl.h>
+#include <unistd.h>
+
+// <sys/ioctl.h> 会间接包含 glibc 的 termios 定义，与 <asm/termbits.h> 的 termios2 冲突
+extern "C" int ioctl(int fd, unsigned long request, ...);
+
+/**
+ * @brief NativeSerialTransport 的伪终端测试
+ *
+ * 用 posix_openpt 创建一对伪终端，以原生后端打开从端，主端模拟设备：
+ * - 自定义波特率：从主端读回 termios2，检查 BOTHER 与 c_ispeed/c_ospeed
+ * - VMIN：收到数据后 VMIN 提高到配置值，不足 VMIN 的尾部由定时读取取走，
+ *   线路空闲后恢复为 1
+ * - 写入：一次写入远超内核缓冲区的数据，write() 必须立即返回，
+ *   其余数据由写通知在主端读取时陆续发出，内容逐字节一致
+ * - 挂断：关闭主端后报告 errorOccurred，read() 返回 -1
+ * 任一检查失败时返回非零。
+ *
+ * 只在 Linux 下编译。用法：ptytest
+ */
+
+namespace {
+
+constexpr qint32 CUSTOM_BAUD_RATE = 250000;   ///< 非标准波特率（只能通过 BOTHER 设置）
+constexpr int TEST_VMIN = 64;                 ///< 测试用 VMIN
+constexpr int LATENCY_MS = 20;                ///< 读取合并的最大延迟（定时读取周期）
+constexpr int TAIL_BYTES = 10;                ///< 不足 VMIN 的尾部
+constexpr qsizetype WRITE_BYTES = 1 << 20;    ///< 写入测试的数据量
+constexpr int TIMEOUT_MS = 5000;              ///< 单项等待超时
+
+QTextStream out(stdout);
+int failures = 0;
+
+void check(bool ok, const QString &what)
+{
+    out << (ok ? "PASS " : "FAIL ") << what << "\n";
+    out.flush();
+    if (!ok) {
+        ++failures;
+    }
+}
+
+// 处理事件直到条件成立或超时
+bool waitFor(const std::function<bool()> &condition, int timeoutMs = TIMEOUT_MS)
+{
+    // 定时唤醒，保证没有事件时也能检查超时
+    QTimer tick;
+    tick.start(10);
+    QElapsedTimer timer;
+    timer.start();
+    while (!condition()) {
+        if (timer.elapsed() > timeoutMs) {
+            return false;
+        }
+        QCoreApplication::processEvents(QEventLoop::WaitForMoreEvents);
+    }
+    return true;
+}
+
+// 从端的 termios2；主端的 TCGETS2 读取的就是从端设置
+bool slaveSettings(int master, termios2 *tio)
+{
+    return ::ioctl(master, TCGETS2, tio) == 0;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    const int master = ::posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+    if (master < 0 || ::grantpt(master) < 0 || ::unlockpt(master) < 0) {
+        out << "posix_openpt failed: " << errno << "\n";
+        return 1;
+    }
+    const QString slavePath = QString::fromLocal8Bit(::ptsname(master));
+    out << "slave: " << slavePath << "\n";
+
+    NativeSerialTransport transport;
+    QByteArray received;
+    QString lastError;
+    bool readFailed = false;
+    QObject::connect(&transport, &SerialTransport::readyRead, [&]() {
+        char buffer[4096];
+        for (;;) {
+            const qint64 n = transport.read(buffer, sizeof(buffer));
+            if (n > 0) {
+                received.append(buffer, n);
+                continue;
+            }
+            readFailed |= n < 0;
+            break;
+        }
+    });
+    QObject::connect(&transport, &SerialTransport::errorOccurred, [&](const QString &error) {
+        lastError = error;
+    });
+
+    SerialConfig config;
+    config.portName = slavePath;
+    config.baudRate = CUSTOM_BAUD_RATE;
+    config.backend = SerialConfig::NativeBackend;
+    config.nativeVmin = TEST_VMIN;
+    config.batchLatencyMs = LATENCY_MS;
+    if (!transport.open(config)) {
+        out << "open failed: " << transport.errorString() << "\n";
+        return 1;
+    }
+
+    // 自定义波特率
+    termios2 tio = {};
+    check(slaveSettings(master, &tio), "TCGETS2");
+    check((tio.c_cflag & CBAUD) == BOTHER && tio.c_ispeed == speed_t(CUSTOM_BAUD_RATE)
+              && tio.c_ospeed == speed_t(CUSTOM_BAUD_RATE),
+          QStringLiteral("custom baud %1 via BOTHER (got %2/%3)")
+              .arg(CUSTOM_BAUD_RATE).arg(tio.c_ispeed).arg(tio.c_ospeed));
+    check(tio.c_cc[VMIN] == 1, "idle line opens with VMIN 1");
+
+    // 第一批数据由 epoll 唤醒，之后 VMIN 提高
+    const QByteArray burst(200, 'a');
+    check(::write(master, burst.constData(), size_t(burst.size())) == burst.size(), "master write burst");
+    check(waitFor([&]() { return received.size() >= burst.size(); }), "burst received");
+    check(slaveSettings(master, &tio) && tio.c_cc[VMIN] == TEST_VMIN,
+          QStringLiteral("VMIN raised to %1").arg(TEST_VMIN));
+
+    // 不足 VMIN 的尾部：epoll 不会唤醒，只能由定时读取取走（紧接着写入，定时读取仍在运行）
+    received.clear();
+    const QByteArray tail(TAIL_BYTES, 'b');
+    QElapsedTimer tailTimer;
+    tailTimer.start();
+    check(::write(master, tail.constData(), size_t(tail.size())) == tail.size(), "master write tail");
+    const bool tailReceived = waitFor([&]() { return received.size() >= tail.size(); });
+    check(tailReceived && received == tail,
+          QStringLiteral("tail below VMIN drained by timer (%1 ms)").arg(tailTimer.elapsed()));
+
+    // 线路空闲：VMIN 恢复为 1
+    check(waitFor([&]() { return slaveSettings(master, &tio) && tio.c_cc[VMIN] == 1; }),
+          "VMIN back to 1 after idle");
+
+    // 写入不阻塞：设备（主端）暂不读取，write() 只写入能写的部分并立即返回
+    QByteArray payload(WRITE_BYTES, Qt::Uninitialized);
+    for (qsizetype i = 0; i < payload.size(); ++i) {
+        payload[i] = char(i * 31 + (i >> 8));
+    }
+    QElapsedTimer writeTimer;
+    writeTimer.start();
+    const qint64 accepted = transport.write(payload);
+    const qint64 writeNs = writeTimer.nsecsElapsed();
+    check(accepted == payload.size(), QStringLiteral("write accepted %1 of %2 bytes").arg(accepted).arg(payload.size()));
+    check(writeNs < 50 * 1000 * 1000, QStringLiteral("write returned in %1 ms").arg(writeNs / 1e6, 0, 'f', 2));
+
+    {
+        QByteArray sent;
+        QSocketNotifier masterNotifier(master, QSocketNotifier::Read);
+        QObject::connect(&masterNotifier, &QSocketNotifier::activated, [&]() {
+            char buffer[4096];
+            ssize_t n;
+            while ((n = ::read(master, buffer, sizeof(buffer))) > 0) {
+                sent.append(buffer, n);
+            }
+        });
+        const bool drained = waitFor([&]() { return sent.size() >= payload.size(); }, TIMEOUT_MS * 2);
+        check(drained && sent == payload,
+              QStringLiteral("queued write drained (%1 of %2 bytes)").arg(sent.size()).arg(payload.size()));
+    }
+
+    // 挂断：关闭主端，从端读到 EOF/EPOLLHUP
+    ::close(master);
+    const bool hungUp = waitFor([&]() { return !lastError.isEmpty(); });
+    check(hungUp, QStringLiteral("hang-up reported: %1").arg(lastError));
+    char byte;
+    check(readFailed && transport.read(&byte, 1) == -1, "read fails after hang-up");
+
+    transport.close();
+    out << (failures ? "FAILED" : "OK") << "\n";
+    return failures;
+}
@@ -0,0 +1,20 @@
+QT = core serialport
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+TARGET = ptytest
+
+INCLUDEPATH += ..
+
+SOURCES += \
+    ptytest.cpp \
+    ../nativeserialtransport.cpp \
+    ../qtserialtransport.cpp \
+    ../serialtransport.cpp
+
+HEADERS += \
+    ../nativeserialtransport.h \
+    ../qtserialtransport.h \
+    ../serialconfig.h \
+    ../serialtransport.h
@@ -0,0 +1,127 @@
+#include "bytescan.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define BYTESCAN_SSE2 1
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#endif
+
+/**
+ * @brief ByteScan 实现
+ */
+
+namespace {
+
+inline bool isCrLf(char c)
+{
+    return c == '\n' || c == '\r';
+}
+
+#ifdef BYTESCAN_SSE2
+// 16 字节中为 0x0A 或 0x0D 的位置掩码
+inline int crLfMask(const char *p)
+{
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+    const __m128i lf = _mm_cmpeq_epi8(v, _mm_set1_epi8('\n'));
+    const __m128i cr = _mm_cmpeq_epi8(v, _mm_set1_epi8('\r'));
+    return _mm_movemask_epi8(_mm_or_si128(lf, cr));
+}
+
+inline int lowestBit(int mask)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index;
+    _BitScanForward(&index, static_cast<unsigned long>(mask));
+    return static_cast<int>(index);
+#else
+    return __builtin_ctz(static_cast<unsigned>(mask));
+#endif
+}
+
+inline int popCount(int mask)
+{
+    unsigned v = static_cast<unsigned>(mask);
+    int count = 0;
+    while (v) {
+        v &= v - 1;
+        ++count;
+    }
+    return count;
+}
+#endif
+
+} // namespace
+
+qsizetype ByteScan::findCrLf(const char *data, qsizetype size, qsizetype from)
+{
+    qsizetype i = qMax<qsizetype>(from, 0);
+
+#ifdef BYTESCAN_SSE2
+    for (; i + 16 <= size; i += 16) {
+        const int mask = crLfMask(data + i);
+        if (mask) {
+            return i + lowestBit(mask);
+        }
+    }
+#endif
+
+    for (; i < size; ++i) {
+        if (isCrLf(data[i])) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+qsizetype ByteScan::countCrLf(const char *data, qsizetype size)
+{
+    qsizetype count = 0;
+    qsizetype i = 0;
+
+#ifdef BYTESCAN_SSE2
+    for (; i + 16 <= size; i += 16) {
+        const int mask = crLfMask(data + i);
+        if (mask) {
+            count += popCount(mask);
+        }
+    }
+#endif
+
+    for (; i < size; ++i) {
+        if (isCrLf(data[i])) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+bool ByteScan::isAscii(const char *data, qsizetype size)
+{
+    qsizetype i = 0;
+
+#ifdef BYTESCAN_SSE2
+    // 每次检查 64 字节：先按位或合并，再取各字节最高位
+    for (; i + 64 <= size; i += 64) {
+        const __m128i *p = reinterpret_cast<const __m128i *>(data + i);
+        const __m128i merged = _mm_or_si128(_mm_or_si128(_mm_loadu_si128(p), _mm_loadu_si128(p + 1)),
+                                            _mm_or_si128(_mm_loadu_si128(p + 2), _mm_loadu_si128(p + 3)));
+        if (_mm_movemask_epi8(merged)) {
+            return false;
+        }
+    }
+    for (; i + 16 <= size; i += 16) {
+        if (_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i)))) {
+            return false;
+        }
+    }
+#endif
+
+    for (; i < size; ++i) {
+        if (static_cast<uchar>(data[i]) & 0x80) {
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,44 @@
+#ifndef BYTESCAN_H
+#define BYTESCAN_H
+
+#include <QtGlobal>
+
+/**
+ * @brief ByteScan - 字节扫描工具
+ *
+ * 提供数据流处理中常用的字节查找/统计函数，x86 平台使用 SSE2 每次比较 16 字节，
+ * 其他平台使用标量实现，结果完全一致。
+ */
+class ByteScan
+{
+public:
+    /**
+     * @brief 查找第一个换行符（0x0A）或回车符（0x0D）
+     * @param data 数据起始地址
+     * @param size 数据长度
+     * @param from 起始查找位置
+     * @return 找到的下标，未找到返回 -1
+     */
+    static qsizetype findCrLf(const char *data, qsizetype size, qsizetype from = 0);
+
+    /**
+     * @brief 统计换行符（0x0A）和回车符（0x0D）的个数
+     * @param data 数据起始地址
+     * @param size 数据长度
+     * @return 0x0A 与 0x0D 的总个数
+     */
+    static qsizetype countCrLf(const char *data, qsizetype size);
+
+    /**
+     * @brief 检查数据是否全部为 7 位 ASCII（最高位均为 0）
+     * @param data 数据起始地址
+     * @param size 数据长度
+     * @return true 如果没有任何字节 >= 0x80
+     */
+    static bool isAscii(const char *data, qsizetype size);
+
+private:
+    ByteScan() = delete;
+};
+
+#endif // BYTESCAN_H
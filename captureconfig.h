@@ -0,0 +1,90 @@
+#ifndef CAPTURECONFIG_H
+#define CAPTURECONFIG_H
+
+#include <QString>
+
+/**
+ * @brief CaptureConfig - 原始数据捕获配置数据结构
+ *
+ * 决定接收到的原始字节写到哪里、何时切换到新文件以及何时强制落盘，提供配置验证功能。
+ */
+struct CaptureConfig {
+    /**
+     * @brief 落盘策略
+     */
+    enum SyncPolicy {
+        NoSync,          ///< 不主动同步，由操作系统决定何时写入磁盘
+        PeriodicSync,    ///< 每隔 syncIntervalMs 同步一次
+        SyncEveryWrite   ///< 每次写入后同步（最安全，吞吐最低）
+    };
+
+    /**
+     * @brief 文件格式
+     */
+    enum Format {
+        RawFormat,       ///< 原样写入接收到的字节（.bin）
+        IndexedFormat    ///< 带时间戳、方向和端口号的记录，附稀疏时间索引（见 CaptureFormat）
+    };
+
+    static constexpr qint64 MIN_FILE_BYTES = qint64(1) << 20;      ///< 单个文件大小上限的最小值（1 MB）
+    static constexpr qint64 MIN_QUEUE_BYTES = qint64(1) << 20;     ///< 写入队列上限的最小值（1 MB）
+
+    bool enabled = false;                        ///< 是否在打开串口时开始捕获
+    QString directory;                           ///< 捕获文件目录
+    QString baseName = QStringLiteral("capture");  ///< 文件名前缀（通常为端口名）
+    quint16 portId = 0;                          ///< 写入每条记录的端口号（由会话分配，不保存）
+    Format format = IndexedFormat;               ///< 文件格式
+    qint64 maxFileBytes = qint64(256) << 20;     ///< 单个文件大小上限，0 表示不按大小分割
+    int maxFileSeconds = 3600;                   ///< 单个文件时长上限（秒），0 表示不按时间分割
+    SyncPolicy syncPolicy = PeriodicSync;        ///< 落盘策略
+    int syncIntervalMs = 1000;                   ///< 定期同步的间隔（毫秒）
+    qint64 queueBytes = qint64(64) << 20;        ///< 写入队列上限，超过后丢弃新数据（不阻塞串口线程）
+
+    /**
+     * @brief 验证配置参数是否有效
+     * @return true 如果所有参数有效，否则返回 false
+     */
+    bool isValid() const {
+        return validationError().isEmpty();
+    }
+
+    /**
+     * @brief 获取配置验证错误信息
+     * @return 错误描述字符串，如果配置有效则返回空字符串
+     */
+    QString validationError() const {
+        if (directory.isEmpty()) {
+            return QStringLiteral("Capture directory must not be empty");
+        }
+        if (baseName.isEmpty()) {
+            return QStringLiteral("Capture file name must not be empty");
+        }
+        if (maxFileBytes != 0 && maxFileBytes < MIN_FILE_BYTES) {
+            return QStringLiteral("Capture file size limit must be at least 1 MB");
+        }
+        if (maxFileSeconds < 0) {
+            return QStringLiteral("Capture file duration must not be negative");
+        }
+        if (syncPolicy == PeriodicSync && syncIntervalMs <= 0) {
+            return QStringLiteral("Sync interval must be a positive number");
+        }
+        if (queueBytes < MIN_QUEUE_BYTES) {
+            return QStringLiteral("Capture queue limit must be at least 1 MB");
+        }
+        return QString();
+    }
+
+    bool operator==(const CaptureConfig &other) const {
+        return enabled == other.enabled && directory == other.directory
+            && baseName == other.baseName && portId == other.portId
+            && format == other.format && maxFileBytes == other.maxFileBytes
+            && maxFileSeconds == other.maxFileSeconds && syncPolicy == other.syncPolicy
+            && syncIntervalMs == other.syncIntervalMs && queueBytes == other.queueBytes;
+    }
+
+    bool operator!=(const CaptureConfig &other) const {
+        return !(*this == other);
+    }
+};
+
+#endif // CAPTURECONFIG_H
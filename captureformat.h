@@ -0,0 +1,182 @@
+#ifndef CAPTUREFORMAT_H
+#define CAPTUREFORMAT_H
+
+#include <QByteArray>
+#include <QString>
+#include <QtEndian>
+#include <cstring>
+
+/**
+ * @brief CaptureFormat - 带索引的捕获文件格式（版本 1）
+ *
+ * 数据文件（.sswcap）：
+ * - 文件头 FILE_HEADER_SIZE 字节：魔数、版本、文件头长度、创建时的本地时间（UTC 毫秒）
+ *   与同一时刻的单调时钟、端口名。
+ * - 之后是连续的记录：RECORD_HEADER_SIZE 字节的记录头（同步字、长度、到达时间、
+ *   端口号、方向）加原样的数据。只追加写入，读取方遇到不完整的末尾记录时等待即可。
+ *
+ * 索引文件（.sswcap.idx，与数据文件同名）：
+ * - 索引头 INDEX_HEADER_SIZE 字节，之后是定长的 {时间, 记录偏移} 条目，按时间非递减。
+ * - 条目是稀疏的：每个文件的第一条记录，以及距上一条目超过 INDEX_STRIDE_BYTES 或
+ *   INDEX_STRIDE_NS 的记录。条目只在对应数据写入数据文件后追加，
+ *   因此写入过程中也可以二分查找，再从条目处向后扫描不超过一个步长。
+ *
+ * 所有整数按小端存储。时间为 TimestampFormatter::monotonicNs() 的单调时钟纳秒，
+ * 用文件头中的时间对换算为本地时间。
+ */
+struct CaptureFormat {
+    static constexpr char FILE_MAGIC[8] = {'S', 'S', 'W', 'C', 'A', 'P', '\r', '\n'};
+    static constexpr char INDEX_MAGIC[8] = {'S', 'S', 'W', 'I', 'D', 'X', '\r', '\n'};
+    static constexpr quint16 VERSION = 1;                         ///< 当前版本，读取方拒绝更高的版本
+    static constexpr int FILE_HEADER_SIZE = 64;                   ///< 文件头长度
+    static constexpr int PORT_NAME_SIZE = 32;                     ///< 文件头中端口名的字节数（UTF-8，不足补 0）
+    static constexpr int RECORD_HEADER_SIZE = 24;                 ///< 记录头长度
+    static constexpr quint32 RECORD_MAGIC = 0x43455253;           ///< 记录同步字（"SREC"）
+    static constexpr quint32 MAX_RECORD_SIZE = 64u << 20;         ///< 单条记录数据上限，超过视为损坏
+    static constexpr int INDEX_HEADER_SIZE = 16;                  ///< 索引头长度
+    static constexpr int INDEX_ENTRY_SIZE = 16;                   ///< 索引条目长度
+    static constexpr qint64 INDEX_STRIDE_BYTES = qint64(64) << 10; ///< 索引条目之间最多相隔的字节数
+    static constexpr qint64 INDEX_STRIDE_NS = 1000000000;         ///< 索引条目之间最多相隔的时间（1 秒）
+
+    static inline const QString DATA_SUFFIX = QStringLiteral(".sswcap");  ///< 数据文件扩展名
+    static inline const QString INDEX_SUFFIX = QStringLiteral(".idx");    ///< 索引文件追加的扩展名
+
+    /**
+     * @brief 数据方向
+     */
+    enum Direction : quint8 {
+        Rx = 0,   ///< 接收
+        Tx = 1    ///< 发送
+    };
+
+    /**
+     * @brief 文件头
+     *
+     * 偏移：0 魔数[8]，8 版本 u16，10 文件头长度 u16，12 保留 u32，
+     * 16 本地时间 i64（UTC 毫秒），24 单调时钟 i64（纳秒），32 端口名[32]。
+     */
+    struct FileHeader {
+        quint16 version = VERSION;
+        quint16 headerSize = FILE_HEADER_SIZE;
+        qint64 wallClockMs = 0;    ///< 创建文件时的本地时间（UTC 毫秒）
+        qint64 monotonicNs = 0;    ///< 同一时刻的单调时钟
+        QString portName;
+
+        void encode(char *out) const {
+            std::memset(out, 0, FILE_HEADER_SIZE);
+            std::memcpy(out, FILE_MAGIC, sizeof(FILE_MAGIC));
+            qToLittleEndian<quint16>(version, out + 8);
+            qToLittleEndian<quint16>(headerSize, out + 10);
+            qToLittleEndian<qint64>(wallClockMs, out + 16);
+            qToLittleEndian<qint64>(monotonicNs, out + 24);
+            const QByteArray name = portName.toUtf8().left(PORT_NAME_SIZE);
+            std::memcpy(out + 32, name.constData(), size_t(name.size()));
+        }
+
+        /**
+         * @brief 解析文件头
+         * @param data 至少 FILE_HEADER_SIZE 字节
+         * @return false 如果魔数不符
+         */
+        bool decode(const char *data) {
+            if (std::memcmp(data, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0) {
+                return false;
+            }
+            version = qFromLittleEndian<quint16>(data + 8);
+            headerSize = qFromLittleEndian<quint16>(data + 10);
+            wallClockMs = qFromLittleEndian<qint64>(data + 16);
+            monotonicNs = qFromLittleEndian<qint64>(data + 24);
+            const char *name = data + 32;
+            portName = QString::fromUtf8(name, qsizetype(qstrnlen(name, PORT_NAME_SIZE)));
+            return true;
+        }
+    };
+
+    /**
+     * @brief 记录头
+     *
+     * 偏移：0 同步字 u32，4 数据长度 u32，8 到达时间 i64，16 端口号 u16，18 方向 u8，
+     * 19 保留 u8，20 保留 u32。
+     */
+    struct RecordHeader {
+        quint32 length = 0;
+        qint64 timestampNs = 0;
+        quint16 portId = 0;
+        Direction direction = Rx;
+
+        void encode(char *out) const {
+            std::memset(out, 0, RECORD_HEADER_SIZE);
+            qToLittleEndian<quint32>(RECORD_MAGIC, out);
+            qToLittleEndian<quint32>(length, out + 4);
+            qToLittleEndian<qint64>(timestampNs, out + 8);
+            qToLittleEndian<quint16>(portId, out + 16);
+            out[18] = char(direction);
+        }
+
+        /**
+         * @brief 解析记录头
+         * @param data 至少 RECORD_HEADER_SIZE 字节
+         * @return false 如果同步字不符或长度超出上限
+         */
+        bool decode(const char *data) {
+            if (qFromLittleEndian<quint32>(data) != RECORD_MAGIC) {
+                return false;
+            }
+            length = qFromLittleEndian<quint32>(data + 4);
+            timestampNs = qFromLittleEndian<qint64>(data + 8);
+            portId = qFromLittleEndian<quint16>(data + 16);
+            direction = static_cast<Direction>(quint8(data[18]));
+            return length <= MAX_RECORD_SIZE && direction <= Tx;
+        }
+    };
+
+    /**
+     * @brief 索引条目：偏移 0 时间 i64，8 记录在数据文件中的偏移 i64
+     */
+    struct IndexEntry {
+        qint64 timestampNs = 0;
+        qint64 offset = 0;
+
+        void encode(char *out) const {
+            qToLittleEndian<qint64>(timestampNs, out);
+            qToLittleEndian<qint64>(offset, out + 8);
+        }
+
+        void decode(const char *data) {
+            timestampNs = qFromLittleEndian<qint64>(data);
+            offset = qFromLittleEndian<qint64>(data + 8);
+        }
+    };
+
+    /**
+     * @brief 索引头：偏移 0 魔数[8]，8 版本 u16，10 条目长度 u16，12 保留 u32
+     */
+    static void encodeIndexHeader(char *out) {
+        std::memset(out, 0, INDEX_HEADER_SIZE);
+        std::memcpy(out, INDEX_MAGIC, sizeof(INDEX_MAGIC));
+        qToLittleEndian<quint16>(VERSION, out + 8);
+        qToLittleEndian<quint16>(INDEX_ENTRY_SIZE, out + 10);
+    }
+
+    /**
+     * @brief 检查索引头
+     * @param data 至少 INDEX_HEADER_SIZE 字节
+     * @return true 如果魔数、版本和条目长度都可识别
+     */
+    static bool checkIndexHeader(const char *data) {
+        return std::memcmp(data, INDEX_MAGIC, sizeof(INDEX_MAGIC)) == 0
+            && qFromLittleEndian<quint16>(data + 8) <= VERSION
+            && qFromLittleEndian<quint16>(data + 10) == INDEX_ENTRY_SIZE;
+    }
+
+    /**
+     * @brief 获取数据文件对应的索引文件路径
+     * @param dataPath 数据文件路径
+     * @return 索引文件路径
+     */
+    static QString indexPath(const QString &dataPath) {
+        return dataPath + INDEX_SUFFIX;
+    }
+};
+
+#endif // CAPTUREFORMAT_H
@@ -0,0 +1,231 @@
+#include "capturereader.h"
+
+#include <algorithm>
+#include <iterator>
+
+/**
+ * @brief CaptureReader 实现
+ */
+
+bool CaptureReader::open(const QString &path, QString *error)
+{
+    close();
+
+    auto fail = [this, error](const QString &message) {
+        if (error) {
+            *error = message;
+        }
+        close();
+        return false;
+    };
+
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        return fail(QString("无法打开捕获文件: %1").arg(m_file.errorString()));
+    }
+
+    char encoded[CaptureFormat::FILE_HEADER_SIZE];
+    if (m_file.read(encoded, sizeof(encoded)) != qint64(sizeof(encoded)) || !m_header.decode(encoded)) {
+        return fail("不是带索引的捕获文件");
+    }
+    if (m_header.version > CaptureFormat::VERSION) {
+        return fail(QString("不支持的捕获文件版本 %1").arg(m_header.version));
+    }
+    if (m_header.headerSize < CaptureFormat::FILE_HEADER_SIZE) {
+        return fail("捕获文件头损坏");
+    }
+    m_scanOffset = m_header.headerSize;
+
+    // 索引文件不可用时退回扫描，数据本身仍然可读
+    m_indexFile.setFileName(CaptureFormat::indexPath(path));
+    if (m_indexFile.open(QIODevice::ReadOnly)) {
+        char indexHeader[CaptureFormat::INDEX_HEADER_SIZE];
+        m_hasIndexFile = m_indexFile.read(indexHeader, sizeof(indexHeader)) == qint64(sizeof(indexHeader))
+                         && CaptureFormat::checkIndexHeader(indexHeader);
+        m_indexFileBytes = CaptureFormat::INDEX_HEADER_SIZE;
+        if (!m_hasIndexFile) {
+            m_indexFile.close();
+        }
+    }
+
+    refresh();
+    if (error) {
+        error->clear();
+    }
+    return true;
+}
+
+void CaptureReader::close()
+{
+    m_file.close();
+    m_indexFile.close();
+    m_header = CaptureFormat::FileHeader();
+    m_size = 0;
+    m_index.clear();
+    m_indexFileBytes = 0;
+    m_hasIndexFile = false;
+    m_scanOffset = 0;
+}
+
+bool CaptureReader::isOpen() const
+{
+    return m_file.isOpen();
+}
+
+const CaptureFormat::FileHeader &CaptureReader::header() const
+{
+    return m_header;
+}
+
+bool CaptureReader::hasIndexFile() const
+{
+    return m_hasIndexFile;
+}
+
+qint64 CaptureReader::indexSize() const
+{
+    return qint64(m_index.size());
+}
+
+qint64 CaptureReader::firstOffset() const
+{
+    return m_header.headerSize;
+}
+
+qint64 CaptureReader::size() const
+{
+    return m_size;
+}
+
+bool CaptureReader::refresh()
+{
+    if (!m_file.isOpen()) {
+        return false;
+    }
+
+    // 先读索引再取文件长度：写入方先写数据后写索引，条目指向的数据一定在长度之内
+    if (m_hasIndexFile) {
+        loadIndexFile();
+    }
+    const qint64 size = m_file.size();
+    const bool grown = size > m_size;
+    m_size = size;
+    if (!m_hasIndexFile) {
+        scanIndex();
+    }
+    return grown;
+}
+
+bool CaptureReader::readRecord(qint64 offset, CaptureRecord *record, qint64 *next)
+{
+    CaptureFormat::RecordHeader header;
+    if (!readHeader(offset, &header)) {
+        return false;
+    }
+    const qint64 end = offset + CaptureFormat::RECORD_HEADER_SIZE + header.length;
+    if (end > m_size) {
+        return false;
+    }
+
+    record->data.resize(qsizetype(header.length));
+    if (header.length > 0 && m_file.read(record->data.data(), header.length) != qint64(header.length)) {
+        return false;
+    }
+    record->offset = offset;
+    record->timestampNs = header.timestampNs;
+    record->portId = header.portId;
+    record->direction = header.direction;
+    if (next) {
+        *next = end;
+    }
+    return true;
+}
+
+qint64 CaptureReader::seek(qint64 timestampNs)
+{
+    // 第一个时间不早于目标的条目之前的那个条目开始，之间的记录可能已经达到目标
+    auto it = std::lower_bound(m_index.begin(), m_index.end(), timestampNs,
+                               [](const CaptureFormat::IndexEntry &entry, qint64 target) {
+                                   return entry.timestampNs < target;
+                               });
+    qint64 offset = it == m_index.begin() ? firstOffset() : std::prev(it)->offset;
+
+    CaptureFormat::RecordHeader header;
+    while (readHeader(offset, &header)) {
+        const qint64 end = offset + CaptureFormat::RECORD_HEADER_SIZE + header.length;
+        if (header.timestampNs >= timestampNs || end > m_size) {
+            return offset;
+        }
+        offset = end;
+    }
+    return m_size;
+}
+
+qint64 CaptureReader::seek(const QDateTime &time)
+{
+    return seek(toMonotonic(time));
+}
+
+qint64 CaptureReader::toMonotonic(const QDateTime &time) const
+{
+    return m_header.monotonicNs + (time.toMSecsSinceEpoch() - m_header.wallClockMs) * 1000000;
+}
+
+QDateTime CaptureReader::toDateTime(qint64 timestampNs) const
+{
+    return QDateTime::fromMSecsSinceEpoch(m_header.wallClockMs + (timestampNs - m_header.monotonicNs) / 1000000);
+}
+
+bool CaptureReader::readHeader(qint64 offset, CaptureFormat::RecordHeader *header)
+{
+    if (offset < firstOffset() || offset + CaptureFormat::RECORD_HEADER_SIZE > m_size || !m_file.seek(offset)) {
+        return false;
+    }
+    char encoded[CaptureFormat::RECORD_HEADER_SIZE];
+    return m_file.read(encoded, sizeof(encoded)) == qint64(sizeof(encoded)) && header->decode(encoded);
+}
+
+void CaptureReader::loadIndexFile()
+{
+    // 只读入完整的条目，写到一半的条目留到下次
+    const qint64 available = m_indexFile.size() - m_indexFileBytes;
+    const qint64 count = available / CaptureFormat::INDEX_ENTRY_SIZE;
+    if (count <= 0 || !m_indexFile.seek(m_indexFileBytes)) {
+        return;
+    }
+
+    const QByteArray entries = m_indexFile.read(count * CaptureFormat::INDEX_ENTRY_SIZE);
+    const qint64 complete = entries.size() / CaptureFormat::INDEX_ENTRY_SIZE;
+    for (qint64 i = 0; i < complete; ++i) {
+        CaptureFormat::IndexEntry entry;
+        entry.decode(entries.constData() + i * CaptureFormat::INDEX_ENTRY_SIZE);
+        // 损坏或乱序的条目会破坏二分查找，丢弃
+        if (entry.offset < firstOffset()
+            || (!m_index.empty() && (entry.offset <= m_index.back().offset
+                                     || entry.timestampNs < m_index.back().timestampNs))) {
+            continue;
+        }
+        m_index.push_back(entry);
+    }
+    m_indexFileBytes += complete * CaptureFormat::INDEX_ENTRY_SIZE;
+}
+
+void CaptureReader::scanIndex()
+{
+    CaptureFormat::RecordHeader header;
+    while (readHeader(m_scanOffset, &header)) {
+        const qint64 end = m_scanOffset + CaptureFormat::RECORD_HEADER_SIZE + header.length;
+        if (end > m_size) {
+            break;
+        }
+        if (m_index.empty() || m_scanOffset - m_index.back().offset >= CaptureFormat::INDEX_STRIDE_BYTES
+            || header.timestampNs - m_index.back().timestampNs >= CaptureFormat::INDEX_STRIDE_NS) {
+            CaptureFormat::IndexEntry entry;
+            entry.timestampNs = m_index.empty() ? header.timestampNs
+                                                : qMax(header.timestampNs, m_index.back().timestampNs);
+            entry.offset = m_scanOffset;
+            m_index.push_back(entry);
+        }
+        m_scanOffset = end;
+    }
+}
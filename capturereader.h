@@ -0,0 +1,157 @@
+#ifndef CAPTUREREADER_H
+#define CAPTUREREADER_H
+
+#include <QByteArray>
+#include <QDateTime>
+#include <QFile>
+#include <QString>
+#include <vector>
+
+#include "captureformat.h"
+
+/**
+ * @brief CaptureRecord - 捕获文件中的一条记录
+ */
+struct CaptureRecord {
+    qint64 offset = -1;                                      ///< 记录在数据文件中的偏移
+    qint64 timestampNs = 0;                                  ///< 到达/发送时间（单调时钟纳秒）
+    quint16 portId = 0;                                      ///< 端口号
+    CaptureFormat::Direction direction = CaptureFormat::Rx;  ///< 方向
+    QByteArray data;                                         ///< 数据
+};
+
+/**
+ * @brief CaptureReader - 带索引捕获文件（IndexedFormat）的读取
+ *
+ * 打开时读入文件头和 .idx 索引；按时间定位时在索引中二分查找，
+ * 再从前一个条目向后扫描记录头（不超过一个索引步长），不需要线性扫描整个文件。
+ * 索引文件缺失或损坏时扫描一遍记录头，在内存中按同样的步长重建索引。
+ *
+ * 文件仍在写入时也可以读取：refresh() 读入新追加的索引条目和数据，
+ * 末尾不完整的记录视为尚未写完。
+ *
+ * 不是线程安全的，每个线程使用自己的实例。
+ */
+class CaptureReader
+{
+public:
+    CaptureReader() = default;
+    CaptureReader(const CaptureReader &) = delete;
+    CaptureReader &operator=(const CaptureReader &) = delete;
+
+    /**
+     * @brief 打开捕获文件
+     * @param path 数据文件路径（.sswcap）
+     * @param error 输出错误信息，可为 nullptr
+     * @return true 如果打开成功
+     */
+    bool open(const QString &path, QString *error = nullptr);
+
+    /**
+     * @brief 关闭文件
+     */
+    void close();
+
+    /**
+     * @brief 是否已打开
+     * @return true 如果已打开
+     */
+    bool isOpen() const;
+
+    /**
+     * @brief 获取文件头
+     * @return 文件头（端口名、创建时间等）
+     */
+    const CaptureFormat::FileHeader &header() const;
+
+    /**
+     * @brief 是否使用了 .idx 索引文件（否则为扫描重建的索引）
+     * @return true 如果索引来自索引文件
+     */
+    bool hasIndexFile() const;
+
+    /**
+     * @brief 获取索引条目数
+     * @return 条目数
+     */
+    qint64 indexSize() const;
+
+    /**
+     * @brief 第一条记录的偏移
+     * @return 文件头之后的偏移
+     */
+    qint64 firstOffset() const;
+
+    /**
+     * @brief 获取上次 open()/refresh() 时数据文件的长度
+     * @return 字节数
+     */
+    qint64 size() const;
+
+    /**
+     * @brief 读入打开之后追加的索引条目和数据（文件仍在写入时使用）
+     * @return true 如果文件变长了
+     */
+    bool refresh();
+
+    /**
+     * @brief 读取一条记录
+     * @param offset 记录偏移
+     * @param record 输出记录
+     * @param next 输出下一条记录的偏移，可为 nullptr
+     * @return false 如果已到末尾、末尾记录尚未写完或记录损坏
+     */
+    bool readRecord(qint64 offset, CaptureRecord *record, qint64 *next = nullptr);
+
+    /**
+     * @brief 按时间定位
+     * @param timestampNs 目标时间（单调时钟纳秒）
+     * @return 第一条时间不早于目标的记录偏移；都早于目标时返回 size()
+     */
+    qint64 seek(qint64 timestampNs);
+
+    /**
+     * @brief 按本地时间定位
+     * @param time 目标时间
+     * @return 同 seek()
+     */
+    qint64 seek(const QDateTime &time);
+
+    /**
+     * @brief 本地时间换算为文件中的单调时钟时间
+     */
+    qint64 toMonotonic(const QDateTime &time) const;
+
+    /**
+     * @brief 文件中的单调时钟时间换算为本地时间
+     */
+    QDateTime toDateTime(qint64 timestampNs) const;
+
+private:
+    /**
+     * @brief 读取记录头
+     * @return false 如果超出 m_size 或损坏
+     */
+    bool readHeader(qint64 offset, CaptureFormat::RecordHeader *header);
+
+    /**
+     * @brief 读入索引文件中新的完整条目
+     */
+    void loadIndexFile();
+
+    /**
+     * @brief 从 m_scanOffset 扫描记录头，按写入方的规则补充索引条目（没有索引文件时）
+     */
+    void scanIndex();
+
+    QFile m_file;                                    ///< 数据文件
+    QFile m_indexFile;                               ///< 索引文件
+    CaptureFormat::FileHeader m_header;              ///< 文件头
+    qint64 m_size = 0;                               ///< 已知的数据文件长度
+    std::vector<CaptureFormat::IndexEntry> m_index;  ///< 索引条目（时间非递减）
+    qint64 m_indexFileBytes = 0;                     ///< 已读入的索引文件字节数
+    bool m_hasIndexFile = false;                     ///< 索引来自索引文件
+    qint64 m_scanOffset = 0;                         ///< 扫描重建索引时下一条记录的偏移
+};
+
+#endif // CAPTUREREADER_H
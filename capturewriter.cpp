@@ -0,0 +1,491 @@
+#include "capturewriter.h"
+#include "timestampformatter.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QMutexLocker>
+#include <QThread>
+#include <cstring>
+#include <new>
+
+#ifdef Q_OS_WIN
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+/**
+ * @brief CaptureWriter 实现
+ */
+
+void CaptureWriter::AlignedDeleter::operator()(char *p) const
+{
+    ::operator delete(p, std::align_val_t(BUFFER_ALIGNMENT));
+}
+
+CaptureWriter::CaptureWriter(QObject *parent)
+    : QObject(parent)
+{
+}
+
+CaptureWriter::~CaptureWriter()
+{
+    stop();
+}
+
+bool CaptureWriter::start(const CaptureConfig &config, QString *error)
+{
+    stop();
+
+    const QString validation = config.validationError();
+    if (!validation.isEmpty()) {
+        if (error) {
+            *error = validation;
+        }
+        return false;
+    }
+    if (!QDir().mkpath(config.directory)) {
+        if (error) {
+            *error = QString("无法创建捕获目录: %1").arg(config.directory);
+        }
+        return false;
+    }
+
+    if (!m_buffer) {
+        m_buffer.reset(static_cast<char *>(::operator new(BUFFER_SIZE, std::align_val_t(BUFFER_ALIGNMENT))));
+    }
+    m_config = config;
+    m_bufferUsed = 0;
+    m_fileBytes = 0;
+    m_dirty = false;
+    m_writeFailed = false;
+    m_writtenBytes = 0;
+    m_statsWrittenBytes = 0;
+    m_statsTimer.start();
+
+    {
+        QMutexLocker locker(&m_mutex);
+        m_queue.clear();
+        m_queuedBytes = 0;
+        m_peakQueuedBytes = 0;
+        m_droppedBytes = 0;
+        m_stopping = false;
+        m_failed = false;
+        m_files = 0;
+        m_currentFile.clear();
+        m_lastError.clear();
+        m_running = true;
+    }
+
+    // 专用线程：磁盘写入可能长时间阻塞，不与串口或处理线程共享
+    m_thread.reset(QThread::create([this]() { run(); }));
+    m_thread->setObjectName("SSW-capture");
+    m_thread->start(QThread::LowPriority);
+    return true;
+}
+
+void CaptureWriter::stop()
+{
+    if (!m_thread) {
+        return;
+    }
+
+    {
+        QMutexLocker locker(&m_mutex);
+        m_stopping = true;
+        m_wake.wakeOne();
+    }
+    m_thread->wait();
+    m_thread.reset();
+
+    QMutexLocker locker(&m_mutex);
+    m_running = false;
+    m_queue.clear();
+    m_queuedBytes = 0;
+}
+
+bool CaptureWriter::isRunning() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_running;
+}
+
+void CaptureWriter::append(const RxChunk &chunk)
+{
+    if (chunk.isEmpty()) {
+        return;
+    }
+
+    Pending pending;
+    pending.chunk = chunk;
+    pending.timestampNs = chunk.timestampNs();
+    pending.direction = CaptureFormat::Rx;
+
+    QMutexLocker locker(&m_mutex);
+    enqueue(std::move(pending));
+}
+
+void CaptureWriter::appendTransmit(const QByteArray &data, qint64 timestampNs)
+{
+    if (data.isEmpty()) {
+        return;
+    }
+
+    Pending pending;
+    pending.bytes = data;
+    pending.timestampNs = timestampNs;
+    pending.direction = CaptureFormat::Tx;
+
+    QMutexLocker locker(&m_mutex);
+    // 原样格式只保存接收到的字节
+    if (m_config.format == CaptureConfig::IndexedFormat) {
+        enqueue(std::move(pending));
+    }
+}
+
+bool CaptureWriter::enqueue(Pending &&pending)
+{
+    if (!m_running || m_stopping) {
+        return false;
+    }
+    if (m_failed || m_queuedBytes + pending.size() > m_config.queueBytes) {
+        // 不等待写入线程：宁可丢弃也不阻塞串口线程
+        m_droppedBytes += pending.size();
+        return false;
+    }
+
+    const bool wasEmpty = m_queue.empty();
+    m_queuedBytes += pending.size();
+    m_queue.push_back(std::move(pending));
+    m_peakQueuedBytes = qMax(m_peakQueuedBytes, m_queuedBytes);
+    if (wasEmpty) {
+        m_wake.wakeOne();
+    }
+    return true;
+}
+
+CaptureStats CaptureWriter::stats()
+{
+    CaptureStats stats;
+    {
+        QMutexLocker locker(&m_mutex);
+        stats.running = m_running;
+        stats.droppedBytes = m_droppedBytes;
+        stats.queuedBytes = m_queuedBytes;
+        stats.queuedChunks = qint64(m_queue.size());
+        stats.peakQueuedBytes = m_peakQueuedBytes;
+        stats.files = m_files;
+        stats.currentFile = m_currentFile;
+        stats.lastError = m_lastError;
+    }
+    stats.writtenBytes = m_writtenBytes.load(std::memory_order_relaxed);
+
+    const qint64 elapsedMs = m_statsTimer.isValid() ? m_statsTimer.restart() : 0;
+    if (elapsedMs > 0) {
+        stats.bytesPerSecond = double(stats.writtenBytes - m_statsWrittenBytes) * 1000.0 / double(elapsedMs);
+    }
+    m_statsWrittenBytes = stats.writtenBytes;
+    return stats;
+}
+
+void CaptureWriter::run()
+{
+    // 此方法在写入线程中执行
+    std::deque<Pending> batch;
+    bool stopping = false;
+    m_syncTimer.start();
+
+    while (!stopping) {
+        {
+            QMutexLocker locker(&m_mutex);
+            if (m_queue.empty() && !m_stopping) {
+                m_wake.wait(&m_mutex, FLUSH_INTERVAL_MS);
+            }
+            batch.swap(m_queue);
+            m_queuedBytes = 0;
+            stopping = m_stopping;
+        }
+
+        for (const Pending &pending : batch) {
+            const char *data = pending.direction == CaptureFormat::Rx ? pending.chunk.data() : pending.bytes.constData();
+            // 未记录到达时间的块按写入时间记录
+            const qint64 timestampNs = pending.timestampNs != 0 ? pending.timestampNs : TimestampFormatter::monotonicNs();
+            bufferRecord(data, pending.size(), timestampNs, pending.direction);
+        }
+        // 数据已拷贝到缓冲区，尽快把接收块还给 SlabPool
+        batch.clear();
+
+        // 缓冲区不满时，数据等待太久或即将停止也写出
+        if (m_bufferUsed > 0 && (stopping || m_bufferTimer.hasExpired(FLUSH_INTERVAL_MS))) {
+            writeBuffer();
+        }
+
+        if (m_dirty && m_config.syncPolicy == CaptureConfig::PeriodicSync
+            && m_syncTimer.hasExpired(m_config.syncIntervalMs)) {
+            syncFile();
+        }
+    }
+
+    closeFile();
+}
+
+bool CaptureWriter::bufferRecord(const char *data, qsizetype size, qint64 timestampNs,
+                                 CaptureFormat::Direction direction)
+{
+    if (m_writeFailed) {
+        addDropped(size);
+        return false;
+    }
+
+    const bool indexed = m_config.format == CaptureConfig::IndexedFormat;
+    const qint64 recordBytes = size + (indexed ? CaptureFormat::RECORD_HEADER_SIZE : 0);
+
+    // 只在记录边界切换文件，每个文件都可以独立读取
+    if (m_file.isOpen() && needsRotation(recordBytes)) {
+        if (!writeBuffer()) {
+            addDropped(size);
+            return false;
+        }
+        closeFile();
+    }
+    if (!m_file.isOpen() && !openNextFile()) {
+        addDropped(size);
+        return false;
+    }
+
+    if (indexed) {
+        const qint64 offset = m_fileBytes + m_bufferUsed;
+        if (m_lastIndexOffset < 0 || offset - m_lastIndexOffset >= CaptureFormat::INDEX_STRIDE_BYTES
+            || timestampNs - m_lastIndexNs >= CaptureFormat::INDEX_STRIDE_NS) {
+            // 发送记录来自 UI 线程，可能比前面的接收记录略早：索引时间保持非递减
+            CaptureFormat::IndexEntry entry;
+            entry.timestampNs = m_lastIndexOffset < 0 ? timestampNs : qMax(timestampNs, m_lastIndexNs);
+            entry.offset = offset;
+            m_pendingIndex.push_back(entry);
+            m_lastIndexOffset = offset;
+            m_lastIndexNs = entry.timestampNs;
+        }
+
+        CaptureFormat::RecordHeader header;
+        header.length = quint32(size);
+        header.timestampNs = timestampNs;
+        header.portId = m_config.portId;
+        header.direction = direction;
+        char encoded[CaptureFormat::RECORD_HEADER_SIZE];
+        header.encode(encoded);
+        if (!copyToBuffer(encoded, sizeof(encoded))) {
+            addDropped(size);
+            return false;
+        }
+    }
+    return copyToBuffer(data, size);
+}
+
+bool CaptureWriter::copyToBuffer(const char *data, qsizetype size)
+{
+    qsizetype remaining = size;
+    while (remaining > 0) {
+        if (m_bufferUsed == 0) {
+            m_bufferTimer.start();
+        }
+        const qsizetype n = qMin(remaining, BUFFER_SIZE - m_bufferUsed);
+        std::memcpy(m_buffer.get() + m_bufferUsed, data, size_t(n));
+        m_bufferUsed += n;
+        data += n;
+        remaining -= n;
+
+        if (m_bufferUsed == BUFFER_SIZE && !writeBuffer()) {
+            addDropped(remaining);
+            return false;
+        }
+    }
+    return true;
+}
+
+bool CaptureWriter::needsRotation(qint64 recordBytes) const
+{
+    // 至少写入一条记录后才按大小切换，超大的单条记录不会导致空文件
+    const qint64 headerBytes = m_config.format == CaptureConfig::IndexedFormat ? CaptureFormat::FILE_HEADER_SIZE : 0;
+    const qint64 fileBytes = m_fileBytes + m_bufferUsed;
+    const bool sizeExceeded = m_config.maxFileBytes > 0 && fileBytes > headerBytes
+                              && fileBytes + recordBytes > m_config.maxFileBytes;
+    const bool timeExceeded = m_config.maxFileSeconds > 0
+                              && m_fileTimer.hasExpired(qint64(m_config.maxFileSeconds) * 1000);
+    return sizeExceeded || timeExceeded;
+}
+
+bool CaptureWriter::writeBuffer()
+{
+    if (m_writeFailed) {
+        addDropped(m_bufferUsed);
+        m_bufferUsed = 0;
+        return false;
+    }
+
+    qsizetype written = 0;
+    while (written < m_bufferUsed) {
+        const qint64 n = m_file.write(m_buffer.get() + written, m_bufferUsed - written);
+        if (n <= 0) {
+            fail(QString("写入捕获文件失败: %1").arg(m_file.errorString()));
+            m_fileBytes += written;
+            m_writtenBytes.fetch_add(written, std::memory_order_relaxed);
+            addDropped(m_bufferUsed - written);
+            m_bufferUsed = 0;
+            return false;
+        }
+        written += qsizetype(n);
+    }
+
+    m_fileBytes += m_bufferUsed;
+    m_writtenBytes.fetch_add(m_bufferUsed, std::memory_order_relaxed);
+    m_bufferUsed = 0;
+    m_dirty = true;
+
+    // 数据已在文件中，之后才让读取方看到指向它的索引条目
+    if (!flushIndex()) {
+        return false;
+    }
+
+    if (m_config.syncPolicy == CaptureConfig::SyncEveryWrite) {
+        syncFile();
+    }
+    return true;
+}
+
+bool CaptureWriter::flushIndex()
+{
+    if (m_pendingIndex.empty()) {
+        return true;
+    }
+
+    QByteArray entries(qsizetype(m_pendingIndex.size()) * CaptureFormat::INDEX_ENTRY_SIZE, Qt::Uninitialized);
+    char *out = entries.data();
+    for (const CaptureFormat::IndexEntry &entry : m_pendingIndex) {
+        entry.encode(out);
+        out += CaptureFormat::INDEX_ENTRY_SIZE;
+    }
+    m_pendingIndex.clear();
+
+    if (m_indexFile.write(entries) != entries.size()) {
+        fail(QString("写入捕获索引失败: %1").arg(m_indexFile.errorString()));
+        return false;
+    }
+    return true;
+}
+
+bool CaptureWriter::openNextFile()
+{
+    int index = 0;
+    {
+        QMutexLocker locker(&m_mutex);
+        index = ++m_files;
+    }
+
+    const bool indexed = m_config.format == CaptureConfig::IndexedFormat;
+    const QDateTime now = QDateTime::currentDateTime();
+    const QString name = QString("%1_%2_%3%4")
+        .arg(m_config.baseName, now.toString("yyyyMMdd_HHmmss"))
+        .arg(index, 3, 10, QLatin1Char('0'))
+        .arg(indexed ? CaptureFormat::DATA_SUFFIX : QStringLiteral(".bin"));
+    m_file.setFileName(QDir(m_config.directory).filePath(name));
+
+    // 无缓冲：写缓冲区已经足够大，避免再经过 QFile 的缓冲拷贝一次
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Unbuffered)) {
+        fail(QString("无法创建捕获文件 %1: %2").arg(m_file.fileName(), m_file.errorString()));
+        return false;
+    }
+
+    m_fileBytes = 0;
+    m_pendingIndex.clear();
+    m_lastIndexOffset = -1;
+    m_lastIndexNs = 0;
+
+    if (indexed) {
+        // 文件头记录同一时刻的本地时间和单调时钟，读取方据此按本地时间定位
+        CaptureFormat::FileHeader header;
+        header.wallClockMs = now.toMSecsSinceEpoch();
+        header.monotonicNs = TimestampFormatter::monotonicNs();
+        header.portName = m_config.baseName;
+        char encoded[CaptureFormat::FILE_HEADER_SIZE];
+        header.encode(encoded);
+        if (m_file.write(encoded, sizeof(encoded)) != qint64(sizeof(encoded))) {
+            fail(QString("写入捕获文件失败: %1").arg(m_file.errorString()));
+            m_file.close();
+            return false;
+        }
+        m_fileBytes = sizeof(encoded);
+
+        m_indexFile.setFileName(CaptureFormat::indexPath(m_file.fileName()));
+        char indexHeader[CaptureFormat::INDEX_HEADER_SIZE];
+        CaptureFormat::encodeIndexHeader(indexHeader);
+        if (!m_indexFile.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Unbuffered)
+            || m_indexFile.write(indexHeader, sizeof(indexHeader)) != qint64(sizeof(indexHeader))) {
+            fail(QString("无法创建捕获索引 %1: %2").arg(m_indexFile.fileName(), m_indexFile.errorString()));
+            m_indexFile.close();
+            m_file.close();
+            return false;
+        }
+    }
+
+    m_fileTimer.start();
+    m_syncTimer.start();
+    m_dirty = false;
+
+    QMutexLocker locker(&m_mutex);
+    m_currentFile = m_file.fileName();
+    return true;
+}
+
+void CaptureWriter::closeFile()
+{
+    if (!m_file.isOpen()) {
+        return;
+    }
+    if (m_dirty && m_config.syncPolicy != CaptureConfig::NoSync) {
+        syncFile();
+    }
+    m_file.close();
+    m_indexFile.close();
+}
+
+void CaptureWriter::syncFile()
+{
+    if (!m_file.isOpen()) {
+        return;
+    }
+    for (QFile *file : {&m_file, &m_indexFile}) {
+        if (!file->isOpen()) {
+            continue;
+        }
+#ifdef Q_OS_WIN
+        _commit(file->handle());
+#else
+        ::fsync(file->handle());
+#endif
+    }
+    m_dirty = false;
+    m_syncTimer.start();
+}
+
+void CaptureWriter::addDropped(qint64 bytes)
+{
+    if (bytes > 0) {
+        QMutexLocker locker(&m_mutex);
+        m_droppedBytes += bytes;
+    }
+}
+
+void CaptureWriter::fail(const QString &error)
+{
+    m_writeFailed = true;
+    {
+        QMutexLocker locker(&m_mutex);
+        if (m_failed) {
+            return;
+        }
+        m_failed = true;
+        m_lastError = error;
+    }
+    // 从写入线程发出，排队到 UI 线程中的接收者
+    emit errorOccurred(error);
+}
@@ -0,0 +1,241 @@
+#ifndef CAPTUREWRITER_H
+#define CAPTUREWRITER_H
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QMutex>
+#include <QObject>
+#include <QString>
+#include <QWaitCondition>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "captureconfig.h"
+#include "captureformat.h"
+#include "rxchunk.h"
+
+class QThread;
+
+/**
+ * @brief CaptureStats - 捕获统计
+ */
+struct CaptureStats {
+    bool running = false;         ///< 是否正在捕获
+    qint64 writtenBytes = 0;      ///< 本次捕获累计写入的字节数
+    qint64 droppedBytes = 0;      ///< 队列满或写入失败而丢弃的字节数
+    qint64 queuedBytes = 0;       ///< 队列中等待写入的字节数
+    qint64 queuedChunks = 0;      ///< 队列中等待写入的块数
+    qint64 peakQueuedBytes = 0;   ///< 队列峰值字节数
+    double bytesPerSecond = 0;    ///< 上次调用 stats() 以来的写入速度
+    int files = 0;                ///< 已创建的文件数
+    QString currentFile;          ///< 当前文件路径
+    QString lastError;            ///< 最近一次错误
+};
+
+/**
+ * @brief CaptureWriter - 原始数据捕获（只追加文件）
+ *
+ * 把 SerialWorker 发出的接收块（以及发送的数据）写入磁盘，用于事后分析和回放。
+ * append() 在串口线程中直接调用，只在短暂持锁时把块引用放入队列（不拷贝、不等待磁盘），
+ * 队列超过上限时丢弃新数据并计数，从不阻塞串口线程。
+ *
+ * 写入在专用线程中进行：接收块拷贝到按页对齐的 1 MiB 缓冲区后立即释放引用，
+ * 缓冲区满或数据已等待 FLUSH_INTERVAL_MS 时整块写出（无缓冲打开文件，不再经过 QFile 的缓冲）。
+ * 文件按大小或时长在记录边界轮转，按 SyncPolicy 调用 fsync。
+ *
+ * IndexedFormat 下每块数据写成一条带到达时间、方向和端口号的记录，
+ * 稀疏索引在对应数据写出后追加到同名 .idx 文件（格式见 CaptureFormat）。
+ *
+ * 在 UI 线程中创建和控制；append() 线程安全。
+ */
+class CaptureWriter : public QObject
+{
+    Q_OBJECT
+
+public:
+    static constexpr qsizetype BUFFER_SIZE = qsizetype(1) << 20;   ///< 写缓冲区大小
+    static constexpr size_t BUFFER_ALIGNMENT = 4096;               ///< 写缓冲区对齐
+    static constexpr int FLUSH_INTERVAL_MS = 200;                  ///< 缓冲区中的数据最多等待多久写出
+
+    /**
+     * @brief 构造函数
+     * @param parent 父对象
+     */
+    explicit CaptureWriter(QObject *parent = nullptr);
+
+    /**
+     * @brief 析构函数（写完队列中的数据并关闭文件）
+     */
+    ~CaptureWriter();
+
+    /**
+     * @brief 开始捕获
+     *
+     * 已在捕获时先停止。第一个文件在收到第一块数据时创建。
+     *
+     * @param config 捕获配置
+     * @param error 输出错误信息，可为 nullptr
+     * @return true 如果已开始
+     */
+    bool start(const CaptureConfig &config, QString *error = nullptr);
+
+    /**
+     * @brief 停止捕获：写完队列中的数据，按策略同步后关闭文件
+     */
+    void stop();
+
+    /**
+     * @brief 是否正在捕获
+     * @return true 如果正在捕获
+     */
+    bool isRunning() const;
+
+    /**
+     * @brief 追加一块原始数据（线程安全，不等待磁盘）
+     * @param chunk 接收块
+     */
+    void append(const RxChunk &chunk);
+
+    /**
+     * @brief 追加一段发送的数据（线程安全，不等待磁盘；仅 IndexedFormat 记录）
+     * @param data 发送的数据
+     * @param timestampNs 发送时间（单调时钟纳秒）
+     */
+    void appendTransmit(const QByteArray &data, qint64 timestampNs);
+
+    /**
+     * @brief 获取捕获统计（UI 线程调用，写入速度按两次调用的间隔计算）
+     * @return 统计信息
+     */
+    CaptureStats stats();
+
+signals:
+    /**
+     * @brief 写入失败，捕获已停止写入（后续数据计为丢弃）
+     * @param error 错误描述
+     */
+    void errorOccurred(const QString &error);
+
+private:
+    /**
+     * @brief 写入线程主循环
+     */
+    void run();
+
+    /**
+     * @brief 队列中等待写入的一段数据
+     */
+    struct Pending {
+        RxChunk chunk;                    ///< 接收块（接收方向）
+        QByteArray bytes;                 ///< 发送的数据（发送方向）
+        qint64 timestampNs = 0;           ///< 到达/发送时间
+        CaptureFormat::Direction direction = CaptureFormat::Rx;
+
+        qsizetype size() const { return direction == CaptureFormat::Rx ? chunk.size() : bytes.size(); }
+    };
+
+    /**
+     * @brief 把数据放入队列（调用方已持锁）
+     * @return false 如果队列已满而丢弃
+     */
+    bool enqueue(Pending &&pending);
+
+    /**
+     * @brief 把一条记录（IndexedFormat 下含记录头）放入写缓冲区，必要时先轮转文件
+     * @return false 如果写入失败
+     */
+    bool bufferRecord(const char *data, qsizetype size, qint64 timestampNs, CaptureFormat::Direction direction);
+
+    /**
+     * @brief 把字节拷贝到写缓冲区，满时写出
+     * @return false 如果写入失败（未写入的部分计为丢弃）
+     */
+    bool copyToBuffer(const char *data, qsizetype size);
+
+    /**
+     * @brief 当前文件放入 recordBytes 后是否应切换到新文件
+     */
+    bool needsRotation(qint64 recordBytes) const;
+
+    /**
+     * @brief 写出缓冲区，随后追加已写出数据的索引条目
+     * @return false 如果写入失败
+     */
+    bool writeBuffer();
+
+    /**
+     * @brief 把等待中的索引条目追加到索引文件
+     * @return false 如果写入失败
+     */
+    bool flushIndex();
+
+    /**
+     * @brief 创建下一个捕获文件
+     * @return false 如果创建失败
+     */
+    bool openNextFile();
+
+    /**
+     * @brief 按策略同步并关闭当前文件
+     */
+    void closeFile();
+
+    /**
+     * @brief 把当前文件（和索引文件）同步到磁盘
+     */
+    void syncFile();
+
+    /**
+     * @brief 记录错误，此后丢弃所有数据
+     */
+    void fail(const QString &error);
+
+    /**
+     * @brief 计入丢弃的字节数
+     */
+    void addDropped(qint64 bytes);
+
+    struct AlignedDeleter {
+        void operator()(char *p) const;
+    };
+
+    std::unique_ptr<QThread> m_thread;              ///< 写入线程
+
+    mutable QMutex m_mutex;                         ///< 保护以下成员
+    QWaitCondition m_wake;                          ///< 队列由空变为非空或需要停止时唤醒写入线程
+    std::deque<Pending> m_queue;                    ///< 等待写入的数据
+    qint64 m_queuedBytes = 0;                       ///< 队列字节数
+    qint64 m_peakQueuedBytes = 0;                   ///< 队列峰值字节数
+    qint64 m_droppedBytes = 0;                      ///< 丢弃的字节数
+    bool m_running = false;                         ///< 是否正在捕获
+    bool m_stopping = false;                        ///< 要求写入线程写完后退出
+    bool m_failed = false;                          ///< 写入失败
+    int m_files = 0;                                ///< 已创建的文件数
+    QString m_currentFile;                          ///< 当前文件路径
+    QString m_lastError;                            ///< 最近一次错误
+
+    // 以下只在写入线程中使用（start/stop 在线程不运行时设置）
+    CaptureConfig m_config;                         ///< 捕获配置
+    QFile m_file;                                   ///< 当前文件
+    QFile m_indexFile;                              ///< 当前文件的索引（IndexedFormat）
+    std::vector<CaptureFormat::IndexEntry> m_pendingIndex; ///< 数据尚未写出的索引条目
+    qint64 m_lastIndexOffset = -1;                  ///< 上一索引条目的偏移，-1 表示当前文件还没有条目
+    qint64 m_lastIndexNs = 0;                       ///< 上一索引条目的时间
+    std::unique_ptr<char, AlignedDeleter> m_buffer; ///< 写缓冲区（按页对齐）
+    qsizetype m_bufferUsed = 0;                     ///< 写缓冲区已用字节数
+    QElapsedTimer m_bufferTimer;                    ///< 缓冲区中最早的数据等待了多久
+    qint64 m_fileBytes = 0;                         ///< 当前文件字节数
+    QElapsedTimer m_fileTimer;                      ///< 当前文件打开了多久
+    QElapsedTimer m_syncTimer;                      ///< 距上次同步多久
+    bool m_dirty = false;                           ///< 上次同步之后有写入
+    bool m_writeFailed = false;                     ///< 写入失败（m_failed 的写入线程副本，无需加锁）
+    std::atomic<qint64> m_writtenBytes{0};          ///< 累计写入的字节数
+
+    // 以下只在 UI 线程中使用
+    QElapsedTimer m_statsTimer;                     ///< 距上次 stats() 多久
+    qint64 m_statsWrittenBytes = 0;                 ///< 上次 stats() 时的写入字节数
+};
+
+#endif // CAPTUREWRITER_H
@@ -0,0 +1,284 @@
+#include "channelparser.h"
+
+#include <cmath>
+#include <cstring>
+
+/**
+ * @brief ChannelParser 实现
+ */
+
+namespace {
+
+constexpr qsizetype MAX_LINE_BYTES = 4096;    ///< 超过此长度仍无换行的数据不是遥测行，直接丢弃
+
+// 10^0 ~ 10^22 都能被 double 精确表示
+constexpr double POW10[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+inline bool isDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+inline bool isSeparator(char c)
+{
+    return c == ',' || c == ';' || c == ' ' || c == '\t';
+}
+
+inline bool isSpace(char c)
+{
+    return c == ' ' || c == '\t';
+}
+
+} // namespace
+
+void ChannelParser::setMode(Mode mode)
+{
+    if (m_mode != mode) {
+        m_mode = mode;
+        reset();
+    }
+}
+
+ChannelParser::Mode ChannelParser::mode() const
+{
+    return m_mode;
+}
+
+bool ChannelParser::feed(QByteArrayView data, qint64 timestampNs, QVector<ChannelSample> &out)
+{
+    m_newChannel = false;
+    if (m_mode == Off || m_mode == Struct) {
+        return false;
+    }
+
+    m_lines.clear();
+    m_lineFramer.feed(data, timestampNs, m_lines);
+    for (const LineFramer::Segment &line : std::as_const(m_lines)) {
+        // 因过长被丢弃的行，其剩余部分不是完整的行
+        if (line.startsLine) {
+            parseLine(line.bytes.data(), line.bytes.data() + line.bytes.size(), line.timestampNs, out);
+        }
+    }
+
+    if (m_lineFramer.pendingSize() > MAX_LINE_BYTES) {
+        m_lines.clear();
+        m_lineFramer.flush(m_lines);
+    }
+    m_lines.clear();
+
+    return m_newChannel;
+}
+
+const QVector<QByteArray> &ChannelParser::channelNames() const
+{
+    return m_names;
+}
+
+void ChannelParser::reset()
+{
+    m_lineFramer.reset();
+    m_lines.clear();
+    m_names.clear();
+    m_columnChannels.clear();
+    m_newChannel = false;
+}
+
+const char *ChannelParser::parseNumber(const char *begin, const char *end, double *value)
+{
+    const char *p = begin;
+    bool negative = false;
+    if (p < end && (*p == '+' || *p == '-')) {
+        negative = *p == '-';
+        ++p;
+    }
+
+    // 最多保留 19 位有效数字，其余只影响指数
+    quint64 mantissa = 0;
+    int significant = 0;
+    int exponent = 0;
+    bool anyDigit = false;
+
+    while (p < end && isDigit(*p)) {
+        if (significant < 19) {
+            mantissa = mantissa * 10 + quint64(*p - '0');
+            if (mantissa) {
+                ++significant;
+            }
+        } else {
+            ++exponent;
+        }
+        anyDigit = true;
+        ++p;
+    }
+
+    if (p < end && *p == '.') {
+        ++p;
+        while (p < end && isDigit(*p)) {
+            if (significant < 19) {
+                mantissa = mantissa * 10 + quint64(*p - '0');
+                if (mantissa) {
+                    ++significant;
+                }
+                --exponent;
+            }
+            anyDigit = true;
+            ++p;
+        }
+    }
+
+    if (!anyDigit) {
+        return begin;
+    }
+
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        const char *q = p + 1;
+        bool negativeExponent = false;
+        if (q < end && (*q == '+' || *q == '-')) {
+            negativeExponent = *q == '-';
+            ++q;
+        }
+        if (q < end && isDigit(*q)) {
+            int e = 0;
+            while (q < end && isDigit(*q)) {
+                if (e < 10000) {
+                    e = e * 10 + (*q - '0');
+                }
+                ++q;
+            }
+            exponent += negativeExponent ? -e : e;
+            p = q;
+        }
+    }
+
+    double result = double(mantissa);
+    if (mantissa == 0) {
+        result = 0;
+    } else if (exponent >= 0 && exponent <= 22) {
+        result *= POW10[exponent];
+    } else if (exponent < 0 && exponent >= -22) {
+        result /= POW10[-exponent];
+    } else {
+        result *= std::pow(10.0, exponent);
+    }
+
+    *value = negative ? -result : result;
+    return p;
+}
+
+void ChannelParser::parseLine(const char *begin, const char *end, qint64 timestampNs,
+                              QVector<ChannelSample> &out)
+{
+    while (end > begin && (end[-1] == '\n' || end[-1] == '\r')) {
+        --end;
+    }
+    if (begin == end) {
+        return;
+    }
+
+    bool keyValue = m_mode == KeyValue;
+    if (m_mode == Auto) {
+        keyValue = std::memchr(begin, '=', size_t(end - begin)) || std::memchr(begin, ':', size_t(end - begin));
+    }
+
+    const char *p = begin;
+    double value = 0;
+
+    if (!keyValue) {
+        // CSV：每个字段一列，非数值字段也占列号
+        int column = 0;
+        while (p < end) {
+            while (p < end && isSeparator(*p)) {
+                ++p;
+            }
+            if (p == end) {
+                break;
+            }
+            const char *fieldEnd = p;
+            while (fieldEnd < end && !isSeparator(*fieldEnd)) {
+                ++fieldEnd;
+            }
+            if (parseNumber(p, fieldEnd, &value) == fieldEnd) {
+                const int channel = channelForColumn(column);
+                if (channel >= 0) {
+                    out.append({channel, timestampNs, float(value)});
+                }
+            }
+            ++column;
+            p = fieldEnd;
+        }
+        return;
+    }
+
+    // 键值：key=value 或 key: value，以 ',' ';' 空白分隔
+    while (p < end) {
+        while (p < end && isSeparator(*p)) {
+            ++p;
+        }
+        const char *keyBegin = p;
+        while (p < end && !isSeparator(*p) && *p != '=' && *p != ':') {
+            ++p;
+        }
+        const char *keyEnd = p;
+        const char *q = keyEnd;
+        while (q < end && isSpace(*q)) {
+            ++q;
+        }
+        if (q < end && (*q == '=' || *q == ':')) {
+            p = q + 1;
+            while (p < end && isSpace(*p)) {
+                ++p;
+            }
+            const char *numberEnd = parseNumber(p, end, &value);
+            if (numberEnd != p && keyEnd > keyBegin) {
+                const int channel = channelForKey(keyBegin, keyEnd - keyBegin);
+                if (channel >= 0) {
+                    out.append({channel, timestampNs, float(value)});
+                }
+            }
+            p = numberEnd;
+        }
+        while (p < end && !isSeparator(*p)) {
+            ++p;
+        }
+    }
+}
+
+int ChannelParser::channelForKey(const char *key, qsizetype size)
+{
+    for (qsizetype i = 0; i < m_names.size(); ++i) {
+        const QByteArray &name = m_names.at(i);
+        if (name.size() == size && std::memcmp(name.constData(), key, size_t(size)) == 0) {
+            return int(i);
+        }
+    }
+
+    if (m_names.size() >= MAX_CHANNELS) {
+        return -1;
+    }
+    m_names.append(QByteArray(key, size));
+    m_newChannel = true;
+    return int(m_names.size() - 1);
+}
+
+int ChannelParser::channelForColumn(int column)
+{
+    if (column >= MAX_CHANNELS) {
+        return -1;
+    }
+    if (column < m_columnChannels.size() && m_columnChannels.at(column) >= 0) {
+        return m_columnChannels.at(column);
+    }
+
+    const QByteArray name = "CH" + QByteArray::number(column + 1);
+    const int channel = channelForKey(name.constData(), name.size());
+    if (channel >= 0) {
+        if (m_columnChannels.size() <= column) {
+            m_columnChannels.resize(column + 1, -1);
+        }
+        m_columnChannels[column] = channel;
+    }
+    return channel;
+}
@@ -0,0 +1,125 @@
+#ifndef CHANNELPARSER_H
+#define CHANNELPARSER_H
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QVector>
+
+#include "lineframer.h"
+
+/**
+ * @brief ChannelSample - 一个通道采样
+ */
+struct ChannelSample {
+    int channel = 0;            ///< 通道下标（ChannelParser 分配，与 TimeSeriesStore 一致）
+    qint64 timestampNs = 0;     ///< 所在行第一个字节的到达时间（单调时钟纳秒）
+    float value = 0;            ///< 数值
+};
+
+/**
+ * @brief ChannelParser - 文本遥测的数值通道提取
+ *
+ * 在处理线程中把原始字节按行切分（LineFramer），再把每行解析为若干数值通道：
+ * - CSV：以 ',' ';' 空格或制表符分隔，第 n 列为通道 "CHn"
+ * - 键值：如 "t=123,v=3.31,i=0.52" 或 "v: 3.31"，键名即通道名
+ * - 自动：行中含 '=' 或 ':' 时按键值解析，否则按 CSV 解析
+ * 不含数值的行（普通日志）不产生采样。
+ *
+ * 解析为手写状态机，不分配内存：数值用整数尾数 + 十的幂表换算（不保证最后一位正确舍入，
+ * 对波形显示足够），键名按字节与已知通道逐个比较，只有出现新通道时才分配。
+ *
+ * 非线程安全，只在处理线程中使用。
+ */
+class ChannelParser
+{
+public:
+    /**
+     * @brief 行格式
+     */
+    enum Mode {
+        Off,        ///< 不提取
+        Auto,       ///< 按行自动判断 CSV 或键值
+        Csv,        ///< 按列
+        KeyValue,   ///< 按键名
+        Struct      ///< 通道来自帧的结构体布局（由 StructLayout 解码，本类不提取）
+    };
+
+    static constexpr int MAX_CHANNELS = 64;    ///< 最多通道数，之后出现的新通道被忽略
+
+    /**
+     * @brief 设置行格式
+     *
+     * 切换格式时清空通道表和未结束的行。
+     *
+     * @param mode 行格式
+     */
+    void setMode(Mode mode);
+
+    /**
+     * @brief 获取行格式
+     * @return 行格式
+     */
+    Mode mode() const;
+
+    /**
+     * @brief 喂入一块原始数据
+     *
+     * 完整的行被解析，采样追加到 out；最后不完整的行保留到下一块。
+     *
+     * @param data 原始字节
+     * @param timestampNs 这块数据的到达时间
+     * @param out 采样输出
+     * @return 本次是否出现了新通道（调用者需同步通道名）
+     */
+    bool feed(QByteArrayView data, qint64 timestampNs, QVector<ChannelSample> &out);
+
+    /**
+     * @brief 获取通道名
+     * @return 通道名，下标即通道下标
+     */
+    const QVector<QByteArray> &channelNames() const;
+
+    /**
+     * @brief 清空通道表和未结束的行
+     */
+    void reset();
+
+    /**
+     * @brief 解析一个数值
+     *
+     * 格式：[+-]digits[.digits][(e|E)[+-]digits]，也接受 ".5" 和 "5."。
+     *
+     * @param begin 起始位置
+     * @param end 结束位置
+     * @param value 输出数值
+     * @return 数值之后的位置；不是数值时返回 begin
+     */
+    static const char *parseNumber(const char *begin, const char *end, double *value);
+
+private:
+    /**
+     * @brief 解析一行
+     */
+    void parseLine(const char *begin, const char *end, qint64 timestampNs, QVector<ChannelSample> &out);
+
+    /**
+     * @brief 按键名查找或新建通道
+     * @return 通道下标，通道已满时返回 -1
+     */
+    int channelForKey(const char *key, qsizetype size);
+
+    /**
+     * @brief 按列号查找或新建通道
+     * @return 通道下标，通道已满时返回 -1
+     */
+    int channelForColumn(int column);
+
+    Mode m_mode = Off;                  ///< 行格式
+    LineFramer m_lineFramer;            ///< 行切分
+    QVector<LineFramer::Segment> m_lines;  ///< 行切分输出（复用）
+    QVector<QByteArray> m_names;        ///< 通道名
+    QVector<int> m_columnChannels;      ///< 列号 -> 通道下标（-1 表示尚未分配）
+    bool m_newChannel = false;          ///< 本次 feed 出现了新通道
+};
+
+#endif // CHANNELPARSER_H
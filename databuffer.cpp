@@ -1,73 +1,144 @@
 #include "databuffer.h"
 
+#include <QtMath>
+#include <cstring>
+
 /**
- * @brief DataBuffer - 线程安全的环形数据缓冲区实现
- * 
+ * @brief DataBuffer - 无锁单生产者/单消费者环形数据缓冲区实现
+ *
+ * 头尾索引为单调递增的 64 位逻辑位置，实际下标为 pos & m_mask。
+ * 生产者写满时不修改 m_tail，而是由消费者在读取时发现 head - tail 超过容量，
+ * 自行跳过被覆盖的部分；m_reserve 用于识别读取过程中被并发覆盖的字节。
+ *
  * Requirements: 2.1, 2.2, 2.3, 2.4
  */
 
 DataBuffer::DataBuffer(int capacity, QObject *parent)
     : QObject(parent)
-    , m_capacity(capacity > 0 ? capacity : 65536)
+    , m_capacity(static_cast<int>(qNextPowerOfTwo(static_cast<quint32>((capacity > 0 ? capacity : 65536) - 1))))
+    , m_mask(static_cast<quint64>(m_capacity) - 1)
 {
-    m_buffer.reserve(m_capacity);
+    m_storage.reset(new char[m_capacity]);
 }
 
 void DataBuffer::write(const QByteArray &data)
 {
-    if (data.isEmpty()) {
+    write(data.constData(), data.size());
+}
+
+void DataBuffer::write(const char *data, qsizetype size)
+{
+    if (!data || size <= 0) {
         return;
     }
 
-    QMutexLocker locker(&m_mutex);
+    quint64 start = m_head.load(std::memory_order_relaxed);
 
     // 如果新数据本身就超过容量，只保留最新的 capacity 字节
-    if (data.size() >= m_capacity) {
-        m_buffer = data.right(m_capacity);
-        return;
+    if (size > m_capacity) {
+        start += static_cast<quint64>(size - m_capacity);
+        data += size - m_capacity;
+        size = m_capacity;
     }
+    const quint64 end = start + static_cast<quint64>(size);
 
-    // 追加新数据
-    m_buffer.append(data);
-
-    // 如果超过容量，移除最旧的数据（保留最新数据）
+    // 先公布即将覆盖的区间，再写入数据，消费者据此丢弃被并发覆盖的字节
     // Requirements: 2.2 - 覆盖最旧数据，保留最新数据
-    if (m_buffer.size() > m_capacity) {
-        int excess = m_buffer.size() - m_capacity;
-        m_buffer.remove(0, excess);
+    m_reserve.store(end, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    const qsizetype offset = static_cast<qsizetype>(start & m_mask);
+    const qsizetype first = qMin<qsizetype>(size, m_capacity - offset);
+    std::memcpy(m_storage.get() + offset, data, static_cast<size_t>(first));
+    if (first < size) {
+        std::memcpy(m_storage.get(), data + first, static_cast<size_t>(size - first));
     }
+
+    m_head.store(end, std::memory_order_release);
 }
 
-QByteArray DataBuffer::readAll()
+void DataBuffer::copyOut(quint64 pos, char *dest, qsizetype size) const
 {
-    QMutexLocker locker(&m_mutex);
+    const qsizetype offset = static_cast<qsizetype>(pos & m_mask);
+    const qsizetype first = qMin<qsizetype>(size, m_capacity - offset);
+    std::memcpy(dest, m_storage.get() + offset, static_cast<size_t>(first));
+    if (first < size) {
+        std::memcpy(dest + first, m_storage.get(), static_cast<size_t>(size - first));
+    }
+}
+
+qsizetype DataBuffer::read(char *dest, qsizetype maxSize)
+{
+    if (!dest || maxSize <= 0) {
+        return 0;
+    }
+
+    const quint64 head = m_head.load(std::memory_order_acquire);
+    quint64 tail = m_tail.load(std::memory_order_relaxed);
+
+    // 生产者已经绕过一整圈，最旧的数据已被覆盖
+    if (head - tail > static_cast<quint64>(m_capacity)) {
+        const quint64 lost = head - tail - static_cast<quint64>(m_capacity);
+        m_overwritten.fetch_add(lost, std::memory_order_relaxed);
+        tail = head - static_cast<quint64>(m_capacity);
+    }
+
+    qsizetype count = static_cast<qsizetype>(qMin<quint64>(head - tail, static_cast<quint64>(maxSize)));
+    if (count == 0) {
+        return 0;
+    }
+    copyOut(tail, dest, count);
+
+    // 拷贝期间生产者可能又覆盖了开头的一部分，丢弃这部分字节
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const quint64 reserve = m_reserve.load(std::memory_order_relaxed);
+    if (reserve > static_cast<quint64>(m_capacity)) {
+        const quint64 validStart = reserve - static_cast<quint64>(m_capacity);
+        if (validStart > tail) {
+            const qsizetype lost = static_cast<qsizetype>(qMin<quint64>(validStart - tail, static_cast<quint64>(count)));
+            m_overwritten.fetch_add(static_cast<quint64>(lost), std::memory_order_relaxed);
+            std::memmove(dest, dest + lost, static_cast<size_t>(count - lost));
+            count -= lost;
+            tail += static_cast<quint64>(lost);
+        }
+    }
 
     // Requirements: 2.4 - FIFO 顺序返回数据
-    QByteArray result = m_buffer;
-    m_buffer.clear();
+    m_tail.store(tail + static_cast<quint64>(count), std::memory_order_release);
+    return count;
+}
+
+QByteArray DataBuffer::readAll()
+{
+    QByteArray result(size(), Qt::Uninitialized);
+    result.truncate(read(result.data(), result.size()));
     return result;
 }
 
 bool DataBuffer::isEmpty() const
 {
-    QMutexLocker locker(&m_mutex);
-    return m_buffer.isEmpty();
+    return size() == 0;
 }
 
 int DataBuffer::size() const
 {
-    QMutexLocker locker(&m_mutex);
-    return m_buffer.size();
+    const quint64 tail = m_tail.load(std::memory_order_acquire);
+    const quint64 head = m_head.load(std::memory_order_acquire);
+    return static_cast<int>(qMin<quint64>(head - tail, static_cast<quint64>(m_capacity)));
 }
 
 void DataBuffer::clear()
 {
-    QMutexLocker locker(&m_mutex);
-    m_buffer.clear();
+    m_tail.store(m_head.load(std::memory_order_acquire), std::memory_order_release);
 }
 
 int DataBuffer::capacity() const
 {
-    // capacity 在构造后不变，无需加锁
+    // capacity 在构造后不变
     return m_capacity;
 }
+
+quint64 DataBuffer::overwrittenBytes() const
+{
+    return m_overwritten.load(std::memory_order_relaxed);
+}
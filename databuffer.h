@@ -3,15 +3,19 @@
 
 #include <QObject>
 #include <QByteArray>
-#include <QMutex>
-#include <QMutexLocker>
+#include <atomic>
+#include <memory>
 
 /**
- * @brief DataBuffer - 线程安全的环形数据缓冲区
- * 
+ * @brief DataBuffer - 无锁单生产者/单消费者环形数据缓冲区
+ *
  * 用于在生产者（串口工作线程）和消费者（主UI线程）之间传递数据。
- * 使用 QMutex 保护并发访问，确保数据完整性。
- * 
+ * 容量固定为 2 的幂，头尾索引为单调递增的原子计数器，读写均不加锁。
+ * 写满后覆盖最旧数据（保留最新数据），语义与原 QMutex 版本一致。
+ *
+ * 线程约定：write() 只能由一个生产者线程调用；read()/readAll()/clear()
+ * 只能由一个消费者线程调用；size()/isEmpty()/capacity() 可在任意线程调用。
+ *
  * Requirements: 2.1, 2.2, 2.3, 2.4
  */
 class DataBuffer : public QObject
@@ -21,28 +25,45 @@ class DataBuffer : public QObject
 public:
     /**
      * @brief 构造函数
-     * @param capacity 缓冲区最大容量（字节），默认 65536
+     * @param capacity 缓冲区最大容量（字节），默认 65536，向上取整为 2 的幂
      * @param parent 父对象
      */
     explicit DataBuffer(int capacity = 65536, QObject *parent = nullptr);
 
     /**
-     * @brief 写入数据到缓冲区
-     * 
+     * @brief 写入数据到缓冲区（生产者）
+     *
      * 如果写入后超过容量，将覆盖最旧的数据（保留最新数据）。
-     * 线程安全。
-     * 
+     *
      * @param data 要写入的数据
      * Requirements: 2.1, 2.2, 2.3
      */
     void write(const QByteArray &data);
 
     /**
-     * @brief 读取并清空缓冲区中的所有数据
-     * 
+     * @brief 写入数据到缓冲区（生产者）
+     * @param data 数据起始地址
+     * @param size 数据长度
+     */
+    void write(const char *data, qsizetype size);
+
+    /**
+     * @brief 读取数据到调用者提供的内存（消费者）
+     *
+     * 按 FIFO 顺序最多读取 maxSize 字节，自动处理环绕。
+     * 读取过程中被生产者覆盖的部分会被丢弃并计入 overwrittenBytes()。
+     *
+     * @param dest 目标内存
+     * @param maxSize 目标内存大小
+     * @return 实际读取的字节数
+     */
+    qsizetype read(char *dest, qsizetype maxSize);
+
+    /**
+     * @brief 读取并清空缓冲区中的所有数据（消费者）
+     *
      * 返回数据按 FIFO 顺序排列。
-     * 线程安全。
-     * 
+     *
      * @return 缓冲区中的所有数据
      * Requirements: 2.3, 2.4
      */
@@ -50,26 +71,18 @@ public:
 
     /**
      * @brief 检查缓冲区是否为空
-     * 
-     * 线程安全。
-     * 
      * @return true 如果缓冲区为空
      */
     bool isEmpty() const;
 
     /**
      * @brief 获取缓冲区当前数据大小
-     * 
-     * 线程安全。
-     * 
      * @return 当前存储的字节数
      */
     int size() const;
 
     /**
-     * @brief 清空缓冲区
-     * 
-     * 线程安全。
+     * @brief 清空缓冲区（消费者）
      */
     void clear();
 
@@ -79,10 +92,26 @@ public:
      */
     int capacity() const;
 
+    /**
+     * @brief 获取因缓冲区写满而被覆盖丢弃的累计字节数
+     * @return 被覆盖的字节数
+     */
+    quint64 overwrittenBytes() const;
+
 private:
-    QByteArray m_buffer;      ///< 数据存储
-    int m_capacity;           ///< 最大容量
-    mutable QMutex m_mutex;   ///< 互斥锁，保护并发访问
+    /**
+     * @brief 从逻辑位置 pos 开始拷贝 size 字节到 dest（处理环绕）
+     */
+    void copyOut(quint64 pos, char *dest, qsizetype size) const;
+
+    std::unique_ptr<char[]> m_storage;  ///< 数据存储（容量为 2 的幂）
+    int m_capacity;                     ///< 最大容量
+    quint64 m_mask;                     ///< 索引掩码（m_capacity - 1）
+
+    alignas(64) std::atomic<quint64> m_head{0};     ///< 写入位置（仅生产者修改）
+    std::atomic<quint64> m_reserve{0};              ///< 正在写入的区间末尾（仅生产者修改）
+    alignas(64) std::atomic<quint64> m_tail{0};     ///< 读取位置（仅消费者修改）
+    std::atomic<quint64> m_overwritten{0};          ///< 被覆盖丢弃的字节数
 };
 
 #endif // DATABUFFER_H
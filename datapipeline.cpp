@@ -0,0 +1,298 @@
+#include "datapipeline.h"
+#include "keywordhighlighter.h"
+#include "iothreadpool.h"
+
+#include <QMutexLocker>
+
+/**
+ * @brief DataPipeline - 数据处理流水线实现
+ *
+ * Requirements: 3.1, 3.2, 3.3, 6.1, 6.2
+ */
+
+DataPipeline::DataPipeline(QObject *parent)
+    : QObject(parent)
+    , m_processor(new DataProcessor(this))
+    , m_buffer(new DataBuffer(65536, this))
+    , m_highlighter(new KeywordHighlighter(this))
+    , m_stage(m_highlighter)
+{
+    // 处理器与本对象处于同一线程，直接连接
+    connect(m_processor, &DataProcessor::dataProcessed, this, &DataPipeline::onDataProcessed);
+    connect(m_processor, &DataProcessor::samplesDecoded, this, &DataPipeline::onSamplesDecoded);
+
+    initThread();
+}
+
+DataPipeline::~DataPipeline()
+{
+    cleanupThread();
+}
+
+void DataPipeline::initThread()
+{
+    m_thread = IoThreadPool::instance(IoThreadPool::Processing)->acquire();
+
+    // 将 DataPipeline（及其子对象 DataProcessor）移动到处理线程
+    this->moveToThread(m_thread);
+
+    QMetaObject::invokeMethod(this, [this]() {
+        m_pipelineThreadId = QThread::currentThreadId();
+    });
+}
+
+void DataPipeline::cleanupThread()
+{
+    if (m_thread) {
+        // 处理线程可能被其他会话共享：先移回调用线程，之后才能安全析构
+        QThread *target = QThread::currentThread();
+        QMetaObject::invokeMethod(this, [this, target]() {
+            this->moveToThread(target);
+        }, Qt::BlockingQueuedConnection);
+
+        IoThreadPool::instance(IoThreadPool::Processing)->release(m_thread);
+        m_thread = nullptr;
+        m_pipelineThreadId = nullptr;
+    }
+}
+
+DisplayBatch DataPipeline::takeBatch(qsizetype maxChars)
+{
+    QMutexLocker locker(&m_mutex);
+    DisplayBatch batch = m_queue.take(maxChars);
+    batch.rawBytes = m_pendingRaw;
+    m_pendingRaw = 0;
+    return batch;
+}
+
+DisplayBatch DataPipeline::takeSummary(qsizetype keepChars, const std::function<QString(qint64)> &marker,
+                                       qint64 *skippedBytes)
+{
+    QMutexLocker locker(&m_mutex);
+    const double bytesPerChar = m_textTotal > 0 ? double(m_rawTotal) / double(m_textTotal) : 1.0;
+    qint64 skipped = 0;
+    DisplayBatch batch = m_queue.takeElided(keepChars, [&](qsizetype chars) {
+        skipped = qint64(chars * bytesPerChar);
+        return marker(skipped);
+    });
+    if (skippedBytes) {
+        *skippedBytes = skipped;
+    }
+
+    batch.rawBytes = m_pendingRaw;
+    m_pendingRaw = 0;
+    return batch;
+}
+
+qsizetype DataPipeline::pendingChars()
+{
+    QMutexLocker locker(&m_mutex);
+    return m_queue.pendingChars();
+}
+
+qint64 DataPipeline::processedBytes()
+{
+    QMutexLocker locker(&m_mutex);
+    return m_processedTotal;
+}
+
+void DataPipeline::setQueueBudget(qint64 budgetBytes)
+{
+    QMutexLocker locker(&m_mutex);
+    m_queue.setBudget(budgetBytes);
+}
+
+void DataPipeline::setSeriesBudget(qint64 memoryBytes, qint64 diskBytes)
+{
+    m_series.setBudget(memoryBytes, diskBytes);
+}
+
+void DataPipeline::setOverflowPolicy(AppSettings::OverflowPolicy policy)
+{
+    QMutexLocker locker(&m_mutex);
+    m_queue.setPolicy(policy);
+}
+
+QueueStats DataPipeline::queueStats()
+{
+    QMutexLocker locker(&m_mutex);
+    return m_queue.stats();
+}
+
+void DataPipeline::clear()
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        m_queue.clear();
+        m_pendingRaw = 0;
+        m_resetStage = true;
+    }
+    m_series.clear();
+
+    // 环形缓冲区只能由处理线程（写入方）清空；未结束的行属于清空之前
+    QMetaObject::invokeMethod(m_processor, [this]() {
+        m_buffer->clear();
+        m_processor->clearPendingLine();
+    });
+}
+
+void DataPipeline::appendText(const QString &text)
+{
+    QMetaObject::invokeMethod(this, [this, text]() {
+        onDataProcessed(text);
+    });
+}
+
+void DataPipeline::drain()
+{
+    QMetaObject::invokeMethod(this, [this]() {
+        emit drained();
+    }, Qt::QueuedConnection);
+}
+
+DataBuffer *DataPipeline::buffer() const
+{
+    return m_buffer;
+}
+
+TimeSeriesStore *DataPipeline::series()
+{
+    return &m_series;
+}
+
+Qt::HANDLE DataPipeline::pipelineThreadId() const
+{
+    return m_pipelineThreadId;
+}
+
+void DataPipeline::setFormat(DataProcessor::Format format)
+{
+    QMetaObject::invokeMethod(m_processor, [this, format]() {
+        m_processor->setFormat(format);
+    });
+}
+
+void DataPipeline::setTimestampEnabled(bool enabled)
+{
+    QMetaObject::invokeMethod(m_processor, [this, enabled]() {
+        m_processor->setTimestampEnabled(enabled);
+    });
+}
+
+void DataPipeline::setEncoding(AppSettings::Encoding encoding)
+{
+    QMetaObject::invokeMethod(m_processor, [this, encoding]() {
+        m_processor->setEncoding(encoding);
+    });
+}
+
+void DataPipeline::setHexNewlineEnabled(bool enabled)
+{
+    QMetaObject::invokeMethod(m_processor, [this, enabled]() {
+        m_processor->setHexNewlineEnabled(enabled);
+    });
+}
+
+void DataPipeline::setLineIdleTimeout(int milliseconds)
+{
+    QMetaObject::invokeMethod(m_processor, [this, milliseconds]() {
+        m_processor->setLineIdleTimeout(milliseconds);
+    });
+}
+
+void DataPipeline::setFrameConfig(const FrameConfig &config)
+{
+    QMetaObject::invokeMethod(m_processor, [this, config]() {
+        m_processor->setFrameConfig(config);
+    });
+}
+
+void DataPipeline::setChannelMode(ChannelParser::Mode mode)
+{
+    QMetaObject::invokeMethod(this, [this, mode]() {
+        if (m_channelParser.mode() != mode) {
+            m_channelParser.setMode(mode);
+            m_series.reset();
+            if (mode == ChannelParser::Struct) {
+                m_series.setChannelNames(m_structLayout.fieldNames());
+            }
+        }
+    });
+}
+
+void DataPipeline::setStructLayout(const StructLayout &layout)
+{
+    QMetaObject::invokeMethod(this, [this, layout]() {
+        if (m_structLayout == layout) {
+            return;
+        }
+        m_structLayout = layout;
+        m_processor->setStructLayout(layout);
+        if (m_channelParser.mode() == ChannelParser::Struct) {
+            m_series.reset();
+            m_series.setChannelNames(layout.fieldNames());
+        }
+    });
+}
+
+void DataPipeline::process(const RxChunk &data)
+{
+    // 此方法在处理线程中执行
+    if (data.isEmpty()) {
+        return;
+    }
+
+    m_buffer->write(data.data(), data.size());
+    {
+        QMutexLocker locker(&m_mutex);
+        m_pendingRaw += data.size();
+        m_rawTotal += data.size();
+    }
+
+    // 波形通道与显示格式无关，直接从原始字节提取
+    if (m_channelParser.mode() != ChannelParser::Off && m_channelParser.mode() != ChannelParser::Struct) {
+        const qint64 timestampNs = data.timestampNs() ? data.timestampNs() : TimestampFormatter::monotonicNs();
+        if (m_channelParser.feed(data.view(), timestampNs, m_samples)) {
+            m_series.setChannelNames(m_channelParser.channelNames());
+        }
+        m_series.append(m_samples);
+        m_samples.clear();
+    }
+
+    // 格式转换在处理线程完成，结果经 onDataProcessed（直接连接）进入待显示批次
+    m_processor->process(data.view(), data.timestampNs());
+
+    QMutexLocker locker(&m_mutex);
+    m_processedTotal += data.size();
+}
+
+void DataPipeline::onSamplesDecoded(const QVector<ChannelSample> &samples)
+{
+    // 此方法在处理线程中执行
+    if (m_channelParser.mode() == ChannelParser::Struct) {
+        m_series.append(samples);
+    }
+}
+
+void DataPipeline::onDataProcessed(const QString &text)
+{
+    // 此方法在处理线程中执行；分行和匹配不持有锁，避免阻塞 UI 线程取数据
+    {
+        QMutexLocker locker(&m_mutex);
+        if (m_resetStage) {
+            m_stage.reset();
+            m_resetStage = false;
+        }
+    }
+
+    DisplayBatch batch;
+    batch.newlines = m_stage.feed(text, batch.text, batch.spans);
+
+    QMutexLocker locker(&m_mutex);
+    if (m_resetStage) {
+        // 处理期间接收区被清空，这段数据属于清空之前
+        return;
+    }
+    m_textTotal += batch.text.size();
+    m_queue.push(std::move(batch));
+}
@@ -0,0 +1,244 @@
+#ifndef DATAPIPELINE_H
+#define DATAPIPELINE_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QString>
+#include <QThread>
+#include <QMutex>
+#include <functional>
+
+#include "appsettings.h"
+#include "channelparser.h"
+#include "databuffer.h"
+#include "dataprocessor.h"
+#include "displayqueue.h"
+#include "highlightstage.h"
+#include "rxchunk.h"
+#include "timeseriesstore.h"
+
+class KeywordHighlighter;
+
+/**
+ * @brief DataPipeline - 数据处理流水线
+ *
+ * 在独立线程中运行 DataProcessor，完成分帧、十六进制格式化、文本解码和时间戳，
+ * 再由 HighlightStage 分行并计算关键词高亮区间（无论高亮是否启用），
+ * 将结果作为 DisplayBatch 放入有上限的 DisplayQueue，供 UI 线程在刷新定时器中取走。
+ * 启用波形通道时，ChannelParser 同时从原始数据中提取数值，写入 TimeSeriesStore；
+ * 通道来源为结构体时，改为写入 DataProcessor 按 StructLayout 从每帧解码出的字段。
+ * 与 SerialWorker 相同，对象自身被移动到处理线程中；处理线程取自 IoThreadPool，
+ * 多个串口会话共享。
+ *
+ * Requirements: 3.1, 3.2, 3.3, 6.1, 6.2
+ */
+class DataPipeline : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief 构造函数
+     * @param parent 父对象（必须为 nullptr，对象会被移动到处理线程）
+     */
+    explicit DataPipeline(QObject *parent = nullptr);
+
+    /**
+     * @brief 析构函数
+     *
+     * 停止处理线程并释放资源。
+     */
+    ~DataPipeline();
+
+    /**
+     * @brief 取走不超过 maxChars 个字符的显示数据，其余留到下一帧
+     *
+     * 线程安全，由 UI 线程在每个刷新周期调用。
+     * 自上次调用以来的原始字节数全部计入本次结果。
+     *
+     * @param maxChars 最多取走的字符数
+     * @return 取走的数据
+     */
+    DisplayBatch takeBatch(qsizetype maxChars);
+
+    /**
+     * @brief 以摘要方式取走全部显示数据
+     *
+     * 只保留最新的约 keepChars 个字符，中间部分替换为“已跳过”标记行。线程安全。
+     *
+     * @param keepChars 保留的字符数
+     * @param marker 根据跳过的原始字节数（估算）生成标记行文本
+     * @param skippedBytes 输出：跳过的原始字节数（估算）
+     * @return 取走的数据
+     */
+    DisplayBatch takeSummary(qsizetype keepChars, const std::function<QString(qint64)> &marker,
+                             qint64 *skippedBytes);
+
+    /**
+     * @brief 获取待显示的字符数
+     *
+     * 线程安全。
+     *
+     * @return 字符数
+     */
+    qsizetype pendingChars();
+
+    /**
+     * @brief 获取处理线程累计处理完的原始字节数
+     *
+     * 在数据的显示文本进入显示队列之后才计入（分行、高亮都已完成）。
+     * 线程安全。ReplaySource 据此限制已发出但尚未处理的数据量。
+     *
+     * @return 字节数（clear() 不清零）
+     */
+    qint64 processedBytes();
+
+    /**
+     * @brief 设置显示队列的内存上限
+     *
+     * 线程安全。
+     *
+     * @param budgetBytes 内存上限（字节）
+     */
+    void setQueueBudget(qint64 budgetBytes);
+
+    /**
+     * @brief 设置显示队列的溢出策略
+     *
+     * 线程安全。
+     *
+     * @param policy 溢出策略
+     */
+    void setOverflowPolicy(AppSettings::OverflowPolicy policy);
+
+    /**
+     * @brief 设置波形数据的内存和磁盘预算
+     *
+     * 线程安全。
+     *
+     * @param memoryBytes 内存预算（字节）
+     * @param diskBytes 磁盘预算（字节），0 表示不溢出
+     */
+    void setSeriesBudget(qint64 memoryBytes, qint64 diskBytes);
+
+    /**
+     * @brief 获取显示队列统计
+     *
+     * 线程安全。
+     *
+     * @return 统计信息
+     */
+    QueueStats queueStats();
+
+    /**
+     * @brief 清空待显示数据和原始数据缓冲区
+     *
+     * 线程安全。
+     */
+    void clear();
+
+    /**
+     * @brief 追加一段本地文本（系统消息、发送回显）
+     *
+     * 线程安全。与接收数据经过相同的分行和高亮，保证两者在接收区中顺序一致。
+     *
+     * @param text 要显示的文本
+     */
+    void appendText(const QString &text);
+
+    /**
+     * @brief 请求在已排队的数据全部处理完后发出 drained 信号
+     *
+     * 用于串口关闭时把最后一批数据刷新到界面。
+     */
+    void drain();
+
+    /**
+     * @brief 获取原始数据缓冲区（处理线程为生产者）
+     * @return 原始数据环形缓冲区
+     */
+    DataBuffer *buffer() const;
+
+    /**
+     * @brief 获取波形通道数据（处理线程为生产者，线程安全）
+     * @return 时间序列存储
+     */
+    TimeSeriesStore *series();
+
+    /**
+     * @brief 获取处理线程ID（用于测试验证线程隔离）
+     * @return 处理线程ID，如果未运行则返回 nullptr
+     */
+    Qt::HANDLE pipelineThreadId() const;
+
+    // 以下设置函数线程安全，实际修改在处理线程中执行
+    void setFormat(DataProcessor::Format format);
+    void setTimestampEnabled(bool enabled);
+    void setEncoding(AppSettings::Encoding encoding);
+    void setHexNewlineEnabled(bool enabled);
+    void setLineIdleTimeout(int milliseconds);
+    void setFrameConfig(const FrameConfig &config);
+    void setChannelMode(ChannelParser::Mode mode);
+    void setStructLayout(const StructLayout &layout);
+
+public slots:
+    /**
+     * @brief 处理一块原始数据
+     *
+     * 在处理线程中执行，通常由 SerialWorker::dataReceived 排队调用。
+     * 直接读取接收块中的数据，不拷贝为 QByteArray。
+     *
+     * @param data 原始字节数据
+     */
+    void process(const RxChunk &data);
+
+signals:
+    /**
+     * @brief drain() 之前排队的数据已全部处理完成
+     */
+    void drained();
+
+private slots:
+    /**
+     * @brief 收集 DataProcessor 的输出到待显示批次
+     * @param text 处理后的文本
+     */
+    void onDataProcessed(const QString &text);
+
+    /**
+     * @brief 把结构体字段写入波形通道（通道来源为结构体时）
+     * @param samples 采样
+     */
+    void onSamplesDecoded(const QVector<ChannelSample> &samples);
+
+private:
+    /**
+     * @brief 从 IoThreadPool 取处理线程并移动过去
+     */
+    void initThread();
+
+    /**
+     * @brief 移回调用线程并把处理线程归还 IoThreadPool
+     */
+    void cleanupThread();
+
+    QThread *m_thread = nullptr;             ///< 处理线程（IoThreadPool 所有）
+    DataProcessor *m_processor = nullptr;    ///< 数据处理器（随本对象在处理线程中运行）
+    DataBuffer *m_buffer = nullptr;          ///< 原始数据环形缓冲区
+    KeywordHighlighter *m_highlighter = nullptr; ///< 处理线程使用的高亮规则
+    HighlightStage m_stage;                  ///< 分行与高亮（只在处理线程中使用）
+    ChannelParser m_channelParser;           ///< 波形通道提取（只在处理线程中使用）
+    QVector<ChannelSample> m_samples;        ///< 通道提取输出（复用）
+    StructLayout m_structLayout;             ///< 结构体布局（只在处理线程中使用）
+    TimeSeriesStore m_series;                ///< 波形通道数据（自身线程安全）
+    QMutex m_mutex;                          ///< 保护以下成员
+    DisplayQueue m_queue;                    ///< 待显示数据
+    qint64 m_pendingRaw = 0;                 ///< 尚未取走的原始字节数
+    bool m_resetStage = false;               ///< clear() 之后需要丢弃 m_stage 的当前行
+    qint64 m_rawTotal = 0;                   ///< 累计原始字节数（估算跳过的字节数）
+    qint64 m_processedTotal = 0;             ///< 累计处理完（显示文本已入队）的原始字节数
+    qint64 m_textTotal = 0;                  ///< 累计显示字符数
+    Qt::HANDLE m_pipelineThreadId = nullptr; ///< 处理线程ID
+};
+
+#endif // DATAPIPELINE_H
@@ -1,5 +1,9 @@
 #include "dataprocessor.h"
-#include <QStringDecoder>
+#include "hexencoder.h"
+#include "bytescan.h"
+#include "historystore.h"
+
+#include <QTimer>
 
 /**
  * @brief DataProcessor 实现
@@ -13,11 +17,25 @@ DataProcessor::DataProcessor(QObject *parent)
     , m_timestampEnabled(false)
     , m_encoding(AppSettings::ANSI)
     , m_hexNewlineEnabled(true)
+    , m_lineIdleTimer(new QTimer(this))
+    , m_frameIdleTimer(new QTimer(this))
 {
+    resetDecoder();
+
+    // 作为子对象随处理器移动到处理线程
+    m_lineIdleTimer->setSingleShot(true);
+    connect(m_lineIdleTimer, &QTimer::timeout, this, &DataProcessor::onLineIdleTimeout);
+    m_frameIdleTimer->setSingleShot(true);
+    m_frameIdleTimer->setTimerType(Qt::PreciseTimer);
+    connect(m_frameIdleTimer, &QTimer::timeout, this, &DataProcessor::onFrameIdleTimeout);
 }
 
 void DataProcessor::setFormat(Format format)
 {
+    if (m_format != format) {
+        flushPendingLine();
+        m_lineFramer.reset();
+    }
     m_format = format;
 }
 
@@ -28,6 +46,10 @@ DataProcessor::Format DataProcessor::format() const
 
 void DataProcessor::setTimestampEnabled(bool enabled)
 {
+    if (m_timestampEnabled != enabled) {
+        flushPendingLine();
+        m_lineFramer.reset();
+    }
     m_timestampEnabled = enabled;
 }
 
@@ -38,7 +60,12 @@ bool DataProcessor::isTimestampEnabled() const
 
 void DataProcessor::setEncoding(AppSettings::Encoding encoding)
 {
-    m_encoding = encoding;
+    if (m_encoding != encoding) {
+        // 未结束的行仍按原编码解码
+        flushPendingLine();
+        m_encoding = encoding;
+        resetDecoder();
+    }
 }
 
 AppSettings::Encoding DataProcessor::encoding() const
@@ -56,18 +83,64 @@ bool DataProcessor::isHexNewlineEnabled() const
     return m_hexNewlineEnabled;
 }
 
-void DataProcessor::process(const QByteArray &data)
+void DataProcessor::setLineIdleTimeout(int milliseconds)
+{
+    m_lineIdleTimeoutMs = qMax(0, milliseconds);
+    if (m_lineIdleTimeoutMs == 0) {
+        flushPendingLine();
+    }
+}
+
+void DataProcessor::setFrameConfig(const FrameConfig &config)
+{
+    flushPendingLine();
+    m_lineFramer.reset();
+    m_frameIdleTimer->stop();
+    m_frameBatch.clear();
+    m_frameDecoder = FrameDecoder::create(config);
+}
+
+void DataProcessor::setStructLayout(const StructLayout &layout)
+{
+    m_structLayout = layout;
+    m_fieldValues.resize(layout.fieldCount());
+    m_structSamples.clear();
+}
+
+void DataProcessor::clearPendingLine()
+{
+    m_lineIdleTimer->stop();
+    m_lineFramer.reset();
+    m_frameIdleTimer->stop();
+    if (m_frameDecoder) {
+        m_frameDecoder->reset();
+    }
+}
+
+void DataProcessor::process(QByteArrayView data, qint64 timestampNs)
 {
     if (data.isEmpty()) {
         return;
     }
 
+    if (m_frameDecoder) {
+        processFrames(data, timestampNs);
+        return;
+    }
+
+    // 文本模式下时间戳按行标注
+    // Requirements: 3.2
+    if (m_timestampEnabled && m_format == ASCII) {
+        processLines(data, timestampNs);
+        return;
+    }
+
     QString result;
 
     // 添加时间戳（如果启用）
     // Requirements: 3.2
     if (m_timestampEnabled) {
-        result = formatTimestamp() + " >>";
+        result = formatTimestamp(timestampNs) + " >>";
     }
 
     // 根据格式转换数据
@@ -86,87 +159,204 @@ void DataProcessor::process(const QByteArray &data)
     emit dataProcessed(result);
 }
 
-QString DataProcessor::toHexString(const QByteArray &data) const
+void DataProcessor::processLines(QByteArrayView data, qint64 timestampNs)
+{
+    if (!timestampNs) {
+        timestampNs = TimestampFormatter::monotonicNs();
+    }
+
+    m_segments.clear();
+    const bool hadPending = m_lineFramer.hasPending();
+    m_lineFramer.feed(data, timestampNs, m_segments);
+
+    // 一直没有换行的数据（只用 '\r' 的设备、二进制噪声）：达到接收区的折行长度时先行显示，
+    // 保留的行尾不会无限增长
+    if (m_lineFramer.pendingSize() >= HistoryStore::MAX_LINE_BYTES) {
+        m_lineFramer.flush(m_segments);
+    }
+
+    if (!m_lineFramer.hasPending()) {
+        m_lineIdleTimer->stop();
+    } else if (m_lineIdleTimeoutMs == 0) {
+        m_lineFramer.flush(m_segments);
+    } else {
+        // 本块结束了之前的行（或之前没有保留）：保留的是新的行尾，从现在开始计时。
+        // 定时器不随每块数据重启，超时时再按保留时长判断
+        if (!hadPending || !m_segments.isEmpty()) {
+            m_pendingSinceNs = TimestampFormatter::monotonicNs();
+        }
+        if (!m_lineIdleTimer->isActive()) {
+            m_lineIdleTimer->start(m_lineIdleTimeoutMs);
+        }
+    }
+
+    emitSegments();
+}
+
+void DataProcessor::emitSegments()
 {
-    // 转换为大写十六进制，每字节用空格分隔
-    // 当 m_hexNewlineEnabled 为 true 时，换行符(0x0A)和回车符(0x0D)单独显示并在前后添加换行
-    // 当 m_hexNewlineEnabled 为 false 时，0x0A 和 0x0D 作为普通十六进制值显示
-    // Requirements: 2.2, 2.3
     QString result;
-    result.reserve(data.size() * 4);  // 预分配空间
-
-    for (int i = 0; i < data.size(); ++i) {
-        quint8 byte = static_cast<quint8>(data.at(i));
-        
-        // 处理换行符序列 (0x0D 0x0A 或单独的 0x0A 或 0x0D)
-        // Requirements: 2.2 - 当启用时插入换行
-        // Requirements: 2.3 - 当禁用时显示为普通十六进制值
-        if (m_hexNewlineEnabled && (byte == 0x0A || byte == 0x0D)) {
-            if (!result.isEmpty() && !result.endsWith('\n')) {
-                result += '\n';
-            }
-            
-            // 收集连续的换行符
-            QString controlSequence = "[" + QString("%1").arg(byte, 2, 16, QChar('0')).toUpper();
-            
-            // 查看后续字节是否也是换行符
-            while (i + 1 < data.size()) {
-                quint8 nextByte = static_cast<quint8>(data.at(i + 1));
-                if (nextByte == 0x0A || nextByte == 0x0D) {
-                    controlSequence += " " + QString("%1").arg(nextByte, 2, 16, QChar('0')).toUpper();
-                    i++;  // 移动到下一个字节
-                } else {
-                    break;
+    for (const LineFramer::Segment &segment : std::as_const(m_segments)) {
+        if (segment.startsLine) {
+            result += formatTimestamp(segment.timestampNs);
+            result += QLatin1StringView(" >>");
+        }
+        result += toAsciiString(segment.bytes);
+    }
+    m_segments.clear();
+
+    if (!result.isEmpty()) {
+        emit dataProcessed(result);
+    }
+}
+
+void DataProcessor::flushPendingLine()
+{
+    m_lineIdleTimer->stop();
+    if (!m_lineFramer.hasPending()) {
+        return;
+    }
+
+    m_segments.clear();
+    m_lineFramer.flush(m_segments);
+    emitSegments();
+}
+
+void DataProcessor::onLineIdleTimeout()
+{
+    if (!m_lineFramer.hasPending()) {
+        return;
+    }
+
+    // 按最早保留的字节计时：数据持续到达但一直没有换行时也按时显示
+    const qint64 heldMs = (TimestampFormatter::monotonicNs() - m_pendingSinceNs) / 1000000;
+    if (heldMs < m_lineIdleTimeoutMs) {
+        m_lineIdleTimer->start(int(qMax<qint64>(1, m_lineIdleTimeoutMs - heldMs)));
+        return;
+    }
+
+    flushPendingLine();
+}
+
+void DataProcessor::processFrames(QByteArrayView data, qint64 timestampNs)
+{
+    if (!timestampNs) {
+        timestampNs = TimestampFormatter::monotonicNs();
+    }
+
+    m_frameDecoder->feed(data, timestampNs, m_frameBatch);
+
+    // 空闲分帧：最后一帧要等到一段时间没有新数据才能结束
+    const qint64 gapNs = m_frameDecoder->idleGapNs();
+    if (gapNs > 0 && m_frameDecoder->hasPartialFrame() && !m_frameIdleTimer->isActive()) {
+        m_frameIdleTimer->start(int(qMax<qint64>(1, gapNs / 1000000)));
+    }
+
+    emitFrames();
+}
+
+void DataProcessor::emitFrames()
+{
+    if (m_frameBatch.frames.isEmpty()) {
+        return;
+    }
+
+    QString result;
+    for (qsizetype i = 0; i < m_frameBatch.frames.size(); ++i) {
+        const FrameBatch::Frame &frame = m_frameBatch.frames.at(i);
+        const QByteArrayView bytes = m_frameBatch.bytes(i);
+
+        // 结构体字段：格式错误或被截断的帧内容不可信，不解码
+        if (!m_structLayout.isEmpty() && frame.flags == 0
+            && m_structLayout.decode(bytes.constData(), bytes.size(), m_fieldValues.data())) {
+            for (int field = 0; field < m_fieldValues.size(); ++field) {
+                ChannelSample sample;
+                sample.channel = field;
+                sample.timestampNs = frame.timestampNs;
+                sample.value = float(m_fieldValues.at(field));
+                // NaN/无穷大（含 double 转 float 溢出）无法绘制，丢弃该采样
+                if (!qIsFinite(sample.value)) {
+                    continue;
                 }
+                m_structSamples.append(sample);
             }
-            
-            controlSequence += "]\n";
-            result += controlSequence;
-        } else {
-            // 普通字节处理（或禁用换行时的 0x0A/0x0D）
-            if (!result.isEmpty() && !result.endsWith(' ') && !result.endsWith('\n')) {
-                result += ' ';
-            }
-            result += QString("%1").arg(byte, 2, 16, QChar('0')).toUpper();
         }
+
+        if (m_timestampEnabled) {
+            result += formatTimestamp(frame.timestampNs);
+            result += QLatin1StringView(" >>");
+        }
+        result += m_format == Hexadecimal ? HexEncoder::encode(bytes, false) : frameToText(bytes);
+        if (frame.flags & FrameBatch::Malformed) {
+            result += QStringLiteral(" [格式错误]");
+        }
+        if (frame.flags & FrameBatch::Truncated) {
+            result += QStringLiteral(" [已截断]");
+        }
+        result += QLatin1Char('\n');
+    }
+    m_frameBatch.clear();
+
+    if (!m_structSamples.isEmpty()) {
+        emit samplesDecoded(m_structSamples);
+        m_structSamples.clear();
+    }
+    emit dataProcessed(result);
+}
+
+void DataProcessor::onFrameIdleTimeout()
+{
+    if (!m_frameDecoder || !m_frameDecoder->hasPartialFrame()) {
+        return;
+    }
+
+    m_frameDecoder->checkIdle(TimestampFormatter::monotonicNs(), m_frameBatch);
+    if (m_frameDecoder->hasPartialFrame()) {
+        // 期间又收到了数据，继续等待
+        m_frameIdleTimer->start(int(qMax<qint64>(1, m_frameDecoder->idleGapNs() / 1000000)));
     }
 
-    // 确保结果末尾没有多余的空格
-    if (result.endsWith(' ')) {
-        result.chop(1);
+    emitFrames();
+}
+
+QString DataProcessor::frameToText(QByteArrayView data)
+{
+    QString text;
+    if (m_format == ASCII && m_frameDecoderText.isValid()
+        && !ByteScan::isAscii(data.constData(), data.size())) {
+        text = m_frameDecoderText(data);
+    } else {
+        text = QString::fromLatin1(data);
     }
 
-    return result;
+    // 每帧一行：帧内的换行符显示为控制符号
+    text.replace(QLatin1Char('\r'), QChar(0x240D));
+    text.replace(QLatin1Char('\n'), QChar(0x240A));
+    return text;
 }
 
-QString DataProcessor::toAsciiString(const QByteArray &data) const
+QString DataProcessor::toHexString(QByteArrayView data) const
+{
+    // 转换为大写十六进制，每字节用空格分隔
+    // 当 m_hexNewlineEnabled 为 true 时，换行符(0x0A)和回车符(0x0D)单独显示并在前后添加换行
+    // 当 m_hexNewlineEnabled 为 false 时，0x0A 和 0x0D 作为普通十六进制值显示
+    // 由 HexEncoder 直接写入预分配的 UTF-16 缓冲区（SIMD/查表）
+    // Requirements: 2.2, 2.3
+    return HexEncoder::encode(data, m_hexNewlineEnabled);
+}
+
+QString DataProcessor::toAsciiString(QByteArrayView data)
 {
     // 根据当前编码设置转换字节数据
     // Requirements: 1.2
     switch (m_encoding) {
-    case AppSettings::UTF8: {
-        // 使用 UTF-8 编码转换 (Qt 6 QStringDecoder)
-        auto decoder = QStringDecoder(QStringDecoder::Utf8);
-        if (decoder.isValid()) {
-            QString result = decoder(data);
-            return result;
-        }
-        break;
-    }
-    case AppSettings::GBK: {
-        // 使用 GBK 编码转换 (Qt 6 QStringDecoder)
-        auto decoder = QStringDecoder("GBK");
-        if (decoder.isValid()) {
-            QString result = decoder(data);
-            return result;
-        }
-        // GBK 可能不可用，回退到 System 编码
-        auto sysDecoder = QStringDecoder(QStringDecoder::System);
-        if (sysDecoder.isValid()) {
-            return sysDecoder(data);
+    case AppSettings::UTF8:
+    case AppSettings::GBK:
+        // 使用持久的流式解码器 (Qt 6 QStringDecoder)
+        if (m_decoder.isValid()) {
+            return decodeStream(data);
         }
         break;
-    }
     case AppSettings::ANSI:
     default:
         // 使用 Latin1 编码转换（ANSI/Windows 本地编码）
@@ -177,9 +367,59 @@ QString DataProcessor::toAsciiString(const QByteArray &data) const
     return QString::fromLatin1(data);
 }
 
-QString DataProcessor::formatTimestamp() const
+QString DataProcessor::decodeStream(QByteArrayView data)
+{
+    // ASCII 在 UTF-8 和 GBK 中编码相同，纯 ASCII 块无需经过解码器
+    if (ByteScan::isAscii(data.constData(), data.size())) {
+        if (m_decoderPending == 0) {
+            return QString::fromLatin1(data);
+        }
+
+        // 上一块可能以不完整的多字节序列结尾：之后累计 3 个 ASCII 字节即可让
+        // 解码器完成或判定该序列（GB18030 四字节序列最长需要 3 个后续字节），
+        // 不足 3 字节的块不能解除，例如前导字节之后的 "3" 仍是四字节序列的前缀
+        const qsizetype head = qMin<qsizetype>(data.size(), m_decoderPending);
+        QString result = m_decoder(QByteArrayView(data.constData(), head));
+        result += QLatin1StringView(data.constData() + head, data.size() - head);
+        m_decoderPending -= int(head);
+        return result;
+    }
+
+    // 含多字节字符，交给解码器；末尾不完整的序列保留在解码器中等待下一块
+    m_decoderPending = 3;
+    return m_decoder(data);
+}
+
+void DataProcessor::resetDecoder()
+{
+    m_decoderPending = 0;
+
+    switch (m_encoding) {
+    case AppSettings::UTF8:
+        m_decoder = QStringDecoder(QStringDecoder::Utf8);
+        m_frameDecoderText = QStringDecoder(QStringDecoder::Utf8, QStringDecoder::Flag::Stateless);
+        break;
+    case AppSettings::GBK:
+        m_decoder = QStringDecoder("GBK");
+        m_frameDecoderText = QStringDecoder("GBK", QStringDecoder::Flag::Stateless);
+        if (!m_decoder.isValid()) {
+            // GBK 可能不可用，回退到 System 编码
+            m_decoder = QStringDecoder(QStringDecoder::System);
+            m_frameDecoderText = QStringDecoder(QStringDecoder::System, QStringDecoder::Flag::Stateless);
+        }
+        break;
+    case AppSettings::ANSI:
+    default:
+        // Latin1 无状态，不需要解码器
+        m_decoder = QStringDecoder();
+        m_frameDecoderText = QStringDecoder();
+        break;
+    }
+}
+
+QString DataProcessor::formatTimestamp(qint64 timestampNs)
 {
-    // 格式：HH:mm:ss.zzz
+    // 格式：HH:mm:ss.zzz，时间为 SerialWorker 读到数据的时刻
     // Requirements: 3.2
-    return QDateTime::currentDateTime().toString("HH:mm:ss.zzz");
+    return m_timestampFormatter.format(timestampNs ? timestampNs : TimestampFormatter::monotonicNs());
 }
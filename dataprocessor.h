@@ -2,16 +2,29 @@
 #define DATAPROCESSOR_H
 
 #include <QObject>
-#include <QByteArray>
+#include <QByteArrayView>
 #include <QString>
-#include <QDateTime>
+#include <QStringDecoder>
+#include <QVector>
+#include <memory>
 #include "appsettings.h"
+#include "channelparser.h"
+#include "framedecoder.h"
+#include "lineframer.h"
+#include "structlayout.h"
+#include "timestampformatter.h"
+
+class QTimer;
 
 /**
  * @brief DataProcessor - 数据处理器
  * 
  * 负责将原始字节数据转换为可显示格式（ASCII 或 Hexadecimal）。
- * 支持时间戳格式化功能。
+ * 支持时间戳格式化功能：ASCII 模式下由 LineFramer 按行分帧，每行标注其第一个
+ * 字节的到达时间；未结束的行在空闲超时后先行显示，剩余部分作为续行追加。
+ * 十六进制模式仍按接收块标注时间。
+ * 设置了帧格式时，数据先经 FrameDecoder 分帧，每帧显示为一行（按当前格式显示帧内容）；
+ * 同时设置了结构体布局时，每个完整的帧还按 StructLayout 解码为数值通道（字段下标即通道下标）。
  * 
  * Requirements: 3.1, 3.2, 3.3
  */
@@ -57,6 +70,9 @@ public:
 
     /**
      * @brief 设置文本编码方式
+     *
+     * 仅在编码实际改变时重建流式解码器，丢弃其中未完成的多字节序列。
+     *
      * @param encoding 编码方式（ANSI, UTF8, GBK）
      * Requirements: 1.2
      */
@@ -87,6 +103,39 @@ public:
      */
     bool isTimestampEnabled() const;
 
+    /**
+     * @brief 设置未结束行的空闲超时
+     *
+     * 时间戳模式下，行尾之后超过该时间没有新数据时，先显示已收到的部分。
+     *
+     * @param milliseconds 超时（毫秒），0 表示不等待，每块数据立即显示
+     * Requirements: 3.2
+     */
+    void setLineIdleTimeout(int milliseconds);
+
+    /**
+     * @brief 设置帧格式
+     *
+     * 切换时丢弃未完成的帧；type 为 None 或配置无效时恢复按字节流显示。
+     *
+     * @param config 帧解析配置
+     */
+    void setFrameConfig(const FrameConfig &config);
+
+    /**
+     * @brief 设置帧内结构体布局
+     *
+     * 为空时不解码；只对设置了帧格式后的完整帧生效。
+     *
+     * @param layout 已编译的布局
+     */
+    void setStructLayout(const StructLayout &layout);
+
+    /**
+     * @brief 丢弃未结束的行和未完成的帧（接收区清空时调用）
+     */
+    void clearPendingLine();
+
 public slots:
     /**
      * @brief 处理原始数据
@@ -96,9 +145,10 @@ public slots:
      * 处理完成后发出 dataProcessed 信号。
      * 
      * @param data 原始字节数据
+     * @param timestampNs 数据到达时间（单调时钟纳秒），0 表示使用当前时间
      * Requirements: 3.1, 3.2, 3.3
      */
-    void process(const QByteArray &data);
+    void process(QByteArrayView data, qint64 timestampNs = 0);
 
 signals:
     /**
@@ -111,6 +161,15 @@ signals:
      */
     void dataProcessed(const QString &text);
 
+    /**
+     * @brief 帧按结构体布局解码完成信号
+     *
+     * 每批帧发出一次，通道下标即字段下标，时间为帧第一个字节的到达时间。
+     *
+     * @param samples 解码得到的采样
+     */
+    void samplesDecoded(const QVector<ChannelSample> &samples);
+
 private:
     /**
      * @brief 将字节数组转换为十六进制字符串
@@ -122,33 +181,112 @@ private:
      * @return 十六进制字符串
      * Requirements: 3.1
      */
-    QString toHexString(const QByteArray &data) const;
+    QString toHexString(QByteArrayView data) const;
 
     /**
      * @brief 将字节数组转换为 ASCII 字符串
      * 
      * 保留可打印字符，不可打印字符保持原样（由 QString::fromLatin1 处理）。
+     * UTF-8/GBK 使用持久的流式解码器，跨两次读取被截断的多字节字符能正确拼接。
      * 
      * @param data 原始字节数据
      * @return ASCII 字符串
      * Requirements: 3.1
      */
-    QString toAsciiString(const QByteArray &data) const;
+    QString toAsciiString(QByteArrayView data);
+
+    /**
+     * @brief 使用流式解码器解码一块数据
+     *
+     * 纯 ASCII 块（SIMD 检查最高位）绕过解码器直接展宽；
+     * 若上一块交给了解码器，先把开头几个字节送入解码器以结束可能未完成的序列。
+     *
+     * @param data 原始字节数据
+     * @return 解码后的字符串
+     */
+    QString decodeStream(QByteArrayView data);
+
+    /**
+     * @brief 按当前编码重建流式解码器
+     */
+    void resetDecoder();
 
     /**
-     * @brief 格式化当前时间戳
+     * @brief 格式化时间戳
      * 
      * 格式：HH:mm:ss.zzz
      * 
+     * @param timestampNs 单调时钟纳秒，0 表示当前时间
      * @return 格式化的时间戳字符串
      * Requirements: 3.2
      */
-    QString formatTimestamp() const;
+    QString formatTimestamp(qint64 timestampNs);
+
+    /**
+     * @brief 按行分帧并标注时间戳（ASCII 且启用时间戳时使用）
+     * @param data 原始字节数据
+     * @param timestampNs 数据到达时间（单调时钟纳秒）
+     */
+    void processLines(QByteArrayView data, qint64 timestampNs);
+
+    /**
+     * @brief 把 m_segments 转换为显示文本并发出 dataProcessed
+     */
+    void emitSegments();
+
+    /**
+     * @brief 立即显示未结束的行（离开分行模式或切换编码之前调用）
+     */
+    void flushPendingLine();
+
+    /**
+     * @brief 超时：未结束的行已保留超过超时时间则先行显示（数据仍在到达时也是如此）
+     */
+    void onLineIdleTimeout();
+
+    /**
+     * @brief 分帧并显示完整的帧（设置了帧格式时使用）
+     * @param data 原始字节数据
+     * @param timestampNs 数据到达时间（单调时钟纳秒）
+     */
+    void processFrames(QByteArrayView data, qint64 timestampNs);
+
+    /**
+     * @brief 把 m_frameBatch 转换为每帧一行的显示文本并发出 dataProcessed
+     */
+    void emitFrames();
+
+    /**
+     * @brief 空闲分帧的定时检查
+     */
+    void onFrameIdleTimeout();
+
+    /**
+     * @brief 把一帧解码为单行文本（不跨帧保留解码状态，换行符显示为符号）
+     * @param data 帧字节
+     * @return 文本
+     */
+    QString frameToText(QByteArrayView data);
 
     Format m_format = ASCII;           ///< 当前显示格式
     bool m_timestampEnabled = false;   ///< 时间戳启用状态
     AppSettings::Encoding m_encoding = AppSettings::ANSI;  ///< 文本编码方式
     bool m_hexNewlineEnabled = true;   ///< 十六进制换行启用状态 (Requirements: 2.2, 2.3)
+    QStringDecoder m_decoder;          ///< 流式解码器（UTF-8/GBK），跨块保留未完成的多字节序列
+    QStringDecoder m_frameDecoderText; ///< 无状态解码器，用于逐帧解码
+    int m_decoderPending = 0;          ///< 解码器中可能残留未完成序列时，之后还需经过解码器的 ASCII 字节数
+    TimestampFormatter m_timestampFormatter;  ///< 到达时间的格式化（缓存时分秒）
+    LineFramer m_lineFramer;           ///< 增量分行（保留跨块的不完整行尾）
+    QVector<LineFramer::Segment> m_segments;  ///< 分行输出（复用以避免分配）
+    QTimer *m_lineIdleTimer = nullptr; ///< 未结束行的空闲超时（单次）
+    int m_lineIdleTimeoutMs = 100;     ///< 空闲超时（毫秒）
+    qint64 m_pendingSinceNs = 0;       ///< 当前未结束行开始保留的时间（处理线程的单调时钟）
+    std::unique_ptr<FrameDecoder> m_frameDecoder;  ///< 帧解码器，为空表示不分帧
+    FrameBatch m_frameBatch;           ///< 分帧输出（复用以避免分配）
+    QTimer *m_frameIdleTimer = nullptr;  ///< 空闲分帧的定时检查（单次）
+    StructLayout m_structLayout;       ///< 帧内结构体布局，为空表示不解码
+    QVector<double> m_fieldValues;     ///< 一帧的字段值（复用）
+    QVector<ChannelSample> m_structSamples;  ///< 结构体解码输出（复用）
 };
 
 #endif // DATAPROCESSOR_H
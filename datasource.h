@@ -0,0 +1,70 @@
+#ifndef DATASOURCE_H
+#define DATASOURCE_H
+
+#include <QObject>
+#include <QString>
+
+#include "rxchunk.h"
+
+/**
+ * @brief DataSource - 会话的原始数据来源
+ *
+ * PortSession 从数据来源接收原始数据：SerialWorker（串口）或 ReplaySource（回放捕获文件）。
+ * 两者发出相同的信号，下游（DataPipeline → 高亮 → 显示）不区分数据来自哪里。
+ * 信号可以从来源自己的线程发出，接收方按排队连接处理。
+ */
+class DataSource : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief 构造函数
+     * @param parent 父对象
+     */
+    explicit DataSource(QObject *parent = nullptr) : QObject(parent) {}
+
+    /**
+     * @brief 检查是否正在产生数据
+     * @return true 如果已启动且尚未停止
+     */
+    virtual bool isRunning() const = 0;
+
+public slots:
+    /**
+     * @brief 停止，完成后发出 stopped
+     */
+    virtual void stop() = 0;
+
+signals:
+    /**
+     * @brief 已成功启动
+     */
+    void started();
+
+    /**
+     * @brief 已停止
+     */
+    void stopped();
+
+    /**
+     * @brief 收到数据
+     *
+     * 数据位于池化的接收块中，接收方持有引用而不是拷贝；
+     * 引用携带数据到达时的单调时钟时间戳。
+     * Requirements: 1.2
+     *
+     * @param data 原始数据
+     */
+    void dataReceived(const RxChunk &data);
+
+    /**
+     * @brief 发生错误（配置无效、打开失败、读取错误等）
+     * Requirements: 1.4
+     *
+     * @param error 错误描述
+     */
+    void errorOccurred(const QString &error);
+};
+
+#endif // DATASOURCE_H
@@ -0,0 +1,523 @@
+#include "displayqueue.h"
+
+#include <QDataStream>
+#include <QTemporaryFile>
+
+/**
+ * @brief DisplayBatch / DisplayQueue 实现
+ */
+
+void DisplayBatch::append(const DisplayBatch &next)
+{
+    rawBytes += next.rawBytes;
+    if (next.text.isEmpty()) {
+        return;
+    }
+
+    if (text.isEmpty()) {
+        replacesOpenLine = next.replacesOpenLine;
+    }
+    if (next.replacesOpenLine) {
+        while (!spans.isEmpty() && spans.last().line == newlines) {
+            spans.removeLast();
+        }
+    }
+    spans.reserve(spans.size() + next.spans.size());
+    for (HighlightSpan span : next.spans) {
+        span.line += newlines;
+        spans.append(span);
+    }
+    text.append(next.text);
+    newlines += next.newlines;
+}
+
+DisplayBatch DisplayBatch::takeFront(qsizetype maxChars)
+{
+    if (text.size() <= maxChars) {
+        DisplayBatch all = std::move(*this);
+        *this = DisplayBatch();
+        return all;
+    }
+
+    // 尽量在行尾切分；一行都放不下时在字符边界切分
+    qsizetype cut = maxChars > 0 ? text.lastIndexOf(QLatin1Char('\n'), maxChars - 1) + 1 : 0;
+    if (cut <= 0) {
+        cut = qMax<qsizetype>(1, maxChars);
+        if (cut < text.size() && text.at(cut).isLowSurrogate()) {
+            --cut;
+        }
+    }
+
+    DisplayBatch head;
+    head.text = text.left(cut);
+    head.replacesOpenLine = replacesOpenLine;
+    head.newlines = static_cast<qint32>(QStringView(head.text).count(QLatin1Char('\n')));
+    head.rawBytes = rawBytes;
+
+    // 最后一行在切分点之后的区间留给剩余部分
+    const qint32 lastLine = head.newlines;
+    const qsizetype lastLineLength = cut - (head.text.lastIndexOf(QLatin1Char('\n')) + 1);
+    QVector<HighlightSpan> rest;
+    for (const HighlightSpan &span : std::as_const(spans)) {
+        if (span.line < lastLine
+            || (span.line == lastLine && span.start + span.length <= lastLineLength)) {
+            head.spans.append(span);
+        }
+        if (span.line >= lastLine) {
+            HighlightSpan shifted = span;
+            shifted.line -= lastLine;
+            rest.append(shifted);
+        }
+    }
+
+    text.remove(0, cut);
+    spans = std::move(rest);
+    newlines -= lastLine;
+    rawBytes = 0;
+    if (lastLine > 0) {
+        replacesOpenLine = true;
+    }
+    return head;
+}
+
+qsizetype DisplayBatch::elide(qsizetype keepChars, const std::function<QString(qsizetype)> &marker)
+{
+    // 第 0 行之后、末尾保留部分之前的整行被省略
+    const qsizetype firstBreak = text.indexOf(QLatin1Char('\n'));
+    if (firstBreak < 0) {
+        return 0;
+    }
+    const qsizetype tailFrom = qMax(firstBreak + 1, text.size() - keepChars);
+    const qsizetype tailStart = (tailFrom == firstBreak + 1)
+        ? tailFrom
+        : text.lastIndexOf(QLatin1Char('\n'), tailFrom - 1) + 1;
+    const qsizetype skipped = tailStart - (firstBreak + 1);
+    if (skipped <= 0) {
+        return 0;
+    }
+
+    const qint32 tailLine = static_cast<qint32>(
+        QStringView(text).left(tailStart).count(QLatin1Char('\n')));
+
+    // 新的行：0 = 原第 0 行，1 = 标记行，2.. = 原 tailLine..
+    QVector<HighlightSpan> kept;
+    for (const HighlightSpan &span : std::as_const(spans)) {
+        if (span.line == 0) {
+            kept.append(span);
+        } else if (span.line >= tailLine) {
+            HighlightSpan shifted = span;
+            shifted.line = span.line - tailLine + 2;
+            kept.append(shifted);
+        }
+    }
+
+    QString result;
+    result.reserve(firstBreak + 1 + 64 + text.size() - tailStart);
+    result.append(QStringView(text).left(firstBreak + 1));
+    result.append(marker(skipped));
+    result.append(QLatin1Char('\n'));
+    result.append(QStringView(text).mid(tailStart));
+
+    text = std::move(result);
+    spans = std::move(kept);
+    newlines = newlines - tailLine + 2;
+    return skipped;
+}
+
+bool DisplayBatch::restartAfterGap(const QString &marker)
+{
+    const qsizetype firstBreak = text.indexOf(QLatin1Char('\n'));
+    if (firstBreak < 0) {
+        return false;
+    }
+
+    // 新的行：0 = 结束接收区当前行，1 = 标记行，2.. = 原 1..
+    QVector<HighlightSpan> kept;
+    kept.reserve(spans.size());
+    for (const HighlightSpan &span : std::as_const(spans)) {
+        if (span.line > 0) {
+            HighlightSpan shifted = span;
+            shifted.line += 1;
+            kept.append(shifted);
+        }
+    }
+
+    QString result;
+    result.reserve(text.size() - firstBreak + marker.size() + 2);
+    result.append(QLatin1Char('\n'));
+    result.append(marker);
+    result.append(QLatin1Char('\n'));
+    result.append(QStringView(text).mid(firstBreak + 1));
+
+    text = std::move(result);
+    spans = std::move(kept);
+    newlines += 1;
+    replacesOpenLine = false;
+    return true;
+}
+
+
+namespace {
+
+// 一批数据在内存中占用的字节数
+inline qint64 footprint(const DisplayBatch &batch)
+{
+    return qint64(batch.text.size()) * qint64(sizeof(QChar))
+         + qint64(batch.spans.size()) * qint64(sizeof(HighlightSpan));
+}
+
+QByteArray serialize(const DisplayBatch &batch)
+{
+    QByteArray data;
+    QDataStream out(&data, QIODevice::WriteOnly);
+    out << batch.text << batch.newlines << batch.replacesOpenLine
+        << static_cast<quint32>(batch.spans.size());
+    out.writeRawData(reinterpret_cast<const char *>(batch.spans.constData()),
+                     static_cast<int>(batch.spans.size() * sizeof(HighlightSpan)));
+    return data;
+}
+
+DisplayBatch deserialize(const QByteArray &data)
+{
+    DisplayBatch batch;
+    QDataStream in(data);
+    quint32 spanCount = 0;
+    in >> batch.text >> batch.newlines >> batch.replacesOpenLine >> spanCount;
+    batch.spans.resize(spanCount);
+    in.readRawData(reinterpret_cast<char *>(batch.spans.data()),
+                   static_cast<int>(spanCount * sizeof(HighlightSpan)));
+    return batch;
+}
+
+} // namespace
+
+DisplayQueue::DisplayQueue(qint64 budgetBytes, AppSettings::OverflowPolicy policy)
+    : m_budget(qMax<qint64>(1, budgetBytes))
+    , m_policy(policy)
+{
+}
+
+DisplayQueue::~DisplayQueue() = default;
+
+void DisplayQueue::setBudget(qint64 budgetBytes)
+{
+    m_budget = qMax<qint64>(1, budgetBytes);
+    if (m_policy == AppSettings::DropOldest) {
+        dropOldest();
+    }
+}
+
+void DisplayQueue::setPolicy(AppSettings::OverflowPolicy policy)
+{
+    m_policy = policy;
+}
+
+void DisplayQueue::push(DisplayBatch &&batch)
+{
+    if (batch.text.isEmpty()) {
+        return;
+    }
+
+    // 之前有数据被丢弃：从下一个完整行开始，插入标记
+    if (m_gap) {
+        if (!batch.restartAfterGap(gapMarker())) {
+            drop(batch);
+            return;
+        }
+        m_gap = false;
+    }
+
+    // 已经开始溢出到文件时，后续数据也写入文件，保持顺序
+    if (!m_spilled.empty()) {
+        if (!spill(batch)) {
+            drop(batch);
+        }
+        return;
+    }
+
+    if (m_queuedBytes + footprint(batch) > m_budget) {
+        switch (m_policy) {
+        case AppSettings::DropNewest:
+            drop(batch);
+            return;
+        case AppSettings::SpillToDisk:
+            if (!spill(batch)) {
+                drop(batch);
+            }
+            return;
+        case AppSettings::DropOldest:
+            enqueue(std::move(batch));
+            dropOldest();
+            return;
+        }
+    }
+
+    enqueue(std::move(batch));
+}
+
+DisplayBatch DisplayQueue::take(qsizetype maxChars)
+{
+    DisplayBatch result;
+    refill();
+    while (!m_segments.empty() && result.text.size() < maxChars) {
+        DisplayBatch &front = m_segments.front();
+        const qsizetype room = maxChars - result.text.size();
+        if (front.text.size() <= room) {
+            result.append(popFront());
+            refill();
+            continue;
+        }
+
+        const qint64 before = footprint(front);
+        const qsizetype charsBefore = front.text.size();
+        result.append(front.takeFront(room));
+        m_queuedBytes -= before - footprint(front);
+        m_queuedChars -= charsBefore - front.text.size();
+        break;
+    }
+    return result;
+}
+
+DisplayBatch DisplayQueue::takeElided(qsizetype keepChars, const std::function<QString(qsizetype)> &marker)
+{
+    DisplayBatch result;
+    while (!m_segments.empty()) {
+        result.append(popFront());
+    }
+
+    // 溢出文件中较新的数据只读回末尾需要保留的部分，其余直接计为省略
+    qsizetype middleChars = 0;
+    if (!m_spilled.empty()) {
+        auto tail = m_spilled.end();
+        qsizetype tailChars = 0;
+        while (tail != m_spilled.begin() && tailChars < keepChars) {
+            --tail;
+            tailChars += tail->chars;
+        }
+        // 第一批总是读回，保证结果的第 0 行与接收区当前行相连
+        auto it = m_spilled.begin();
+        if (result.text.isEmpty()) {
+            result.append(unspill(*it));
+            ++it;
+        }
+        for (; it != m_spilled.end(); ++it) {
+            if (it < tail) {
+                middleChars += it->chars;
+            } else {
+                result.append(unspill(*it));
+            }
+        }
+        resetSpill();
+    }
+
+    result.elide(keepChars, [&](qsizetype chars) {
+        return marker(chars + middleChars);
+    });
+    return result;
+}
+
+qsizetype DisplayQueue::pendingChars() const
+{
+    return m_queuedChars + m_spilledChars;
+}
+
+void DisplayQueue::clear()
+{
+    m_segments.clear();
+    m_queuedBytes = 0;
+    m_queuedChars = 0;
+    resetSpill();
+    m_spilledTotal = 0;
+    m_droppedBytes = 0;
+    m_peakBytes = 0;
+    m_gap = false;
+}
+
+QueueStats DisplayQueue::stats() const
+{
+    QueueStats stats;
+    stats.queuedBytes = m_queuedBytes;
+    stats.spilledBytes = m_spilledBytes;
+    stats.spilledTotal = m_spilledTotal;
+    stats.droppedBytes = m_droppedBytes;
+    stats.peakBytes = m_peakBytes;
+    return stats;
+}
+
+void DisplayQueue::enqueue(DisplayBatch &&batch)
+{
+    m_queuedBytes += footprint(batch);
+    m_queuedChars += batch.text.size();
+
+    if (!m_segments.empty() && footprint(m_segments.back()) < MERGE_BYTES) {
+        m_segments.back().append(batch);
+    } else {
+        m_segments.push_back(std::move(batch));
+    }
+    m_peakBytes = qMax(m_peakBytes, m_queuedBytes);
+}
+
+DisplayBatch DisplayQueue::popFront()
+{
+    DisplayBatch batch = std::move(m_segments.front());
+    m_segments.pop_front();
+    m_queuedBytes -= footprint(batch);
+    m_queuedChars -= batch.text.size();
+    return batch;
+}
+
+void DisplayQueue::dropOldest()
+{
+    bool dropped = false;
+    while (m_queuedBytes > m_budget && !m_segments.empty()) {
+        drop(popFront());
+        dropped = true;
+    }
+    if (!dropped) {
+        return;
+    }
+
+    // 新的队首接在被丢弃的数据后面
+    while (!m_segments.empty()) {
+        DisplayBatch &front = m_segments.front();
+        const qint64 before = footprint(front);
+        const qsizetype charsBefore = front.text.size();
+        if (front.restartAfterGap(gapMarker())) {
+            m_queuedBytes += footprint(front) - before;
+            m_queuedChars += front.text.size() - charsBefore;
+            m_gap = false;
+            return;
+        }
+        drop(popFront());
+    }
+    m_gap = true;
+}
+
+void DisplayQueue::drop(const DisplayBatch &batch)
+{
+    m_droppedBytes += footprint(batch);
+    m_gap = true;
+}
+
+bool DisplayQueue::spill(const DisplayBatch &batch)
+{
+    // 持续过载时队首一直在读、队尾一直在写，单个文件永远读不空：
+    // 当前文件写满一半上限且另一个文件已读空时，改为从头重写另一个文件
+    const int other = 1 - m_spillWrite;
+    const bool otherDrained = m_spilled.empty() || m_spilled.front().file == m_spillWrite;
+    if (m_spillEnd[m_spillWrite] >= MAX_SPILL_BYTES / 2 && otherDrained) {
+        truncateSpillFile(other);
+        m_spillWrite = other;
+    }
+
+    const QByteArray data = serialize(batch);
+    if (m_spillEnd[0] + m_spillEnd[1] + data.size() > MAX_SPILL_BYTES) {
+        return false;
+    }
+
+    std::unique_ptr<QTemporaryFile> &file = m_spillFiles[m_spillWrite];
+    if (!file) {
+        file = std::make_unique<QTemporaryFile>();
+        if (!file->open()) {
+            file.reset();
+            return false;
+        }
+    }
+
+    const qint64 offset = m_spillEnd[m_spillWrite];
+    if (!file->seek(offset) || file->write(data) != data.size()) {
+        return false;
+    }
+
+    m_spilled.push_back(SpillEntry{m_spillWrite, offset, data.size(), batch.text.size()});
+    m_spillEnd[m_spillWrite] = offset + data.size();
+    m_spilledBytes += data.size();
+    m_spilledTotal += data.size();
+    m_spilledChars += batch.text.size();
+    return true;
+}
+
+DisplayBatch DisplayQueue::unspill(const SpillEntry &entry)
+{
+    QTemporaryFile *file = m_spillFiles[entry.file].get();
+    QByteArray data;
+    if (file && file->seek(entry.offset)) {
+        data = file->read(entry.size);
+    }
+    if (data.size() != entry.size) {
+        // 读取失败的数据计为丢弃，之后读回的数据从下一个完整行继续
+        m_droppedBytes += qint64(entry.chars) * qint64(sizeof(QChar));
+        m_spillGap = true;
+        return DisplayBatch();
+    }
+
+    DisplayBatch batch = deserialize(data);
+    if (m_spillGap) {
+        if (!batch.restartAfterGap(gapMarker())) {
+            m_droppedBytes += footprint(batch);
+            return DisplayBatch();
+        }
+        m_spillGap = false;
+    }
+    return batch;
+}
+
+void DisplayQueue::releaseSpilled(const SpillEntry &entry)
+{
+    m_spilledBytes -= entry.size;
+    m_spilledChars -= entry.chars;
+
+    // 该文件中已没有未读回的数据：截断，释放磁盘空间
+    if ((m_spilled.empty() || m_spilled.front().file != entry.file) && entry.file != m_spillWrite) {
+        truncateSpillFile(entry.file);
+    }
+}
+
+void DisplayQueue::refill()
+{
+    // 内存中的数据取完后，从溢出文件按顺序读回，最多读到上限的一半
+    if (!m_segments.empty() || m_spilled.empty()) {
+        return;
+    }
+    while (!m_spilled.empty() && m_queuedBytes < m_budget / 2) {
+        const SpillEntry entry = m_spilled.front();
+        m_spilled.pop_front();
+        DisplayBatch batch = unspill(entry);
+        releaseSpilled(entry);
+        if (!batch.text.isEmpty()) {
+            enqueue(std::move(batch));
+        }
+    }
+    if (m_spilled.empty()) {
+        resetSpill();
+    }
+}
+
+void DisplayQueue::resetSpill()
+{
+    m_spilled.clear();
+    m_spilledBytes = 0;
+    m_spilledChars = 0;
+    truncateSpillFile(0);
+    truncateSpillFile(1);
+    m_spillWrite = 0;
+
+    // 溢出文件末尾的数据读取失败：之后的新数据同样从下一个完整行开始
+    if (m_spillGap) {
+        m_gap = true;
+        m_spillGap = false;
+    }
+}
+
+void DisplayQueue::truncateSpillFile(int file)
+{
+    m_spillEnd[file] = 0;
+    if (m_spillFiles[file]) {
+        m_spillFiles[file]->resize(0);
+    }
+}
+
+QString DisplayQueue::gapMarker() const
+{
+    return QString("SYSINFO >> 显示积压超过上限，累计丢弃 %1 字节显示数据").arg(m_droppedBytes);
+}
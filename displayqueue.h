@@ -0,0 +1,210 @@
+#ifndef DISPLAYQUEUE_H
+#define DISPLAYQUEUE_H
+
+#include <QString>
+#include <QVector>
+#include <deque>
+#include <functional>
+#include <memory>
+
+#include "appsettings.h"
+#include "historystore.h"
+
+class QTemporaryFile;
+
+/**
+ * @brief DisplayBatch - 一批可直接显示的数据
+ *
+ * 由处理线程生成，UI 线程每个刷新周期取走一次，只需插入和布局。
+ * 高亮区间已在处理线程中算好，行号相对于追加前接收区的最后一行。
+ */
+struct DisplayBatch {
+    QString text;                   ///< 已格式化的显示文本（HistoryStore 行格式）
+    QVector<HighlightSpan> spans;   ///< 文本涉及各行的完整高亮区间
+    qint32 newlines = 0;            ///< text 中的换行数
+    bool replacesOpenLine = true;   ///< spans 是否给出第 0 行的完整区间（为 false 时保留接收区当前行的区间）
+    qint64 rawBytes = 0;            ///< 对应的原始字节数（用于速度统计）
+
+    bool isEmpty() const { return text.isEmpty() && rawBytes == 0; }
+
+    /**
+     * @brief 把后续一批合并到末尾
+     *
+     * next 的第 0 行就是本批的最后一行，该行的区间以 next 给出的为准。
+     *
+     * @param next 后续的一批
+     */
+    void append(const DisplayBatch &next);
+
+    /**
+     * @brief 取出开头不超过 maxChars 个字符，剩余部分留在本批
+     *
+     * 尽量在行尾切分；原始字节数全部计入取出的部分。
+     *
+     * @param maxChars 最多取出的字符数
+     * @return 取出的部分
+     */
+    DisplayBatch takeFront(qsizetype maxChars);
+
+    /**
+     * @brief 省略中间部分
+     *
+     * 保留第 0 行（与接收区当前行相连）和末尾约 keepChars 个字符的完整行，
+     * 中间替换为一行 marker(被省略的字符数)。
+     *
+     * @param keepChars 末尾保留的字符数
+     * @param marker 生成标记行文本（不含换行符）
+     * @return 被省略的字符数
+     */
+    qsizetype elide(qsizetype keepChars, const std::function<QString(qsizetype)> &marker);
+
+    /**
+     * @brief 前面的数据被丢弃后，从下一个完整行重新开始
+     *
+     * 丢弃第 0 行（它接在被丢弃的数据后面），在前面插入一行 marker，
+     * 接收区当前行的区间保持不变。
+     *
+     * @param marker 标记行文本（不含换行符）
+     * @return false 如果本批没有完整行（整批都应丢弃）
+     */
+    bool restartAfterGap(const QString &marker);
+};
+
+/**
+ * @brief QueueStats - 显示队列统计
+ *
+ * 字节数按内存占用计算（UTF-16 文本 + 高亮区间）。
+ */
+struct QueueStats {
+    qint64 queuedBytes = 0;    ///< 内存中排队的字节数
+    qint64 spilledBytes = 0;   ///< 溢出到临时文件的字节数
+    qint64 spilledTotal = 0;   ///< 累计溢出到临时文件的字节数
+    qint64 droppedBytes = 0;   ///< 累计丢弃的字节数
+    qint64 peakBytes = 0;      ///< 内存占用峰值
+};
+
+/**
+ * @brief DisplayQueue - 有上限的待显示数据队列
+ *
+ * 处理线程生成的 DisplayBatch 在这里排队等待 UI 线程取走。内存占用超过上限时
+ * （例如 UI 线程被模态对话框阻塞）按溢出策略处理：
+ * - DropOldest：丢弃最旧的数据
+ * - DropNewest：丢弃新到达的数据
+ * - SpillToDisk：后续数据写入临时文件，内存中的数据取完后再按顺序读回；
+ *   两个临时文件轮流写入，读空的文件被截断后重新使用，
+ *   两个文件合计超过 MAX_SPILL_BYTES 时丢弃新数据
+ * 丢弃数据后从下一个完整行继续，并插入一行“已丢弃”标记。
+ *
+ * 非线程安全，由 DataPipeline 加锁使用。
+ */
+class DisplayQueue
+{
+public:
+    static constexpr qint64 MAX_SPILL_BYTES = qint64(1) << 30;   ///< 临时文件合计上限（磁盘占用）
+    static constexpr qint64 MERGE_BYTES = 64 * 1024;            ///< 小于该大小的相邻批次合并存放
+
+    /**
+     * @brief 构造函数
+     * @param budgetBytes 内存上限（字节）
+     * @param policy 溢出策略
+     */
+    explicit DisplayQueue(qint64 budgetBytes = qint64(64) << 20,
+                          AppSettings::OverflowPolicy policy = AppSettings::DropOldest);
+
+    /**
+     * @brief 析构函数（删除临时文件）
+     */
+    ~DisplayQueue();
+
+    /**
+     * @brief 设置内存上限
+     * @param budgetBytes 内存上限（字节）
+     */
+    void setBudget(qint64 budgetBytes);
+
+    /**
+     * @brief 设置溢出策略
+     * @param policy 溢出策略
+     */
+    void setPolicy(AppSettings::OverflowPolicy policy);
+
+    /**
+     * @brief 入队一批数据
+     * @param batch 处理线程生成的数据
+     */
+    void push(DisplayBatch &&batch);
+
+    /**
+     * @brief 取出不超过 maxChars 个字符
+     * @param maxChars 最多取出的字符数
+     * @return 取出的数据
+     */
+    DisplayBatch take(qsizetype maxChars);
+
+    /**
+     * @brief 取出全部数据，只保留最新的约 keepChars 个字符
+     * @param keepChars 保留的字符数
+     * @param marker 根据被省略的字符数生成标记行文本
+     * @return 取出的数据
+     */
+    DisplayBatch takeElided(qsizetype keepChars, const std::function<QString(qsizetype)> &marker);
+
+    /**
+     * @brief 获取待显示的字符数（含临时文件中的数据）
+     * @return 字符数
+     */
+    qsizetype pendingChars() const;
+
+    /**
+     * @brief 清空队列、临时文件和统计
+     */
+    void clear();
+
+    /**
+     * @brief 获取统计信息
+     * @return 统计信息
+     */
+    QueueStats stats() const;
+
+private:
+    /**
+     * @brief 溢出文件中的一批数据
+     */
+    struct SpillEntry {
+        int file;           ///< 所在的临时文件（0 或 1）
+        qint64 offset;      ///< 文件偏移
+        qint64 size;        ///< 序列化后的字节数
+        qsizetype chars;    ///< 文本字符数
+    };
+
+    void enqueue(DisplayBatch &&batch);
+    DisplayBatch popFront();
+    void dropOldest();
+    void drop(const DisplayBatch &batch);
+    bool spill(const DisplayBatch &batch);
+    DisplayBatch unspill(const SpillEntry &entry);
+    void releaseSpilled(const SpillEntry &entry);
+    void refill();
+    void resetSpill();
+    void truncateSpillFile(int file);
+    QString gapMarker() const;
+
+    std::deque<DisplayBatch> m_segments;             ///< 内存中的数据（按时间顺序）
+    qint64 m_queuedBytes = 0;                        ///< 内存中的字节数
+    qsizetype m_queuedChars = 0;                     ///< 内存中的字符数
+    std::unique_ptr<QTemporaryFile> m_spillFiles[2]; ///< 轮流写入的溢出文件
+    qint64 m_spillEnd[2] = {0, 0};                   ///< 各溢出文件已写到的位置（即磁盘占用）
+    int m_spillWrite = 0;                            ///< 当前写入的溢出文件
+    std::deque<SpillEntry> m_spilled;                ///< 溢出文件中的数据（按时间顺序）
+    qint64 m_spilledBytes = 0;                       ///< 溢出文件中未读回的字节数
+    qsizetype m_spilledChars = 0;                    ///< 溢出文件中的字符数
+    qint64 m_budget;                                 ///< 内存上限
+    AppSettings::OverflowPolicy m_policy;            ///< 溢出策略
+    qint64 m_spilledTotal = 0;                       ///< 累计溢出的字节数
+    qint64 m_droppedBytes = 0;                       ///< 累计丢弃的字节数
+    qint64 m_peakBytes = 0;                          ///< 内存占用峰值
+    bool m_gap = false;                              ///< 新数据之前有被丢弃的数据
+    bool m_spillGap = false;                         ///< 读回溢出文件时有数据读取失败
+};
+
+#endif // DISPLAYQUEUE_H
@@ -0,0 +1,99 @@
+#include "fieldtable.h"
+
+#include <QHeaderView>
+#include <QTimer>
+
+/**
+ * @brief FieldTable 实现
+ */
+
+namespace {
+
+enum Column {
+    NameColumn,
+    TypeColumn,
+    OffsetColumn,
+    ValueColumn,
+    ColumnCount
+};
+
+} // namespace
+
+FieldTable::FieldTable(QWidget *parent)
+    : QTableWidget(parent)
+    , m_refreshTimer(new QTimer(this))
+{
+    setColumnCount(ColumnCount);
+    setHorizontalHeaderLabels({"字段", "类型", "偏移", "值"});
+    setEditTriggers(QAbstractItemView::NoEditTriggers);
+    setSelectionBehavior(QAbstractItemView::SelectRows);
+    verticalHeader()->setVisible(false);
+    verticalHeader()->setDefaultSectionSize(fontMetrics().height() + 6);
+    horizontalHeader()->setStretchLastSection(true);
+
+    m_refreshTimer->setInterval(REFRESH_INTERVAL_MS);
+    connect(m_refreshTimer, &QTimer::timeout, this, &FieldTable::onRefreshTimeout);
+}
+
+void FieldTable::setStructLayout(const StructLayout &layout)
+{
+    m_layout = layout;
+    setRowCount(layout.fieldCount());
+    for (int field = 0; field < layout.fieldCount(); ++field) {
+        setItem(field, NameColumn, new QTableWidgetItem(QString::fromUtf8(layout.fieldName(field))));
+        setItem(field, TypeColumn, new QTableWidgetItem(layout.fieldTypeName(field)));
+        QTableWidgetItem *offsetItem = new QTableWidgetItem(QString::number(layout.fieldOffset(field)));
+        offsetItem->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+        setItem(field, OffsetColumn, offsetItem);
+        QTableWidgetItem *valueItem = new QTableWidgetItem();
+        valueItem->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+        setItem(field, ValueColumn, valueItem);
+    }
+    resizeColumnsToContents();
+    updateValues();
+}
+
+void FieldTable::setStore(TimeSeriesStore *store)
+{
+    if (m_store != store) {
+        m_store = store;
+        updateValues();
+    }
+}
+
+TimeSeriesStore *FieldTable::store() const
+{
+    return m_store;
+}
+
+void FieldTable::showEvent(QShowEvent *event)
+{
+    QTableWidget::showEvent(event);
+    updateValues();
+    m_refreshTimer->start();
+}
+
+void FieldTable::hideEvent(QHideEvent *event)
+{
+    QTableWidget::hideEvent(event);
+    m_refreshTimer->stop();
+}
+
+void FieldTable::onRefreshTimeout()
+{
+    if (m_store && m_store->revision() != m_lastRevision) {
+        updateValues();
+    }
+}
+
+void FieldTable::updateValues()
+{
+    m_lastRevision = m_store ? m_store->revision() : 0;
+    for (int field = 0; field < rowCount(); ++field) {
+        // 存储的通道与布局不一致（切换布局后尚未收到新帧）时不显示旧值
+        float value = 0;
+        const bool valid = m_store && m_store->channelName(field) == QString::fromUtf8(m_layout.fieldName(field))
+                           && m_store->lastSample(field, nullptr, &value);
+        item(field, ValueColumn)->setText(valid ? QString::number(double(value), 'g', 7) : QString());
+    }
+}
@@ -0,0 +1,71 @@
+#ifndef FIELDTABLE_H
+#define FIELDTABLE_H
+
+#include <QTableWidget>
+
+#include "structlayout.h"
+#include "timeseriesstore.h"
+
+class QTimer;
+
+/**
+ * @brief FieldTable - 结构体字段表
+ *
+ * 按 StructLayout 列出每个字段的名称、类型、偏移，并显示 TimeSeriesStore 中
+ * 对应通道（字段下标即通道下标）的最新值。与 WavePlot 一样只在数据有变化时刷新，
+ * 隐藏时停止刷新。
+ */
+class FieldTable : public QTableWidget
+{
+    Q_OBJECT
+
+public:
+    static constexpr int REFRESH_INTERVAL_MS = 100;    ///< 刷新间隔
+
+    /**
+     * @brief 构造函数
+     * @param parent 父控件
+     */
+    explicit FieldTable(QWidget *parent = nullptr);
+
+    /**
+     * @brief 设置结构体布局，重建所有行
+     * @param layout 已编译的布局
+     */
+    void setStructLayout(const StructLayout &layout);
+
+    /**
+     * @brief 设置数据源
+     * @param store 时间序列存储，可为 nullptr（值列为空）
+     */
+    void setStore(TimeSeriesStore *store);
+
+    /**
+     * @brief 获取数据源
+     * @return 时间序列存储
+     */
+    TimeSeriesStore *store() const;
+
+protected:
+    void showEvent(QShowEvent *event) override;
+    void hideEvent(QHideEvent *event) override;
+
+private slots:
+    /**
+     * @brief 刷新定时器：数据有变化时更新值列
+     */
+    void onRefreshTimeout();
+
+private:
+    /**
+     * @brief 从数据源读取每个字段的最新值
+     */
+    void updateValues();
+
+    TimeSeriesStore *m_store = nullptr;   ///< 数据源
+    QTimer *m_refreshTimer = nullptr;     ///< 刷新定时器
+    quint64 m_lastRevision = 0;           ///< 上次刷新时的数据修改计数
+    StructLayout m_layout;                ///< 当前布局
+};
+
+#endif // FIELDTABLE_H
@@ -0,0 +1,110 @@
+#ifndef FRAMECONFIG_H
+#define FRAMECONFIG_H
+
+#include <QByteArray>
+#include <QString>
+
+/**
+ * @brief FrameConfig - 帧解析配置数据结构
+ *
+ * 选择帧解码器及其参数，提供配置验证功能。Type 为 None 时按原始字节流显示。
+ */
+struct FrameConfig {
+    /**
+     * @brief 帧格式
+     */
+    enum Type {
+        None,            ///< 不分帧，按原始字节流显示
+        Delimiter,       ///< 以分隔符结尾（如 0D 0A）
+        FixedLength,     ///< 固定长度
+        LengthPrefix,    ///< 帧头中带长度字段
+        Slip,            ///< SLIP（RFC 1055，C0 结束，DB 转义）
+        Cobs,            ///< COBS（00 结束）
+        IdleGap          ///< 字节间空闲超过一定时间即为帧结束
+    };
+
+    static constexpr int MAX_FRAME_SIZE = 65536;    ///< 单帧最大字节数上限
+
+    Type type = None;
+    QByteArray delimiter = QByteArray("\r\n");  ///< 分隔符（1~8 字节）
+    bool keepDelimiter = false;   ///< 显示的帧是否包含分隔符
+    int fixedLength = 16;         ///< 固定帧长度（字节）
+    int lengthOffset = 0;         ///< 长度字段之前的字节数（同步头、地址等）
+    int lengthSize = 1;           ///< 长度字段字节数（1、2 或 4）
+    bool lengthBigEndian = false; ///< 长度字段是否为大端
+    int lengthAdjust = 0;         ///< 长度字段之后的字节数 = 字段值 + lengthAdjust（如校验和）
+    int idleGapMs = 5;            ///< 空闲分帧的间隔（毫秒）
+    int maxFrameSize = 4096;      ///< 单帧最大字节数，超过的部分被截断
+
+    /**
+     * @brief 长度前缀帧的帧头字节数
+     * @return lengthOffset + lengthSize
+     */
+    int lengthHeaderSize() const {
+        return lengthOffset + lengthSize;
+    }
+
+    /**
+     * @brief 验证配置参数是否有效
+     * @return true 如果所有参数有效，否则返回 false
+     */
+    bool isValid() const {
+        return validationError().isEmpty();
+    }
+
+    /**
+     * @brief 获取配置验证错误信息
+     * @return 错误描述字符串，如果配置有效则返回空字符串
+     */
+    QString validationError() const {
+        if (maxFrameSize <= 0 || maxFrameSize > MAX_FRAME_SIZE) {
+            return QStringLiteral("Max frame size must be between 1 and %1").arg(MAX_FRAME_SIZE);
+        }
+
+        switch (type) {
+        case Delimiter:
+            if (delimiter.isEmpty() || delimiter.size() > 8) {
+                return QStringLiteral("Delimiter must be 1 to 8 bytes");
+            }
+            break;
+        case FixedLength:
+            if (fixedLength <= 0 || fixedLength > maxFrameSize) {
+                return QStringLiteral("Frame length must be between 1 and %1").arg(maxFrameSize);
+            }
+            break;
+        case LengthPrefix:
+            if (lengthSize != 1 && lengthSize != 2 && lengthSize != 4) {
+                return QStringLiteral("Length field must be 1, 2 or 4 bytes");
+            }
+            if (lengthOffset < 0 || lengthHeaderSize() > maxFrameSize) {
+                return QStringLiteral("Length field offset is out of range");
+            }
+            break;
+        case IdleGap:
+            if (idleGapMs <= 0) {
+                return QStringLiteral("Idle gap must be a positive number");
+            }
+            break;
+        case None:
+        case Slip:
+        case Cobs:
+            break;
+        }
+
+        return QString();
+    }
+
+    bool operator==(const FrameConfig &other) const {
+        return type == other.type && delimiter == other.delimiter
+            && keepDelimiter == other.keepDelimiter && fixedLength == other.fixedLength
+            && lengthOffset == other.lengthOffset && lengthSize == other.lengthSize
+            && lengthBigEndian == other.lengthBigEndian && lengthAdjust == other.lengthAdjust
+            && idleGapMs == other.idleGapMs && maxFrameSize == other.maxFrameSize;
+    }
+
+    bool operator!=(const FrameConfig &other) const {
+        return !(*this == other);
+    }
+};
+
+#endif // FRAMECONFIG_H
@@ -0,0 +1,449 @@
+#include "framedecoder.h"
+
+#include <cstring>
+
+/**
+ * @brief FrameDecoder 及各帧格式实现
+ */
+
+namespace {
+
+constexpr qint64 MAX_DECLARED_FRAME = qint64(16) << 20;    ///< 长度字段允许的最大整帧长度
+
+constexpr char SLIP_END = char(0xC0);
+constexpr char SLIP_ESC = char(0xDB);
+constexpr char SLIP_ESC_END = char(0xDC);
+constexpr char SLIP_ESC_ESC = char(0xDD);
+
+} // namespace
+
+// ==================== FrameDecoder ====================
+
+FrameDecoder::FrameDecoder(int maxFrameSize)
+    : m_maxFrameSize(qMax(1, maxFrameSize))
+{
+    m_frame.resize(m_maxFrameSize);
+}
+
+std::unique_ptr<FrameDecoder> FrameDecoder::create(const FrameConfig &config)
+{
+    if (!config.isValid()) {
+        return nullptr;
+    }
+
+    switch (config.type) {
+    case FrameConfig::Delimiter:
+        return std::make_unique<DelimiterFrameDecoder>(config.delimiter, config.keepDelimiter,
+                                                       config.maxFrameSize);
+    case FrameConfig::FixedLength:
+        return std::make_unique<FixedLengthFrameDecoder>(config.fixedLength);
+    case FrameConfig::LengthPrefix:
+        return std::make_unique<LengthPrefixFrameDecoder>(config);
+    case FrameConfig::Slip:
+        return std::make_unique<SlipFrameDecoder>(config.maxFrameSize);
+    case FrameConfig::Cobs:
+        return std::make_unique<CobsFrameDecoder>(config.maxFrameSize);
+    case FrameConfig::IdleGap:
+        return std::make_unique<IdleGapFrameDecoder>(config.idleGapMs, config.maxFrameSize);
+    case FrameConfig::None:
+        break;
+    }
+    return nullptr;
+}
+
+void FrameDecoder::checkIdle(qint64 nowNs, FrameBatch &out)
+{
+    Q_UNUSED(nowNs);
+    Q_UNUSED(out);
+}
+
+qint64 FrameDecoder::idleGapNs() const
+{
+    return 0;
+}
+
+void FrameDecoder::reset()
+{
+    discardFrame();
+}
+
+bool FrameDecoder::hasPartialFrame() const
+{
+    return m_inFrame;
+}
+
+void FrameDecoder::appendBytes(const char *data, qsizetype size, qint64 timestampNs)
+{
+    if (!m_inFrame) {
+        m_inFrame = true;
+        m_frameTimestampNs = timestampNs;
+    }
+
+    const qsizetype copy = qMin(size, m_maxFrameSize - m_frameSize);
+    if (copy > 0) {
+        std::memcpy(m_frame.data() + m_frameSize, data, size_t(copy));
+        m_frameSize += copy;
+    }
+    m_receivedSize += size;
+}
+
+void FrameDecoder::appendByte(char byte, qint64 timestampNs)
+{
+    if (!m_inFrame) {
+        m_inFrame = true;
+        m_frameTimestampNs = timestampNs;
+    }
+
+    if (m_frameSize < m_maxFrameSize) {
+        m_frame.data()[m_frameSize++] = byte;
+    }
+    ++m_receivedSize;
+}
+
+void FrameDecoder::finishFrame(FrameBatch &out, qsizetype trimTail, int flags)
+{
+    // 被截断时丢弃的是帧尾，要去掉的尾部字节可能已不在缓冲区中
+    const qsizetype dropped = m_receivedSize - m_frameSize;
+    if (dropped > 0) {
+        flags |= FrameBatch::Truncated;
+    }
+    const qsizetype size = m_frameSize - qMax<qsizetype>(0, trimTail - dropped);
+
+    if (m_inFrame && (size > 0 || flags)) {
+        FrameBatch::Frame frame;
+        frame.offset = out.data.size();
+        frame.size = size;
+        frame.timestampNs = m_frameTimestampNs;
+        frame.flags = flags;
+        out.data.append(m_frame.constData(), size);
+        out.frames.append(frame);
+    }
+
+    discardFrame();
+}
+
+void FrameDecoder::discardFrame()
+{
+    m_frameSize = 0;
+    m_receivedSize = 0;
+    m_inFrame = false;
+}
+
+// ==================== DelimiterFrameDecoder ====================
+
+DelimiterFrameDecoder::DelimiterFrameDecoder(const QByteArray &delimiter, bool keepDelimiter, int maxFrameSize)
+    : FrameDecoder(maxFrameSize)
+    , m_delimiter(delimiter)
+    , m_keepDelimiter(keepDelimiter)
+{
+    // KMP 前缀表：m_failure[i] 为 delimiter[0..i] 的最长真前后缀长度
+    m_failure.resize(m_delimiter.size());
+    int k = 0;
+    for (qsizetype i = 1; i < m_delimiter.size(); ++i) {
+        while (k > 0 && m_delimiter[i] != m_delimiter[k]) {
+            k = m_failure[k - 1];
+        }
+        if (m_delimiter[i] == m_delimiter[k]) {
+            ++k;
+        }
+        m_failure[i] = k;
+    }
+}
+
+void DelimiterFrameDecoder::feed(QByteArrayView data, qint64 timestampNs, FrameBatch &out)
+{
+    const char *p = data.data();
+    const qsizetype size = data.size();
+    const qsizetype delimiterSize = m_delimiter.size();
+    const char first = m_delimiter[0];
+    qsizetype pos = 0;
+
+    while (pos < size) {
+        if (m_matched == 0) {
+            // 帧内容整段拷贝，直到下一个可能的分隔符
+            const void *hit = std::memchr(p + pos, first, size_t(size - pos));
+            const qsizetype end = hit ? static_cast<const char *>(hit) - p : size;
+            if (end > pos) {
+                appendBytes(p + pos, end - pos, timestampNs);
+            }
+            pos = end;
+            if (!hit) {
+                break;
+            }
+        }
+
+        const char byte = p[pos++];
+        while (m_matched > 0 && byte != m_delimiter[m_matched]) {
+            m_matched = m_failure[m_matched - 1];
+        }
+        if (byte == m_delimiter[m_matched]) {
+            ++m_matched;
+        }
+        appendByte(byte, timestampNs);
+
+        if (m_matched == delimiterSize) {
+            finishFrame(out, m_keepDelimiter ? 0 : delimiterSize);
+            m_matched = 0;
+        }
+    }
+}
+
+void DelimiterFrameDecoder::reset()
+{
+    FrameDecoder::reset();
+    m_matched = 0;
+}
+
+// ==================== FixedLengthFrameDecoder ====================
+
+FixedLengthFrameDecoder::FixedLengthFrameDecoder(int length)
+    : FrameDecoder(length)
+    , m_length(length)
+{
+}
+
+void FixedLengthFrameDecoder::feed(QByteArrayView data, qint64 timestampNs, FrameBatch &out)
+{
+    const char *p = data.data();
+    const qsizetype size = data.size();
+    qsizetype pos = 0;
+
+    while (pos < size) {
+        const qsizetype take = qMin(m_length - m_receivedSize, size - pos);
+        appendBytes(p + pos, take, timestampNs);
+        pos += take;
+        if (m_receivedSize == m_length) {
+            finishFrame(out);
+        }
+    }
+}
+
+// ==================== LengthPrefixFrameDecoder ====================
+
+LengthPrefixFrameDecoder::LengthPrefixFrameDecoder(const FrameConfig &config)
+    : FrameDecoder(config.maxFrameSize)
+    , m_lengthOffset(config.lengthOffset)
+    , m_lengthSize(config.lengthSize)
+    , m_bigEndian(config.lengthBigEndian)
+    , m_lengthAdjust(config.lengthAdjust)
+{
+}
+
+qint64 LengthPrefixFrameDecoder::parseFrameLength() const
+{
+    const uchar *field = reinterpret_cast<const uchar *>(m_frame.constData()) + m_lengthOffset;
+    quint64 value = 0;
+    for (int i = 0; i < m_lengthSize; ++i) {
+        const int index = m_bigEndian ? i : m_lengthSize - 1 - i;
+        value = (value << 8) | field[index];
+    }
+
+    const qint64 total = qint64(m_lengthOffset + m_lengthSize) + qint64(value) + m_lengthAdjust;
+    if (total < m_lengthOffset + m_lengthSize || total > MAX_DECLARED_FRAME) {
+        return -1;
+    }
+    return total;
+}
+
+void LengthPrefixFrameDecoder::feed(QByteArrayView data, qint64 timestampNs, FrameBatch &out)
+{
+    const char *p = data.data();
+    const qsizetype size = data.size();
+    const qsizetype headerSize = m_lengthOffset + m_lengthSize;
+    qsizetype pos = 0;
+
+    while (pos < size) {
+        if (m_frameLength < 0) {
+            // 先收齐帧头（帧头不超过最大帧长，不会被截断）
+            const qsizetype take = qMin(headerSize - m_frameSize, size - pos);
+            appendBytes(p + pos, take, timestampNs);
+            pos += take;
+            if (m_frameSize < headerSize) {
+                break;
+            }
+
+            m_frameLength = parseFrameLength();
+            if (m_frameLength < 0) {
+                // 长度越界：输出帧头供查看，从帧头之后重新同步
+                finishFrame(out, 0, FrameBatch::Malformed);
+                continue;
+            }
+        }
+
+        const qsizetype take = qMin<qsizetype>(m_frameLength - m_receivedSize, size - pos);
+        appendBytes(p + pos, take, timestampNs);
+        pos += take;
+        if (m_receivedSize == m_frameLength) {
+            finishFrame(out);
+            m_frameLength = -1;
+        }
+    }
+}
+
+void LengthPrefixFrameDecoder::reset()
+{
+    FrameDecoder::reset();
+    m_frameLength = -1;
+}
+
+// ==================== SlipFrameDecoder ====================
+
+SlipFrameDecoder::SlipFrameDecoder(int maxFrameSize)
+    : FrameDecoder(maxFrameSize)
+{
+}
+
+void SlipFrameDecoder::feed(QByteArrayView data, qint64 timestampNs, FrameBatch &out)
+{
+    const char *p = data.data();
+    const qsizetype size = data.size();
+    qsizetype pos = 0;
+
+    while (pos < size) {
+        if (!m_escape) {
+            // 普通字节整段拷贝，直到下一个 END 或 ESC
+            qsizetype end = pos;
+            while (end < size && p[end] != SLIP_END && p[end] != SLIP_ESC) {
+                ++end;
+            }
+            if (end > pos) {
+                appendBytes(p + pos, end - pos, timestampNs);
+                pos = end;
+                if (pos == size) {
+                    break;
+                }
+            }
+        }
+
+        const char byte = p[pos++];
+        if (m_escape) {
+            m_escape = false;
+            if (byte == SLIP_ESC_END) {
+                appendByte(SLIP_END, timestampNs);
+            } else if (byte == SLIP_ESC_ESC) {
+                appendByte(SLIP_ESC, timestampNs);
+            } else if (byte == SLIP_END) {
+                finishFrame(out, 0, m_flags | FrameBatch::Malformed);
+                m_flags = 0;
+            } else {
+                // 非法转义：保留原字节并标记
+                m_flags |= FrameBatch::Malformed;
+                appendByte(byte, timestampNs);
+            }
+        } else if (byte == SLIP_END) {
+            finishFrame(out, 0, m_flags);
+            m_flags = 0;
+        } else {
+            m_escape = true;
+            appendBytes(p, 0, timestampNs);
+        }
+    }
+}
+
+void SlipFrameDecoder::reset()
+{
+    FrameDecoder::reset();
+    m_escape = false;
+    m_flags = 0;
+}
+
+// ==================== CobsFrameDecoder ====================
+
+CobsFrameDecoder::CobsFrameDecoder(int maxFrameSize)
+    : FrameDecoder(maxFrameSize)
+{
+}
+
+void CobsFrameDecoder::feed(QByteArrayView data, qint64 timestampNs, FrameBatch &out)
+{
+    const char *p = data.data();
+    const qsizetype size = data.size();
+    qsizetype pos = 0;
+
+    while (pos < size) {
+        if (m_remaining == 0) {
+            const uchar code = uchar(p[pos++]);
+            if (code == 0) {
+                // 帧结束；最后一块隐含的 00 不属于数据
+                if (m_started) {
+                    finishFrame(out, 0, m_flags);
+                } else {
+                    discardFrame();
+                }
+                m_pendingZero = false;
+                m_started = false;
+                m_flags = 0;
+                continue;
+            }
+
+            appendBytes(p, 0, timestampNs);
+            if (m_pendingZero) {
+                appendByte(0, timestampNs);
+            }
+            m_started = true;
+            m_remaining = code - 1;
+            m_pendingZero = code < 0xFF;
+            continue;
+        }
+
+        // 块内不应出现 00；出现则说明块长度错误，该 00 作为帧结束
+        const qsizetype limit = qMin<qsizetype>(m_remaining, size - pos);
+        const void *hit = std::memchr(p + pos, 0, size_t(limit));
+        const qsizetype take = hit ? static_cast<const char *>(hit) - (p + pos) : limit;
+        appendBytes(p + pos, take, timestampNs);
+        pos += take;
+        m_remaining -= int(take);
+        if (hit) {
+            m_flags |= FrameBatch::Malformed;
+            m_remaining = 0;
+        }
+    }
+}
+
+void CobsFrameDecoder::reset()
+{
+    FrameDecoder::reset();
+    m_remaining = 0;
+    m_pendingZero = false;
+    m_started = false;
+    m_flags = 0;
+}
+
+// ==================== IdleGapFrameDecoder ====================
+
+IdleGapFrameDecoder::IdleGapFrameDecoder(int idleGapMs, int maxFrameSize)
+    : FrameDecoder(maxFrameSize)
+    , m_gapNs(qint64(idleGapMs) * 1000000)
+{
+}
+
+void IdleGapFrameDecoder::feed(QByteArrayView data, qint64 timestampNs, FrameBatch &out)
+{
+    if (data.isEmpty()) {
+        return;
+    }
+
+    if (m_inFrame && timestampNs - m_lastArrivalNs >= m_gapNs) {
+        finishFrame(out);
+    }
+    appendBytes(data.data(), data.size(), timestampNs);
+    m_lastArrivalNs = timestampNs;
+}
+
+void IdleGapFrameDecoder::checkIdle(qint64 nowNs, FrameBatch &out)
+{
+    if (m_inFrame && nowNs - m_lastArrivalNs >= m_gapNs) {
+        finishFrame(out);
+    }
+}
+
+qint64 IdleGapFrameDecoder::idleGapNs() const
+{
+    return m_gapNs;
+}
+
+void IdleGapFrameDecoder::reset()
+{
+    FrameDecoder::reset();
+    m_lastArrivalNs = 0;
+}
@@ -0,0 +1,261 @@
+#ifndef FRAMEDECODER_H
+#define FRAMEDECODER_H
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QVector>
+#include <memory>
+
+#include "frameconfig.h"
+
+/**
+ * @brief FrameBatch - 一次解码得到的若干帧
+ *
+ * 所有帧的字节连续存放在 data 中，frames 记录各帧的位置。
+ * clear() 保留已分配的容量，在处理线程中反复使用，不随每块数据重新分配。
+ */
+struct FrameBatch {
+    /**
+     * @brief 帧标志
+     */
+    enum Flag {
+        Truncated = 0x1,    ///< 超过最大帧长，只保留了开头部分
+        Malformed = 0x2     ///< 编码错误（转义、COBS 块长度、长度字段越界等）
+    };
+
+    /**
+     * @brief 一帧的位置
+     */
+    struct Frame {
+        qsizetype offset = 0;       ///< 在 data 中的起始偏移
+        qsizetype size = 0;         ///< 字节数
+        qint64 timestampNs = 0;     ///< 第一个字节的到达时间（单调时钟纳秒）
+        int flags = 0;              ///< Flag 组合
+    };
+
+    QByteArray data;            ///< 帧字节
+    QVector<Frame> frames;      ///< 帧位置
+
+    /**
+     * @brief 清空但保留容量
+     */
+    void clear() {
+        data.resize(0);
+        frames.resize(0);
+    }
+
+    /**
+     * @brief 获取一帧的字节
+     * @param index 帧下标
+     * @return 帧字节视图，在下一次 clear() 之前有效
+     */
+    QByteArrayView bytes(qsizetype index) const {
+        const Frame &frame = frames.at(index);
+        return QByteArrayView(data.constData() + frame.offset, frame.size);
+    }
+};
+
+/**
+ * @brief FrameDecoder - 增量帧解码器基类
+ *
+ * 每种帧格式是一个可恢复的状态机：按到达顺序喂入任意切分的数据块，
+ * 完整的帧追加到 FrameBatch，未完成的帧保存在解码器内部，等待下一块。
+ * 帧缓冲区按最大帧长一次分配，逐字节解码（SLIP、COBS）只写入已分配的空间；
+ * 分隔符、COBS 块等边界用 memchr 查找，普通字节段整段拷贝。
+ *
+ * 非线程安全，只在处理线程中使用。
+ */
+class FrameDecoder
+{
+public:
+    /**
+     * @brief 构造函数
+     * @param maxFrameSize 单帧最大字节数
+     */
+    explicit FrameDecoder(int maxFrameSize);
+    virtual ~FrameDecoder() = default;
+
+    /**
+     * @brief 按配置创建解码器
+     * @param config 帧解析配置（type 为 None 或配置无效时返回空指针）
+     * @return 解码器
+     */
+    static std::unique_ptr<FrameDecoder> create(const FrameConfig &config);
+
+    /**
+     * @brief 喂入一块数据
+     * @param data 原始字节
+     * @param timestampNs 这块数据的到达时间
+     * @param out 完整的帧追加到这里
+     */
+    virtual void feed(QByteArrayView data, qint64 timestampNs, FrameBatch &out) = 0;
+
+    /**
+     * @brief 检查空闲时间是否已足够结束当前帧（只有空闲分帧使用）
+     *
+     * @param nowNs 当前时间（单调时钟纳秒）
+     * @param out 结束的帧追加到这里
+     */
+    virtual void checkIdle(qint64 nowNs, FrameBatch &out);
+
+    /**
+     * @brief 获取空闲分帧的间隔
+     * @return 间隔（纳秒），0 表示不需要定时检查
+     */
+    virtual qint64 idleGapNs() const;
+
+    /**
+     * @brief 丢弃未完成的帧，下一个字节从帧边界开始
+     */
+    virtual void reset();
+
+    /**
+     * @brief 检查是否有未完成的帧
+     * @return true 如果有
+     */
+    bool hasPartialFrame() const;
+
+protected:
+    /**
+     * @brief 向当前帧追加字节，必要时开始新帧；超过最大帧长的部分丢弃并标记截断
+     */
+    void appendBytes(const char *data, qsizetype size, qint64 timestampNs);
+
+    /**
+     * @brief 向当前帧追加一个字节
+     */
+    void appendByte(char byte, qint64 timestampNs);
+
+    /**
+     * @brief 结束当前帧并输出（空帧不输出）
+     * @param out 输出
+     * @param trimTail 从帧尾去掉的字节数（如不保留的分隔符）
+     * @param flags 额外的帧标志
+     */
+    void finishFrame(FrameBatch &out, qsizetype trimTail = 0, int flags = 0);
+
+    /**
+     * @brief 丢弃当前帧
+     */
+    void discardFrame();
+
+    QByteArray m_frame;             ///< 当前帧缓冲区（按最大帧长一次分配）
+    qsizetype m_frameSize = 0;      ///< 当前帧已写入的字节数
+    qsizetype m_receivedSize = 0;   ///< 当前帧收到的字节数（含被截断丢弃的）
+    qint64 m_frameTimestampNs = 0;  ///< 当前帧第一个字节的到达时间
+    bool m_inFrame = false;         ///< 当前帧已开始
+    qsizetype m_maxFrameSize;       ///< 单帧最大字节数
+};
+
+/**
+ * @brief DelimiterFrameDecoder - 分隔符分帧
+ *
+ * 分隔符可以跨数据块；多字节分隔符用 KMP 前缀表匹配，帧内容用 memchr 跳到分隔符首字节。
+ */
+class DelimiterFrameDecoder : public FrameDecoder
+{
+public:
+    DelimiterFrameDecoder(const QByteArray &delimiter, bool keepDelimiter, int maxFrameSize);
+    void feed(QByteArrayView data, qint64 timestampNs, FrameBatch &out) override;
+    void reset() override;
+
+private:
+    QByteArray m_delimiter;         ///< 分隔符
+    QVector<int> m_failure;         ///< KMP 前缀表
+    int m_matched = 0;              ///< 帧尾已匹配的分隔符字节数
+    bool m_keepDelimiter;           ///< 输出的帧是否包含分隔符
+};
+
+/**
+ * @brief FixedLengthFrameDecoder - 固定长度分帧
+ */
+class FixedLengthFrameDecoder : public FrameDecoder
+{
+public:
+    explicit FixedLengthFrameDecoder(int length);
+    void feed(QByteArrayView data, qint64 timestampNs, FrameBatch &out) override;
+
+private:
+    qsizetype m_length;             ///< 帧长度
+};
+
+/**
+ * @brief LengthPrefixFrameDecoder - 长度前缀分帧
+ *
+ * 帧 = lengthOffset 字节 + 长度字段 + (字段值 + lengthAdjust) 字节，输出整帧（含帧头）。
+ * 长度越界时输出已收到的帧头并标记格式错误，从下一个字节重新同步。
+ */
+class LengthPrefixFrameDecoder : public FrameDecoder
+{
+public:
+    explicit LengthPrefixFrameDecoder(const FrameConfig &config);
+    void feed(QByteArrayView data, qint64 timestampNs, FrameBatch &out) override;
+    void reset() override;
+
+private:
+    /**
+     * @brief 从已收齐的帧头解析整帧长度
+     * @return 整帧字节数，越界时返回 -1
+     */
+    qint64 parseFrameLength() const;
+
+    int m_lengthOffset;             ///< 长度字段偏移
+    int m_lengthSize;               ///< 长度字段字节数
+    bool m_bigEndian;               ///< 长度字段字节序
+    int m_lengthAdjust;             ///< 长度修正
+    qint64 m_frameLength = -1;      ///< 当前帧总长度，-1 表示帧头未收齐
+};
+
+/**
+ * @brief SlipFrameDecoder - SLIP 分帧（RFC 1055）
+ */
+class SlipFrameDecoder : public FrameDecoder
+{
+public:
+    explicit SlipFrameDecoder(int maxFrameSize);
+    void feed(QByteArrayView data, qint64 timestampNs, FrameBatch &out) override;
+    void reset() override;
+
+private:
+    bool m_escape = false;          ///< 上一个字节是 ESC
+    int m_flags = 0;                ///< 当前帧的错误标志
+};
+
+/**
+ * @brief CobsFrameDecoder - COBS 分帧（00 结束）
+ */
+class CobsFrameDecoder : public FrameDecoder
+{
+public:
+    explicit CobsFrameDecoder(int maxFrameSize);
+    void feed(QByteArrayView data, qint64 timestampNs, FrameBatch &out) override;
+    void reset() override;
+
+private:
+    int m_remaining = 0;            ///< 当前块还需要拷贝的字节数，0 表示下一个字节是块长度
+    bool m_pendingZero = false;     ///< 上一块长度小于 0xFF，下一块开始前补一个 00
+    bool m_started = false;         ///< 当前帧已读到第一个块长度
+    int m_flags = 0;                ///< 当前帧的错误标志
+};
+
+/**
+ * @brief IdleGapFrameDecoder - 空闲分帧
+ *
+ * 相邻两块数据的到达时间相差超过间隔即结束当前帧；最后一帧由 checkIdle() 结束。
+ * 分辨率受 SerialWorker 的读取合并延迟限制，间隔应明显大于 batchLatencyMs。
+ */
+class IdleGapFrameDecoder : public FrameDecoder
+{
+public:
+    IdleGapFrameDecoder(int idleGapMs, int maxFrameSize);
+    void feed(QByteArrayView data, qint64 timestampNs, FrameBatch &out) override;
+    void checkIdle(qint64 nowNs, FrameBatch &out) override;
+    qint64 idleGapNs() const override;
+    void reset() override;
+
+private:
+    qint64 m_gapNs;                 ///< 空闲间隔
+    qint64 m_lastArrivalNs = 0;     ///< 最后一块数据的到达时间
+};
+
+#endif // FRAMEDECODER_H
@@ -0,0 +1,76 @@
+#include "framepacer.h"
+
+/**
+ * @brief FramePacer 实现
+ *
+ * Requirements: 6.1, 6.2, 6.3
+ */
+
+namespace {
+
+constexpr qint64 TARGET_NS = qint64(FramePacer::TARGET_FRAME_MS) * 1000000;
+constexpr qsizetype MIN_SAMPLE_CHARS = 512;   // 字符太少时耗时以固定开销为主，不参与估算
+constexpr double SMOOTHING = 0.25;
+
+} // namespace
+
+FramePacer::FramePacer(int initialIntervalMs)
+    : m_initialInterval(qBound(MIN_INTERVAL_MS, initialIntervalMs, MAX_INTERVAL_MS))
+    , m_interval(m_initialInterval)
+{
+}
+
+void FramePacer::frameFinished(qint64 frameNs, qsizetype shownChars, qsizetype incomingChars)
+{
+    // 1. 每字符代价 -> 每帧预算
+    if (shownChars >= MIN_SAMPLE_CHARS && frameNs > 0) {
+        const double sample = double(frameNs) / double(shownChars);
+        m_nsPerChar = (m_nsPerChar > 0) ? m_nsPerChar + SMOOTHING * (sample - m_nsPerChar) : sample;
+    }
+    if (m_nsPerChar > 0) {
+        m_budget = qBound(MIN_BUDGET, qsizetype(double(TARGET_NS) / m_nsPerChar), MAX_BUDGET);
+    }
+
+    // 2. 刷新间隔：超时拉长，空闲缩短
+    if (frameNs > TARGET_NS) {
+        m_interval = qMin(MAX_INTERVAL_MS, m_interval + m_interval / 4 + 1);
+    } else if (frameNs < TARGET_NS / 2) {
+        m_interval = qMax(MIN_INTERVAL_MS, m_interval - m_interval / 8 - 1);
+    }
+
+    // 3. 摘要模式
+    if (!m_summary) {
+        if (incomingChars - shownChars > m_budget * SUMMARY_ENTER_FRAMES) {
+            m_summary = true;
+            m_calmFrames = 0;
+        }
+    } else if (incomingChars <= m_budget) {
+        if (++m_calmFrames >= SUMMARY_EXIT_FRAMES) {
+            m_summary = false;
+        }
+    } else {
+        m_calmFrames = 0;
+    }
+}
+
+void FramePacer::reset()
+{
+    m_interval = m_initialInterval;
+    m_summary = false;
+    m_calmFrames = 0;
+}
+
+int FramePacer::interval() const
+{
+    return m_interval;
+}
+
+qsizetype FramePacer::charBudget() const
+{
+    return m_budget;
+}
+
+bool FramePacer::isSummaryMode() const
+{
+    return m_summary;
+}
@@ -0,0 +1,76 @@
+#ifndef FRAMEPACER_H
+#define FRAMEPACER_H
+
+#include <QtGlobal>
+
+/**
+ * @brief FramePacer - 接收区刷新节奏控制
+ *
+ * 根据每帧实际耗时（插入 + 绘制）自适应调整刷新间隔和每帧最多插入的字符数：
+ * - 估算每字符的显示代价，使每帧耗时保持在 TARGET_FRAME_MS 左右
+ * - 单帧超时则拉长刷新间隔，空闲时逐步缩短，范围 MIN_INTERVAL_MS ~ MAX_INTERVAL_MS
+ * - 积压超过 SUMMARY_ENTER_FRAMES 帧的预算时进入摘要模式，每帧只显示最新的数据，
+ *   中间部分以“已跳过 N 字节”标记代替；连续 SUMMARY_EXIT_FRAMES 帧输入不超过预算后退出
+ *
+ * 只在 UI 线程中使用。
+ *
+ * Requirements: 6.1, 6.2, 6.3
+ */
+class FramePacer
+{
+public:
+    static constexpr int MIN_INTERVAL_MS = 16;          ///< 最短刷新间隔
+    static constexpr int MAX_INTERVAL_MS = 100;         ///< 最长刷新间隔
+    static constexpr int TARGET_FRAME_MS = 8;           ///< 每帧目标耗时
+    static constexpr qsizetype MIN_BUDGET = 4096;       ///< 每帧最少插入字符数（大于一行的上限）
+    static constexpr qsizetype MAX_BUDGET = 1 << 20;    ///< 每帧最多插入字符数
+    static constexpr int SUMMARY_ENTER_FRAMES = 8;      ///< 积压超过多少帧的预算时进入摘要模式
+    static constexpr int SUMMARY_EXIT_FRAMES = 3;       ///< 连续多少帧不超预算时退出摘要模式
+
+    /**
+     * @brief 构造函数
+     * @param initialIntervalMs 初始刷新间隔（毫秒）
+     */
+    explicit FramePacer(int initialIntervalMs = 33);
+
+    /**
+     * @brief 记录一帧的结果并更新策略
+     * @param frameNs 本帧耗时（纳秒，插入 + 绘制）
+     * @param shownChars 本帧插入的字符数
+     * @param incomingChars 本帧开始时待显示的字符数
+     */
+    void frameFinished(qint64 frameNs, qsizetype shownChars, qsizetype incomingChars);
+
+    /**
+     * @brief 恢复初始状态（保留已测得的显示代价）
+     */
+    void reset();
+
+    /**
+     * @brief 获取当前刷新间隔
+     * @return 刷新间隔（毫秒）
+     */
+    int interval() const;
+
+    /**
+     * @brief 获取每帧最多插入的字符数
+     * @return 字符数预算
+     */
+    qsizetype charBudget() const;
+
+    /**
+     * @brief 是否处于摘要模式
+     * @return true 如果输入速度超过显示能力
+     */
+    bool isSummaryMode() const;
+
+private:
+    int m_initialInterval;            ///< 初始刷新间隔
+    int m_interval;                   ///< 当前刷新间隔（毫秒）
+    double m_nsPerChar = 0;           ///< 每字符显示代价估计（纳秒，指数平均）
+    qsizetype m_budget = MIN_BUDGET;  ///< 每帧字符预算
+    bool m_summary = false;           ///< 摘要模式
+    int m_calmFrames = 0;             ///< 摘要模式下连续未超预算的帧数
+};
+
+#endif // FRAMEPACER_H
@@ -0,0 +1,288 @@
+#include "hexencoder.h"
+#include "bytescan.h"
+
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define HEXENCODER_SSE2 1
+#endif
+
+// AVX2 路径：编译时启用 AVX2 时直接使用，否则 GCC/Clang 在 x86 上按运行时检测的结果选择
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define HEXENCODER_AVX2 1
+#define HEXENCODER_TARGET_AVX2
+#elif defined(HEXENCODER_SSE2) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define HEXENCODER_AVX2 1
+#define HEXENCODER_AVX2_DISPATCH 1
+#define HEXENCODER_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+/**
+ * @brief HexEncoder 实现
+ *
+ * Requirements: 2.2, 2.3, 3.1
+ */
+
+namespace {
+
+// 每个字节对应的两个大写十六进制 UTF-16 字符
+struct HexTable {
+    char16_t pairs[256][2];
+};
+
+constexpr HexTable makeHexTable()
+{
+    HexTable table{};
+    const char digits[] = "0123456789ABCDEF";
+    for (int i = 0; i < 256; ++i) {
+        table.pairs[i][0] = static_cast<char16_t>(digits[i >> 4]);
+        table.pairs[i][1] = static_cast<char16_t>(digits[i & 0x0F]);
+    }
+    return table;
+}
+
+constexpr HexTable kHexTable = makeHexTable();
+
+inline bool isCrLf(uchar byte)
+{
+    return byte == 0x0A || byte == 0x0D;
+}
+
+inline char16_t *writeHexPair(uchar byte, char16_t *dst)
+{
+    std::memcpy(dst, kHexTable.pairs[byte], sizeof(kHexTable.pairs[byte]));
+    return dst + 2;
+}
+
+#ifdef HEXENCODER_SSE2
+// 半字节 0..15 转为 '0'..'9'、'A'..'F'：加 '0'，大于 9 的再加 7
+inline __m128i nibblesToAscii(__m128i nibbles)
+{
+    const __m128i letters = _mm_cmpgt_epi8(nibbles, _mm_set1_epi8(9));
+    return _mm_add_epi8(_mm_add_epi8(nibbles, _mm_set1_epi8('0')),
+                        _mm_and_si128(letters, _mm_set1_epi8('A' - '0' - 10)));
+}
+
+// 4 个 "HL" 字符对（每对一个 32 位单元）各补一个空格写出，每次写 4 个字符、前进 3 个，
+// 第 4 个字符由下一次写入覆盖
+inline char16_t *storePairs4(__m128i pairs, char16_t *dst)
+{
+    const __m128i space = _mm_set1_epi32(' ');
+    const __m128i q0 = _mm_unpacklo_epi32(pairs, space);
+    const __m128i q1 = _mm_unpackhi_epi32(pairs, space);
+    _mm_storel_epi64(reinterpret_cast<__m128i *>(dst), q0);
+    _mm_storel_epi64(reinterpret_cast<__m128i *>(dst + 3), _mm_srli_si128(q0, 8));
+    _mm_storel_epi64(reinterpret_cast<__m128i *>(dst + 6), q1);
+    _mm_storel_epi64(reinterpret_cast<__m128i *>(dst + 9), _mm_srli_si128(q1, 8));
+    return dst + 12;
+}
+
+/*
+ * SSE2（x86-64 基线）：16 个输入字节展开为 48 个输出字符 "XX XX ... XX "。
+ * 半字节用比较加法转成 ASCII，交错成 H0 L0 H1 L1 ... 后零扩展为 UTF-16，
+ * 空格由 storePairs4 插入。会多写 1 个字符到 dst[48]，调用者保证其后还有输出。
+ */
+inline char16_t *encodeBlock16Sse2(const uchar *src, char16_t *dst)
+{
+    const __m128i nibbleMask = _mm_set1_epi8(0x0F);
+    const __m128i zero = _mm_setzero_si128();
+
+    const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+    const __m128i hi = nibblesToAscii(_mm_and_si128(_mm_srli_epi16(bytes, 4), nibbleMask));
+    const __m128i lo = nibblesToAscii(_mm_and_si128(bytes, nibbleMask));
+    const __m128i p0 = _mm_unpacklo_epi8(hi, lo);
+    const __m128i p1 = _mm_unpackhi_epi8(hi, lo);
+
+    dst = storePairs4(_mm_unpacklo_epi8(p0, zero), dst);
+    dst = storePairs4(_mm_unpackhi_epi8(p0, zero), dst);
+    dst = storePairs4(_mm_unpacklo_epi8(p1, zero), dst);
+    return storePairs4(_mm_unpackhi_epi8(p1, zero), dst);
+}
+#endif
+
+#ifdef HEXENCODER_AVX2
+/*
+ * AVX2：16 个输入字节展开为 48 个输出字符。
+ * 先用 pshufb 把半字节查表成 ASCII，交错成 H0 L0 H1 L1 ... 两个向量 p0/p1，
+ * 再用三组重排掩码把它们拼成每 3 字符一组（第 3 个为空格）的三个 16 字节向量，
+ * 最后用 vpmovzxbw 零扩展为 UTF-16 写出。
+ */
+struct ShuffleTables {
+    alignas(16) signed char fromP0[3][16];
+    alignas(16) signed char fromP1[3][16];
+    alignas(16) signed char spaces[3][16];
+};
+
+constexpr ShuffleTables makeShuffleTables()
+{
+    ShuffleTables t{};
+    for (int v = 0; v < 3; ++v) {
+        for (int i = 0; i < 16; ++i) {
+            const int out = v * 16 + i;
+            const int byteIndex = out / 3;
+            const int column = out % 3;
+            t.fromP0[v][i] = -128;
+            t.fromP1[v][i] = -128;
+            t.spaces[v][i] = 0;
+            if (column == 2) {
+                t.spaces[v][i] = ' ';
+                continue;
+            }
+            const int source = byteIndex * 2 + column;
+            if (source < 16) {
+                t.fromP0[v][i] = static_cast<signed char>(source);
+            } else {
+                t.fromP1[v][i] = static_cast<signed char>(source - 16);
+            }
+        }
+    }
+    return t;
+}
+
+constexpr ShuffleTables kShuffle = makeShuffleTables();
+
+HEXENCODER_TARGET_AVX2 inline __m128i loadMask(const signed char *mask)
+{
+    return _mm_load_si128(reinterpret_cast<const __m128i *>(mask));
+}
+
+HEXENCODER_TARGET_AVX2 inline char16_t *encodeBlock16Avx2(const uchar *src, char16_t *dst)
+{
+    const __m128i digits = _mm_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7',
+                                         '8', '9', 'A', 'B', 'C', 'D', 'E', 'F');
+    const __m128i nibbleMask = _mm_set1_epi8(0x0F);
+
+    const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+    const __m128i hi = _mm_shuffle_epi8(digits, _mm_and_si128(_mm_srli_epi16(bytes, 4), nibbleMask));
+    const __m128i lo = _mm_shuffle_epi8(digits, _mm_and_si128(bytes, nibbleMask));
+    const __m128i p0 = _mm_unpacklo_epi8(hi, lo);
+    const __m128i p1 = _mm_unpackhi_epi8(hi, lo);
+
+    for (int v = 0; v < 3; ++v) {
+        const __m128i ascii = _mm_or_si128(
+            _mm_or_si128(_mm_shuffle_epi8(p0, loadMask(kShuffle.fromP0[v])),
+                         _mm_shuffle_epi8(p1, loadMask(kShuffle.fromP1[v]))),
+            loadMask(kShuffle.spaces[v]));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + v * 16), _mm256_cvtepu8_epi16(ascii));
+    }
+    return dst + 48;
+}
+#endif
+
+// 查表编码剩余字节，每字节写 "XX "
+char16_t *encodeTail(const uchar *src, qsizetype size, char16_t *dst)
+{
+    for (qsizetype i = 0; i < size; ++i) {
+        dst = writeHexPair(src[i], dst);
+        *dst++ = u' ';
+    }
+    return dst;
+}
+
+#ifdef HEXENCODER_AVX2
+HEXENCODER_TARGET_AVX2 char16_t *encodeRunAvx2(const uchar *src, qsizetype size, char16_t *dst)
+{
+    qsizetype i = 0;
+    for (; i + 16 <= size; i += 16) {
+        dst = encodeBlock16Avx2(src + i, dst);
+    }
+    return encodeTail(src + i, size - i, dst);
+}
+#endif
+
+#ifdef HEXENCODER_AVX2_DISPATCH
+// CPU 特性只检测一次
+bool hasAvx2()
+{
+    static const bool supported = (__builtin_cpu_init(), __builtin_cpu_supports("avx2"));
+    return supported;
+}
+#endif
+
+// 编码一段不含换行处理的普通字节，每字节写 "XX "，返回写入末尾
+char16_t *encodeRun(const uchar *src, qsizetype size, char16_t *dst)
+{
+#if defined(HEXENCODER_AVX2_DISPATCH)
+    if (hasAvx2()) {
+        return encodeRunAvx2(src, size, dst);
+    }
+#elif defined(HEXENCODER_AVX2)
+    return encodeRunAvx2(src, size, dst);
+#endif
+
+    qsizetype i = 0;
+#ifdef HEXENCODER_SSE2
+    // 严格小于：每块多写的 1 个字符由后面的字节覆盖
+    for (; i + 16 < size; i += 16) {
+        dst = encodeBlock16Sse2(src + i, dst);
+    }
+#endif
+    return encodeTail(src + i, size - i, dst);
+}
+
+} // namespace
+
+qsizetype HexEncoder::maxEncodedSize(const char *data, qsizetype size, bool newlineEnabled)
+{
+    // 普通字节最多 3 个字符；每个换行字节最多再多 3 个字符（"\n[" 与 "]\n"）
+    qsizetype bound = size * 3;
+    if (newlineEnabled) {
+        bound += ByteScan::countCrLf(data, size) * 3;
+    }
+    return bound;
+}
+
+qsizetype HexEncoder::encodeTo(const char *data, qsizetype size, bool newlineEnabled, char16_t *dst)
+{
+    const uchar *src = reinterpret_cast<const uchar *>(data);
+    char16_t *const begin = dst;
+    qsizetype pos = 0;
+
+    while (pos < size) {
+        // 普通字节段（禁用换行时为整个输入）
+        qsizetype end = newlineEnabled ? ByteScan::findCrLf(data, size, pos) : -1;
+        if (end < 0) {
+            end = size;
+        }
+        if (end > pos) {
+            dst = encodeRun(src + pos, end - pos, dst);
+            --dst;  // 去掉段尾多余的空格
+            pos = end;
+        }
+        if (pos >= size) {
+            break;
+        }
+
+        // 连续的 0x0A/0x0D 单独一行显示为 "[0D 0A]"
+        // Requirements: 2.2 - 当启用时插入换行
+        if (dst != begin && dst[-1] != u'\n') {
+            *dst++ = u'\n';
+        }
+        *dst++ = u'[';
+        dst = writeHexPair(src[pos++], dst);
+        while (pos < size && isCrLf(src[pos])) {
+            *dst++ = u' ';
+            dst = writeHexPair(src[pos++], dst);
+        }
+        *dst++ = u']';
+        *dst++ = u'\n';
+    }
+
+    return dst - begin;
+}
+
+QString HexEncoder::encode(QByteArrayView data, bool newlineEnabled)
+{
+    if (data.isEmpty()) {
+        return QString();
+    }
+
+    QString result(maxEncodedSize(data.data(), data.size(), newlineEnabled), Qt::Uninitialized);
+    const qsizetype length = encodeTo(data.data(), data.size(), newlineEnabled,
+                                      reinterpret_cast<char16_t *>(result.data()));
+    result.truncate(length);
+    return result;
+}
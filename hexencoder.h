@@ -0,0 +1,60 @@
+#ifndef HEXENCODER_H
+#define HEXENCODER_H
+
+#include <QByteArrayView>
+#include <QString>
+
+/**
+ * @brief HexEncoder - 十六进制显示编码器
+ *
+ * 将原始字节直接写成 UTF-16 的 "XX XX XX" 形式，不产生任何临时 QString。
+ * 启用换行时，连续的 0x0A/0x0D 单独成行显示为 "[0D 0A]"，规则与原
+ * DataProcessor::toHexString 完全一致。
+ *
+ * 普通字节段的编码路径（16 字节一组）：
+ * - AVX2：pshufb 查表并插入分隔空格，vpmovzxbw 一次展宽 16 个字符；
+ *   未以 -mavx2 编译时由 GCC/Clang 在运行时检测 CPU 后选用
+ * - SSE2（x86-64 基线）：比较加法把半字节转为字符，重叠写入插入空格
+ * - 其他：256 项查找表逐字节写入
+ * 0x0A/0x0D 的定位使用 ByteScan（SSE2）。
+ *
+ * Requirements: 2.2, 2.3, 3.1
+ */
+class HexEncoder
+{
+public:
+    /**
+     * @brief 将字节数组编码为十六进制显示字符串
+     * @param data 原始字节数据
+     * @param newlineEnabled true 时 0x0A/0x0D 触发换行
+     * @return 十六进制字符串
+     */
+    static QString encode(QByteArrayView data, bool newlineEnabled);
+
+    /**
+     * @brief 计算编码结果的长度上限
+     * @param data 原始字节数据
+     * @param size 数据长度
+     * @param newlineEnabled 是否启用 0x0A/0x0D 换行
+     * @return 需要预分配的 UTF-16 字符数
+     */
+    static qsizetype maxEncodedSize(const char *data, qsizetype size, bool newlineEnabled);
+
+    /**
+     * @brief 将字节编码写入调用者预分配的缓冲区
+     *
+     * dst 至少需要 maxEncodedSize() 个字符的空间。
+     *
+     * @param data 数据起始地址
+     * @param size 数据长度
+     * @param newlineEnabled 是否启用 0x0A/0x0D 换行
+     * @param dst 输出缓冲区
+     * @return 实际写入的字符数
+     */
+    static qsizetype encodeTo(const char *data, qsizetype size, bool newlineEnabled, char16_t *dst);
+
+private:
+    HexEncoder() = delete;
+};
+
+#endif // HEXENCODER_H
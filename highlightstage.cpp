@@ -0,0 +1,112 @@
+#include "highlightstage.h"
+#include "keywordhighlighter.h"
+
+/**
+ * @brief HighlightStage 实现
+ */
+
+namespace {
+
+// 一个 UTF-16 单元在 UTF-8 中占用的字节数（代理对的两个单元各计 2 字节）
+inline int utf8Length(char16_t c)
+{
+    if (c < 0x80) {
+        return 1;
+    }
+    if (c < 0x800 || QChar::isSurrogate(c)) {
+        return 2;
+    }
+    return 3;
+}
+
+} // namespace
+
+HighlightStage::HighlightStage(const KeywordHighlighter *highlighter)
+    : m_highlighter(highlighter)
+{
+}
+
+qint32 HighlightStage::feed(QStringView input, QString &text, QVector<HighlightSpan> &spans)
+{
+    const char16_t *s = input.utf16();
+    const qsizetype size = input.size();
+    const qsizetype textStart = text.size();
+    qint32 line = 0;
+
+    text.reserve(text.size() + size);
+
+    qsizetype segment = 0;
+    auto flush = [&](qsizetype end) {
+        if (end > segment) {
+            const QStringView part = input.mid(segment, end - segment);
+            m_openLine.append(part);
+            text.append(part);
+        }
+    };
+    auto breakLine = [&]() {
+        highlightOpenLine(line, spans);
+        text.append(QLatin1Char('\n'));
+        m_openLine.clear();
+        m_openLineBytes = 0;
+        ++line;
+    };
+
+    for (qsizetype i = 0; i < size; ++i) {
+        const char16_t c = s[i];
+        if (c == u'\n' || c == u'\r') {
+            flush(i);
+            segment = i + 1;
+            if (c == u'\n') {
+                breakLine();
+            }
+            continue;
+        }
+
+        // 与 HistoryStore 相同的折断规则：不拆开代理对
+        int bytes = utf8Length(c);
+        if (QChar::isHighSurrogate(c) && i + 1 < size && QChar::isLowSurrogate(s[i + 1])) {
+            bytes = 4;
+        }
+        if (m_openLineBytes + bytes > HistoryStore::MAX_LINE_BYTES) {
+            flush(i);
+            segment = i;
+            breakLine();
+        }
+        m_openLineBytes += bytes;
+        if (bytes == 4) {
+            ++i;
+        }
+    }
+    flush(size);
+
+    // 没有产生任何输出（例如只有 '\r'）时不涉及任何行
+    if (text.size() == textStart) {
+        return 0;
+    }
+
+    highlightOpenLine(line, spans);
+    return line;
+}
+
+void HighlightStage::reset()
+{
+    m_openLine.clear();
+    m_openLineBytes = 0;
+}
+
+void HighlightStage::highlightOpenLine(qint32 line, QVector<HighlightSpan> &spans) const
+{
+    if (!m_highlighter || m_openLine.isEmpty()) {
+        return;
+    }
+
+    const QVector<KeywordMatcher::Match> matches = m_highlighter->match(m_openLine);
+    for (const KeywordMatcher::Match &match : matches) {
+        HighlightSpan span;
+        span.line = line;
+        span.start = static_cast<quint16>(match.start);
+        span.length = static_cast<quint16>(match.length);
+        span.rule = static_cast<quint16>(match.id);
+        spans.append(span);
+    }
+}
@@ -0,0 +1,59 @@
+#ifndef HIGHLIGHTSTAGE_H
+#define HIGHLIGHTSTAGE_H
+
+#include <QString>
+#include <QStringView>
+#include <QVector>
+
+#include "historystore.h"
+
+class KeywordHighlighter;
+
+/**
+ * @brief HighlightStage - 处理线程中的分行与高亮
+ *
+ * 把 DataProcessor 输出的文本按 HistoryStore 的规则分行（丢弃 '\r'，
+ * 超过 MAX_LINE_BYTES 的行在同样的位置折断），并为涉及的每一行计算完整的高亮区间。
+ * 未结束的当前行被保留，下一段文本到来时连同新内容重新匹配（最多一行的长度），
+ * 因此跨批次的关键词也能正确匹配。
+ *
+ * 输出的文本已是 HistoryStore 的行格式，区间行号相对于追加前的最后一行。
+ * 非线程安全，只在处理线程中使用。
+ */
+class HighlightStage
+{
+public:
+    /**
+     * @brief 构造函数
+     * @param highlighter 关键词高亮器（只调用 const 方法）
+     */
+    explicit HighlightStage(const KeywordHighlighter *highlighter);
+
+    /**
+     * @brief 处理一段文本
+     * @param input 处理后的显示文本
+     * @param text 输出：规范化后的文本（追加）
+     * @param spans 输出：涉及各行的高亮区间（追加）
+     * @return 输出文本中的换行数
+     */
+    qint32 feed(QStringView input, QString &text, QVector<HighlightSpan> &spans);
+
+    /**
+     * @brief 丢弃当前行（接收区清空时调用）
+     */
+    void reset();
+
+private:
+    /**
+     * @brief 为当前行计算高亮区间
+     * @param line 相对行号
+     * @param spans 输出区间
+     */
+    void highlightOpenLine(qint32 line, QVector<HighlightSpan> &spans) const;
+
+    const KeywordHighlighter *m_highlighter;   ///< 关键词高亮器
+    QString m_openLine;                        ///< 当前未结束的行
+    qsizetype m_openLineBytes = 0;             ///< 当前行的 UTF-8 字节数
+};
+
+#endif // HIGHLIGHTSTAGE_H
@@ -0,0 +1,474 @@
+#include "historysearch.h"
+#include "bytescan.h"
+
+#include <QMutexLocker>
+#include <QThread>
+#include <QTimer>
+#include <algorithm>
+#include <cstring>
+
+/**
+ * @brief HistorySearch 实现
+ */
+
+namespace {
+
+constexpr int COLLECT_INTERVAL_MS = 50;                   ///< 仍有任务时两次合并的最小间隔
+constexpr qsizetype CANCEL_CHECK_BYTES = 1 << 20;         ///< 按字节查找时检查取消的间隔
+constexpr qsizetype CANCEL_CHECK_LINES = 256;             ///< 逐行匹配时检查取消的间隔
+
+} // namespace
+
+HistorySearch::HistorySearch(QObject *parent)
+    : QObject(parent)
+{
+}
+
+HistorySearch::~HistorySearch()
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        m_quit = true;
+        ++m_generation;
+        m_wake.wakeAll();
+    }
+    for (const std::unique_ptr<QThread> &thread : m_threads) {
+        thread->wait();
+    }
+}
+
+bool HistorySearch::start(const SearchQuery &query, const HistoryStore &store, QString *error)
+{
+    if (!query.isValid()) {
+        if (error) {
+            *error = query.validationError();
+        }
+        return false;
+    }
+
+    cancel();
+
+    auto matcher = std::make_shared<Matcher>();
+    matcher->literal = query.isLiteral();
+    if (matcher->literal) {
+        matcher->foldCase = !query.caseSensitive;
+        matcher->needle = matcher->foldCase ? query.text.toUtf8().toLower() : query.text.toUtf8();
+        matcher->needleLength = static_cast<qint32>(query.text.size());
+    } else {
+        matcher->expression = query.toRegularExpression();
+        matcher->expression.optimize();
+    }
+    m_matcher = std::move(matcher);
+    m_query = query;
+    m_active = true;
+    m_firstLine = store.firstLineNumber();
+    m_searchedUntil = m_firstLine;
+
+    if (m_threads.empty()) {
+        const int count = qBound(1, QThread::idealThreadCount(), MAX_THREADS);
+        for (int i = 0; i < count; ++i) {
+            m_threads.emplace_back(QThread::create([this]() { workerLoop(); }));
+            m_threads.back()->setObjectName("SSW-search");
+            m_threads.back()->start();
+        }
+    }
+
+    enqueue(store);
+    searchOpenLine(store);
+    emit hitsChanged();
+    if (error) {
+        error->clear();
+    }
+    return true;
+}
+
+void HistorySearch::update(const HistoryStore &store)
+{
+    if (!m_active) {
+        return;
+    }
+
+    // 最旧的块被丢弃（或历史被清空）后，其中的匹配不再有效
+    m_firstLine = store.firstLineNumber();
+    if (!m_hits.empty() && m_hits.front().line < m_firstLine) {
+        const SearchHit first{m_firstLine, 0, 0};
+        m_hits.erase(m_hits.begin(), std::lower_bound(m_hits.begin(), m_hits.end(), first));
+        m_openHits = qMin(m_openHits, qsizetype(m_hits.size()));
+        emit hitsChanged();
+    }
+    m_searchedUntil = qMax(m_searchedUntil, m_firstLine);
+    enqueue(store);
+    searchOpenLine(store);
+}
+
+void HistorySearch::cancel()
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        // 正在执行的任务看到新的代号后放弃，结果也不会再合并
+        ++m_generation;
+        m_jobs.clear();
+        m_pending.clear();
+        m_outstanding = 0;
+        m_collectQueued = false;
+    }
+    m_found = 0;
+    m_matcher.reset();
+    m_active = false;
+    m_searching = false;
+    m_truncated = false;
+    m_hits.clear();
+    m_hits.shrink_to_fit();
+    m_hasCurrent = false;
+    m_openLine = -1;
+    m_openLineSize = -1;
+    m_openHits = 0;
+}
+
+bool HistorySearch::isActive() const
+{
+    return m_active;
+}
+
+bool HistorySearch::isSearching() const
+{
+    return m_searching;
+}
+
+SearchQuery HistorySearch::query() const
+{
+    return m_query;
+}
+
+qsizetype HistorySearch::hitCount() const
+{
+    return qsizetype(m_hits.size());
+}
+
+bool HistorySearch::isTruncated() const
+{
+    return m_truncated;
+}
+
+qsizetype HistorySearch::currentIndex() const
+{
+    if (!m_hasCurrent) {
+        return -1;
+    }
+    const auto it = std::lower_bound(m_hits.begin(), m_hits.end(), m_current);
+    return it != m_hits.end() && *it == m_current ? qsizetype(it - m_hits.begin()) : -1;
+}
+
+bool HistorySearch::next(SearchHit *hit)
+{
+    if (m_hits.empty()) {
+        return false;
+    }
+    auto it = m_hasCurrent ? std::upper_bound(m_hits.begin(), m_hits.end(), m_current) : m_hits.begin();
+    if (it == m_hits.end()) {
+        it = m_hits.begin();
+    }
+    m_current = *it;
+    m_hasCurrent = true;
+    *hit = m_current;
+    return true;
+}
+
+bool HistorySearch::previous(SearchHit *hit)
+{
+    if (m_hits.empty()) {
+        return false;
+    }
+    auto it = m_hasCurrent ? std::lower_bound(m_hits.begin(), m_hits.end(), m_current) : m_hits.end();
+    if (it == m_hits.begin()) {
+        it = m_hits.end();
+    }
+    --it;
+    m_current = *it;
+    m_hasCurrent = true;
+    *hit = m_current;
+    return true;
+}
+
+void HistorySearch::enqueue(const HistoryStore &store)
+{
+    // 最后一行可能还在追加，等它结束后再搜索
+    const qint64 complete = store.firstLineNumber() + store.lineCount() - 1;
+    if (complete <= m_searchedUntil) {
+        return;
+    }
+    std::vector<HistoryStore::Block> blocks = store.snapshot(m_searchedUntil, complete);
+    m_searchedUntil = complete;
+    if (blocks.empty()) {
+        return;
+    }
+
+    {
+        QMutexLocker locker(&m_mutex);
+        const quint64 generation = m_generation.load();
+        for (HistoryStore::Block &block : blocks) {
+            Job job;
+            job.generation = generation;
+            job.block = std::move(block);
+            job.matcher = m_matcher;
+            m_jobs.push_back(std::move(job));
+        }
+        m_outstanding += int(blocks.size());
+        m_wake.wakeAll();
+    }
+
+    if (!m_searching) {
+        m_searching = true;
+        emit hitsChanged();
+    }
+}
+
+void HistorySearch::searchOpenLine(const HistoryStore &store)
+{
+    const qsizetype count = store.lineCount();
+    const qint64 line = store.firstLineNumber() + count - 1;
+    const QString text = count > 0 ? store.line(count - 1) : QString();
+    if (line == m_openLine && text.size() == m_openLineSize) {
+        return;
+    }
+
+    // 行只会变长或结束：重新搜索，替换上次的匹配（结束的行已由 enqueue() 交给搜索线程）
+    bool changed = removeOpenHits();
+    m_openLine = line;
+    m_openLineSize = text.size();
+    if (!text.isEmpty()) {
+        Job job;
+        job.generation = m_generation.load();
+        job.block.firstLine = line;
+        job.block.data = text.toUtf8();
+        job.block.lineStarts.append(0);
+        job.matcher = m_matcher;
+
+        std::vector<SearchHit> hits;
+        searchBlock(job, hits);
+        // 其余匹配都在前面的行上，追加后仍然有序
+        m_hits.insert(m_hits.end(), hits.begin(), hits.end());
+        m_openHits = qsizetype(hits.size());
+        changed |= !hits.empty();
+    }
+
+    if (changed) {
+        m_truncated = m_found.load(std::memory_order_relaxed) >= MAX_HITS;
+        emit hitsChanged();
+    }
+}
+
+bool HistorySearch::removeOpenHits()
+{
+    if (m_openHits == 0) {
+        return false;
+    }
+    m_hits.erase(m_hits.end() - m_openHits, m_hits.end());
+    m_found.fetch_sub(m_openHits, std::memory_order_relaxed);
+    m_openHits = 0;
+    return true;
+}
+
+void HistorySearch::workerLoop()
+{
+    // 此方法在搜索线程中执行
+    for (;;) {
+        Job job;
+        {
+            QMutexLocker locker(&m_mutex);
+            while (!m_quit && m_jobs.empty()) {
+                m_wake.wait(&m_mutex);
+            }
+            if (m_quit) {
+                return;
+            }
+            job = std::move(m_jobs.front());
+            m_jobs.pop_front();
+        }
+
+        std::vector<SearchHit> hits;
+        searchBlock(job, hits);
+
+        bool notify = false;
+        {
+            QMutexLocker locker(&m_mutex);
+            // 代号在持锁时比较，与 cancel() 互斥
+            if (job.generation != m_generation.load()) {
+                continue;
+            }
+            m_pending.insert(m_pending.end(), hits.begin(), hits.end());
+            --m_outstanding;
+            notify = !m_collectQueued;
+            m_collectQueued = true;
+        }
+        if (notify) {
+            QMetaObject::invokeMethod(this, [this]() { collect(); }, Qt::QueuedConnection);
+        }
+    }
+}
+
+bool HistorySearch::searchBlock(const Job &job, std::vector<SearchHit> &hits)
+{
+    const HistoryStore::Block &block = job.block;
+    const Matcher &matcher = *job.matcher;
+    const char *data = block.data.constData();
+    const qsizetype size = block.data.size();
+    const qsizetype lines = block.lineStarts.size();
+
+    auto lineEnd = [&](qsizetype line) {
+        return line + 1 < lines ? qsizetype(block.lineStarts.at(line + 1)) : size;
+    };
+    auto cancelled = [&]() {
+        return m_generation.load(std::memory_order_relaxed) != job.generation;
+    };
+    auto addHit = [&](qsizetype line, qsizetype start, qsizetype length) {
+        if (m_found.fetch_add(1, std::memory_order_relaxed) >= MAX_HITS) {
+            return false;
+        }
+        hits.push_back(SearchHit{block.firstLine + line, qint32(start), qint32(length)});
+        return true;
+    };
+
+    if (matcher.literal) {
+        // 块内各行首尾相接存放（无换行符），整块一次扫描，再排除跨行的匹配
+        const char *needle = matcher.needle.constData();
+        const qsizetype needleSize = matcher.needle.size();
+        const qsizetype limit = size - needleSize + 1;    // 匹配起点的上界（不含）
+
+        // 首字节的候选位置；忽略大小写且首字节是字母时，大小写两种形式各自查找并缓存结果
+        const char first = needle[0];
+        const bool twoCases = matcher.foldCase && first >= 'a' && first <= 'z';
+        const char firstUpper = twoCases ? char(first - 'a' + 'A') : first;
+        auto scan = [&](char c, qsizetype from) -> qsizetype {
+            const void *found = std::memchr(data + from, c, size_t(limit - from));
+            return found ? static_cast<const char *>(found) - data : -1;
+        };
+        qsizetype nextLower = -2;    // -2 为尚未查找，-1 为之后没有
+        qsizetype nextUpper = -2;
+        auto findFirst = [&](qsizetype from) -> qsizetype {
+            if (nextLower != -1 && nextLower < from) {
+                nextLower = scan(first, from);
+            }
+            if (!twoCases) {
+                return nextLower;
+            }
+            if (nextUpper != -1 && nextUpper < from) {
+                nextUpper = scan(firstUpper, from);
+            }
+            if (nextLower < 0 || nextUpper < 0) {
+                return qMax(nextLower, nextUpper);
+            }
+            return qMin(nextLower, nextUpper);
+        };
+        auto matchesRest = [&](qsizetype at) {
+            if (!matcher.foldCase) {
+                return std::memcmp(data + at + 1, needle + 1, size_t(needleSize - 1)) == 0;
+            }
+            for (qsizetype i = 1; i < needleSize; ++i) {
+                uchar c = uchar(data[at + i]);
+                if (c >= 'A' && c <= 'Z') {
+                    c = uchar(c - 'A' + 'a');
+                }
+                if (c != uchar(needle[i])) {
+                    return false;
+                }
+            }
+            return true;
+        };
+
+        qsizetype line = 0;
+        qsizetype pos = 0;
+        qsizetype checked = 0;
+        while (pos < limit) {
+            if (pos - checked >= CANCEL_CHECK_BYTES) {
+                if (cancelled()) {
+                    return false;
+                }
+                checked = pos;
+            }
+
+            const qsizetype at = findFirst(pos);
+            if (at < 0) {
+                break;
+            }
+            if (!matchesRest(at)) {
+                pos = at + 1;
+                continue;
+            }
+
+            // 匹配位置递增，所在行只会向后推进
+            while (line + 1 < lines && qsizetype(block.lineStarts.at(line + 1)) <= at) {
+                ++line;
+            }
+            if (at + needleSize > lineEnd(line)) {
+                pos = at + 1;
+                continue;
+            }
+
+            const qsizetype lineStart = block.lineStarts.at(line);
+            const char *prefix = data + lineStart;
+            const qsizetype prefixSize = at - lineStart;
+            const qsizetype column = ByteScan::isAscii(prefix, prefixSize)
+                ? prefixSize
+                : QString::fromUtf8(prefix, prefixSize).size();
+            if (!addHit(line, column, matcher.needleLength)) {
+                break;
+            }
+            pos = at + needleSize;
+        }
+        return true;
+    }
+
+    for (qsizetype line = 0; line < lines; ++line) {
+        if (line % CANCEL_CHECK_LINES == 0 && cancelled()) {
+            return false;
+        }
+        const qsizetype start = block.lineStarts.at(line);
+        const QString text = QString::fromUtf8(data + start, lineEnd(line) - start);
+        QRegularExpressionMatchIterator it = matcher.expression.globalMatch(text);
+        while (it.hasNext()) {
+            const QRegularExpressionMatch match = it.next();
+            if (match.capturedLength() == 0) {
+                continue;
+            }
+            if (!addHit(line, match.capturedStart(), match.capturedLength())) {
+                return true;
+            }
+        }
+    }
+    return true;
+}
+
+void HistorySearch::collect()
+{
+    std::vector<SearchHit> pending;
+    bool searching = false;
+    {
+        QMutexLocker locker(&m_mutex);
+        // 还有任务时限制合并频率：每次合并都要移动已合并的匹配
+        if (m_outstanding > 0 && m_lastCollect.isValid() && m_lastCollect.elapsed() < COLLECT_INTERVAL_MS) {
+            QTimer::singleShot(COLLECT_INTERVAL_MS - int(m_lastCollect.elapsed()), this, [this]() { collect(); });
+            return;
+        }
+        pending.swap(m_pending);
+        searching = m_outstanding > 0;
+        m_collectQueued = false;
+    }
+    m_lastCollect.restart();
+
+    if (!m_active) {
+        return;
+    }
+
+    // 各块完成的顺序不定，排序后与已有结果归并
+    std::sort(pending.begin(), pending.end());
+    const SearchHit first{m_firstLine, 0, 0};
+    pending.erase(pending.begin(), std::lower_bound(pending.begin(), pending.end(), first));
+    const auto middle = m_hits.size();
+    m_hits.insert(m_hits.end(), pending.begin(), pending.end());
+    std::inplace_merge(m_hits.begin(), m_hits.begin() + middle, m_hits.end());
+
+    m_truncated = m_found.load(std::memory_order_relaxed) >= MAX_HITS;
+    m_searching = searching;
+    emit hitsChanged();
+}
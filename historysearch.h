@@ -0,0 +1,232 @@
+#ifndef HISTORYSEARCH_H
+#define HISTORYSEARCH_H
+
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QObject>
+#include <QRegularExpression>
+#include <QWaitCondition>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "historystore.h"
+#include "searchquery.h"
+
+class QThread;
+
+/**
+ * @brief SearchHit - 一处匹配
+ */
+struct SearchHit {
+    qint64 line = 0;     ///< 绝对行号（同 HistoryStore）
+    qint32 start = 0;    ///< 行内起始位置（UTF-16）
+    qint32 length = 0;   ///< 长度（UTF-16）
+
+    bool operator<(const SearchHit &other) const {
+        return line < other.line || (line == other.line && start < other.start);
+    }
+    bool operator==(const SearchHit &other) const {
+        return line == other.line && start == other.start;
+    }
+};
+
+/**
+ * @brief HistorySearch - 接收历史的并行搜索
+ *
+ * 开始搜索时对 HistoryStore 取快照（已写满的块隐式共享，不拷贝），每块一个任务，
+ * 由常驻的搜索线程并行扫描；结果分批送回 UI 线程并按行号合并，可以边搜索边浏览。
+ *
+ * - 普通文本直接在 UTF-8 字节上查找：memchr 定位首字节（SIMD 实现），再比较其余字节，
+ *   跨行的匹配被排除。不区分大小写时分别查找首字母的大小写两种形式，按 ASCII 规则折叠比较。
+ * - 正则表达式，以及含有非 ASCII 字母的不区分大小写文本，逐行解码后用 QRegularExpression 匹配。
+ * - 搜索期间接收继续：update() 把之后追加的完整行作为新任务加入；已被丢弃的行上的匹配随之移除。
+ * - 最后一行（尚未收到换行符，例如提示符或中途停止的输出）在 UI 线程中直接搜索
+ *   （不超过 HistoryStore::MAX_LINE_BYTES），内容变化后重新搜索并替换它的匹配，
+ *   该行结束后再作为完整行交给搜索线程。
+ * - 匹配数超过 MAX_HITS 后停止记录。
+ *
+ * 在 UI 线程中创建和使用。
+ */
+class HistorySearch : public QObject
+{
+    Q_OBJECT
+
+public:
+    static constexpr int MAX_THREADS = 8;                   ///< 搜索线程数上限
+    static constexpr qsizetype MAX_HITS = 1000000;          ///< 最多记录的匹配数
+
+    /**
+     * @brief 构造函数
+     * @param parent 父对象
+     */
+    explicit HistorySearch(QObject *parent = nullptr);
+
+    /**
+     * @brief 析构函数（停止搜索线程）
+     */
+    ~HistorySearch();
+
+    /**
+     * @brief 开始新的搜索（取消之前的搜索）
+     * @param query 搜索条件
+     * @param store 接收历史
+     * @param error 条件无效时写入错误描述，可为 nullptr
+     * @return true 如果已开始
+     */
+    bool start(const SearchQuery &query, const HistoryStore &store, QString *error = nullptr);
+
+    /**
+     * @brief 搜索上次之后追加的完整行，并移除已被丢弃的行上的匹配
+     * @param store 接收历史
+     */
+    void update(const HistoryStore &store);
+
+    /**
+     * @brief 取消搜索并清除结果
+     */
+    void cancel();
+
+    /**
+     * @brief 是否有生效的搜索条件
+     * @return true 如果已开始且未取消
+     */
+    bool isActive() const;
+
+    /**
+     * @brief 是否还有未完成的任务
+     * @return true 如果仍在搜索
+     */
+    bool isSearching() const;
+
+    /**
+     * @brief 获取当前搜索条件
+     * @return 搜索条件
+     */
+    SearchQuery query() const;
+
+    /**
+     * @brief 获取已合并的匹配数
+     * @return 匹配数
+     */
+    qsizetype hitCount() const;
+
+    /**
+     * @brief 匹配数是否达到上限（之后的匹配未记录）
+     * @return true 如果已截断
+     */
+    bool isTruncated() const;
+
+    /**
+     * @brief 获取当前匹配的序号
+     * @return 0 起的序号，未定位过时返回 -1
+     */
+    qsizetype currentIndex() const;
+
+    /**
+     * @brief 定位到下一处匹配（到末尾后回到第一处）
+     * @param hit 输出匹配
+     * @return false 如果没有匹配
+     */
+    bool next(SearchHit *hit);
+
+    /**
+     * @brief 定位到上一处匹配（到开头后回到最后一处）
+     * @param hit 输出匹配
+     * @return false 如果没有匹配
+     */
+    bool previous(SearchHit *hit);
+
+signals:
+    /**
+     * @brief 匹配数或搜索状态改变
+     */
+    void hitsChanged();
+
+private:
+    /**
+     * @brief 编译后的搜索条件（各任务共享，只读）
+     */
+    struct Matcher {
+        bool literal = false;           ///< 按字节查找
+        bool foldCase = false;          ///< 按 ASCII 规则忽略大小写（literal）
+        QByteArray needle;              ///< UTF-8 搜索文本（literal，foldCase 时为小写）
+        qint32 needleLength = 0;        ///< 搜索文本的 UTF-16 长度（literal）
+        QRegularExpression expression;  ///< 正则表达式（非 literal）
+    };
+
+    /**
+     * @brief 搜索任务：一段连续行
+     */
+    struct Job {
+        quint64 generation = 0;                   ///< 所属的搜索
+        HistoryStore::Block block;                ///< 行快照
+        std::shared_ptr<const Matcher> matcher;   ///< 搜索条件
+    };
+
+    /**
+     * @brief 把 [m_searchedUntil, 最后一个完整行] 加入任务队列
+     */
+    void enqueue(const HistoryStore &store);
+
+    /**
+     * @brief 搜索最后一行（未结束），替换该行之前的匹配
+     */
+    void searchOpenLine(const HistoryStore &store);
+
+    /**
+     * @brief 移除最后一行上的匹配（位于 m_hits 末尾）
+     * @return true 如果移除了匹配
+     */
+    bool removeOpenHits();
+
+    /**
+     * @brief 搜索线程主循环
+     */
+    void workerLoop();
+
+    /**
+     * @brief 在一段行中搜索
+     * @param job 任务
+     * @param hits 输出匹配
+     * @return false 如果搜索已被取消
+     */
+    bool searchBlock(const Job &job, std::vector<SearchHit> &hits);
+
+    /**
+     * @brief 取走搜索线程送回的匹配并合并（UI 线程）
+     */
+    void collect();
+
+    std::vector<std::unique_ptr<QThread>> m_threads;    ///< 常驻搜索线程（第一次搜索时启动）
+
+    mutable QMutex m_mutex;                  ///< 保护以下共享状态
+    QWaitCondition m_wake;                   ///< 有新任务或要求退出
+    std::deque<Job> m_jobs;                  ///< 待执行的任务
+    std::vector<SearchHit> m_pending;        ///< 已找到、尚未合并的匹配
+    int m_outstanding = 0;                   ///< 当前搜索未完成的任务数
+    bool m_collectQueued = false;            ///< 已请求 UI 线程合并
+    bool m_quit = false;                     ///< 要求搜索线程退出
+
+    std::atomic<quint64> m_generation{0};    ///< 每次开始或取消搜索时递增
+    std::atomic<qsizetype> m_found{0};       ///< 当前搜索已找到的匹配数
+
+    // 以下只在 UI 线程中访问
+    SearchQuery m_query;                     ///< 当前搜索条件
+    std::shared_ptr<const Matcher> m_matcher;
+    bool m_active = false;
+    bool m_searching = false;
+    bool m_truncated = false;
+    qint64 m_searchedUntil = 0;              ///< 已加入任务的行（不含）
+    qint64 m_firstLine = 0;                  ///< 历史中第一行的行号，更早的匹配已无效
+    QElapsedTimer m_lastCollect;             ///< 上一次合并的时间
+    std::vector<SearchHit> m_hits;           ///< 已合并的匹配（按位置排序）
+    qint64 m_openLine = -1;                  ///< 上次搜索的未结束行的行号
+    qsizetype m_openLineSize = -1;           ///< 该行当时的长度
+    qsizetype m_openHits = 0;                ///< 该行的匹配数（位于 m_hits 末尾）
+    SearchHit m_current;                     ///< 当前定位的匹配
+    bool m_hasCurrent = false;
+};
+
+#endif // HISTORYSEARCH_H
@@ -0,0 +1,254 @@
+#include "historystore.h"
+#include "bytescan.h"
+
+#include <algorithm>
+
+/**
+ * @brief HistoryStore 实现
+ */
+
+namespace {
+
+template <typename Chunk>
+inline qint64 chunkBytes(const Chunk &chunk)
+{
+    return chunk.data.size() + chunk.lineStarts.size() * qint64(sizeof(quint32))
+         + chunk.spans.size() * qint64(sizeof(HighlightSpan));
+}
+
+} // namespace
+
+HistoryStore::HistoryStore(qint64 maxBytes)
+    : m_maxBytes(maxBytes > 0 ? maxBytes : qint64(512) << 20)
+{
+    startChunk(0);
+}
+
+void HistoryStore::startChunk(qint64 firstLine)
+{
+    if (!m_chunks.empty()) {
+        const Chunk &last = m_chunks.back();
+        m_sealedBytes += chunkBytes(last);
+    }
+
+    Chunk chunk;
+    chunk.firstLine = firstLine;
+    chunk.data.reserve(CHUNK_SIZE + MAX_LINE_BYTES);
+    chunk.lineStarts.append(0);
+    m_chunks.push_back(std::move(chunk));
+}
+
+void HistoryStore::append(QStringView text, const QVector<HighlightSpan> &spans, bool replaceOpenLine)
+{
+    if (text.isEmpty()) {
+        return;
+    }
+
+    // 当前行的区间由本次给出的完整集合替换
+    const qint64 baseLine = firstLineNumber() + lineCount() - 1;
+    Chunk &open = m_chunks.back();
+    const qint32 openLocal = static_cast<qint32>(baseLine - open.firstLine);
+    while (replaceOpenLine && !open.spans.isEmpty() && open.spans.last().line == openLocal) {
+        open.spans.removeLast();
+    }
+
+    const QByteArray utf8 = text.toUtf8();
+    const char *data = utf8.constData();
+    const qsizetype size = utf8.size();
+
+    qsizetype pos = 0;
+    while (pos < size) {
+        qsizetype next = ByteScan::findCrLf(data, size, pos);
+        if (next < 0) {
+            next = size;
+        }
+        if (next > pos) {
+            appendToOpenLine(data + pos, next - pos);
+        }
+        if (next < size && data[next] == '\n') {
+            newLine();
+        }
+        // '\r' 直接丢弃
+        pos = next + 1;
+    }
+
+    storeSpans(spans, baseLine);
+    trim();
+}
+
+void HistoryStore::storeSpans(const QVector<HighlightSpan> &spans, qint64 baseLine)
+{
+    // 新行只会落在最后几块中，从后向前找
+    auto it = m_chunks.end() - 1;
+    for (const HighlightSpan &span : spans) {
+        const qint64 absolute = baseLine + span.line;
+        while (it != m_chunks.begin() && absolute < it->firstLine) {
+            --it;
+        }
+        if (absolute < it->firstLine || absolute >= it->firstLine + it->lineStarts.size()) {
+            continue;
+        }
+
+        HighlightSpan stored = span;
+        stored.line = static_cast<qint32>(absolute - it->firstLine);
+        it->spans.append(stored);
+        if (it != m_chunks.end() - 1) {
+            m_sealedBytes += sizeof(HighlightSpan);
+        }
+    }
+}
+
+void HistoryStore::appendToOpenLine(const char *data, qsizetype size)
+{
+    while (size > 0) {
+        Chunk &chunk = m_chunks.back();
+        const qsizetype lineLength = chunk.data.size() - chunk.lineStarts.last();
+        qsizetype take = qMin(size, MAX_LINE_BYTES - lineLength);
+
+        // 不在 UTF-8 多字节字符中间折断
+        if (take < size) {
+            while (take > 0 && (static_cast<uchar>(data[take]) & 0xC0) == 0x80) {
+                --take;
+            }
+        }
+        if (take <= 0) {
+            newLine();
+            continue;
+        }
+
+        chunk.data.append(data, take);
+        data += take;
+        size -= take;
+    }
+}
+
+void HistoryStore::newLine()
+{
+    Chunk &chunk = m_chunks.back();
+    if (chunk.data.size() >= CHUNK_SIZE) {
+        startChunk(chunk.firstLine + chunk.lineStarts.size());
+        return;
+    }
+    chunk.lineStarts.append(static_cast<quint32>(chunk.data.size()));
+}
+
+void HistoryStore::trim()
+{
+    while (m_chunks.size() > 1 && byteSize() > m_maxBytes) {
+        const Chunk &front = m_chunks.front();
+        m_sealedBytes -= chunkBytes(front);
+        m_chunks.pop_front();
+    }
+}
+
+void HistoryStore::clear()
+{
+    const qint64 nextLine = firstLineNumber() + lineCount();
+    m_chunks.clear();
+    m_sealedBytes = 0;
+    startChunk(nextLine);
+}
+
+qsizetype HistoryStore::lineCount() const
+{
+    const Chunk &last = m_chunks.back();
+    return static_cast<qsizetype>(last.firstLine + last.lineStarts.size() - m_chunks.front().firstLine);
+}
+
+qint64 HistoryStore::firstLineNumber() const
+{
+    return m_chunks.front().firstLine;
+}
+
+const HistoryStore::Chunk &HistoryStore::chunkFor(qsizetype index, qsizetype *lineInChunk) const
+{
+    const qint64 absolute = m_chunks.front().firstLine + index;
+    auto it = std::upper_bound(m_chunks.begin(), m_chunks.end(), absolute,
+                               [](qint64 line, const Chunk &chunk) { return line < chunk.firstLine; });
+    const Chunk &chunk = *(it - 1);
+    *lineInChunk = static_cast<qsizetype>(absolute - chunk.firstLine);
+    return chunk;
+}
+
+QByteArrayView HistoryStore::lineBytes(qsizetype index) const
+{
+    if (index < 0 || index >= lineCount()) {
+        return QByteArrayView();
+    }
+
+    qsizetype local = 0;
+    const Chunk &chunk = chunkFor(index, &local);
+    const qsizetype start = chunk.lineStarts.at(local);
+    const qsizetype end = (local + 1 < chunk.lineStarts.size())
+        ? qsizetype(chunk.lineStarts.at(local + 1))
+        : chunk.data.size();
+    return QByteArrayView(chunk.data.constData() + start, end - start);
+}
+
+QVector<HighlightSpan> HistoryStore::lineSpans(qsizetype index) const
+{
+    QVector<HighlightSpan> result;
+    if (index < 0 || index >= lineCount()) {
+        return result;
+    }
+
+    qsizetype local = 0;
+    const Chunk &chunk = chunkFor(index, &local);
+    auto first = std::lower_bound(chunk.spans.begin(), chunk.spans.end(), local,
+                                  [](const HighlightSpan &span, qsizetype line) { return span.line < line; });
+    for (auto it = first; it != chunk.spans.end() && it->line == local; ++it) {
+        result.append(*it);
+    }
+    return result;
+}
+
+std::vector<HistoryStore::Block> HistoryStore::snapshot(qint64 fromLine, qint64 toLine) const
+{
+    std::vector<Block> blocks;
+    for (const Chunk &chunk : m_chunks) {
+        const qint64 chunkEnd = chunk.firstLine + chunk.lineStarts.size();
+        if (chunkEnd <= fromLine || chunk.firstLine >= toLine) {
+            continue;
+        }
+
+        const qsizetype first = static_cast<qsizetype>(qMax(fromLine, chunk.firstLine) - chunk.firstLine);
+        const qsizetype last = static_cast<qsizetype>(qMin(toLine, chunkEnd) - chunk.firstLine);
+        Block block;
+        block.firstLine = chunk.firstLine + first;
+        if (&chunk != &m_chunks.back() && first == 0 && last == chunk.lineStarts.size()) {
+            // 已写满的块不再改变，直接共享
+            block.data = chunk.data;
+            block.lineStarts = chunk.lineStarts;
+        } else {
+            const qsizetype start = chunk.lineStarts.at(first);
+            const qsizetype end = last < chunk.lineStarts.size() ? qsizetype(chunk.lineStarts.at(last))
+                                                                 : chunk.data.size();
+            block.data = QByteArray(chunk.data.constData() + start, end - start);
+            block.lineStarts.reserve(last - first);
+            for (qsizetype i = first; i < last; ++i) {
+                block.lineStarts.append(static_cast<quint32>(chunk.lineStarts.at(i) - start));
+            }
+        }
+        blocks.push_back(std::move(block));
+    }
+    return blocks;
+}
+
+QString HistoryStore::line(qsizetype index) const
+{
+    return QString::fromUtf8(lineBytes(index));
+}
+
+qint64 HistoryStore::byteSize() const
+{
+    const Chunk &last = m_chunks.back();
+    return m_sealedBytes + chunkBytes(last);
+}
+
+void HistoryStore::setMaxBytes(qint64 maxBytes)
+{
+    if (maxBytes > 0) {
+        m_maxBytes = maxBytes;
+        trim();
+    }
+}
@@ -0,0 +1,178 @@
+#ifndef HISTORYSTORE_H
+#define HISTORYSTORE_H
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QString>
+#include <QVector>
+#include <deque>
+#include <vector>
+
+#include "linesource.h"
+
+/**
+ * @brief HistoryStore - 接收历史的分块存储
+ *
+ * 只追加的紧凑存储：显示文本以 UTF-8 保存在约 1 MiB 的块中，
+ * 每块额外保存各行的起始偏移（每行 4 字节），行不跨块。
+ * 超过内存上限时整块丢弃最旧的数据，行号按绝对值递增，不需要重新编号。
+ *
+ * 行以 '\n' 分隔，'\r' 被丢弃；超过 MAX_LINE_BYTES 的行会被强制折断，
+ * 保证显示一行的代价有上限。最后一行为当前未结束的行，可以继续追加。
+ * 每块还保存该块各行的高亮区间（按行排序）。
+ *
+ * 非线程安全，只在 UI 线程中使用。
+ */
+class HistoryStore : public LineSource
+{
+public:
+    static constexpr qsizetype CHUNK_SIZE = 1 << 20;     ///< 单块目标大小（字节）
+    static constexpr qsizetype MAX_LINE_BYTES = 1024;    ///< 单行最大字节数，超过则折断
+
+    /**
+     * @brief 一段连续行的只读快照
+     *
+     * 已写满的块与存储隐式共享（不拷贝），当前块只拷贝所需的行；
+     * 快照不随之后的追加和丢弃改变，可以交给其他线程读取。
+     */
+    struct Block {
+        qint64 firstLine = 0;          ///< 第一行的绝对行号
+        QByteArray data;               ///< 行文本（UTF-8，无换行符）
+        QVector<quint32> lineStarts;   ///< 每行在 data 中的起始偏移
+    };
+
+    /**
+     * @brief 构造函数
+     * @param maxBytes 内存上限（字节），超过后丢弃最旧的块
+     */
+    explicit HistoryStore(qint64 maxBytes = qint64(512) << 20);
+
+    /**
+     * @brief 追加文本
+     *
+     * spans 中的行号相对于追加前的最后一行（0 为该行），按行排序；
+     * 出现的每一行都给出完整的区间集合，因此第 0 行原有的区间会被替换，
+     * 除非 replaceOpenLine 为 false（第 0 行的区间未知，保留原有的）。
+     *
+     * @param text 要追加的显示文本
+     * @param spans 文本涉及各行的高亮区间
+     * @param replaceOpenLine 是否替换第 0 行原有的区间
+     */
+    void append(QStringView text, const QVector<HighlightSpan> &spans = {}, bool replaceOpenLine = true);
+
+    /**
+     * @brief 清空所有历史
+     */
+    void clear();
+
+    /**
+     * @brief 获取行数（至少为 1，最后一行可能为空）
+     * @return 当前保存的行数
+     */
+    qsizetype lineCount() const override;
+
+    /**
+     * @brief 获取第一行的绝对行号
+     *
+     * 每次丢弃最旧的块后增加，用于在裁剪后保持选区和滚动位置。
+     *
+     * @return 第一行的绝对行号
+     */
+    qint64 firstLineNumber() const override;
+
+    /**
+     * @brief 获取一行的文本
+     * @param index 行下标（0 ~ lineCount()-1）
+     * @return 行文本（不含换行符）
+     */
+    QString line(qsizetype index) const override;
+
+    /**
+     * @brief 获取一行的 UTF-8 原始字节
+     *
+     * 返回的视图在下一次 append()/clear() 之前有效。
+     *
+     * @param index 行下标（0 ~ lineCount()-1）
+     * @return 行字节
+     */
+    QByteArrayView lineBytes(qsizetype index) const;
+
+    /**
+     * @brief 获取一行的高亮区间
+     * @param index 行下标（0 ~ lineCount()-1）
+     * @return 高亮区间，按规则优先级排序
+     */
+    QVector<HighlightSpan> lineSpans(qsizetype index) const override;
+
+    /**
+     * @brief 获取 [fromLine, toLine) 之间各行的快照（每块一段）
+     * @param fromLine 起始绝对行号
+     * @param toLine 结束绝对行号（不含）
+     * @return 按行号排序的快照，已被丢弃的行不包含在内
+     */
+    std::vector<Block> snapshot(qint64 fromLine, qint64 toLine) const;
+
+    /**
+     * @brief 获取当前占用的字节数（文本、行索引与高亮区间）
+     * @return 占用字节数
+     */
+    qint64 byteSize() const;
+
+    /**
+     * @brief 设置内存上限
+     * @param maxBytes 内存上限（字节）
+     */
+    void setMaxBytes(qint64 maxBytes);
+
+private:
+    /**
+     * @brief 数据块
+     */
+    struct Chunk {
+        qint64 firstLine = 0;          ///< 块内第一行的绝对行号
+        QByteArray data;               ///< 行文本（UTF-8，无换行符）
+        QVector<quint32> lineStarts;   ///< 每行在 data 中的起始偏移
+        QVector<HighlightSpan> spans;  ///< 高亮区间（line 为块内行下标，按行排序）
+    };
+
+    /**
+     * @brief 向当前行追加不含换行符的字节，必要时折断超长行
+     */
+    void appendToOpenLine(const char *data, qsizetype size);
+
+    /**
+     * @brief 结束当前行并开始新行，当前块已满时新建块
+     */
+    void newLine();
+
+    /**
+     * @brief 新建一个空块，其第一行从 firstLine 开始
+     */
+    void startChunk(qint64 firstLine);
+
+    /**
+     * @brief 定位行所在的块
+     * @param index 行下标
+     * @param lineInChunk 输出块内行下标
+     * @return 所在块
+     */
+    const Chunk &chunkFor(qsizetype index, qsizetype *lineInChunk) const;
+
+    /**
+     * @brief 按绝对行号保存高亮区间
+     * @param spans 相对 baseLine 的区间
+     * @param baseLine 第 0 行的绝对行号
+     */
+    void storeSpans(const QVector<HighlightSpan> &spans, qint64 baseLine);
+
+    /**
+     * @brief 超过内存上限时丢弃最旧的块
+     */
+    void trim();
+
+    std::deque<Chunk> m_chunks;    ///< 数据块（至少一块）
+    qint64 m_sealedBytes = 0;      ///< 除最后一块外所有块占用的字节数
+    qint64 m_maxBytes;             ///< 内存上限
+};
+
+#endif // HISTORYSTORE_H
@@ -0,0 +1,79 @@
+#include "iothreadpool.h"
+
+#include <QMutexLocker>
+#include <QThread>
+
+/**
+ * @brief IoThreadPool 实现
+ */
+
+IoThreadPool *IoThreadPool::instance(Role role)
+{
+    // 不析构：线程随最后一个使用者退出，退出时池本身已为空
+    static IoThreadPool *serialIo = new IoThreadPool(QStringLiteral("SerialIo"), 2);
+    static IoThreadPool *processing = new IoThreadPool(QStringLiteral("Pipeline"),
+                                                       qMax(1, QThread::idealThreadCount() / 2));
+    return role == SerialIo ? serialIo : processing;
+}
+
+IoThreadPool::IoThreadPool(const QString &name, int maxThreads)
+    : m_name(name)
+    , m_maxThreads(qMax(1, maxThreads))
+{
+}
+
+QThread *IoThreadPool::acquire()
+{
+    QMutexLocker locker(&m_mutex);
+
+    // 先找空闲线程；没有且未达上限时新建；否则复用使用者最少的线程
+    int best = -1;
+    for (int i = 0; i < m_threads.size(); ++i) {
+        if (best < 0 || m_threads.at(i).users < m_threads.at(best).users) {
+            best = i;
+        }
+    }
+
+    if (best < 0 || (m_threads.at(best).users > 0 && m_threads.size() < m_maxThreads)) {
+        Entry entry;
+        entry.thread = new QThread();
+        entry.thread->setObjectName(QStringLiteral("%1-%2").arg(m_name).arg(m_threads.size()));
+        entry.thread->start();
+        m_threads.append(entry);
+        best = m_threads.size() - 1;
+    }
+
+    ++m_threads[best].users;
+    return m_threads.at(best).thread;
+}
+
+void IoThreadPool::release(QThread *thread)
+{
+    QMutexLocker locker(&m_mutex);
+    for (int i = 0; i < m_threads.size(); ++i) {
+        if (m_threads.at(i).thread != thread) {
+            continue;
+        }
+        if (--m_threads[i].users > 0) {
+            return;
+        }
+
+        m_threads.removeAt(i);
+        locker.unlock();
+        thread->quit();
+        thread->wait();
+        delete thread;
+        return;
+    }
+}
+
+int IoThreadPool::threadCount() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_threads.size();
+}
+
+int IoThreadPool::maxThreads() const
+{
+    return m_maxThreads;
+}
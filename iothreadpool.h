@@ -0,0 +1,82 @@
+#ifndef IOTHREADPOOL_H
+#define IOTHREADPOOL_H
+
+#include <QMutex>
+#include <QString>
+#include <QVector>
+
+class QThread;
+
+/**
+ * @brief IoThreadPool - 串口会话共享的事件循环线程池
+ *
+ * 多个串口会话同时运行时，SerialWorker 和 DataPipeline 不再各自独占一个
+ * QThread，而是从对应的池中取一个负载最少的线程，把自己移动过去。
+ * 串口读写大部分时间在等待，少量线程即可服务多个端口；处理线程按 CPU 核数限制。
+ * 线程在第一个使用者到来时启动，最后一个使用者归还时退出。
+ *
+ * 线程安全。
+ */
+class IoThreadPool
+{
+public:
+    /**
+     * @brief 线程池用途
+     */
+    enum Role {
+        SerialIo,     ///< 串口读写（SerialWorker）
+        Processing    ///< 数据处理（DataPipeline）
+    };
+
+    /**
+     * @brief 获取指定用途的线程池
+     * @param role 用途
+     * @return 线程池（全局唯一，不析构）
+     */
+    static IoThreadPool *instance(Role role);
+
+    /**
+     * @brief 取一个线程（当前使用者最少的那个，必要时新建）
+     * @return 已启动的线程
+     */
+    QThread *acquire();
+
+    /**
+     * @brief 归还线程，没有使用者时退出并释放该线程
+     *
+     * 调用前使用者必须已经离开该线程（moveToThread 到其他线程）。
+     *
+     * @param thread acquire() 返回的线程
+     */
+    void release(QThread *thread);
+
+    /**
+     * @brief 获取当前运行的线程数
+     * @return 线程数
+     */
+    int threadCount() const;
+
+    /**
+     * @brief 获取线程数上限
+     * @return 上限
+     */
+    int maxThreads() const;
+
+private:
+    IoThreadPool(const QString &name, int maxThreads);
+
+    /**
+     * @brief 一个池线程
+     */
+    struct Entry {
+        QThread *thread = nullptr;
+        int users = 0;     ///< 正在使用该线程的对象数
+    };
+
+    mutable QMutex m_mutex;      ///< 保护 m_threads
+    QVector<Entry> m_threads;    ///< 运行中的线程
+    QString m_name;              ///< 线程名前缀
+    int m_maxThreads;            ///< 线程数上限
+};
+
+#endif // IOTHREADPOOL_H
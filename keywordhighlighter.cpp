@@ -1,23 +1,42 @@
 #include "keywordhighlighter.h"
 
-// 辅助函数：添加关键词高亮规则
-void KeywordHighlighter::addKeywordRule(const QString &pattern, const QColor &color, 
-                                         bool bold, bool caseInsensitive)
+#include <algorithm>
+
+// 辅助函数：创建规则格式，规则 ID 即添加顺序
+int KeywordHighlighter::addFormat(const QColor &color, bool bold)
 {
-    HighlightRule rule;
     QTextCharFormat format;
     format.setForeground(color);
     if (bold) {
         format.setFontWeight(QFont::Bold);
     }
-    
+    m_formats.append(format);
+    return m_formats.size() - 1;
+}
+
+// 辅助函数：添加关键词高亮规则
+void KeywordHighlighter::addKeywordRule(const QStringList &keywords, KeywordMatcher::Mode mode,
+                                         const QColor &color, bool bold)
+{
+    const int id = addFormat(color, bold);
+    for (const QString &keyword : keywords) {
+        m_matcher.addKeyword(keyword, mode, id);
+    }
+}
+
+// 辅助函数：添加正则高亮规则
+void KeywordHighlighter::addRegexRule(const QString &pattern, const QColor &color,
+                                       bool bold, bool caseInsensitive)
+{
+    RegexRule rule;
     QRegularExpression::PatternOptions options = QRegularExpression::NoPatternOption;
     if (caseInsensitive) {
         options = QRegularExpression::CaseInsensitiveOption;
     }
     rule.pattern = QRegularExpression(pattern, options);
-    rule.format = format;
-    m_rules.append(rule);
+    rule.pattern.optimize();
+    rule.id = addFormat(color, bold);
+    m_regexRules.append(rule);
 }
 
 /**
@@ -26,63 +45,63 @@ void KeywordHighlighter::addKeywordRule(const QString &pattern, const QColor &co
  * 初始化高亮规则，支持多种日志级别和常见模式。
  * Requirements: 3.2, 3.5
  */
-KeywordHighlighter::KeywordHighlighter(QTextDocument *parent)
-    : QSyntaxHighlighter(parent)
+KeywordHighlighter::KeywordHighlighter(QObject *parent)
+    : QObject(parent)
     , m_enabled(true)
 {
+    using M = KeywordMatcher;
+
     // === 日志级别关键词 ===
     // DEBUG/TRACE/D: - 灰色
-    addKeywordRule("\\b(debug|trace|verbose)\\b", QColor("#808080"), false, true);
-    addKeywordRule("^\\s*[DdVv]:", QColor("#808080"), false, false);  // D: V: 开头
+    addKeywordRule({"debug", "trace", "verbose"}, M::WholeWord, QColor("#808080"));
+    addKeywordRule({"d:", "v:"}, M::LineStart, QColor("#808080"));  // D: V: 开头
     
     // INFO/I: - 蓝色
-    addKeywordRule("\\b(info|notice)\\b", QColor("#0066CC"), false, true);
-    addKeywordRule("^\\s*[Ii]:", QColor("#0066CC"), false, false);  // I: 开头
+    addKeywordRule({"info", "notice"}, M::WholeWord, QColor("#0066CC"));
+    addKeywordRule({"i:"}, M::LineStart, QColor("#0066CC"));  // I: 开头
     
     // WARNING/WARN/W: - 橙色
-    addKeywordRule("\\b(warning|warn)\\b", QColor("#FF9900"), false, true);
-    addKeywordRule("^\\s*[Ww]:", QColor("#FF9900"), false, false);  // W: 开头
+    addKeywordRule({"warning", "warn"}, M::WholeWord, QColor("#FF9900"));
+    addKeywordRule({"w:"}, M::LineStart, QColor("#FF9900"));  // W: 开头
     
     // ERROR/ERR/FAIL/E: - 红色
-    addKeywordRule("\\b(error|err|fail|failed|failure)\\b", QColor("#CC0000"), false, true);
-    addKeywordRule("^\\s*[Ee]:", QColor("#CC0000"), false, false);  // E: 开头
+    addKeywordRule({"error", "err", "fail", "failed", "failure"}, M::WholeWord, QColor("#CC0000"));
+    addKeywordRule({"e:"}, M::LineStart, QColor("#CC0000"));  // E: 开头
     
     // FATAL/CRITICAL/F: - 深红色
-    addKeywordRule("\\b(fatal|critical|panic)\\b", QColor("#990000"), false, true);
-    addKeywordRule("^\\s*[Ff]:", QColor("#990000"), false, false);  // F: 开头
+    addKeywordRule({"fatal", "critical", "panic"}, M::WholeWord, QColor("#990000"));
+    addKeywordRule({"f:"}, M::LineStart, QColor("#990000"));  // F: 开头
     
     // SUCCESS/OK/PASS - 绿色
-    addKeywordRule("\\b(success|ok|pass|passed|done|complete|completed)\\b", QColor("#00AA00"), false, true);
+    addKeywordRule({"success", "ok", "pass", "passed", "done", "complete", "completed"},
+                   M::WholeWord, QColor("#00AA00"));
     
     // SYSINFO - 绿色
-    addKeywordRule("\\bsysinfo\\b", QColor("#00AA00"), false, true);
+    addKeywordRule({"sysinfo"}, M::WholeWord, QColor("#00AA00"));
     
     // === 常见日志格式前缀 ===
     // [INFO] [WARN] [ERROR] 等方括号格式
-    addKeywordRule("\\[DEBUG\\]|\\[TRACE\\]|\\[VERBOSE\\]", QColor("#808080"), false, true);
-    addKeywordRule("\\[INFO\\]|\\[NOTICE\\]", QColor("#0066CC"), false, true);
-    addKeywordRule("\\[WARN\\]|\\[WARNING\\]", QColor("#FF9900"), false, true);
-    addKeywordRule("\\[ERROR\\]|\\[ERR\\]|\\[FAIL\\]", QColor("#CC0000"), false, true);
-    addKeywordRule("\\[FATAL\\]|\\[CRITICAL\\]", QColor("#990000"), false, true);
+    addKeywordRule({"[debug]", "[trace]", "[verbose]"}, M::Literal, QColor("#808080"));
+    addKeywordRule({"[info]", "[notice]"}, M::Literal, QColor("#0066CC"));
+    addKeywordRule({"[warn]", "[warning]"}, M::Literal, QColor("#FF9900"));
+    addKeywordRule({"[error]", "[err]", "[fail]"}, M::Literal, QColor("#CC0000"));
+    addKeywordRule({"[fatal]", "[critical]"}, M::Literal, QColor("#990000"));
     
-    // === 特殊格式 ===
+    // === 特殊格式（需要正则） ===
     // 时间戳 (HH:mm:ss.zzz >>) - 灰色
-    addKeywordRule("\\d{2}:\\d{2}:\\d{2}\\.\\d{3}\\s*>>", QColor("#808080"), false, false);
+    addRegexRule("\\d{2}:\\d{2}:\\d{2}\\.\\d{3}\\s*>>", QColor("#808080"), false, false);
     
     // 十六进制数 (0x...) - 紫色
-    addKeywordRule("\\b0x[0-9A-Fa-f]+\\b", QColor("#9932CC"), false, false);
+    addRegexRule("\\b0x[0-9A-Fa-f]+\\b", QColor("#9932CC"), false, false);
     
     // 数字 - 青色 (可选，如果觉得太花哨可以注释掉)
-    // addKeywordRule("\\b\\d+\\b", QColor("#008B8B"), false, false);
+    // addRegexRule("\\b\\d+\\b", QColor("#008B8B"), false, false);
     
     // SEND >> 前缀 - 灰色斜体
-    HighlightRule sendRule;
-    QTextCharFormat sendFormat;
-    sendFormat.setForeground(QColor("#666666"));
-    sendFormat.setFontItalic(true);
-    sendRule.pattern = QRegularExpression("SEND\\s*>>");
-    sendRule.format = sendFormat;
-    m_rules.append(sendRule);
+    addRegexRule("SEND\\s*>>", QColor("#666666"), false, false);
+    m_formats.last().setFontItalic(true);
+
+    m_matcher.build();
 }
 
 /**
@@ -94,8 +113,8 @@ void KeywordHighlighter::setEnabled(bool enabled)
 {
     if (m_enabled != enabled) {
         m_enabled = enabled;
-        // 触发重新高亮整个文档
-        rehighlight();
+        // 高亮区间已随文本保存，切换时接收区只需重绘可见行
+        emit enabledChanged(m_enabled);
     }
 }
 
@@ -109,27 +128,44 @@ bool KeywordHighlighter::isEnabled() const
 }
 
 /**
- * @brief 高亮文本块
+ * @brief 匹配一行文本中的所有高亮规则
  * 
- * 遍历所有高亮规则，对匹配的关键词应用相应的颜色格式。
- * 如果高亮功能被禁用，则不应用任何格式。
+ * 关键词规则由自动机一次扫描得出，正则规则单独匹配；
+ * 结果按规则 ID 稳定排序，使后添加的规则覆盖先添加的规则（与原逐条匹配一致）。
  * 
- * @param text 要处理的文本块
+ * @param text 要处理的一行文本
+ * @return 匹配结果
  * Requirements: 3.2, 3.5
  */
-void KeywordHighlighter::highlightBlock(const QString &text)
+QVector<KeywordMatcher::Match> KeywordHighlighter::match(const QString &text) const
 {
-    // 如果高亮功能被禁用，不应用任何格式
-    if (!m_enabled) {
-        return;
-    }
+    QVector<KeywordMatcher::Match> matches;
+    m_matcher.match(text, matches);
 
-    // 遍历所有高亮规则
-    for (const HighlightRule &rule : m_rules) {
+    for (const RegexRule &rule : m_regexRules) {
         QRegularExpressionMatchIterator matchIterator = rule.pattern.globalMatch(text);
         while (matchIterator.hasNext()) {
-            QRegularExpressionMatch match = matchIterator.next();
-            setFormat(match.capturedStart(), match.capturedLength(), rule.format);
+            const QRegularExpressionMatch match = matchIterator.next();
+            matches.append(KeywordMatcher::Match{rule.id, match.capturedStart(), match.capturedLength()});
         }
     }
+
+    std::stable_sort(matches.begin(), matches.end(),
+                     [](const KeywordMatcher::Match &a, const KeywordMatcher::Match &b) {
+                         return a.id < b.id;
+                     });
+    return matches;
+}
+
+/**
+ * @brief 获取规则对应的文本格式
+ * @param ruleId 规则 ID
+ * @return 文本格式
+ */
+QTextCharFormat KeywordHighlighter::format(int ruleId) const
+{
+    if (ruleId < 0 || ruleId >= m_formats.size()) {
+        return QTextCharFormat();
+    }
+    return m_formats.at(ruleId);
 }
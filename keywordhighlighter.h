@@ -1,29 +1,36 @@
 #ifndef KEYWORDHIGHLIGHTER_H
 #define KEYWORDHIGHLIGHTER_H
 
-#include <QSyntaxHighlighter>
+#include <QObject>
 #include <QTextCharFormat>
 #include <QRegularExpression>
+#include <QStringList>
 #include <QVector>
 
+#include "keywordmatcher.h"
+
 /**
  * @brief KeywordHighlighter - 关键词高亮器
  * 
- * 继承自 QSyntaxHighlighter，用于在 QTextDocument 中高亮显示
- * 特定关键词（info, warning, error）。
+ * 为接收区的单行文本匹配关键词（info, warning, error 等）。
+ * 匹配在处理线程中完成（见 HighlightStage），结果以规则 ID 随文本保存；
+ * ReceiveView 绘制可见行时只按规则 ID 取格式，不再做任何匹配。
+ * 
+ * 关键词类规则（单词、方括号标签、行首前缀）编译进同一个 KeywordMatcher，
+ * 每行只扫描一遍；只有时间戳、0x 十六进制等真正需要正则的规则单独匹配。
  * 
  * Requirements: 3.1, 3.2, 3.3
  */
-class KeywordHighlighter : public QSyntaxHighlighter
+class KeywordHighlighter : public QObject
 {
     Q_OBJECT
 
 public:
     /**
      * @brief 构造函数
-     * @param parent 父 QTextDocument 对象
+     * @param parent 父对象
      */
-    explicit KeywordHighlighter(QTextDocument *parent = nullptr);
+    explicit KeywordHighlighter(QObject *parent = nullptr);
 
     /**
      * @brief 设置高亮功能是否启用
@@ -38,40 +45,74 @@ public:
      */
     bool isEnabled() const;
 
-protected:
     /**
-     * @brief 高亮文本块
+     * @brief 匹配一行文本中的所有高亮规则
      * 
-     * 重写 QSyntaxHighlighter::highlightBlock，对文本中的
-     * 关键词应用相应的颜色格式。
+     * 结果按规则 ID 稳定排序，应用时后面的规则覆盖前面的规则。
+     * 与启用状态无关，只读，可在处理线程中调用。
      * 
-     * @param text 要处理的文本块
+     * @param text 要处理的一行文本
+     * @return 匹配结果（id 为规则 ID，对应 format()）
      * Requirements: 3.2, 3.5
      */
-    void highlightBlock(const QString &text) override;
+    QVector<KeywordMatcher::Match> match(const QString &text) const;
+
+    /**
+     * @brief 获取规则对应的文本格式
+     * @param ruleId 规则 ID
+     * @return 文本格式，ID 无效时返回空格式
+     */
+    QTextCharFormat format(int ruleId) const;
+
+signals:
+    /**
+     * @brief 高亮启用状态改变
+     * @param enabled 新的启用状态
+     */
+    void enabledChanged(bool enabled);
 
 private:
     /**
-     * @brief 高亮规则结构体
+     * @brief 正则高亮规则
      * 
-     * 定义关键词匹配模式和对应的文本格式。
+     * 只用于无法表示为关键词的模式。
      */
-    struct HighlightRule {
+    struct RegexRule {
         QRegularExpression pattern;  ///< 匹配模式（正则表达式）
-        QTextCharFormat format;      ///< 文本格式（颜色等）
+        int id;                      ///< 规则 ID（即优先级，越大越优先）
     };
 
     /**
-     * @brief 添加关键词高亮规则
+     * @brief 创建规则格式并分配规则 ID
+     * @param color 高亮颜色
+     * @param bold 是否加粗
+     * @return 规则 ID
+     */
+    int addFormat(const QColor &color, bool bold = false);
+
+    /**
+     * @brief 添加关键词高亮规则（大小写不敏感，编译进自动机）
+     * @param keywords 关键词列表
+     * @param mode 匹配方式
+     * @param color 高亮颜色
+     * @param bold 是否加粗
+     */
+    void addKeywordRule(const QStringList &keywords, KeywordMatcher::Mode mode,
+                        const QColor &color, bool bold = false);
+
+    /**
+     * @brief 添加正则高亮规则
      * @param pattern 正则表达式模式
      * @param color 高亮颜色
      * @param bold 是否加粗
      * @param caseInsensitive 是否大小写不敏感
      */
-    void addKeywordRule(const QString &pattern, const QColor &color, 
-                        bool bold = false, bool caseInsensitive = true);
+    void addRegexRule(const QString &pattern, const QColor &color,
+                      bool bold = false, bool caseInsensitive = true);
 
-    QVector<HighlightRule> m_rules;  ///< 高亮规则列表
+    KeywordMatcher m_matcher;           ///< 关键词自动机
+    QVector<RegexRule> m_regexRules;    ///< 正则规则
+    QVector<QTextCharFormat> m_formats; ///< 按规则 ID 索引的格式
     bool m_enabled = true;           ///< 高亮启用状态
 };
 
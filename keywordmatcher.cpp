@@ -0,0 +1,175 @@
+#include "keywordmatcher.h"
+
+#include <QQueue>
+#include <cstring>
+
+/**
+ * @brief KeywordMatcher 实现
+ */
+
+namespace {
+
+inline char toLowerAscii(char c)
+{
+    return (c >= 'A' && c <= 'Z') ? char(c + ('a' - 'A')) : c;
+}
+
+// 与 QRegularExpression 默认（非 UCP）的 \w 一致：ASCII 字母、数字和下划线
+inline bool isWordChar(char16_t c)
+{
+    return (c >= u'a' && c <= u'z') || (c >= u'A' && c <= u'Z')
+        || (c >= u'0' && c <= u'9') || c == u'_';
+}
+
+inline bool isSpace(char16_t c)
+{
+    return c == u' ' || c == u'\t' || c == u'\r' || c == u'\n' || c == u'\f' || c == u'\v';
+}
+
+} // namespace
+
+void KeywordMatcher::addKeyword(QStringView keyword, Mode mode, int id)
+{
+    if (keyword.isEmpty()) {
+        return;
+    }
+
+    Keyword entry;
+    entry.text = keyword.toLatin1();
+    for (char &c : entry.text) {
+        c = toLowerAscii(c);
+    }
+    entry.id = id;
+    entry.mode = mode;
+    m_keywords.append(entry);
+    m_built = false;
+}
+
+int KeywordMatcher::addNode()
+{
+    const int node = m_outputs.size();
+    m_transitions.resize(m_transitions.size() + m_classCount, -1);
+    m_outputs.append(QVector<int>());
+    return node;
+}
+
+void KeywordMatcher::build()
+{
+    // 1. 字母表：只为关键词中出现的字符分配类别，其他字符都归入类别 0
+    std::memset(m_classMap, 0, sizeof(m_classMap));
+    m_classCount = 1;
+    for (const Keyword &keyword : m_keywords) {
+        for (char c : keyword.text) {
+            const uchar lower = static_cast<uchar>(c) & 0x7F;
+            if (!m_classMap[lower]) {
+                m_classMap[lower] = static_cast<unsigned char>(m_classCount++);
+            }
+        }
+    }
+    for (int c = 'A'; c <= 'Z'; ++c) {
+        m_classMap[c] = m_classMap[c + ('a' - 'A')];
+    }
+
+    // 2. 字典树
+    m_transitions.clear();
+    m_outputs.clear();
+    addNode();
+    for (int k = 0; k < m_keywords.size(); ++k) {
+        int node = 0;
+        for (char c : m_keywords.at(k).text) {
+            const int slot = node * m_classCount + m_classMap[static_cast<uchar>(c) & 0x7F];
+            int next = m_transitions.at(slot);
+            if (next < 0) {
+                next = addNode();
+                m_transitions[slot] = next;
+            }
+            node = next;
+        }
+        m_outputs[node].append(k);
+    }
+
+    // 3. 按层 BFS 计算失败链接，补全 goto 表并合并后缀输出
+    QVector<qint32> fail(m_outputs.size(), 0);
+    QQueue<int> queue;
+    for (int c = 0; c < m_classCount; ++c) {
+        const int next = m_transitions.at(c);
+        if (next < 0) {
+            m_transitions[c] = 0;
+        } else {
+            fail[next] = 0;
+            queue.enqueue(next);
+        }
+    }
+    while (!queue.isEmpty()) {
+        const int node = queue.dequeue();
+        m_outputs[node] += m_outputs.at(fail.at(node));
+        for (int c = 0; c < m_classCount; ++c) {
+            const int slot = node * m_classCount + c;
+            const int fallback = m_transitions.at(fail.at(node) * m_classCount + c);
+            const int next = m_transitions.at(slot);
+            if (next < 0) {
+                m_transitions[slot] = fallback;
+            } else {
+                fail[next] = fallback;
+                queue.enqueue(next);
+            }
+        }
+    }
+
+    m_built = true;
+}
+
+void KeywordMatcher::match(QStringView text, QVector<Match> &out) const
+{
+    if (!m_built || m_keywords.isEmpty()) {
+        return;
+    }
+
+    const char16_t *s = text.utf16();
+    const qsizetype size = text.size();
+
+    // 行首匹配允许的位置：第一个非空白字符
+    qsizetype firstNonSpace = 0;
+    while (firstNonSpace < size && isSpace(s[firstNonSpace])) {
+        ++firstNonSpace;
+    }
+
+    const qint32 *transitions = m_transitions.constData();
+    int state = 0;
+    for (qsizetype i = 0; i < size; ++i) {
+        const char16_t c = s[i];
+        const int cls = c < 128 ? m_classMap[c] : 0;
+        state = transitions[state * m_classCount + cls];
+
+        const QVector<int> &outputs = m_outputs.at(state);
+        for (int k : outputs) {
+            const Keyword &keyword = m_keywords.at(k);
+            const qsizetype length = keyword.text.size();
+            const qsizetype start = i + 1 - length;
+
+            switch (keyword.mode) {
+            case WholeWord:
+                if ((start > 0 && isWordChar(s[start - 1])) || (i + 1 < size && isWordChar(s[i + 1]))) {
+                    continue;
+                }
+                out.append(Match{keyword.id, start, length});
+                break;
+            case Literal:
+                out.append(Match{keyword.id, start, length});
+                break;
+            case LineStart:
+                if (start != firstNonSpace) {
+                    continue;
+                }
+                // 与 ^\s*word 一致，区间包含前导空白
+                out.append(Match{keyword.id, 0, i + 1});
+                break;
+            }
+        }
+    }
+}
+
+bool KeywordMatcher::isEmpty() const
+{
+    return m_keywords.isEmpty();
+}
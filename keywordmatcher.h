@@ -0,0 +1,91 @@
+#ifndef KEYWORDMATCHER_H
+#define KEYWORDMATCHER_H
+
+#include <QByteArray>
+#include <QStringView>
+#include <QVector>
+
+/**
+ * @brief KeywordMatcher - 多关键词单遍匹配器（Aho-Corasick）
+ *
+ * 将所有关键词编译为一个确定性自动机（完整的 goto 表），每行文本只扫描一遍，
+ * 匹配代价与关键词数量无关。关键词为 ASCII，大小写不敏感。
+ * 支持三种匹配方式，语义与原正则规则一致：
+ * - WholeWord：等价于 \b(word)\b，单词字符为 ASCII 字母、数字和下划线
+ * - Literal：任意位置的字面匹配，如 [INFO]
+ * - LineStart：等价于 ^\s*word，匹配区间从行首开始
+ *
+ * build() 之后只读，可在多个线程中同时使用。
+ */
+class KeywordMatcher
+{
+public:
+    /**
+     * @brief 匹配方式
+     */
+    enum Mode {
+        WholeWord,   ///< 前后为单词边界
+        Literal,     ///< 任意位置
+        LineStart    ///< 行首（允许前导空白）
+    };
+
+    /**
+     * @brief 一次匹配结果
+     */
+    struct Match {
+        int id;              ///< 关键词所属规则 ID
+        qsizetype start;     ///< 起始位置（UTF-16 下标）
+        qsizetype length;    ///< 长度
+    };
+
+    /**
+     * @brief 添加关键词
+     * @param keyword 关键词（ASCII）
+     * @param mode 匹配方式
+     * @param id 规则 ID，随匹配结果返回
+     */
+    void addKeyword(QStringView keyword, Mode mode, int id);
+
+    /**
+     * @brief 编译自动机，添加完所有关键词后调用一次
+     */
+    void build();
+
+    /**
+     * @brief 扫描一行文本，将所有匹配追加到 out
+     * @param text 一行文本
+     * @param out 匹配结果（按结束位置递增）
+     */
+    void match(QStringView text, QVector<Match> &out) const;
+
+    /**
+     * @brief 检查是否没有任何关键词
+     * @return true 如果没有关键词
+     */
+    bool isEmpty() const;
+
+private:
+    /**
+     * @brief 关键词信息
+     */
+    struct Keyword {
+        QByteArray text;   ///< 小写关键词
+        int id;
+        Mode mode;
+    };
+
+    /**
+     * @brief 新增一个自动机节点
+     * @return 节点下标
+     */
+    int addNode();
+
+    QVector<Keyword> m_keywords;          ///< 所有关键词
+    QVector<qint32> m_transitions;        ///< goto 表：node * m_classCount + class
+    QVector<QVector<int>> m_outputs;      ///< 每个节点（含后缀链）输出的关键词下标
+    unsigned char m_classMap[128] = {};   ///< ASCII 字符到类别（大小写映射到同一类别）
+    int m_classCount = 1;                 ///< 类别数量（含类别 0）
+    bool m_built = false;                 ///< 是否已编译
+};
+
+#endif // KEYWORDMATCHER_H
@@ -0,0 +1,88 @@
+#include "lineframer.h"
+
+#include <cstring>
+
+/**
+ * @brief LineFramer 实现
+ *
+ * Requirements: 3.2
+ */
+
+void LineFramer::feed(QByteArrayView data, qint64 timestampNs, QVector<Segment> &out)
+{
+    const char *begin = data.data();
+    const qsizetype size = data.size();
+    qsizetype pos = 0;
+
+    while (pos < size) {
+        const void *found = std::memchr(begin + pos, '\n', size_t(size - pos));
+        if (!found) {
+            // 行尾不完整，保留到下一块
+            if (m_pending.isEmpty()) {
+                m_pendingTimestampNs = timestampNs;
+                m_pendingStartsLine = !m_lineOpen;
+            }
+            m_pending.append(begin + pos, size - pos);
+            return;
+        }
+
+        const qsizetype end = static_cast<const char *>(found) - begin + 1;
+        Segment segment;
+        if (!m_pending.isEmpty()) {
+            // 与上一块保留的行尾拼接；每块最多发生一次
+            m_pending.append(begin + pos, end - pos);
+            m_emitted.swap(m_pending);
+            m_pending.clear();
+            segment.bytes = QByteArrayView(m_emitted);
+            segment.timestampNs = m_pendingTimestampNs;
+            segment.startsLine = m_pendingStartsLine;
+        } else {
+            segment.bytes = QByteArrayView(begin + pos, end - pos);
+            segment.timestampNs = timestampNs;
+            segment.startsLine = !m_lineOpen;
+        }
+        segment.endsLine = true;
+        out.append(segment);
+
+        m_lineOpen = false;
+        pos = end;
+    }
+}
+
+void LineFramer::flush(QVector<Segment> &out)
+{
+    if (m_pending.isEmpty()) {
+        return;
+    }
+
+    m_emitted.swap(m_pending);
+    m_pending.clear();
+
+    Segment segment;
+    segment.bytes = QByteArrayView(m_emitted);
+    segment.timestampNs = m_pendingTimestampNs;
+    segment.startsLine = m_pendingStartsLine;
+    segment.endsLine = false;
+    out.append(segment);
+
+    m_lineOpen = true;
+}
+
+bool LineFramer::hasPending() const
+{
+    return !m_pending.isEmpty();
+}
+
+qsizetype LineFramer::pendingSize() const
+{
+    return m_pending.size();
+}
+
+void LineFramer::reset()
+{
+    m_pending.clear();
+    m_emitted.clear();
+    m_pendingTimestampNs = 0;
+    m_pendingStartsLine = true;
+    m_lineOpen = false;
+}
@@ -0,0 +1,78 @@
+#ifndef LINEFRAMER_H
+#define LINEFRAMER_H
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QVector>
+
+/**
+ * @brief LineFramer - 增量分行器
+ *
+ * 在解码之前按 '\n' 把原始字节切分为行，跨数据块保留不完整的行尾，
+ * 每一行带有其第一个字节所在数据块的到达时间。'\n' 在 UTF-8 和 GBK 中都不会
+ * 出现在多字节字符内部，因此按字节分行不会切断字符。
+ *
+ * 行边界用 memchr 查找（glibc 中为 SIMD 实现），多 Mbaud 速率下分行代价很小。
+ * 不完整的行尾由调用者在保留超时或达到长度上限后用 flush() 取出，之后到达的同一行剩余部分
+ * 作为续行输出（startsLine 为 false）。
+ *
+ * 非线程安全，只在处理线程中使用。
+ */
+class LineFramer
+{
+public:
+    /**
+     * @brief 一段输出
+     *
+     * bytes 指向输入数据或分行器内部缓冲区，在下一次 feed()/flush()/reset() 之前有效。
+     */
+    struct Segment {
+        QByteArrayView bytes;       ///< 字节（完整行包含结尾的 '\n'）
+        qint64 timestampNs = 0;     ///< 第一个字节的到达时间（单调时钟纳秒）
+        bool startsLine = true;     ///< 是否从行首开始（false 表示之前已 flush 过该行的开头）
+        bool endsLine = true;       ///< 是否以 '\n' 结尾
+    };
+
+    /**
+     * @brief 切分一块数据
+     *
+     * 完整的行追加到 out；最后不完整的部分保留在内部，等待下一块或 flush()。
+     *
+     * @param data 原始字节
+     * @param timestampNs 这块数据的到达时间
+     * @param out 输出段
+     */
+    void feed(QByteArrayView data, qint64 timestampNs, QVector<Segment> &out);
+
+    /**
+     * @brief 取出保留的不完整行尾
+     * @param out 输出段（无保留数据时不追加）
+     */
+    void flush(QVector<Segment> &out);
+
+    /**
+     * @brief 检查是否保留有不完整的行尾
+     * @return true 如果有
+     */
+    bool hasPending() const;
+
+    /**
+     * @brief 获取保留的不完整行尾的字节数
+     * @return 字节数
+     */
+    qsizetype pendingSize() const;
+
+    /**
+     * @brief 丢弃所有状态，下一个字节从新行开始
+     */
+    void reset();
+
+private:
+    QByteArray m_pending;            ///< 保留的不完整行尾
+    QByteArray m_emitted;            ///< 已输出、由 Segment 引用的拼接行
+    qint64 m_pendingTimestampNs = 0; ///< m_pending 第一个字节的到达时间
+    bool m_pendingStartsLine = true; ///< m_pending 是否从行首开始
+    bool m_lineOpen = false;         ///< 已 flush 出一行的开头，尚未遇到 '\n'
+};
+
+#endif // LINEFRAMER_H
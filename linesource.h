@@ -0,0 +1,59 @@
+#ifndef LINESOURCE_H
+#define LINESOURCE_H
+
+#include <QString>
+#include <QVector>
+
+/**
+ * @brief HighlightSpan - 一段高亮区间
+ *
+ * 由处理线程计算，随文本一起追加到 HistoryStore；绘制时按 rule 取格式。
+ */
+struct HighlightSpan {
+    qint32 line = 0;      ///< 行号（追加时相对于追加前的最后一行，读取时无意义）
+    quint16 start = 0;    ///< 行内起始位置（UTF-16）
+    quint16 length = 0;   ///< 长度（UTF-16）
+    quint16 rule = 0;     ///< 高亮规则 ID
+};
+
+/**
+ * @brief LineSource - ReceiveView 显示的行数据
+ *
+ * ReceiveView 只按行号读取可见的若干行，不关心行保存在哪里：
+ * 接收历史（HistoryStore）或内存映射的日志文件（LogFile）。
+ *
+ * 只在 UI 线程中调用。
+ */
+class LineSource
+{
+public:
+    virtual ~LineSource() = default;
+
+    /**
+     * @brief 获取行数（至少为 1，最后一行可能为空）
+     * @return 当前可显示的行数
+     */
+    virtual qsizetype lineCount() const = 0;
+
+    /**
+     * @brief 获取第一行的绝对行号
+     * @return 第一行的绝对行号
+     */
+    virtual qint64 firstLineNumber() const = 0;
+
+    /**
+     * @brief 获取一行的文本
+     * @param index 行下标（0 ~ lineCount()-1）
+     * @return 行文本（不含换行符）
+     */
+    virtual QString line(qsizetype index) const = 0;
+
+    /**
+     * @brief 获取一行的高亮区间
+     * @param index 行下标（0 ~ lineCount()-1）
+     * @return 高亮区间，按规则优先级排序
+     */
+    virtual QVector<HighlightSpan> lineSpans(qsizetype index) const = 0;
+};
+
+#endif // LINESOURCE_H
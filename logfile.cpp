@@ -0,0 +1,496 @@
+#include "logfile.h"
+#include "hexencoder.h"
+#include "historystore.h"
+#include "keywordhighlighter.h"
+#include "timestampformatter.h"
+
+#include <QElapsedTimer>
+#include <QMutexLocker>
+#include <QThread>
+#include <algorithm>
+#include <cstring>
+
+/**
+ * @brief LogFile 实现
+ */
+
+namespace {
+
+constexpr int PROGRESS_INTERVAL_MS = 50;    ///< indexProgress 的最小间隔
+
+} // namespace
+
+LogFile::LogFile(QObject *parent)
+    : QObject(parent)
+{
+}
+
+LogFile::~LogFile()
+{
+    close();
+}
+
+bool LogFile::open(const QString &path, QString *error)
+{
+    close();
+
+    auto fail = [this, error](const QString &message) {
+        if (error) {
+            *error = message;
+        }
+        close();
+        return false;
+    };
+
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        return fail(QString("无法打开日志文件: %1").arg(m_file.errorString()));
+    }
+    m_size = m_file.size();
+    if (m_size > 0) {
+        m_data = m_file.map(0, m_size);
+        if (!m_data) {
+            return fail(QString("无法映射日志文件: %1").arg(m_file.errorString()));
+        }
+    }
+
+    const int chunkCount = int((m_size + CHUNK_BYTES - 1) / CHUNK_BYTES);
+    {
+        QMutexLocker locker(&m_mutex);
+        m_stopping = false;
+        m_results.assign(size_t(chunkCount), ChunkResult());
+        m_threads = qMin(chunkCount, qBound(1, QThread::idealThreadCount(), MAX_INDEX_THREADS));
+        m_startNs = TimestampFormatter::monotonicNs();
+        m_indexing = true;
+    }
+
+    m_indexThread.reset(QThread::create([this]() { buildIndex(); }));
+    m_indexThread->setObjectName("SSW-logindex");
+    m_indexThread->start();
+
+    if (error) {
+        error->clear();
+    }
+    return true;
+}
+
+void LogFile::close()
+{
+    stopIndexing();
+
+    if (m_data) {
+        m_file.unmap(const_cast<uchar *>(m_data));
+        m_data = nullptr;
+    }
+    m_file.close();
+    m_size = 0;
+
+    QMutexLocker locker(&m_mutex);
+    m_checkpoints.clear();
+    m_checkpoints.shrink_to_fit();
+    m_segments.clear();
+    m_segments.shrink_to_fit();
+    m_results.clear();
+    m_indexedEnd = 0;
+    m_lineCount = 0;
+    m_elapsedNs = 0;
+    m_indexing = false;
+    m_finished = false;
+    m_threads = 0;
+    m_nextChunk = 0;
+    m_mergedChunks = 0;
+    m_cursorLine = -1;
+    m_cachedLine = -1;
+    m_cachedText.clear();
+}
+
+bool LogFile::isOpen() const
+{
+    return m_file.isOpen();
+}
+
+QString LogFile::path() const
+{
+    return m_file.isOpen() ? m_file.fileName() : QString();
+}
+
+void LogFile::setHexMode(bool enabled)
+{
+    m_hexMode = enabled;
+    m_cachedLine = -1;
+}
+
+bool LogFile::hexMode() const
+{
+    return m_hexMode;
+}
+
+void LogFile::setEncoding(AppSettings::Encoding encoding)
+{
+    m_encoding = encoding;
+    m_decoder = QStringDecoder();
+    if (encoding == AppSettings::GBK) {
+        // 只解码互不相连的整行，不需要跨行保留状态
+        m_decoder = QStringDecoder("GBK", QStringDecoder::Flag::Stateless);
+        if (!m_decoder.isValid()) {
+            m_decoder = QStringDecoder(QStringDecoder::System, QStringDecoder::Flag::Stateless);
+        }
+    }
+    m_cachedLine = -1;
+}
+
+void LogFile::setHighlighter(const KeywordHighlighter *highlighter)
+{
+    m_highlighter = highlighter;
+}
+
+LogIndexStats LogFile::stats() const
+{
+    QMutexLocker locker(&m_mutex);
+    LogIndexStats stats;
+    stats.fileSize = m_size;
+    stats.indexedBytes = m_indexedEnd;
+    stats.lines = m_lineCount;
+    stats.indexBytes = qint64(m_checkpoints.capacity() + m_segments.capacity()) * qint64(sizeof(qint64));
+    stats.elapsedNs = m_indexing ? TimestampFormatter::monotonicNs() - m_startNs : m_elapsedNs;
+    stats.threads = m_threads;
+    stats.finished = m_finished;
+    return stats;
+}
+
+qsizetype LogFile::lineCount() const
+{
+    if (m_hexMode) {
+        return qsizetype(qMax<qint64>(1, (m_size + HEX_BYTES_PER_LINE - 1) / HEX_BYTES_PER_LINE));
+    }
+    QMutexLocker locker(&m_mutex);
+    return qsizetype(qMax<qint64>(1, m_lineCount));
+}
+
+qint64 LogFile::firstLineNumber() const
+{
+    return 0;
+}
+
+QString LogFile::line(qsizetype index) const
+{
+    if (index == m_cachedLine) {
+        return m_cachedText;
+    }
+
+    const char *data = reinterpret_cast<const char *>(m_data);
+    if (m_hexMode) {
+        const qint64 start = qint64(index) * HEX_BYTES_PER_LINE;
+        if (index < 0 || start >= m_size) {
+            return QString();
+        }
+        m_cachedText = HexEncoder::encode(QByteArrayView(data + start, qMin<qint64>(HEX_BYTES_PER_LINE, m_size - start)),
+                                          false);
+    } else {
+        qint64 start = 0;
+        qint64 end = 0;
+        if (!locate(index, &start, &end)) {
+            return QString();
+        }
+        m_cachedText = decode(data + start, qsizetype(end - start));
+    }
+    m_cachedLine = index;
+    return m_cachedText;
+}
+
+QVector<HighlightSpan> LogFile::lineSpans(qsizetype index) const
+{
+    QVector<HighlightSpan> spans;
+    if (!m_highlighter) {
+        return spans;
+    }
+
+    // 只有绘制的可见行会走到这里，匹配代价与文件大小无关
+    const QString text = line(index);
+    if (text.isEmpty()) {
+        return spans;
+    }
+    const QVector<KeywordMatcher::Match> matches = m_highlighter->match(text);
+    spans.reserve(matches.size());
+    for (const KeywordMatcher::Match &match : matches) {
+        HighlightSpan span;
+        span.start = static_cast<quint16>(match.start);
+        span.length = static_cast<quint16>(match.length);
+        span.rule = static_cast<quint16>(match.id);
+        spans.append(span);
+    }
+    return spans;
+}
+
+qsizetype LogFile::scanLine(const char *data, qsizetype size, qsizetype start, qsizetype *next)
+{
+    // 恰好 MAX_LINE_BYTES 字节后紧跟的 '\n' 仍属于本行，与 HistoryStore 一致
+    const qsizetype limit = qMin(size, start + HistoryStore::MAX_LINE_BYTES);
+    const qsizetype searchEnd = qMin(size, limit + 1);
+    const void *found = std::memchr(data + start, '\n', size_t(searchEnd - start));
+    if (found) {
+        const qsizetype end = static_cast<const char *>(found) - data;
+        *next = end + 1;
+        return end;
+    }
+    if (limit == size) {
+        *next = size;
+        return size;
+    }
+
+    // 超长行折断，不在 UTF-8 多字节字符中间折断
+    qsizetype end = limit;
+    while (end > start + 1 && (static_cast<uchar>(data[end]) & 0xC0) == 0x80) {
+        --end;
+    }
+    *next = end;
+    return end;
+}
+
+qsizetype LogFile::syncPoint(const char *data, qsizetype size, qsizetype from)
+{
+    const qsizetype limit = qMin(size, from + SYNC_WINDOW);
+    const void *found = std::memchr(data + from, '\n', size_t(limit - from));
+    return found ? static_cast<const char *>(found) - data + 1 : from;
+}
+
+void LogFile::buildIndex()
+{
+    // 此方法在索引线程中执行；m_results 的大小与 m_threads 在线程运行期间不变
+    const int chunkCount = int(m_results.size());
+    std::vector<std::unique_ptr<QThread>> scanners;
+    for (int i = 0; i < m_threads; ++i) {
+        scanners.emplace_back(QThread::create([this]() { scanChunks(); }));
+        scanners.back()->setObjectName("SSW-logscan");
+        scanners.back()->start();
+    }
+
+    QElapsedTimer sinceProgress;
+    sinceProgress.start();
+    bool complete = true;
+    qint64 lineCount = 0;    // 只有本线程写 m_lineCount，这里保留一份不加锁的副本
+
+    // 按文件顺序合并：已合并的部分从文件头开始连续，可以立即显示
+    for (int chunk = 0; chunk < chunkCount; ++chunk) {
+        ChunkResult result;
+        {
+            QMutexLocker locker(&m_mutex);
+            while (!m_stopping && !m_results[size_t(chunk)].done) {
+                m_wake.wait(&m_mutex);
+            }
+            if (m_stopping) {
+                complete = false;
+                break;
+            }
+            result = std::move(m_results[size_t(chunk)]);
+            m_results[size_t(chunk)] = ChunkResult();
+            m_mergedChunks = chunk + 1;
+            m_wake.wakeAll();
+        }
+
+        // 记录点在锁外选出，持锁时只追加
+        std::vector<qint64> checkpoints;
+        const qint64 lines = qint64(result.lineStarts.size());
+        for (qint64 i = (CHECKPOINT_STRIDE - lineCount % CHECKPOINT_STRIDE) % CHECKPOINT_STRIDE; i < lines;
+             i += CHECKPOINT_STRIDE) {
+            checkpoints.push_back(result.start + result.lineStarts[size_t(i)]);
+        }
+        lineCount += lines;
+
+        {
+            QMutexLocker locker(&m_mutex);
+            m_checkpoints.insert(m_checkpoints.end(), checkpoints.begin(), checkpoints.end());
+            m_segments.push_back(result.start);
+            m_indexedEnd = result.end;
+            m_lineCount = lineCount;
+        }
+
+        if (chunk == 0 || sinceProgress.elapsed() >= PROGRESS_INTERVAL_MS) {
+            sinceProgress.restart();
+            emit indexProgress();
+        }
+    }
+
+    for (const std::unique_ptr<QThread> &scanner : scanners) {
+        scanner->wait();
+    }
+
+    {
+        QMutexLocker locker(&m_mutex);
+        m_elapsedNs = TimestampFormatter::monotonicNs() - m_startNs;
+        m_indexing = false;
+        m_finished = complete;
+    }
+    if (complete) {
+        emit indexProgress();
+        emit indexFinished();
+    }
+}
+
+void LogFile::scanChunks()
+{
+    // 此方法在扫描线程中执行
+    auto fail = [this](const QString &message) {
+        emit errorOccurred(message);
+        QMutexLocker locker(&m_mutex);
+        m_stopping = true;
+        m_wake.wakeAll();
+    };
+
+    // 用普通读取扫描：读过的页留在系统缓存中，不计入本进程的内存
+    QFile file(m_file.fileName());
+    if (!file.open(QIODevice::ReadOnly)) {
+        fail(QString("无法读取日志文件: %1").arg(file.errorString()));
+        return;
+    }
+
+    const int chunkCount = int(m_results.size());
+    const int maxAhead = 2 * m_threads;
+    QByteArray buffer;
+    for (;;) {
+        int chunk = 0;
+        {
+            QMutexLocker locker(&m_mutex);
+            // 合并落后太多时等待，限制未合并的结果占用的内存
+            while (!m_stopping && m_nextChunk < chunkCount && m_nextChunk >= m_mergedChunks + maxAhead) {
+                m_wake.wait(&m_mutex);
+            }
+            if (m_stopping || m_nextChunk >= chunkCount) {
+                return;
+            }
+            chunk = m_nextChunk++;
+        }
+
+        ChunkResult result;
+        if (!scanChunk(file, chunk, buffer, &result)) {
+            fail(QString("读取日志文件失败: %1").arg(file.errorString()));
+            return;
+        }
+        result.done = true;
+
+        QMutexLocker locker(&m_mutex);
+        m_results[size_t(chunk)] = std::move(result);
+        m_wake.wakeAll();
+    }
+}
+
+bool LogFile::scanChunk(QFile &file, int chunk, QByteArray &buffer, ChunkResult *result) const
+{
+    // 多读 SYNC_WINDOW 字节，找到下一块的第一行
+    const qint64 chunkStart = qint64(chunk) * CHUNK_BYTES;
+    const qint64 chunkEnd = qMin(m_size, chunkStart + CHUNK_BYTES);
+    const qint64 readEnd = qMin(m_size, chunkEnd + SYNC_WINDOW);
+    buffer.resize(qsizetype(readEnd - chunkStart));
+    if (!file.seek(chunkStart)) {
+        return false;
+    }
+    qsizetype filled = 0;
+    while (filled < buffer.size()) {
+        const qint64 n = file.read(buffer.data() + filled, buffer.size() - filled);
+        if (n <= 0) {
+            return false;
+        }
+        filled += qsizetype(n);
+    }
+
+    // 两个相邻块用同样的数据确定分界，结果一致
+    const char *data = buffer.constData();
+    const qsizetype begin = chunk == 0 ? 0 : syncPoint(data, buffer.size(), 0);
+    const qsizetype end = chunkEnd == m_size ? buffer.size()
+                                             : syncPoint(data, buffer.size(), qsizetype(chunkEnd - chunkStart));
+    result->start = chunkStart + begin;
+    result->end = chunkStart + end;
+
+    const char *segment = data + begin;
+    const qsizetype size = end - begin;
+    qsizetype pos = 0;
+    while (pos < size) {
+        result->lineStarts.push_back(quint32(pos));
+        scanLine(segment, size, pos, &pos);
+    }
+    return true;
+}
+
+bool LogFile::locate(qsizetype index, qint64 *start, qint64 *end) const
+{
+    QMutexLocker locker(&m_mutex);
+    if (index < 0 || index >= m_lineCount) {
+        return false;
+    }
+
+    // 从最近的记录点（或上一次定位的行）向后逐行查找
+    qsizetype line = index - index % CHECKPOINT_STRIDE;
+    qint64 offset = m_checkpoints[size_t(index / CHECKPOINT_STRIDE)];
+    if (m_cursorLine >= line && m_cursorLine <= index) {
+        line = m_cursorLine;
+        offset = m_cursorOffset;
+    }
+
+    const char *data = reinterpret_cast<const char *>(m_data);
+    qint64 segmentStart = 0;
+    qint64 segmentEnd = 0;
+    auto findSegment = [&]() {
+        auto it = std::upper_bound(m_segments.begin(), m_segments.end(), offset);
+        segmentStart = *(it - 1);
+        segmentEnd = it == m_segments.end() ? m_indexedEnd : *it;
+    };
+    findSegment();
+
+    for (;;) {
+        qsizetype next = 0;
+        const qsizetype lineEnd = scanLine(data + segmentStart, qsizetype(segmentEnd - segmentStart),
+                                           qsizetype(offset - segmentStart), &next);
+        if (line == index) {
+            *start = offset;
+            *end = segmentStart + lineEnd;
+            break;
+        }
+        offset = segmentStart + next;
+        ++line;
+        if (offset >= segmentEnd) {
+            findSegment();
+        }
+    }
+
+    m_cursorLine = index;
+    m_cursorOffset = *start;
+    return true;
+}
+
+QString LogFile::decode(const char *data, qsizetype size) const
+{
+    QByteArrayView bytes(data, size);
+    QByteArray stripped;
+    if (size > 0 && std::memchr(data, '\r', size_t(size))) {
+        stripped = bytes.toByteArray();
+        stripped.replace("\r", "");
+        bytes = stripped;
+    }
+
+    switch (m_encoding) {
+    case AppSettings::UTF8:
+        return QString::fromUtf8(bytes);
+    case AppSettings::GBK:
+        if (m_decoder.isValid()) {
+            return m_decoder(bytes);
+        }
+        break;
+    case AppSettings::ANSI:
+    default:
+        break;
+    }
+    return QString::fromLatin1(bytes);
+}
+
+void LogFile::stopIndexing()
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        m_stopping = true;
+        m_wake.wakeAll();
+    }
+    if (m_indexThread) {
+        m_indexThread->wait();
+        m_indexThread.reset();
+    }
+}
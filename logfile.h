@@ -0,0 +1,227 @@
+#ifndef LOGFILE_H
+#define LOGFILE_H
+
+#include <QFile>
+#include <QMutex>
+#include <QObject>
+#include <QStringDecoder>
+#include <QWaitCondition>
+#include <memory>
+#include <vector>
+
+#include "appsettings.h"
+#include "linesource.h"
+
+class KeywordHighlighter;
+class QThread;
+
+/**
+ * @brief LogIndexStats - 日志行索引统计
+ */
+struct LogIndexStats {
+    qint64 fileSize = 0;        ///< 文件长度
+    qint64 indexedBytes = 0;    ///< 已建立索引的字节数（从文件头开始连续）
+    qint64 lines = 0;           ///< 已建立索引的行数
+    qint64 indexBytes = 0;      ///< 索引占用的内存
+    qint64 elapsedNs = 0;       ///< 建立索引已用（完成后为总）时间
+    int threads = 0;            ///< 扫描线程数
+    bool finished = false;      ///< 索引已完成
+};
+
+/**
+ * @brief LogFile - 内存映射的大日志文件
+ *
+ * 用于在接收区中查看现场带回的数 GB 串口日志，与接收历史使用相同的显示、高亮和十六进制模式：
+ *
+ * - 整个文件只读映射，只有可见的若干行被访问、解码和高亮，常驻内存与文件大小无关。
+ * - 行索引在后台建立：文件按 CHUNK_BYTES 分块，多个线程并行用普通读取扫描换行符
+ *   （扫描不经过映射，读过的页不计入本进程），按顺序合并后立即可见，
+ *   打开后第一块扫描完即可显示首屏。
+ * - 索引是稀疏的：每 CHECKPOINT_STRIDE 行记录一个起始偏移，其余行从最近的记录点向后查找。
+ * - 分行规则与 HistoryStore 相同：以 '\n' 分行，丢弃 '\r'，超过 MAX_LINE_BYTES 的行被折断。
+ *   每块从块首之后的第一个 '\n' 开始，因此各块可以独立扫描；
+ *   SYNC_WINDOW 内没有换行符（二进制数据）时在块首处折断。
+ * - 十六进制模式每行 HEX_BYTES_PER_LINE 字节，不需要索引。
+ *
+ * 行读取方法只在 UI 线程中调用；索引线程通过 indexProgress 通知新增的行。
+ */
+class LogFile : public QObject, public LineSource
+{
+    Q_OBJECT
+
+public:
+    static constexpr qint64 CHUNK_BYTES = qint64(4) << 20;     ///< 并行扫描的分块大小
+    static constexpr qsizetype SYNC_WINDOW = 64 * 1024;        ///< 块首之后查找第一个换行符的范围
+    static constexpr qsizetype CHECKPOINT_STRIDE = 64;         ///< 每隔多少行记录一个起始偏移
+    static constexpr qsizetype HEX_BYTES_PER_LINE = 16;        ///< 十六进制模式每行字节数
+    static constexpr int MAX_INDEX_THREADS = 8;                ///< 扫描线程数上限
+
+    /**
+     * @brief 构造函数
+     * @param parent 父对象
+     */
+    explicit LogFile(QObject *parent = nullptr);
+
+    /**
+     * @brief 析构函数（停止索引线程并解除映射）
+     */
+    ~LogFile();
+
+    /**
+     * @brief 打开并映射日志文件，开始在后台建立行索引
+     * @param path 文件路径
+     * @param error 失败时写入错误描述，可为 nullptr
+     * @return true 如果打开成功
+     */
+    bool open(const QString &path, QString *error = nullptr);
+
+    /**
+     * @brief 停止建立索引并关闭文件
+     */
+    void close();
+
+    bool isOpen() const;
+    QString path() const;
+
+    /**
+     * @brief 设置十六进制显示（每行 HEX_BYTES_PER_LINE 字节）
+     * @param enabled true 为十六进制
+     */
+    void setHexMode(bool enabled);
+    bool hexMode() const;
+
+    /**
+     * @brief 设置文本解码方式（与接收区相同）
+     * @param encoding 编码
+     */
+    void setEncoding(AppSettings::Encoding encoding);
+
+    /**
+     * @brief 设置关键词高亮器（可见行在读取时匹配）
+     * @param highlighter 高亮器，可为 nullptr
+     */
+    void setHighlighter(const KeywordHighlighter *highlighter);
+
+    /**
+     * @brief 获取索引统计（线程安全）
+     * @return 统计信息
+     */
+    LogIndexStats stats() const;
+
+    qsizetype lineCount() const override;
+    qint64 firstLineNumber() const override;
+    QString line(qsizetype index) const override;
+    QVector<HighlightSpan> lineSpans(qsizetype index) const override;
+
+signals:
+    /**
+     * @brief 索引新增了行（限速发出，在索引线程中发出）
+     */
+    void indexProgress();
+
+    /**
+     * @brief 索引已完成（在索引线程中发出）
+     */
+    void indexFinished();
+
+    /**
+     * @brief 读取文件出错，索引停止在出错位置（在索引线程中发出）
+     * @param error 错误描述
+     */
+    void errorOccurred(const QString &error);
+
+private:
+    /**
+     * @brief 一个分块的扫描结果
+     */
+    struct ChunkResult {
+        qint64 start = 0;                   ///< 块内第一行的起始偏移
+        qint64 end = 0;                     ///< 下一块第一行的起始偏移
+        std::vector<quint32> lineStarts;    ///< 各行相对 start 的起始偏移
+        bool done = false;                  ///< 已扫描完
+    };
+
+    /**
+     * @brief 从 start 开始的一行（与 HistoryStore 相同的折断规则）
+     * @param data 数据起始地址（一块的第一行）
+     * @param size 到下一块第一行为止的长度
+     * @param start 行起始下标
+     * @param next 输出下一行起始下标
+     * @return 行结束下标（不含 '\n'）
+     */
+    static qsizetype scanLine(const char *data, qsizetype size, qsizetype start, qsizetype *next);
+
+    /**
+     * @brief 查找块首之后的第一行起始位置
+     * @param data 数据
+     * @param size 数据长度
+     * @param from 块首下标
+     * @return 第一个 '\n' 之后的下标；SYNC_WINDOW 内没有时返回 from
+     */
+    static qsizetype syncPoint(const char *data, qsizetype size, qsizetype from);
+
+    /**
+     * @brief 索引主线程：启动扫描线程并按顺序合并结果
+     */
+    void buildIndex();
+
+    /**
+     * @brief 扫描线程：依次领取并扫描分块
+     */
+    void scanChunks();
+
+    /**
+     * @brief 扫描一个分块
+     * @return false 如果读取失败
+     */
+    bool scanChunk(QFile &file, int chunk, QByteArray &buffer, ChunkResult *result) const;
+
+    /**
+     * @brief 定位一行在文件中的范围（文本模式）
+     * @return false 如果该行尚未建立索引
+     */
+    bool locate(qsizetype index, qint64 *start, qint64 *end) const;
+
+    /**
+     * @brief 按当前编码解码一段字节（丢弃 '\r'）
+     */
+    QString decode(const char *data, qsizetype size) const;
+
+    /**
+     * @brief 停止并等待索引线程
+     */
+    void stopIndexing();
+
+    QFile m_file;                                ///< 日志文件
+    const uchar *m_data = nullptr;               ///< 文件映射
+    qint64 m_size = 0;                           ///< 文件长度
+    bool m_hexMode = false;                      ///< 十六进制显示
+    AppSettings::Encoding m_encoding = AppSettings::ANSI;
+    mutable QStringDecoder m_decoder;            ///< GBK 解码器（无状态）
+    const KeywordHighlighter *m_highlighter = nullptr;
+
+    std::unique_ptr<QThread> m_indexThread;      ///< 索引主线程
+
+    mutable QMutex m_mutex;                      ///< 保护以下索引和扫描状态
+    QWaitCondition m_wake;                       ///< 分块完成、合并推进或要求停止
+    bool m_stopping = false;                     ///< 要求索引线程退出
+    std::vector<qint64> m_checkpoints;           ///< 第 k*CHECKPOINT_STRIDE 行的起始偏移
+    std::vector<qint64> m_segments;              ///< 已合并各块第一行的起始偏移
+    qint64 m_indexedEnd = 0;                     ///< 已合并部分的结束偏移
+    qint64 m_lineCount = 0;                      ///< 已合并的行数
+    qint64 m_startNs = 0;                        ///< 开始建立索引的单调时钟
+    qint64 m_elapsedNs = 0;                      ///< 索引线程退出时写入
+    bool m_indexing = false;                     ///< 索引线程正在运行
+    bool m_finished = false;                     ///< 已扫描到文件末尾
+    int m_threads = 0;                           ///< 扫描线程数
+    std::vector<ChunkResult> m_results;          ///< 各分块的扫描结果（合并后释放）
+    int m_nextChunk = 0;                         ///< 下一个待领取的分块
+    int m_mergedChunks = 0;                      ///< 已合并的分块数
+
+    mutable qsizetype m_cursorLine = -1;         ///< 最近一次定位的行（顺序读取时从这里继续）
+    mutable qint64 m_cursorOffset = 0;           ///< 该行的起始偏移
+    mutable qsizetype m_cachedLine = -1;         ///< 最近一次解码的行
+    mutable QString m_cachedText;                ///< 该行文本（line() 与 lineSpans() 共用）
+};
+
+#endif // LOGFILE_H
@@ -0,0 +1,91 @@
+#ifndef MINMAXPYRAMID_H
+#define MINMAXPYRAMID_H
+
+#include <QtGlobal>
+
+/**
+ * @brief MinMaxPyramid - 定长采样块的多分辨率最小/最大值金字塔
+ *
+ * 第 level 层每个桶覆盖 FANOUT^(level+1) 个连续采样（8、64、512、4096），
+ * 最顶层一个桶覆盖整块。每追加一个采样只更新各层对应的一个桶（LEVELS 次比较），
+ * 与 TimeSeriesStore 的数据块一起分配、回收，整块丢弃时无需额外维护。
+ *
+ * 绘图时按可见采样数选择每像素约几个桶的层，遍历的桶数只与像素宽度有关。
+ */
+class MinMaxPyramid
+{
+public:
+    static constexpr int FANOUT_SHIFT = 3;                          ///< 每层合并 8 个下层桶
+    static constexpr int LEVELS = 4;                                ///< 层数
+    static constexpr int CAPACITY = 1 << (FANOUT_SHIFT * LEVELS);   ///< 覆盖的采样数（4096）
+
+    /**
+     * @brief 获取一层的桶大小
+     * @param level 层号（0 ~ LEVELS-1）
+     * @return 每桶覆盖的采样数
+     */
+    static constexpr int bucketSize(int level) {
+        return 1 << (FANOUT_SHIFT * (level + 1));
+    }
+
+    /**
+     * @brief 写入第 position 个采样
+     *
+     * 必须按 position 递增的顺序调用；position 为 0 时视为新块。
+     *
+     * @param position 块内位置（0 ~ CAPACITY-1）
+     * @param value 采样值
+     */
+    void update(int position, float value) {
+        int offset = 0;
+        for (int level = 0; level < LEVELS; ++level) {
+            const int shift = FANOUT_SHIFT * (level + 1);
+            const int index = offset + (position >> shift);
+            if ((position & ((1 << shift) - 1)) == 0) {
+                m_min[index] = value;
+                m_max[index] = value;
+            } else {
+                m_min[index] = qMin(m_min[index], value);
+                m_max[index] = qMax(m_max[index], value);
+            }
+            offset += CAPACITY >> shift;
+        }
+    }
+
+    /**
+     * @brief 获取桶的最小值
+     * @param level 层号
+     * @param bucket 层内桶下标
+     * @return 最小值（桶内至少写入过一个采样时有效）
+     */
+    float minimum(int level, int bucket) const {
+        return m_min[levelOffset(level) + bucket];
+    }
+
+    /**
+     * @brief 获取桶的最大值
+     * @param level 层号
+     * @param bucket 层内桶下标
+     * @return 最大值（桶内至少写入过一个采样时有效）
+     */
+    float maximum(int level, int bucket) const {
+        return m_max[levelOffset(level) + bucket];
+    }
+
+private:
+    static constexpr int levelOffset(int level) {
+        int offset = 0;
+        for (int i = 0; i < level; ++i) {
+            offset += CAPACITY >> (FANOUT_SHIFT * (i + 1));
+        }
+        return offset;
+    }
+
+    /// 所有层的桶数：8^(LEVELS-1) + ... + 8^0 = (CAPACITY - 1) / 7（512+64+8+1）
+    static constexpr int TOTAL_BUCKETS = (CAPACITY - 1) / ((1 << FANOUT_SHIFT) - 1);
+
+    float m_min[TOTAL_BUCKETS];
+    float m_max[TOTAL_BUCKETS];
+};
+
+#endif // MINMAXPYRAMID_H
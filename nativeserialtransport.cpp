@@ -0,0 +1,413 @@
+#include "nativeserialtransport.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QSocketNotifier>
+#include <QTimer>
+
+#include <asm/ioctls.h>
+#include <asm/termbits.h>
+#include <linux/serial.h>
+#include <sys/epoll.h>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+// <sys/ioctl.h> 会间接包含 glibc 的 termios 定义，与 <asm/termbits.h> 的 termios2 冲突
+extern "C" int ioctl(int fd, unsigned long request, ...);
+
+/**
+ * @brief NativeSerialTransport 实现
+ */
+
+namespace {
+
+constexpr qsizetype MAX_TX_QUEUE = 16 * 1024 * 1024;  ///< 发送队列上限（设备长时间不可写时拒绝新数据）
+
+QString sysError(int err)
+{
+    return QString::fromLocal8Bit(std::strerror(err));
+}
+
+} // namespace
+
+NativeSerialTransport::NativeSerialTransport(QObject *parent)
+    : SerialTransport(parent)
+{
+}
+
+NativeSerialTransport::~NativeSerialTransport()
+{
+    close();
+}
+
+bool NativeSerialTransport::open(const SerialConfig &config)
+{
+    close();
+    m_errorString.clear();
+
+    // portName 可以是 ttyUSB0 形式，也可以是完整路径
+    const QString path = config.portName.startsWith(QLatin1Char('/'))
+        ? config.portName
+        : QStringLiteral("/dev/") + config.portName;
+
+    m_fd = ::open(QFile::encodeName(path).constData(), O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+    if (m_fd < 0) {
+        const int err = errno;
+        if (err == ENOENT || err == ENODEV || err == ENXIO) {
+            setError(QStringLiteral("Device not found"));
+        } else if (err == EACCES || err == EPERM) {
+            setError(QStringLiteral("Permission denied"));
+        } else {
+            setError(QStringLiteral("Failed to open port"), err);
+        }
+        return false;
+    }
+
+    // 与 QSerialPort 一致，独占打开
+    if (::ioctl(m_fd, TIOCEXCL) < 0 && errno != ENOTTY) {
+        const int err = errno;
+        close();
+        setError(QStringLiteral("Failed to open port"), err);
+        return false;
+    }
+
+    if (!applySettings(config)) {
+        close();
+        return false;
+    }
+    enableLowLatency(config);
+
+    m_epollFd = ::epoll_create1(EPOLL_CLOEXEC);
+    epoll_event event = {};
+    event.events = EPOLLIN | EPOLLRDHUP;
+    event.data.fd = m_fd;
+    if (m_epollFd < 0 || ::epoll_ctl(m_epollFd, EPOLL_CTL_ADD, m_fd, &event) < 0) {
+        const int err = errno;
+        close();
+        setError(QStringLiteral("Failed to open port"), err);
+        return false;
+    }
+
+    m_failed = false;
+    m_streaming = false;
+    m_readSinceDrain = false;
+
+    m_notifier = new QSocketNotifier(m_epollFd, QSocketNotifier::Read, this);
+    connect(m_notifier, &QSocketNotifier::activated, this, &NativeSerialTransport::onActivated);
+
+    m_txQueue.clear();
+    m_txOffset = 0;
+    m_writeNotifier = new QSocketNotifier(m_fd, QSocketNotifier::Write, this);
+    m_writeNotifier->setEnabled(false);
+    connect(m_writeNotifier, &QSocketNotifier::activated, this, &NativeSerialTransport::onWritable);
+
+    // VMIN > 1 时内核只在累积够 VMIN 字节后唤醒，尾部数据靠定时读取取走；
+    // 定时器在 read() 读到数据后才启动
+    m_vmin = qBound(1, config.nativeVmin, 255);
+    if (m_vmin > 1) {
+        m_drainTimer = new QTimer(this);
+        m_drainTimer->setTimerType(Qt::PreciseTimer);
+        m_drainTimer->setSingleShot(true);
+        m_drainTimer->setInterval(qMax(2, config.batchLatencyMs));
+        connect(m_drainTimer, &QTimer::timeout, this, &NativeSerialTransport::onDrainTimeout);
+    }
+
+    return true;
+}
+
+bool NativeSerialTransport::applySettings(const SerialConfig &config)
+{
+    termios2 tio = {};
+    if (::ioctl(m_fd, TCGETS2, &tio) < 0) {
+        setError(QStringLiteral("Failed to read port settings"), errno);
+        return false;
+    }
+
+    // 原始模式（与 cfmakeraw 相同）
+    tio.c_iflag &= ~(IGNBRK | BRKINT | PARMRK | ISTRIP | INLCR | IGNCR | ICRNL | IXON | IXOFF | IXANY);
+    tio.c_oflag &= ~OPOST;
+    tio.c_lflag &= ~(ECHO | ECHONL | ICANON | ISIG | IEXTEN);
+    tio.c_cflag &= ~(CSIZE | PARENB | PARODD | CMSPAR | CSTOPB | CRTSCTS);
+    tio.c_cflag |= CREAD | CLOCAL;
+
+    // 任意波特率：输入输出都使用 BOTHER
+    tio.c_cflag &= ~(CBAUD | (CBAUD << IBSHIFT));
+    tio.c_cflag |= BOTHER | (BOTHER << IBSHIFT);
+    tio.c_ispeed = static_cast<speed_t>(config.baudRate);
+    tio.c_ospeed = static_cast<speed_t>(config.baudRate);
+
+    switch (config.dataBits) {
+    case QSerialPort::Data5: tio.c_cflag |= CS5; break;
+    case QSerialPort::Data6: tio.c_cflag |= CS6; break;
+    case QSerialPort::Data7: tio.c_cflag |= CS7; break;
+    default:                 tio.c_cflag |= CS8; break;
+    }
+
+    switch (config.parity) {
+    case QSerialPort::EvenParity:  tio.c_cflag |= PARENB; break;
+    case QSerialPort::OddParity:   tio.c_cflag |= PARENB | PARODD; break;
+    case QSerialPort::SpaceParity: tio.c_cflag |= PARENB | CMSPAR; break;
+    case QSerialPort::MarkParity:  tio.c_cflag |= PARENB | CMSPAR | PARODD; break;
+    default: break;
+    }
+    if (config.parity != QSerialPort::NoParity) {
+        tio.c_iflag |= INPCK;
+    } else {
+        tio.c_iflag &= ~INPCK;
+    }
+
+    if (config.stopBits == QSerialPort::TwoStop) {
+        tio.c_cflag |= CSTOPB;
+    } else if (config.stopBits == QSerialPort::OneAndHalfStop) {
+        setError(QStringLiteral("1.5 stop bits are not supported by the native backend"));
+        return false;
+    }
+
+    if (config.flowControl == QSerialPort::HardwareControl) {
+        tio.c_cflag |= CRTSCTS;
+    } else if (config.flowControl == QSerialPort::SoftwareControl) {
+        tio.c_iflag |= IXON | IXOFF;
+    }
+
+    // 打开时线路视为空闲，第一个字节即唤醒；收到数据后 read() 再提高到配置的 VMIN
+    tio.c_cc[VMIN] = 1;
+    tio.c_cc[VTIME] = 0;
+
+    if (::ioctl(m_fd, TCSETS2, &tio) < 0) {
+        const int err = errno;
+        if (err == EINVAL) {
+            setError(QStringLiteral("Baud rate %1 is not supported by the device").arg(config.baudRate));
+        } else {
+            setError(QStringLiteral("Failed to apply port settings"), err);
+        }
+        return false;
+    }
+
+    // 丢弃打开前残留的数据
+    ::ioctl(m_fd, TCFLSH, TCIOFLUSH);
+    return true;
+}
+
+void NativeSerialTransport::enableLowLatency(const SerialConfig &config)
+{
+    // 串口驱动的低延迟标志（8250、部分 USB 驱动），不支持时忽略
+    serial_struct serial = {};
+    if (::ioctl(m_fd, TIOCGSERIAL, &serial) == 0) {
+        serial.flags |= ASYNC_LOW_LATENCY;
+        ::ioctl(m_fd, TIOCSSERIAL, &serial);
+    }
+
+    // FTDI 等 USB 转串口默认 16ms 的 latency_timer，需要写权限，失败时忽略
+    const QString name = QFileInfo(config.portName).fileName();
+    QFile latency(QStringLiteral("/sys/class/tty/%1/device/latency_timer").arg(name));
+    if (latency.open(QIODevice::WriteOnly)) {
+        latency.write("1");
+    }
+}
+
+void NativeSerialTransport::setVmin(int vmin)
+{
+    termios2 tio = {};
+    if (::ioctl(m_fd, TCGETS2, &tio) < 0) {
+        return;
+    }
+    tio.c_cc[VMIN] = static_cast<cc_t>(vmin);
+    // TCSETS2 立即生效且不清空输入缓冲区，失败时保持原值
+    ::ioctl(m_fd, TCSETS2, &tio);
+}
+
+void NativeSerialTransport::close()
+{
+    if (m_drainTimer) {
+        delete m_drainTimer;
+        m_drainTimer = nullptr;
+    }
+    if (m_notifier) {
+        delete m_notifier;
+        m_notifier = nullptr;
+    }
+    if (m_writeNotifier) {
+        delete m_writeNotifier;
+        m_writeNotifier = nullptr;
+    }
+    m_txQueue.clear();
+    m_txOffset = 0;
+    if (m_epollFd >= 0) {
+        ::close(m_epollFd);
+        m_epollFd = -1;
+    }
+    if (m_fd >= 0) {
+        ::close(m_fd);
+        m_fd = -1;
+    }
+}
+
+bool NativeSerialTransport::isOpen() const
+{
+    return m_fd >= 0;
+}
+
+qint64 NativeSerialTransport::read(char *data, qint64 maxSize)
+{
+    if (m_fd < 0 || m_failed) {
+        return -1;
+    }
+
+    for (;;) {
+        const ssize_t n = ::read(m_fd, data, static_cast<size_t>(maxSize));
+        if (n > 0) {
+            m_readSinceDrain = true;
+            // 开始收到数据：提高 VMIN，由定时读取取走尾部数据
+            if (m_drainTimer && !m_streaming) {
+                m_streaming = true;
+                setVmin(m_vmin);
+                m_drainTimer->start();
+            }
+            return n;
+        }
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n < 0 && errno == EAGAIN) {
+            return 0;
+        }
+        // n == 0：设备已断开
+        reportReadFailure(n == 0 ? EIO : errno);
+        return -1;
+    }
+}
+
+qint64 NativeSerialTransport::write(const QByteArray &data)
+{
+    if (m_fd < 0) {
+        m_errorString = QStringLiteral("Serial port is not open");
+        return -1;
+    }
+    if (m_txQueue.size() - m_txOffset + data.size() > MAX_TX_QUEUE) {
+        m_errorString = QStringLiteral("Write buffer full");
+        return -1;
+    }
+
+    m_txQueue.append(data);
+    if (!m_writeNotifier->isEnabled() && !flushTx()) {
+        return -1;
+    }
+    return data.size();
+}
+
+bool NativeSerialTransport::flushTx()
+{
+    while (m_txOffset < m_txQueue.size()) {
+        const ssize_t n = ::write(m_fd, m_txQueue.constData() + m_txOffset,
+                                  static_cast<size_t>(m_txQueue.size() - m_txOffset));
+        if (n > 0) {
+            m_txOffset += n;
+            continue;
+        }
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n < 0 && errno == EAGAIN) {
+            // 输出缓冲区满：等设备可写时再继续；已写部分较多时才压缩队列
+            if (m_txOffset > m_txQueue.size() / 2) {
+                m_txQueue.remove(0, m_txOffset);
+                m_txOffset = 0;
+            }
+            m_writeNotifier->setEnabled(true);
+            return true;
+        }
+
+        m_errorString = QStringLiteral("Write error: %1").arg(sysError(n < 0 ? errno : EIO));
+        m_txQueue.clear();
+        m_txOffset = 0;
+        m_writeNotifier->setEnabled(false);
+        return false;
+    }
+
+    m_txQueue.clear();
+    m_txOffset = 0;
+    m_writeNotifier->setEnabled(false);
+    return true;
+}
+
+QString NativeSerialTransport::errorString() const
+{
+    return m_errorString;
+}
+
+void NativeSerialTransport::onActivated()
+{
+    if (m_epollFd < 0) {
+        return;
+    }
+
+    // 清除 epoll 就绪状态，检测挂断
+    epoll_event events[4];
+    const int count = ::epoll_wait(m_epollFd, events, 4, 0);
+    bool hangup = false;
+    for (int i = 0; i < count; ++i) {
+        hangup |= (events[i].events & (EPOLLHUP | EPOLLERR)) != 0;
+    }
+
+    // 先让调用者取走挂断前的剩余数据
+    emit readyRead();
+    if (hangup) {
+        reportReadFailure(EIO);
+    }
+}
+
+void NativeSerialTransport::onDrainTimeout()
+{
+    emit readyRead();
+    if (m_failed || m_fd < 0) {
+        return;
+    }
+
+    // 这个周期内（含本次）读到过数据：继续定时读取
+    if (m_readSinceDrain) {
+        m_readSinceDrain = false;
+        m_drainTimer->start();
+        return;
+    }
+
+    // 线路空闲：恢复 VMIN 为 1，之后的第一个字节由 epoll 唤醒；
+    // 再读一次，取走修改 VMIN 之前到达、不足 VMIN 的数据
+    m_streaming = false;
+    setVmin(1);
+    emit readyRead();
+}
+
+void NativeSerialTransport::onWritable()
+{
+    if (m_fd >= 0 && !flushTx()) {
+        emit errorOccurred(m_errorString);
+    }
+}
+
+void NativeSerialTransport::reportReadFailure(int err)
+{
+    if (m_failed) {
+        return;
+    }
+    m_failed = true;
+    if (m_notifier) {
+        m_notifier->setEnabled(false);
+    }
+    if (m_drainTimer) {
+        m_drainTimer->stop();
+    }
+
+    if (err == EIO || err == ENXIO || err == ENODEV) {
+        setError(QStringLiteral("Resource error (device may have been disconnected)"));
+    } else {
+        setError(QStringLiteral("Read error"), err);
+    }
+}
+
+void NativeSerialTransport::setError(const QString &message, int err)
+{
+    m_errorString = err ? QStringLiteral("%1: %2").arg(message, sysError(err)) : message;
+    emit errorOccurred(m_errorString);
+}
@@ -0,0 +1,122 @@
+#ifndef NATIVESERIALTRANSPORT_H
+#define NATIVESERIALTRANSPORT_H
+
+#include <QByteArray>
+#include <QString>
+
+#include "serialtransport.h"
+
+class QSocketNotifier;
+class QTimer;
+
+/**
+ * @brief NativeSerialTransport - Linux 原生串口传输层
+ *
+ * 绕过 QSerialPort 直接操作 tty 设备：
+ * - termios2 + BOTHER 设置任意波特率（如 250000、1843200）
+ * - 尽力开启低延迟：ASYNC_LOW_LATENCY 与 USB 转串口的 latency_timer
+ * - VMIN 由配置决定：高波特率时让内核累积多字节再唤醒，减少唤醒次数。
+ *   线路空闲时 VMIN 为 1，收到数据后才提高到配置值并启动定时读取，
+ *   取走不足 VMIN 的尾部数据（延迟不超过读取合并的最大延迟）；
+ *   一个周期内没有新数据时停止定时器并恢复 VMIN 为 1，空闲的串口没有定时唤醒
+ * - epoll 描述符交给 QSocketNotifier，接入工作线程的事件循环；
+ *   数据由 read() 直接从设备读入调用者的接收块
+ * - write() 不阻塞：先写入设备能接收的部分，其余放入发送队列，
+ *   设备可写时由写通知继续发送（工作线程由多个串口共享，不能等待）
+ *
+ * 只在 Linux 下编译，必须在工作线程中创建和使用。
+ */
+class NativeSerialTransport : public SerialTransport
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief 构造函数
+     * @param parent 父对象
+     */
+    explicit NativeSerialTransport(QObject *parent = nullptr);
+
+    /**
+     * @brief 析构函数（关闭串口）
+     */
+    ~NativeSerialTransport() override;
+
+    bool open(const SerialConfig &config) override;
+    void close() override;
+    bool isOpen() const override;
+    qint64 read(char *data, qint64 maxSize) override;
+    qint64 write(const QByteArray &data) override;
+    QString errorString() const override;
+
+private slots:
+    /**
+     * @brief epoll 描述符就绪时通知读取，检测设备挂断
+     */
+    void onActivated();
+
+    /**
+     * @brief 定时取走不足 VMIN 的数据，一个周期内没有数据时转为空闲
+     */
+    void onDrainTimeout();
+
+    /**
+     * @brief 设备可写时继续发送队列中的数据
+     */
+    void onWritable();
+
+private:
+    /**
+     * @brief 按配置设置 termios2（原始模式、波特率、数据位、校验、停止位、流控、VMIN）
+     * @return true 如果设置成功
+     */
+    bool applySettings(const SerialConfig &config);
+
+    /**
+     * @brief 尽力开启低延迟模式，失败时忽略
+     */
+    void enableLowLatency(const SerialConfig &config);
+
+    /**
+     * @brief 修改 VMIN（不清空缓冲区）
+     * @param vmin 新的 VMIN
+     */
+    void setVmin(int vmin);
+
+    /**
+     * @brief 把发送队列写入设备，直到写完或设备输出缓冲区满
+     *
+     * 队列中还有数据时开启写通知，写完时关闭。
+     *
+     * @return false 如果写入失败（m_errorString 已设置，队列已清空）
+     */
+    bool flushTx();
+
+    /**
+     * @brief 记录错误并发出 errorOccurred
+     * @param message 错误描述
+     * @param err 系统错误码，0 表示无
+     */
+    void setError(const QString &message, int err = 0);
+
+    /**
+     * @brief 设备断开或读取失败时停止监听并报告
+     * @param err 系统错误码
+     */
+    void reportReadFailure(int err);
+
+    int m_fd = -1;                          ///< tty 文件描述符
+    int m_epollFd = -1;                     ///< epoll 文件描述符
+    QSocketNotifier *m_notifier = nullptr;  ///< 监听 m_epollFd
+    QSocketNotifier *m_writeNotifier = nullptr; ///< 监听 m_fd 可写（只在发送队列非空时开启）
+    QTimer *m_drainTimer = nullptr;         ///< VMIN > 1 时定时取走不足 VMIN 的数据（只在收到数据后运行）
+    QByteArray m_txQueue;                   ///< 发送队列
+    qsizetype m_txOffset = 0;               ///< 发送队列中已写入设备的字节数
+    int m_vmin = 1;                         ///< 收到数据后使用的 VMIN
+    bool m_streaming = false;               ///< 正在收到数据（VMIN 已提高，定时读取运行中）
+    bool m_readSinceDrain = false;          ///< 上次定时读取之后读到过数据
+    bool m_failed = false;                  ///< 已报告读取失败（只报告一次）
+    QString m_errorString;                  ///< 最近一次错误描述
+};
+
+#endif // NATIVESERIALTRANSPORT_H
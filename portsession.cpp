@@ -0,0 +1,531 @@
+#include "portsession.h"
+#include "appsettings.h"
+#include "receiveview.h"
+#include "timestampformatter.h"
+
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QRegularExpression>
+#include <QScrollBar>
+#include <atomic>
+#include <limits>
+
+/**
+ * @brief PortSession 实现
+ *
+ * Requirements: 1.3, 6.1, 6.2, 6.3, 6.4
+ */
+
+PortSession::PortSession(ReceiveView *view, QObject *parent)
+    : QObject(parent)
+    , m_view(view)
+    , m_worker(new SerialWorker())
+    , m_replay(new ReplaySource())
+    , m_pipeline(new DataPipeline())
+    , m_refreshTimer(new QTimer(this))
+    , m_speedMonitor(new SpeedMonitor(this))
+    , m_capture(new CaptureWriter(this))
+    , m_log(new LogFile(this))
+    , m_search(new HistorySearch(this))
+{
+    static std::atomic<quint16> nextPortId{0};
+    m_portId = nextPortId++;
+
+    // 原始数据直接排队进入处理线程，不经过 UI 线程
+    connect(m_worker, &SerialWorker::dataReceived, m_pipeline, &DataPipeline::process);
+    // 捕获在串口线程中直接入队（只增加块引用，不拷贝、不等待磁盘）
+    connect(m_worker, &SerialWorker::dataReceived, m_capture, &CaptureWriter::append, Qt::DirectConnection);
+    connect(m_capture, &CaptureWriter::errorOccurred, this, &PortSession::errorOccurred);
+    connect(m_worker, &SerialWorker::errorOccurred, this, [this]() {
+        // 打开失败时不会发出 stopped，在这里结束为本次打开准备的捕获
+        if (!m_worker->isRunning()) {
+            m_capture->stop();
+        }
+    });
+    connect(m_worker, &SerialWorker::errorOccurred, this, &PortSession::errorOccurred);
+    connect(m_worker, &SerialWorker::started, this, &PortSession::onStarted);
+    connect(m_worker, &SerialWorker::stopped, this, &PortSession::onStopped);
+
+    // 回放与串口走同一条处理链路（回放数据不再写入捕获）
+    connect(m_replay, &ReplaySource::dataReceived, m_pipeline, &DataPipeline::process);
+    connect(m_replay, &ReplaySource::errorOccurred, this, &PortSession::errorOccurred);
+    connect(m_replay, &ReplaySource::started, this, &PortSession::onStarted);
+    connect(m_replay, &ReplaySource::stopped, this, &PortSession::onStopped);
+    m_replay->setProcessedBytesProbe([pipeline = m_pipeline]() {
+        return pipeline->processedBytes();
+    });
+
+    connect(m_pipeline, &DataPipeline::drained, this, &PortSession::onRefreshTimeout);
+
+    // 日志索引在后台推进，行数增加后刷新滚动范围
+    connect(m_log, &LogFile::indexProgress, this, [this]() {
+        if (m_view->source() == m_log) {
+            m_view->updateSource();
+        }
+        emit titleChanged();
+    });
+    connect(m_log, &LogFile::errorOccurred, this, &PortSession::errorOccurred);
+    connect(m_view, &ReceiveView::closeSourceRequested, this, &PortSession::closeLog);
+
+    m_refreshTimer->setTimerType(Qt::PreciseTimer);
+    m_refreshTimer->setInterval(REFRESH_INTERVAL_MS);
+    connect(m_refreshTimer, &QTimer::timeout, this, &PortSession::onRefreshTimeout);
+
+    connect(m_view->verticalScrollBar(), &QScrollBar::valueChanged, this, &PortSession::onScrollValueChanged);
+    connect(m_speedMonitor, &SpeedMonitor::speedUpdated, this, &PortSession::speedUpdated);
+
+    // 与处理相关的全局设置（线程安全，实际修改在处理线程中执行）
+    AppSettings *settings = AppSettings::instance();
+    m_pipeline->setEncoding(settings->encoding());
+    m_log->setEncoding(settings->encoding());
+    m_pipeline->setHexNewlineEnabled(settings->hexNewlineEnabled());
+    m_pipeline->setQueueBudget(qint64(settings->displayQueueBudgetMB()) << 20);
+    m_pipeline->setOverflowPolicy(settings->overflowPolicy());
+    m_pipeline->setLineIdleTimeout(settings->lineIdleTimeoutMs());
+    m_pipeline->setFrameConfig(settings->frameConfig());
+    m_pipeline->setChannelMode(static_cast<ChannelParser::Mode>(settings->channelMode()));
+    m_pipeline->setSeriesBudget(qint64(settings->waveMemoryMB()) << 20, qint64(settings->waveDiskMB()) << 20);
+    StructLayout layout;
+    layout.compile(settings->structLayout());
+    m_pipeline->setStructLayout(layout);
+    connect(settings, &AppSettings::encodingChanged, this, [this](AppSettings::Encoding encoding) {
+        m_pipeline->setEncoding(encoding);
+        m_log->setEncoding(encoding);
+        if (m_view->source() == m_log) {
+            m_view->updateSource();
+        }
+    });
+    connect(settings, &AppSettings::hexNewlineEnabledChanged, this, [this](bool enabled) {
+        m_pipeline->setHexNewlineEnabled(enabled);
+    });
+    connect(settings, &AppSettings::displayQueueBudgetMBChanged, this, [this](int megabytes) {
+        m_pipeline->setQueueBudget(qint64(megabytes) << 20);
+    });
+    connect(settings, &AppSettings::overflowPolicyChanged, this, [this](AppSettings::OverflowPolicy policy) {
+        m_pipeline->setOverflowPolicy(policy);
+    });
+    connect(settings, &AppSettings::lineIdleTimeoutMsChanged, this, [this](int milliseconds) {
+        m_pipeline->setLineIdleTimeout(milliseconds);
+    });
+    connect(settings, &AppSettings::frameConfigChanged, this, [this](const FrameConfig &config) {
+        m_pipeline->setFrameConfig(config);
+    });
+    connect(settings, &AppSettings::channelModeChanged, this, [this](int mode) {
+        m_pipeline->setChannelMode(static_cast<ChannelParser::Mode>(mode));
+    });
+    auto applySeriesBudget = [this]() {
+        AppSettings *settings = AppSettings::instance();
+        m_pipeline->setSeriesBudget(qint64(settings->waveMemoryMB()) << 20, qint64(settings->waveDiskMB()) << 20);
+    };
+    connect(settings, &AppSettings::waveMemoryMBChanged, this, applySeriesBudget);
+    connect(settings, &AppSettings::waveDiskMBChanged, this, applySeriesBudget);
+    connect(settings, &AppSettings::structLayoutChanged, this, [this](const QString &text) {
+        // 设置中保存的布局已校验过；无效时保持为空（不解码）
+        StructLayout layout;
+        layout.compile(text);
+        m_pipeline->setStructLayout(layout);
+    });
+    connect(settings, &AppSettings::captureConfigChanged, this, [this](const CaptureConfig &config) {
+        // 打开期间修改：按新配置重新开始（切换到新文件）或停止
+        if (!m_worker->isRunning()) {
+            return;
+        }
+        if (config.enabled) {
+            startCapture();
+        } else {
+            m_capture->stop();
+        }
+    });
+}
+
+PortSession::~PortSession()
+{
+    m_refreshTimer->stop();
+    if (m_worker->isRunning()) {
+        m_worker->stop();
+    }
+    // 先释放数据来源，之后不再有数据进入处理线程和捕获队列
+    delete m_replay;
+    delete m_worker;
+    delete m_pipeline;
+    m_capture->stop();
+}
+
+ReceiveView *PortSession::view() const
+{
+    return m_view;
+}
+
+SerialWorker *PortSession::worker() const
+{
+    return m_worker;
+}
+
+DataPipeline *PortSession::pipeline() const
+{
+    return m_pipeline;
+}
+
+SpeedMonitor *PortSession::speedMonitor() const
+{
+    return m_speedMonitor;
+}
+
+CaptureWriter *PortSession::capture() const
+{
+    return m_capture;
+}
+
+ReplaySource *PortSession::replay() const
+{
+    return m_replay;
+}
+
+bool PortSession::isRunning() const
+{
+    return m_worker->isRunning() || m_replay->isRunning();
+}
+
+bool PortSession::isReplaying() const
+{
+    return m_replaying;
+}
+
+SerialConfig PortSession::config() const
+{
+    return m_config;
+}
+
+QString PortSession::title() const
+{
+    if (m_log->isOpen()) {
+        const LogIndexStats stats = m_log->stats();
+        QString title = "日志 " + QFileInfo(m_log->path()).fileName();
+        if (!stats.finished && stats.fileSize > 0) {
+            title += QString(" (%1%)").arg(stats.indexedBytes * 100 / stats.fileSize);
+        }
+        return title;
+    }
+    if (m_replaying) {
+        return "回放 " + QFileInfo(m_replay->config().path).fileName();
+    }
+    return m_config.portName.isEmpty() ? QStringLiteral("未连接") : m_config.portName;
+}
+
+void PortSession::start(const SerialConfig &config)
+{
+    if (m_replay->isRunning()) {
+        emit errorOccurred("正在回放，请先停止回放");
+        return;
+    }
+    m_replaying = false;
+    m_replayReportPending = false;
+    m_config = config;
+    // 先于串口启动，第一块数据就能进入捕获
+    if (!m_worker->isRunning() && AppSettings::instance()->captureConfig().enabled) {
+        startCapture();
+    }
+    m_worker->start(config);
+}
+
+void PortSession::startReplay(const ReplayConfig &config)
+{
+    if (isRunning()) {
+        emit errorOccurred("请先关闭串口或停止当前回放");
+        return;
+    }
+    m_replaying = true;
+    m_replayReportPending = false;
+    m_replay->start(config);
+}
+
+void PortSession::stop()
+{
+    if (m_replay->isRunning()) {
+        m_replay->stop();
+    } else {
+        m_worker->stop();
+    }
+}
+
+void PortSession::send(const QByteArray &data, const QString &echo)
+{
+    if (m_replay->isRunning()) {
+        emit errorOccurred("回放时不能发送数据");
+        return;
+    }
+    m_pipeline->appendText(echo + "\r\n");
+    m_pipeline->drain();
+    if (m_worker->isRunning()) {
+        m_capture->appendTransmit(data, TimestampFormatter::monotonicNs());
+    }
+    m_worker->sendData(data);
+}
+
+void PortSession::showSystemMessage(const QString &message)
+{
+    // 经处理线程分行和高亮，drained 时立即刷新（串口关闭时刷新定时器不运行）
+    m_pipeline->appendText("SYSINFO >> " + message + "\r\n");
+    m_pipeline->drain();
+}
+
+void PortSession::clear()
+{
+    if (m_log->isOpen()) {
+        closeLog();
+        return;
+    }
+    m_view->clear();
+    m_pipeline->clear();
+    if (m_search->isActive()) {
+        m_search->update(m_view->store());
+    }
+    m_pacer.reset();
+    m_skippedBytes = 0;
+
+    // Reset speed monitor counters - Requirements: 3.3
+    m_speedMonitor->reset();
+}
+
+bool PortSession::openLog(const QString &path)
+{
+    AppSettings *settings = AppSettings::instance();
+    m_log->setHighlighter(m_view->highlighter());
+    m_log->setHexMode(settings->hexDisplayEnabled());
+
+    QString error;
+    if (!m_log->open(path, &error)) {
+        m_view->setSource(nullptr);
+        emit titleChanged();
+        emit errorOccurred(error);
+        return false;
+    }
+    m_view->setSource(m_log);
+    emit titleChanged();
+    return true;
+}
+
+void PortSession::closeLog()
+{
+    if (!m_log->isOpen()) {
+        return;
+    }
+    m_view->setSource(nullptr);
+    m_autoScroll = true;
+    m_log->close();
+    emit titleChanged();
+}
+
+void PortSession::setLogHexMode(bool enabled)
+{
+    if (m_log->hexMode() == enabled) {
+        return;
+    }
+    m_log->setHexMode(enabled);
+    // 行号随显示格式改变，从头显示
+    if (m_view->source() == m_log) {
+        m_view->setSource(m_log);
+    }
+}
+
+LogFile *PortSession::log() const
+{
+    return m_log;
+}
+
+HistorySearch *PortSession::search() const
+{
+    return m_search;
+}
+
+void PortSession::setActive(bool active)
+{
+    if (m_active == active) {
+        return;
+    }
+    m_active = active;
+    m_pacer.reset();
+    updateRefreshInterval();
+
+    // 切到前台时立即显示后台期间积压的数据
+    if (m_active) {
+        onRefreshTimeout();
+    }
+}
+
+void PortSession::updateRefreshInterval()
+{
+    m_refreshTimer->setInterval(m_active ? m_pacer.interval() : FramePacer::MAX_INTERVAL_MS);
+}
+
+void PortSession::startCapture()
+{
+    CaptureConfig config = AppSettings::instance()->captureConfig();
+    // "/dev/ttyUSB0" -> "ttyUSB0"，"COM3" -> "COM3"
+    QString baseName = QFileInfo(m_config.portName).fileName();
+    baseName.replace(QRegularExpression("[^A-Za-z0-9_.-]"), "_");
+    if (!baseName.isEmpty()) {
+        config.baseName = baseName;
+    }
+    config.portId = m_portId;
+
+    QString error;
+    if (!m_capture->start(config, &error)) {
+        showSystemMessage("无法开始捕获: " + error);
+    }
+}
+
+void PortSession::onRefreshTimeout()
+{
+    // 后台会话不可见，不会绘制：一次取走全部数据写入历史，代价只有追加
+    if (!m_active) {
+        DisplayBatch batch = m_pipeline->takeBatch(std::numeric_limits<qsizetype>::max());
+        m_speedMonitor->recordBytes(batch.rawBytes);
+        if (!batch.text.isEmpty()) {
+            m_view->appendText(batch.text, batch.spans, batch.replacesOpenLine);
+            if (m_autoScroll && !m_log->isOpen()) {
+                m_view->scrollToBottom();
+            }
+            if (m_search->isActive()) {
+                m_search->update(m_view->store());
+            }
+        }
+        if (!isRunning()) {
+            m_refreshTimer->stop();
+        }
+        reportReplayIfDrained();
+        return;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    const qsizetype incoming = m_pipeline->pendingChars();
+    DisplayBatch batch;
+    if (m_pacer.isSummaryMode()) {
+        qint64 skipped = 0;
+        batch = m_pipeline->takeSummary(m_pacer.charBudget(), [this](qint64 bytes) {
+            return QString("SYSINFO >> 显示跟不上接收速度，已跳过约 %1（累计 %2）")
+                .arg(SpeedMonitor::formatBytes(bytes),
+                     SpeedMonitor::formatBytes(m_skippedBytes + bytes));
+        }, &skipped);
+        m_skippedBytes += skipped;
+    } else {
+        batch = m_pipeline->takeBatch(m_pacer.charBudget());
+    }
+
+    m_speedMonitor->recordBytes(batch.rawBytes);
+    if (!batch.text.isEmpty()) {
+        m_view->appendText(batch.text, batch.spans, batch.replacesOpenLine);
+        if (m_autoScroll && !m_log->isOpen()) {
+            m_view->scrollToBottom();
+        }
+        if (m_search->isActive()) {
+            m_search->update(m_view->store());
+        }
+    }
+
+    // 绘制在本函数返回后才发生，用上一次的绘制耗时近似
+    m_pacer.frameFinished(timer.nsecsElapsed() + m_view->lastPaintNs(),
+                          batch.text.size(), incoming);
+    updateRefreshInterval();
+
+    if (m_pipeline->pendingChars() > 0) {
+        if (!m_refreshTimer->isActive()) {
+            m_refreshTimer->start();
+        }
+    } else if (!isRunning()) {
+        m_refreshTimer->stop();
+    }
+    reportReplayIfDrained();
+}
+
+void PortSession::onStarted()
+{
+    if (m_replaying) {
+        const ReplayConfig config = m_replay->config();
+        showSystemMessage(QString("开始回放 %1（%2）").arg(QFileInfo(config.path).fileName(),
+            config.isMaxSpeed() ? QStringLiteral("尽可能快") : QString("×%1").arg(config.speed)));
+        m_replayQueueBase = m_pipeline->queueStats();
+    } else {
+        showSystemMessage("串口已连接！");
+    }
+
+    // Start speed monitoring - Requirements: 1.3, 3.2
+    m_speedMonitor->reset();
+    m_speedMonitor->start();
+
+    m_pacer.reset();
+    m_skippedBytes = 0;
+    updateRefreshInterval();
+    m_refreshTimer->start();
+
+    emit started();
+}
+
+void PortSession::onStopped()
+{
+    // 刷新定时器在积压数据显示完后自行停止
+
+    // Stop speed monitoring - Requirements: 1.3
+    m_speedMonitor->stop();
+
+    // 串口线程已停止，捕获写完队列中的数据后关闭文件
+    m_capture->stop();
+
+    // 等处理线程把已排队的数据处理完，再做最后一次刷新
+    m_pipeline->drain();
+    if (m_replaying && !m_replay->stats().started) {
+        // 捕获文件打开失败（错误已报告），会话回到未连接状态
+        m_replaying = false;
+    } else if (m_replaying) {
+        // 统计等接收区取空显示队列后再显示
+        m_replayReportPending = true;
+        reportReplayIfDrained();
+    } else {
+        showSystemMessage("串口已关闭！");
+    }
+
+    emit stopped();
+}
+
+void PortSession::reportReplayIfDrained()
+{
+    if (!m_replayReportPending || m_pipeline->pendingChars() > 0) {
+        return;
+    }
+    m_replayReportPending = false;
+
+    // 尽可能快地回放到末尾时，平均速度是处理线程、显示队列和接收区插入的端到端吞吐
+    const ReplayStats stats = m_replay->stats();
+    const qint64 elapsedNs = qMax<qint64>(1, TimestampFormatter::monotonicNs() - stats.startNs);
+    QString message = QString("回放%1：%2 条记录，%3，端到端用时 %4 s，平均 %5")
+        .arg(stats.finished ? QStringLiteral("结束") : QStringLiteral("已停止"))
+        .arg(stats.records)
+        .arg(SpeedMonitor::formatBytes(stats.bytes))
+        .arg(QString::number(double(elapsedNs) / 1e9, 'f', 3))
+        .arg(SpeedMonitor::formatSpeed(double(stats.bytes) * 1e9 / double(elapsedNs)));
+
+    // 清空接收区会重置队列统计，差值按 0 计
+    const QueueStats queue = m_pipeline->queueStats();
+    const qint64 dropped = qMax<qint64>(0, queue.droppedBytes - m_replayQueueBase.droppedBytes);
+    const qint64 spilled = qMax<qint64>(0, queue.spilledTotal - m_replayQueueBase.spilledTotal);
+    if (dropped > 0 || spilled > 0 || m_skippedBytes > 0) {
+        message += QString("（显示队列丢弃 %1、溢出到磁盘 %2，摘要跳过约 %3）")
+            .arg(SpeedMonitor::formatBytes(dropped),
+                 SpeedMonitor::formatBytes(spilled),
+                 SpeedMonitor::formatBytes(m_skippedBytes));
+    }
+    showSystemMessage(message);
+}
+
+void PortSession::onScrollValueChanged(int value)
+{
+    // 查看日志时滚动的是日志，不影响接收历史的自动滚动
+    if (m_log->isOpen()) {
+        return;
+    }
+    // 自动滚动暂停/恢复 - Requirements: 6.4
+    QScrollBar *scrollBar = m_view->verticalScrollBar();
+    m_autoScroll = (value >= scrollBar->maximum() - 10);
+}
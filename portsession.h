@@ -0,0 +1,255 @@
+#ifndef PORTSESSION_H
+#define PORTSESSION_H
+
+#include <QObject>
+#include <QTimer>
+
+#include "capturewriter.h"
+#include "datapipeline.h"
+#include "framepacer.h"
+#include "historysearch.h"
+#include "logfile.h"
+#include "replaysource.h"
+#include "serialconfig.h"
+#include "serialworker.h"
+#include "speedmonitor.h"
+
+class ReceiveView;
+
+/**
+ * @brief PortSession - 一个串口会话
+ *
+ * 把一个串口从接收到显示所需的全部对象放在一起：SerialWorker、DataPipeline、
+ * 接收显示区、刷新定时器与 FramePacer、速度统计。数据也可以来自 ReplaySource
+ * （回放捕获文件），两种来源经同一条处理和显示链路。接收区还可以临时显示一个
+ * 内存映射的大日志文件（LogFile），期间接收的数据照常写入历史。一个进程可以同时运行多个会话，
+ * 工作线程和处理线程由 IoThreadPool 在会话间共享。
+ *
+ * 后台会话（不可见）只以最长间隔取走数据，不参与绘制，
+ * 因此总 CPU 开销随会话数的增长低于线性。
+ *
+ * 在 UI 线程中创建和使用。
+ */
+class PortSession : public QObject
+{
+    Q_OBJECT
+
+public:
+    static constexpr int REFRESH_INTERVAL_MS = 33; ///< 初始刷新间隔 ~30 FPS，之后由 FramePacer 调整
+
+    /**
+     * @brief 构造函数
+     * @param view 该会话的接收显示区（不取得所有权）
+     * @param parent 父对象
+     */
+    explicit PortSession(ReceiveView *view, QObject *parent = nullptr);
+
+    /**
+     * @brief 析构函数（停止串口并释放工作线程和处理线程）
+     */
+    ~PortSession();
+
+    ReceiveView *view() const;
+    SerialWorker *worker() const;
+    DataPipeline *pipeline() const;
+
+    ReplaySource *replay() const;
+
+    /**
+     * @brief 检查串口是否正在运行（或正在回放）
+     * @return true 如果已打开
+     */
+    bool isRunning() const;
+
+    /**
+     * @brief 当前（或最近一次）数据来源是否为回放
+     * @return true 如果最近一次启动的是回放
+     */
+    bool isReplaying() const;
+
+    /**
+     * @brief 获取最近一次打开串口使用的配置
+     * @return 串口配置（未打开过时端口名为空）
+     */
+    SerialConfig config() const;
+
+    /**
+     * @brief 获取会话标题（标签页文本）
+     * @return 端口名（回放或查看日志时为文件名），未打开过时为“未连接”
+     */
+    QString title() const;
+
+    /**
+     * @brief 打开串口
+     *
+     * 配置无效或打开失败时发出 errorOccurred。
+     *
+     * @param config 串口配置
+     */
+    void start(const SerialConfig &config);
+
+    /**
+     * @brief 回放捕获文件
+     *
+     * 串口打开时不能回放。文件无法读取时发出 errorOccurred。
+     *
+     * @param config 回放配置
+     */
+    void startReplay(const ReplayConfig &config);
+
+    /**
+     * @brief 关闭串口或停止回放
+     */
+    void stop();
+
+    /**
+     * @brief 发送数据，并在接收区回显
+     * @param data 要发送的数据
+     * @param echo 回显文本（不含换行符）
+     */
+    void send(const QByteArray &data, const QString &echo);
+
+    /**
+     * @brief 在接收区显示系统消息（"SYSINFO >>" 前缀）
+     * @param message 消息内容
+     */
+    void showSystemMessage(const QString &message);
+
+    /**
+     * @brief 清空接收区和待显示数据（正在查看日志时只关闭日志）
+     */
+    void clear();
+
+    /**
+     * @brief 在接收区中查看日志文件
+     *
+     * 文件被映射后立即显示，行索引在后台建立。无法打开时发出 errorOccurred。
+     *
+     * @param path 日志文件路径
+     * @return true 如果已打开
+     */
+    bool openLog(const QString &path);
+
+    /**
+     * @brief 关闭日志，接收区回到接收历史
+     */
+    void closeLog();
+
+    /**
+     * @brief 设置日志的十六进制显示（跟随接收区的显示格式）
+     * @param enabled true 为十六进制
+     */
+    void setLogHexMode(bool enabled);
+
+    /**
+     * @brief 获取日志文件
+     * @return 日志文件（未查看日志时 isOpen() 为 false）
+     */
+    LogFile *log() const;
+
+    /**
+     * @brief 获取接收历史搜索（新接收的行随刷新加入搜索）
+     * @return 历史搜索
+     */
+    HistorySearch *search() const;
+
+    /**
+     * @brief 设置是否为前台会话
+     *
+     * 前台会话按 FramePacer 的间隔刷新；后台会话以 FramePacer::MAX_INTERVAL_MS 取走数据。
+     *
+     * @param active true 为前台
+     */
+    void setActive(bool active);
+
+    /**
+     * @brief 获取速度统计
+     * @return 速度监控器
+     */
+    SpeedMonitor *speedMonitor() const;
+
+    /**
+     * @brief 获取原始数据捕获
+     * @return 捕获写入器（未启用捕获时 isRunning() 为 false）
+     */
+    CaptureWriter *capture() const;
+
+signals:
+    /**
+     * @brief 串口已打开
+     */
+    void started();
+
+    /**
+     * @brief 串口已关闭
+     */
+    void stopped();
+
+    /**
+     * @brief 发生错误
+     * @param error 错误描述
+     */
+    void errorOccurred(const QString &error);
+
+    /**
+     * @brief 接收速度更新（每秒一次）
+     * @param bytesPerSecond 当前速度
+     * @param totalBytes 累计字节数
+     */
+    void speedUpdated(double bytesPerSecond, qint64 totalBytes);
+
+    /**
+     * @brief 会话标题改变（打开/关闭日志、日志索引进度）
+     */
+    void titleChanged();
+
+private slots:
+    /**
+     * @brief 定时刷新：取走本帧预算内的数据并追加到接收区
+     */
+    void onRefreshTimeout();
+
+    void onStarted();
+    void onStopped();
+    void onScrollValueChanged(int value);
+
+private:
+    /**
+     * @brief 按前台/后台状态设置刷新间隔
+     */
+    void updateRefreshInterval();
+
+    /**
+     * @brief 按设置开始原始数据捕获（文件名前缀取端口名）
+     */
+    void startCapture();
+
+    /**
+     * @brief 回放已停止且显示队列已被接收区取空时，显示回放统计
+     *
+     * 用时从回放开始算到接收区取走最后一批数据，即整条显示链路的端到端吞吐；
+     * 同时列出这段时间内显示队列丢弃、溢出到磁盘和摘要模式跳过的数据量。
+     */
+    void reportReplayIfDrained();
+
+    ReceiveView *m_view;
+    SerialWorker *m_worker;
+    ReplaySource *m_replay;
+    DataPipeline *m_pipeline;
+    QTimer *m_refreshTimer;
+    SpeedMonitor *m_speedMonitor;
+    CaptureWriter *m_capture;         ///< 原始数据捕获，随会话存在，打开串口时按设置启动
+    LogFile *m_log;                   ///< 正在查看的日志文件
+    HistorySearch *m_search;          ///< 接收历史搜索
+    FramePacer m_pacer{REFRESH_INTERVAL_MS};
+    SerialConfig m_config;            ///< 最近一次打开使用的配置
+    qint64 m_skippedBytes = 0;        ///< 摘要模式下累计跳过的字节数（估算）
+    bool m_autoScroll = true;
+    bool m_active = true;             ///< 是否为前台会话
+    bool m_replaying = false;         ///< 最近一次启动的是回放
+    bool m_replayReportPending = false; ///< 回放已停止，等显示队列取空后显示统计
+    QueueStats m_replayQueueBase;     ///< 回放开始时的显示队列统计
+    quint16 m_portId;                 ///< 会话编号，写入捕获记录区分端口
+};
+
+#endif // PORTSESSION_H
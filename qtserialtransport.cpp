@@ -0,0 +1,96 @@
+#include "qtserialtransport.h"
+
+/**
+ * @brief QtSerialTransport 实现
+ */
+
+QtSerialTransport::QtSerialTransport(QObject *parent)
+    : SerialTransport(parent)
+    , m_serial(new QSerialPort(this))
+{
+    connect(m_serial, &QSerialPort::readyRead, this, &SerialTransport::readyRead);
+    connect(m_serial, &QSerialPort::errorOccurred, this, &QtSerialTransport::onSerialError);
+}
+
+QtSerialTransport::~QtSerialTransport()
+{
+    close();
+}
+
+bool QtSerialTransport::open(const SerialConfig &config)
+{
+    m_serial->setPortName(config.portName);
+    m_serial->setBaudRate(config.baudRate);
+    m_serial->setDataBits(config.dataBits);
+    m_serial->setStopBits(config.stopBits);
+    m_serial->setParity(config.parity);
+    m_serial->setFlowControl(config.flowControl);
+    m_serial->setReadBufferSize(config.readBufferSize);
+
+    // open() 失败时 QSerialPort 会触发 errorOccurred，经 onSerialError 转发
+    return m_serial->open(QIODevice::ReadWrite);
+}
+
+void QtSerialTransport::close()
+{
+    if (m_serial->isOpen()) {
+        m_serial->close();
+    }
+}
+
+bool QtSerialTransport::isOpen() const
+{
+    return m_serial->isOpen();
+}
+
+qint64 QtSerialTransport::read(char *data, qint64 maxSize)
+{
+    return m_serial->read(data, maxSize);
+}
+
+qint64 QtSerialTransport::write(const QByteArray &data)
+{
+    return m_serial->write(data);
+}
+
+QString QtSerialTransport::errorString() const
+{
+    return m_serial->errorString();
+}
+
+void QtSerialTransport::onSerialError(QSerialPort::SerialPortError error)
+{
+    if (error == QSerialPort::NoError) {
+        return;
+    }
+
+    QString errorString;
+    switch (error) {
+    case QSerialPort::DeviceNotFoundError:
+        errorString = QStringLiteral("Device not found");
+        break;
+    case QSerialPort::PermissionError:
+        errorString = QStringLiteral("Permission denied");
+        break;
+    case QSerialPort::OpenError:
+        errorString = QStringLiteral("Failed to open port");
+        break;
+    case QSerialPort::WriteError:
+        errorString = QStringLiteral("Write error");
+        break;
+    case QSerialPort::ReadError:
+        errorString = QStringLiteral("Read error");
+        break;
+    case QSerialPort::ResourceError:
+        errorString = QStringLiteral("Resource error (device may have been disconnected)");
+        break;
+    case QSerialPort::TimeoutError:
+        errorString = QStringLiteral("Timeout error");
+        break;
+    default:
+        errorString = m_serial->errorString();
+        break;
+    }
+
+    emit errorOccurred(errorString);
+}
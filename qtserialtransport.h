@@ -0,0 +1,48 @@
+#ifndef QTSERIALTRANSPORT_H
+#define QTSERIALTRANSPORT_H
+
+#include <QSerialPort>
+
+#include "serialtransport.h"
+
+/**
+ * @brief QtSerialTransport - 基于 QSerialPort 的传输层
+ *
+ * 所有平台可用的默认后端，只支持常用波特率。
+ */
+class QtSerialTransport : public SerialTransport
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief 构造函数
+     * @param parent 父对象
+     */
+    explicit QtSerialTransport(QObject *parent = nullptr);
+
+    /**
+     * @brief 析构函数（关闭串口）
+     */
+    ~QtSerialTransport() override;
+
+    bool open(const SerialConfig &config) override;
+    void close() override;
+    bool isOpen() const override;
+    qint64 read(char *data, qint64 maxSize) override;
+    qint64 write(const QByteArray &data) override;
+    QString errorString() const override;
+
+private slots:
+    /**
+     * @brief 将 QSerialPort 错误转换为错误描述并转发
+     * @param error 串口错误类型
+     * Requirements: 1.4
+     */
+    void onSerialError(QSerialPort::SerialPortError error);
+
+private:
+    QSerialPort *m_serial;   ///< 串口对象
+};
+
+#endif // QTSERIALTRANSPORT_H
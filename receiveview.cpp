@@ -0,0 +1,486 @@
+#include "receiveview.h"
+#include "keywordhighlighter.h"
+
+#include <QApplication>
+#include <QClipboard>
+#include <QContextMenuEvent>
+#include <QElapsedTimer>
+#include <QFontMetricsF>
+#include <QKeyEvent>
+#include <QMenu>
+#include <QMouseEvent>
+#include <QPainter>
+#include <QScrollBar>
+#include <QTextOption>
+#include <algorithm>
+#include <limits>
+
+/**
+ * @brief ReceiveView 实现
+ *
+ * Requirements: 6.1, 6.2, 6.3, 6.4
+ */
+
+ReceiveView::ReceiveView(QWidget *parent)
+    : QAbstractScrollArea(parent)
+{
+    setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+    setFocusPolicy(Qt::StrongFocus);
+    viewport()->setCursor(Qt::IBeamCursor);
+    verticalScrollBar()->setSingleStep(1);
+    updateScrollBars();
+}
+
+ReceiveView::~ReceiveView()
+{
+}
+
+void ReceiveView::appendText(const QString &text, const QVector<HighlightSpan> &spans,
+                             bool replaceOpenLine)
+{
+    if (text.isEmpty()) {
+        return;
+    }
+
+    const qint64 firstBefore = m_store.firstLineNumber();
+    m_store.append(text, spans, replaceOpenLine);
+    const qint64 dropped = m_store.firstLineNumber() - firstBefore;
+    if (m_source != &m_store) {
+        return;
+    }
+
+    QScrollBar *bar = verticalScrollBar();
+    const bool atBottom = bar->value() >= bar->maximum();
+    updateScrollBars();
+
+    // 最旧的块被丢弃后，保持用户正在浏览的内容不动
+    if (dropped > 0 && !atBottom) {
+        bar->setValue(static_cast<int>(qMax<qint64>(0, bar->value() - dropped)));
+    }
+    clampSelection();
+
+    viewport()->update();
+}
+
+void ReceiveView::clear()
+{
+    m_store.clear();
+    m_source = &m_store;
+    m_visible.clear();
+    m_anchor = Position{m_store.firstLineNumber(), 0};
+    m_cursor = m_anchor;
+    m_selecting = false;
+    updateScrollBars();
+    viewport()->update();
+}
+
+void ReceiveView::scrollToBottom()
+{
+    QScrollBar *bar = verticalScrollBar();
+    bar->setValue(bar->maximum());
+    viewport()->update();
+}
+
+void ReceiveView::setHighlighter(KeywordHighlighter *highlighter)
+{
+    if (m_highlighter) {
+        disconnect(m_highlighter, nullptr, this, nullptr);
+    }
+    m_highlighter = highlighter;
+    if (m_highlighter) {
+        // 切换高亮只需重绘可见行
+        connect(m_highlighter, &KeywordHighlighter::enabledChanged, viewport(), [this]() {
+            viewport()->update();
+        });
+    }
+    viewport()->update();
+}
+
+KeywordHighlighter *ReceiveView::highlighter() const
+{
+    return m_highlighter;
+}
+
+const HistoryStore &ReceiveView::store() const
+{
+    return m_store;
+}
+
+void ReceiveView::setSource(const LineSource *source)
+{
+    m_source = source ? source : &m_store;
+    m_visible.clear();
+    m_anchor = Position{m_source->firstLineNumber(), 0};
+    m_cursor = m_anchor;
+    m_selecting = false;
+    updateScrollBars();
+
+    QScrollBar *bar = verticalScrollBar();
+    bar->setValue(m_source == &m_store ? bar->maximum() : 0);
+    viewport()->update();
+}
+
+const LineSource *ReceiveView::source() const
+{
+    return m_source;
+}
+
+void ReceiveView::updateSource()
+{
+    updateScrollBars();
+    viewport()->update();
+}
+
+qint64 ReceiveView::lastPaintNs() const
+{
+    return m_lastPaintNs;
+}
+
+QString ReceiveView::selectedText() const
+{
+    if (m_anchor == m_cursor) {
+        return QString();
+    }
+
+    const Position start = qMin(m_anchor, m_cursor);
+    const Position end = qMax(m_anchor, m_cursor);
+    const qint64 first = m_source->firstLineNumber();
+
+    // 日志文件可能有数 GB，全选后复制只取前 MAX_COPY_CHARS 个字符
+    QString result;
+    for (qint64 line = qMax(start.line, first); line <= end.line && result.size() < MAX_COPY_CHARS; ++line) {
+        const QString text = m_source->line(static_cast<qsizetype>(line - first));
+        const int from = (line == start.line) ? qMin(start.column, int(text.length())) : 0;
+        const int to = (line == end.line) ? qMin(end.column, int(text.length())) : int(text.length());
+        result += QStringView(text).mid(from, qMax(0, to - from));
+        if (line != end.line) {
+            result += QLatin1Char('\n');
+        }
+    }
+    return result;
+}
+
+void ReceiveView::selectRange(qint64 line, int column, int length)
+{
+    m_anchor = Position{line, column};
+    m_cursor = Position{line, column + length};
+    m_selecting = false;
+
+    // 目标行放在视口中部；靠近末尾时贴底显示，同样可见
+    QScrollBar *bar = verticalScrollBar();
+    const qint64 value = line - m_source->firstLineNumber() - bar->pageStep() / 2;
+    bar->setValue(static_cast<int>(qBound<qint64>(0, value, bar->maximum())));
+    viewport()->update();
+}
+
+void ReceiveView::copy()
+{
+    const QString text = selectedText();
+    if (!text.isEmpty()) {
+        QApplication::clipboard()->setText(text);
+    }
+}
+
+void ReceiveView::selectAll()
+{
+    const qint64 first = m_source->firstLineNumber();
+    const qsizetype last = m_source->lineCount() - 1;
+    m_anchor = Position{first, 0};
+    m_cursor = Position{first + last, static_cast<int>(m_source->line(last).length())};
+    viewport()->update();
+}
+
+void ReceiveView::updateScrollBars()
+{
+    const qreal lineSpacing = QFontMetricsF(font()).lineSpacing();
+    const int rows = qMax(1, static_cast<int>(viewport()->height() / qMax<qreal>(1.0, lineSpacing)));
+    const qsizetype count = m_source->lineCount();
+
+    QScrollBar *bar = verticalScrollBar();
+    bar->setPageStep(rows);
+    bar->setRange(0, static_cast<int>(qBound<qsizetype>(0, count - rows, std::numeric_limits<int>::max())));
+}
+
+ReceiveView::VisibleLine ReceiveView::layoutLine(qsizetype index, qreal width) const
+{
+    VisibleLine visible;
+    visible.line = m_source->firstLineNumber() + index;
+    visible.layout = std::make_unique<QTextLayout>(m_source->line(index), font(), viewport());
+
+    QTextOption option;
+    option.setWrapMode(QTextOption::WrapAtWordBoundaryOrAnywhere);
+    visible.layout->setTextOption(option);
+    visible.layout->setCacheEnabled(true);
+
+    // 区间已在处理线程中算好，这里只按规则 ID 取格式
+    if (m_highlighter && m_highlighter->isEnabled()) {
+        const QVector<HighlightSpan> spans = m_source->lineSpans(index);
+        QList<QTextLayout::FormatRange> ranges;
+        ranges.reserve(spans.size());
+        for (const HighlightSpan &span : spans) {
+            QTextLayout::FormatRange range;
+            range.start = span.start;
+            range.length = span.length;
+            range.format = m_highlighter->format(span.rule);
+            ranges.append(range);
+        }
+        visible.layout->setFormats(ranges);
+    }
+
+    qreal height = 0;
+    visible.layout->beginLayout();
+    for (;;) {
+        QTextLine line = visible.layout->createLine();
+        if (!line.isValid()) {
+            break;
+        }
+        line.setLineWidth(width);
+        line.setPosition(QPointF(0, height));
+        height += line.height();
+    }
+    visible.layout->endLayout();
+
+    visible.height = height > 0 ? height : QFontMetricsF(font()).height();
+    return visible;
+}
+
+void ReceiveView::relayout()
+{
+    m_visible.clear();
+
+    const qsizetype count = m_source->lineCount();
+    const qreal width = qMax<qreal>(1.0, viewport()->width() - 2 * MARGIN);
+    const qreal height = viewport()->height();
+    QScrollBar *bar = verticalScrollBar();
+
+    if (bar->value() >= bar->maximum()) {
+        // 贴底显示：从最后一行向上排版直到填满视口
+        qreal used = 0;
+        for (qsizetype i = count - 1; i >= 0 && used < height; --i) {
+            VisibleLine visible = layoutLine(i, width);
+            used += visible.height;
+            m_visible.push_back(std::move(visible));
+        }
+        std::reverse(m_visible.begin(), m_visible.end());
+
+        qreal top = used < height ? 0 : height - used;
+        for (VisibleLine &visible : m_visible) {
+            visible.top = top;
+            top += visible.height;
+        }
+    } else {
+        qreal top = 0;
+        for (qsizetype i = bar->value(); i < count && top < height; ++i) {
+            VisibleLine visible = layoutLine(i, width);
+            visible.top = top;
+            top += visible.height;
+            m_visible.push_back(std::move(visible));
+        }
+    }
+}
+
+ReceiveView::Position ReceiveView::positionAt(const QPoint &point) const
+{
+    if (m_visible.empty()) {
+        return Position{m_source->firstLineNumber(), 0};
+    }
+
+    const VisibleLine &first = m_visible.front();
+    if (point.y() < first.top) {
+        return Position{first.line, 0};
+    }
+
+    for (const VisibleLine &visible : m_visible) {
+        const bool isLast = (&visible == &m_visible.back());
+        if (point.y() >= visible.top + visible.height && !isLast) {
+            continue;
+        }
+
+        const qreal y = point.y() - visible.top;
+        const int lineCount = visible.layout->lineCount();
+        for (int i = 0; i < lineCount; ++i) {
+            const QTextLine line = visible.layout->lineAt(i);
+            if (y < line.y() + line.height() || i == lineCount - 1) {
+                return Position{visible.line, line.xToCursor(point.x() - MARGIN)};
+            }
+        }
+        return Position{visible.line, 0};
+    }
+    return Position{m_visible.back().line, 0};
+}
+
+void ReceiveView::clampSelection()
+{
+    const qint64 first = m_source->firstLineNumber();
+    if (m_anchor.line < first) {
+        m_anchor = Position{first, 0};
+    }
+    if (m_cursor.line < first) {
+        m_cursor = Position{first, 0};
+    }
+}
+
+void ReceiveView::paintEvent(QPaintEvent *event)
+{
+    Q_UNUSED(event);
+
+    QElapsedTimer timer;
+    timer.start();
+
+    relayout();
+
+    QPainter painter(viewport());
+    const QPalette pal = palette();
+    painter.setPen(pal.color(QPalette::Text));
+
+    const bool hasSelection = !(m_anchor == m_cursor);
+    const Position start = qMin(m_anchor, m_cursor);
+    const Position end = qMax(m_anchor, m_cursor);
+
+    for (const VisibleLine &visible : m_visible) {
+        QList<QTextLayout::FormatRange> selections;
+        if (hasSelection && visible.line >= start.line && visible.line <= end.line) {
+            const int length = visible.layout->text().length();
+            const int from = (visible.line == start.line) ? start.column : 0;
+            const int to = (visible.line == end.line) ? end.column : length;
+            if (to > from) {
+                QTextLayout::FormatRange selection;
+                selection.start = from;
+                selection.length = to - from;
+                selection.format.setBackground(pal.brush(QPalette::Highlight));
+                selection.format.setForeground(pal.brush(QPalette::HighlightedText));
+                selections.append(selection);
+            }
+        }
+        visible.layout->draw(&painter, QPointF(MARGIN, visible.top), selections);
+    }
+
+    m_lastPaintNs = timer.nsecsElapsed();
+}
+
+void ReceiveView::resizeEvent(QResizeEvent *event)
+{
+    QAbstractScrollArea::resizeEvent(event);
+    updateScrollBars();
+}
+
+void ReceiveView::changeEvent(QEvent *event)
+{
+    QAbstractScrollArea::changeEvent(event);
+    if (event->type() == QEvent::FontChange
+        || event->type() == QEvent::PaletteChange
+        || event->type() == QEvent::StyleChange) {
+        updateScrollBars();
+        viewport()->update();
+    }
+}
+
+void ReceiveView::scrollContentsBy(int dx, int dy)
+{
+    Q_UNUSED(dx);
+    Q_UNUSED(dy);
+    viewport()->update();
+}
+
+void ReceiveView::keyPressEvent(QKeyEvent *event)
+{
+    if (event == QKeySequence::Copy) {
+        copy();
+        return;
+    }
+    if (event == QKeySequence::SelectAll) {
+        selectAll();
+        return;
+    }
+    if (event == QKeySequence::MoveToStartOfDocument) {
+        verticalScrollBar()->setValue(0);
+        return;
+    }
+    if (event == QKeySequence::MoveToEndOfDocument) {
+        scrollToBottom();
+        return;
+    }
+    QAbstractScrollArea::keyPressEvent(event);
+}
+
+void ReceiveView::mousePressEvent(QMouseEvent *event)
+{
+    if (event->button() != Qt::LeftButton) {
+        QAbstractScrollArea::mousePressEvent(event);
+        return;
+    }
+
+    const Position position = positionAt(event->position().toPoint());
+    if (!(event->modifiers() & Qt::ShiftModifier)) {
+        m_anchor = position;
+    }
+    m_cursor = position;
+    m_selecting = true;
+    viewport()->update();
+}
+
+void ReceiveView::mouseMoveEvent(QMouseEvent *event)
+{
+    if (!m_selecting) {
+        QAbstractScrollArea::mouseMoveEvent(event);
+        return;
+    }
+
+    // 拖出视口时逐行滚动
+    const QPoint point = event->position().toPoint();
+    if (point.y() < 0) {
+        verticalScrollBar()->triggerAction(QAbstractSlider::SliderSingleStepSub);
+        relayout();
+    } else if (point.y() > viewport()->height()) {
+        verticalScrollBar()->triggerAction(QAbstractSlider::SliderSingleStepAdd);
+        relayout();
+    }
+
+    m_cursor = positionAt(point);
+    viewport()->update();
+}
+
+void ReceiveView::mouseReleaseEvent(QMouseEvent *event)
+{
+    if (event->button() != Qt::LeftButton || !m_selecting) {
+        QAbstractScrollArea::mouseReleaseEvent(event);
+        return;
+    }
+
+    m_selecting = false;
+    QClipboard *clipboard = QApplication::clipboard();
+    if (clipboard->supportsSelection() && !(m_anchor == m_cursor)) {
+        clipboard->setText(selectedText(), QClipboard::Selection);
+    }
+}
+
+void ReceiveView::mouseDoubleClickEvent(QMouseEvent *event)
+{
+    if (event->button() != Qt::LeftButton) {
+        QAbstractScrollArea::mouseDoubleClickEvent(event);
+        return;
+    }
+
+    // 双击选中整行
+    const Position position = positionAt(event->position().toPoint());
+    const qsizetype index = static_cast<qsizetype>(position.line - m_source->firstLineNumber());
+    m_anchor = Position{position.line, 0};
+    m_cursor = Position{position.line, static_cast<int>(m_source->line(index).length())};
+    m_selecting = false;
+    viewport()->update();
+}
+
+void ReceiveView::contextMenuEvent(QContextMenuEvent *event)
+{
+    QMenu menu(this);
+    QAction *copyAction = menu.addAction("复制", this, &ReceiveView::copy);
+    copyAction->setShortcut(QKeySequence::Copy);
+    copyAction->setEnabled(!(m_anchor == m_cursor));
+    QAction *selectAllAction = menu.addAction("全选", this, &ReceiveView::selectAll);
+    selectAllAction->setShortcut(QKeySequence::SelectAll);
+    if (m_source != &m_store) {
+        menu.addSeparator();
+        menu.addAction("关闭日志", this, &ReceiveView::closeSourceRequested);
+    }
+    menu.exec(event->globalPos());
+}
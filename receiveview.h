@@ -0,0 +1,217 @@
+#ifndef RECEIVEVIEW_H
+#define RECEIVEVIEW_H
+
+#include <QAbstractScrollArea>
+#include <QTextLayout>
+#include <memory>
+#include <vector>
+
+#include "historystore.h"
+
+class KeywordHighlighter;
+
+/**
+ * @brief ReceiveView - 虚拟化的接收显示区
+ *
+ * 取代 QPlainTextEdit：历史保存在 HistoryStore 中，每帧只对可见的若干行
+ * 做排版和绘制，因此无论历史有多少行，追加和绘制的代价都基本不变。
+ * 长行按控件宽度自动换行；滚动条以行为单位，滚到底部时从最后一行向上贴底绘制。
+ * 支持鼠标/键盘选择、复制、全选。
+ *
+ * 显示的行也可以来自其他 LineSource（如内存映射的日志文件），此时新接收的数据
+ * 仍写入历史，切回历史后可见。
+ *
+ * Requirements: 6.1, 6.2, 6.3, 6.4
+ */
+class ReceiveView : public QAbstractScrollArea
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief 构造函数
+     * @param parent 父控件
+     */
+    explicit ReceiveView(QWidget *parent = nullptr);
+
+    /**
+     * @brief 析构函数
+     */
+    ~ReceiveView();
+
+    /**
+     * @brief 追加文本到末尾
+     * @param text 要追加的文本
+     * @param spans 预先计算的高亮区间（见 HistoryStore::append）
+     * @param replaceOpenLine 是否替换当前行原有的区间
+     */
+    void appendText(const QString &text, const QVector<HighlightSpan> &spans = {},
+                    bool replaceOpenLine = true);
+
+    /**
+     * @brief 清空所有历史和选区
+     */
+    void clear();
+
+    /**
+     * @brief 滚动到最后一行
+     */
+    void scrollToBottom();
+
+    /**
+     * @brief 设置关键词高亮器（只用于按规则 ID 取格式和启用状态）
+     * @param highlighter 高亮器，可为 nullptr
+     */
+    void setHighlighter(KeywordHighlighter *highlighter);
+
+    /**
+     * @brief 选中一行中的一段并滚动到该行（搜索定位）
+     * @param line 绝对行号
+     * @param column 行内起始位置（UTF-16）
+     * @param length 长度（UTF-16）
+     */
+    void selectRange(qint64 line, int column, int length);
+
+    /**
+     * @brief 获取当前选中的文本
+     * @return 选中文本，多行以 '\n' 连接
+     */
+    QString selectedText() const;
+
+    /**
+     * @brief 获取关键词高亮器
+     * @return 高亮器，可为 nullptr
+     */
+    KeywordHighlighter *highlighter() const;
+
+    /**
+     * @brief 获取历史存储
+     * @return 历史存储
+     */
+    const HistoryStore &store() const;
+
+    /**
+     * @brief 切换显示的行数据
+     *
+     * 切换后清除选区；其他来源从第一行开始显示，切回历史时滚动到底部。
+     *
+     * @param source 行数据（不取得所有权），nullptr 表示接收历史
+     */
+    void setSource(const LineSource *source);
+
+    /**
+     * @brief 获取当前显示的行数据
+     * @return 行数据，显示历史时为 &store()
+     */
+    const LineSource *source() const;
+
+    /**
+     * @brief 当前来源的行数增加后刷新滚动范围和显示
+     */
+    void updateSource();
+
+    /**
+     * @brief 获取最近一次绘制的耗时（排版 + 绘制）
+     * @return 耗时（纳秒）
+     */
+    qint64 lastPaintNs() const;
+
+public slots:
+    /**
+     * @brief 复制选中文本到剪贴板
+     */
+    void copy();
+
+    /**
+     * @brief 选中全部历史
+     */
+    void selectAll();
+
+signals:
+    /**
+     * @brief 用户要求关闭当前来源、回到接收历史（右键菜单）
+     */
+    void closeSourceRequested();
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
+    void changeEvent(QEvent *event) override;
+    void scrollContentsBy(int dx, int dy) override;
+    void keyPressEvent(QKeyEvent *event) override;
+    void mousePressEvent(QMouseEvent *event) override;
+    void mouseMoveEvent(QMouseEvent *event) override;
+    void mouseReleaseEvent(QMouseEvent *event) override;
+    void mouseDoubleClickEvent(QMouseEvent *event) override;
+    void contextMenuEvent(QContextMenuEvent *event) override;
+
+private:
+    /**
+     * @brief 文本位置（绝对行号 + 行内字符偏移）
+     */
+    struct Position {
+        qint64 line = 0;
+        int column = 0;
+
+        bool operator<(const Position &other) const {
+            return line < other.line || (line == other.line && column < other.column);
+        }
+        bool operator==(const Position &other) const {
+            return line == other.line && column == other.column;
+        }
+    };
+
+    /**
+     * @brief 已排版的可见行
+     */
+    struct VisibleLine {
+        qint64 line = 0;                        ///< 绝对行号
+        qreal top = 0;                          ///< 在视口中的顶部 y 坐标
+        qreal height = 0;                       ///< 排版后高度（含自动换行）
+        std::unique_ptr<QTextLayout> layout;    ///< 排版结果
+    };
+
+    /**
+     * @brief 对一行做排版
+     * @param index 行下标（HistoryStore 局部下标）
+     * @param width 可用宽度
+     * @return 可见行信息（top 未设置）
+     */
+    VisibleLine layoutLine(qsizetype index, qreal width) const;
+
+    /**
+     * @brief 按当前滚动位置重新排版可见行
+     */
+    void relayout();
+
+    /**
+     * @brief 根据行数和视口高度更新滚动条范围
+     */
+    void updateScrollBars();
+
+    /**
+     * @brief 视口坐标转换为文本位置
+     * @param point 视口坐标
+     * @return 文本位置
+     */
+    Position positionAt(const QPoint &point) const;
+
+    /**
+     * @brief 将选区裁剪到当前存储范围内
+     */
+    void clampSelection();
+
+    HistoryStore m_store;                         ///< 历史存储
+    const LineSource *m_source = &m_store;        ///< 当前显示的行数据
+    KeywordHighlighter *m_highlighter = nullptr;  ///< 关键词高亮器
+    std::vector<VisibleLine> m_visible;           ///< 最近一次排版的可见行
+    Position m_anchor;                            ///< 选区锚点
+    Position m_cursor;                            ///< 选区活动端
+    bool m_selecting = false;                     ///< 正在拖动选择
+    qint64 m_lastPaintNs = 0;                     ///< 最近一次绘制耗时（纳秒）
+
+    static constexpr int MARGIN = 4;              ///< 文本左右边距（像素）
+    static constexpr qsizetype MAX_COPY_CHARS = qsizetype(64) << 20;  ///< 复制选区的字符数上限
+};
+
+#endif // RECEIVEVIEW_H
@@ -0,0 +1,60 @@
+#ifndef REPLAYCONFIG_H
+#define REPLAYCONFIG_H
+
+#include <QString>
+#include <QTime>
+
+/**
+ * @brief ReplayConfig - 捕获文件回放配置数据结构
+ *
+ * 决定回放哪个文件、从哪里开始以及以什么速度发出数据，提供配置验证功能。
+ */
+struct ReplayConfig {
+    static constexpr double MIN_SPEED = 0.01;      ///< 最小回放速度倍数
+    static constexpr double MAX_SPEED = 10000.0;   ///< 最大回放速度倍数（不含尽可能快）
+
+    QString path;              ///< 捕获文件（.sswcap）
+    double speed = 1.0;        ///< 回放速度倍数，0 表示尽可能快（用作显示链路的端到端吞吐基准）
+    QTime startTime;           ///< 从文件中第一次到达该本地时间的位置开始，无效时从头开始
+
+    /**
+     * @brief 是否尽可能快地回放
+     * @return true 如果不按原始时间间隔等待
+     */
+    bool isMaxSpeed() const {
+        return speed == 0;
+    }
+
+    /**
+     * @brief 验证配置参数是否有效
+     * @return true 如果所有参数有效，否则返回 false
+     */
+    bool isValid() const {
+        return validationError().isEmpty();
+    }
+
+    /**
+     * @brief 获取配置验证错误信息
+     * @return 错误描述字符串，如果配置有效则返回空字符串
+     */
+    QString validationError() const {
+        if (path.isEmpty()) {
+            return QStringLiteral("Replay file must not be empty");
+        }
+        if (speed != 0 && (speed < MIN_SPEED || speed > MAX_SPEED)) {
+            return QStringLiteral("Replay speed must be between %1 and %2, or 0 for maximum speed")
+                .arg(MIN_SPEED).arg(MAX_SPEED);
+        }
+        return QString();
+    }
+
+    bool operator==(const ReplayConfig &other) const {
+        return path == other.path && speed == other.speed && startTime == other.startTime;
+    }
+
+    bool operator!=(const ReplayConfig &other) const {
+        return !(*this == other);
+    }
+};
+
+#endif // REPLAYCONFIG_H
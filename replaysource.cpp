@@ -0,0 +1,257 @@
+#include "replaysource.h"
+#include "capturereader.h"
+#include "timestampformatter.h"
+
+#include <QDateTime>
+#include <QDeadlineTimer>
+#include <QMutexLocker>
+#include <QThread>
+#include <cstring>
+
+/**
+ * @brief ReplaySource 实现
+ */
+
+ReplaySource::ReplaySource(QObject *parent)
+    : DataSource(parent)
+{
+}
+
+ReplaySource::~ReplaySource()
+{
+    stop();
+}
+
+void ReplaySource::start(const ReplayConfig &config)
+{
+    stop();
+
+    if (!config.isValid()) {
+        emit errorOccurred(config.validationError());
+        return;
+    }
+
+    m_config = config;
+    m_processedBase = m_processedBytes ? m_processedBytes() : 0;
+    m_records = 0;
+    m_bytes = 0;
+    m_position = 0;
+    m_fileSize = 0;
+    m_elapsedNs = 0;
+    m_startNs = 0;
+    m_finished = false;
+    {
+        QMutexLocker locker(&m_mutex);
+        m_stopping = false;
+    }
+
+    m_thread.reset(QThread::create([this]() { run(); }));
+    m_thread->setObjectName("SSW-replay");
+    m_thread->start();
+}
+
+void ReplaySource::stop()
+{
+    if (!m_thread) {
+        return;
+    }
+
+    {
+        QMutexLocker locker(&m_mutex);
+        m_stopping = true;
+        m_wake.wakeAll();
+    }
+    m_thread->wait();
+    m_thread.reset();
+}
+
+bool ReplaySource::isRunning() const
+{
+    return m_running.load();
+}
+
+void ReplaySource::setProcessedBytesProbe(std::function<qint64()> probe)
+{
+    m_processedBytes = std::move(probe);
+}
+
+ReplayStats ReplaySource::stats() const
+{
+    ReplayStats stats;
+    stats.records = m_records.load(std::memory_order_relaxed);
+    stats.bytes = m_bytes.load(std::memory_order_relaxed);
+    stats.position = m_position.load(std::memory_order_relaxed);
+    stats.fileSize = m_fileSize.load(std::memory_order_relaxed);
+    stats.finished = m_finished.load();
+    const qint64 startNs = m_startNs.load();
+    stats.startNs = startNs;
+    stats.started = startNs > 0;
+    stats.elapsedNs = m_running.load() && startNs > 0 ? TimestampFormatter::monotonicNs() - startNs
+                                                      : m_elapsedNs.load();
+    return stats;
+}
+
+ReplayConfig ReplaySource::config() const
+{
+    return m_config;
+}
+
+void ReplaySource::run()
+{
+    // 此方法在回放线程中执行
+    CaptureReader reader;
+    QString error;
+    if (!reader.open(m_config.path, &error)) {
+        // 没有发出 started，仍然发出 stopped，让会话结束回放状态
+        emit errorOccurred(error);
+        emit stopped();
+        return;
+    }
+
+    qint64 offset = reader.firstOffset();
+    if (m_config.startTime.isValid()) {
+        // 起始时间只给出时刻：取文件开始之后第一次到达该时刻的位置
+        const QDateTime fileStart = QDateTime::fromMSecsSinceEpoch(reader.header().wallClockMs);
+        QDateTime target(fileStart.date(), m_config.startTime);
+        if (target < fileStart) {
+            target = target.addDays(1);
+        }
+        offset = reader.seek(target);
+    }
+    m_fileSize = reader.size();
+    m_position = offset;
+
+    // 记录时间 + shift = 当前单调时钟上与录制时本地时间相同的时刻
+    const CaptureFormat::FileHeader &header = reader.header();
+    const qint64 shift = (header.wallClockMs - QDateTime::currentMSecsSinceEpoch()) * 1000000
+                         + TimestampFormatter::monotonicNs() - header.monotonicNs;
+
+    m_startNs = TimestampFormatter::monotonicNs();
+    m_running = true;
+    emit started();
+
+    RxChunk slab;                 // 当前接收块，批次位于其末尾
+    qsizetype batchSize = 0;
+    qint64 batchTimestampNs = 0;
+    qint64 emitted = 0;           // 已发出的字节数
+    auto flush = [&]() {
+        if (batchSize == 0) {
+            return;
+        }
+        RxChunk batch = slab.mid(slab.size() - batchSize, batchSize);
+        batch.setTimestampNs(batchTimestampNs);
+        emitted += batchSize;
+        m_bytes.store(emitted, std::memory_order_relaxed);
+        batchSize = 0;
+        emit dataReceived(batch);
+    };
+
+    const bool paced = !m_config.isMaxSpeed();
+    bool firstRecord = true;
+    qint64 firstTimestampNs = 0;
+    bool stopped = false;
+    CaptureRecord record;
+    qint64 next = 0;
+
+    while (!stopped && reader.readRecord(offset, &record, &next)) {
+        offset = next;
+        m_position.store(offset, std::memory_order_relaxed);
+        // 发送记录是当时的回显，回放只重现接收到的数据
+        if (record.direction != CaptureFormat::Rx || record.data.isEmpty()) {
+            continue;
+        }
+
+        if (firstRecord) {
+            firstTimestampNs = record.timestampNs;
+            firstRecord = false;
+        }
+        if (paced) {
+            const qint64 dueNs = qint64(double(record.timestampNs - firstTimestampNs) / m_config.speed);
+            if (dueNs > TimestampFormatter::monotonicNs() - m_startNs) {
+                // 下一条还没到时间：先发出已到期的数据再等待
+                flush();
+                if (!waitUntil(dueNs)) {
+                    break;
+                }
+            }
+        }
+
+        const char *data = record.data.constData();
+        qsizetype remaining = record.data.size();
+        while (remaining > 0) {
+            if (batchSize == 0 && slab.tailCapacity() < BATCH_BYTES) {
+                slab = SlabPool::instance()->acquire();
+            }
+            if (batchSize == 0) {
+                batchTimestampNs = record.timestampNs + shift;
+            }
+            const qsizetype n = qMin(remaining, BATCH_BYTES - batchSize);
+            std::memcpy(slab.tail(), data, size_t(n));
+            slab.commit(n);
+            batchSize += n;
+            data += n;
+            remaining -= n;
+
+            if (batchSize == BATCH_BYTES) {
+                flush();
+                if (!waitForConsumer(MAX_IN_FLIGHT_BYTES)) {
+                    stopped = true;
+                    break;
+                }
+            }
+        }
+        m_records.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    flush();
+    slab = RxChunk();
+
+    // 到达末尾时等全部数据进入显示队列
+    const bool finished = !stopped && !isStopping();
+    if (finished) {
+        waitForConsumer(0);
+    }
+    m_elapsedNs = TimestampFormatter::monotonicNs() - m_startNs;
+    m_finished = finished && !isStopping();
+    m_running = false;
+    emit stopped();
+}
+
+bool ReplaySource::waitUntil(qint64 dueNs)
+{
+    QMutexLocker locker(&m_mutex);
+    while (!m_stopping) {
+        const qint64 remainingNs = dueNs - (TimestampFormatter::monotonicNs() - m_startNs);
+        if (remainingNs <= 0) {
+            return true;
+        }
+        QDeadlineTimer deadline(Qt::PreciseTimer);
+        deadline.setPreciseRemainingTime(0, remainingNs, Qt::PreciseTimer);
+        m_wake.wait(&m_mutex, deadline);
+    }
+    return false;
+}
+
+bool ReplaySource::waitForConsumer(qint64 limit)
+{
+    if (!m_processedBytes) {
+        return !isStopping();
+    }
+
+    QMutexLocker locker(&m_mutex);
+    while (!m_stopping) {
+        const qint64 inFlight = m_bytes.load(std::memory_order_relaxed) - (m_processedBytes() - m_processedBase);
+        if (inFlight <= limit) {
+            return true;
+        }
+        // 处理线程不通知进度，短暂休眠后再查
+        m_wake.wait(&m_mutex, 1);
+    }
+    return false;
+}
+
+bool ReplaySource::isStopping() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_stopping;
+}
@@ -0,0 +1,142 @@
+#ifndef REPLAYSOURCE_H
+#define REPLAYSOURCE_H
+
+#include <QMutex>
+#include <QWaitCondition>
+#include <atomic>
+#include <functional>
+#include <memory>
+
+#include "datasource.h"
+#include "replayconfig.h"
+
+class QThread;
+
+/**
+ * @brief ReplayStats - 回放统计
+ */
+struct ReplayStats {
+    qint64 records = 0;          ///< 已发出的接收记录数
+    qint64 bytes = 0;            ///< 已发出的字节数
+    qint64 position = 0;         ///< 当前读取位置（文件偏移）
+    qint64 fileSize = 0;         ///< 文件长度
+    qint64 startNs = 0;          ///< 开始回放时的单调时钟（未开始时为 0）
+    qint64 elapsedNs = 0;        ///< 从开始到现在（已停止时为到最后一块进入显示队列）的时间
+    bool started = false;        ///< 文件已打开并开始回放（打开失败时为 false）
+    bool finished = false;       ///< 已回放到文件末尾（而不是被中途停止）
+
+    double bytesPerSecond() const { return elapsedNs > 0 ? double(bytes) * 1e9 / double(elapsedNs) : 0.0; }
+};
+
+/**
+ * @brief ReplaySource - 捕获文件回放
+ *
+ * 读取 CaptureWriter 写入的带索引捕获文件，把其中的接收记录按与 SerialWorker 相同的接口
+ * （started / dataReceived / stopped）发出，数据经同一条 DataPipeline → 高亮 → 显示链路处理。
+ *
+ * - 按原始时间间隔除以速度倍数发出；速度为 0 时不等待，尽可能快。
+ * - 记录拷贝进 SlabPool 的接收块，相邻记录合并为不超过 BATCH_BYTES 的批次。
+ * - 时间戳换算为当前单调时钟上与原始本地时间对应的值，时间戳显示为录制时的时间。
+ * - 设置了已处理字节数探针时，已发出但尚未处理的数据超过 MAX_IN_FLIGHT_BYTES 后等待，
+ *   已处理指显示文本已进入显示队列，尽可能快的回放因此不会只测到排队速度；
+ *   端到端用时由 PortSession 计到接收区取空显示队列为止。
+ *
+ * 在专用线程中读取和发出，在 UI 线程中创建和控制。
+ */
+class ReplaySource : public DataSource
+{
+    Q_OBJECT
+
+public:
+    static constexpr qsizetype BATCH_BYTES = 16384;                  ///< 单个批次的最大字节数（同 SerialConfig 默认值）
+    static constexpr qint64 MAX_IN_FLIGHT_BYTES = qint64(8) << 20;   ///< 已发出未处理的数据上限
+
+    /**
+     * @brief 构造函数
+     * @param parent 父对象
+     */
+    explicit ReplaySource(QObject *parent = nullptr);
+
+    /**
+     * @brief 析构函数（停止回放线程）
+     */
+    ~ReplaySource();
+
+    /**
+     * @brief 开始回放
+     *
+     * 已在回放时先停止。文件在回放线程中打开，失败时发出 errorOccurred 和 stopped
+     * （不发出 started，stats().started 为 false）。
+     *
+     * @param config 回放配置
+     */
+    void start(const ReplayConfig &config);
+
+    /**
+     * @brief 停止回放（等待回放线程退出，随后发出 stopped）
+     */
+    void stop() override;
+
+    bool isRunning() const override;
+
+    /**
+     * @brief 设置已处理字节数探针（在开始回放前设置）
+     * @param probe 返回下游累计处理的字节数，线程安全；为空时不限制在途数据
+     */
+    void setProcessedBytesProbe(std::function<qint64()> probe);
+
+    /**
+     * @brief 获取回放统计（线程安全）
+     * @return 统计信息
+     */
+    ReplayStats stats() const;
+
+    /**
+     * @brief 获取最近一次回放的配置
+     * @return 回放配置
+     */
+    ReplayConfig config() const;
+
+private:
+    /**
+     * @brief 回放线程主循环
+     */
+    void run();
+
+    /**
+     * @brief 等待到回放时钟的 dueNs，期间可被 stop() 打断
+     * @return false 如果被要求停止
+     */
+    bool waitUntil(qint64 dueNs);
+
+    /**
+     * @brief 等待下游处理到在途数据不超过 limit
+     * @return false 如果被要求停止
+     */
+    bool waitForConsumer(qint64 limit);
+
+    /**
+     * @brief 是否被要求停止
+     */
+    bool isStopping() const;
+
+    std::unique_ptr<QThread> m_thread;            ///< 回放线程
+    ReplayConfig m_config;                        ///< 回放配置（回放线程运行时只读）
+    std::function<qint64()> m_processedBytes;     ///< 下游已处理字节数探针（回放线程运行时只读）
+    qint64 m_processedBase = 0;                   ///< 开始回放时探针的值
+
+    mutable QMutex m_mutex;                       ///< 保护 m_stopping
+    QWaitCondition m_wake;                        ///< 停止时唤醒回放线程
+    bool m_stopping = false;                      ///< 要求回放线程退出
+
+    std::atomic<bool> m_running{false};           ///< 是否正在回放
+    std::atomic<qint64> m_records{0};
+    std::atomic<qint64> m_bytes{0};
+    std::atomic<qint64> m_position{0};
+    std::atomic<qint64> m_fileSize{0};
+    std::atomic<qint64> m_elapsedNs{0};           ///< 停止时写入
+    std::atomic<qint64> m_startNs{0};             ///< 开始时的单调时钟（运行中计算已用时间）
+    std::atomic<bool> m_finished{false};
+};
+
+#endif // REPLAYSOURCE_H
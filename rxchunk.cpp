@@ -0,0 +1,166 @@
+#include "rxchunk.h"
+
+#include <QMutexLocker>
+#include <utility>
+
+/**
+ * @brief RxChunk / SlabPool 实现
+ */
+
+struct RxChunk::Slab {
+    std::atomic<int> ref{0};                 ///< 引用计数
+    qsizetype filled = 0;                    ///< 已写入的字节数（只由写入方修改）
+    alignas(64) char data[SlabPool::SLAB_SIZE];
+};
+
+RxChunk::RxChunk(Slab *slab, qsizetype offset, qsizetype size)
+    : m_slab(slab)
+    , m_offset(offset)
+    , m_size(size)
+{
+    if (m_slab) {
+        m_slab->ref.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+RxChunk::RxChunk(const RxChunk &other)
+    : RxChunk(other.m_slab, other.m_offset, other.m_size)
+{
+    m_timestampNs = other.m_timestampNs;
+}
+
+RxChunk::RxChunk(RxChunk &&other) noexcept
+    : m_slab(std::exchange(other.m_slab, nullptr))
+    , m_offset(std::exchange(other.m_offset, 0))
+    , m_size(std::exchange(other.m_size, 0))
+    , m_timestampNs(std::exchange(other.m_timestampNs, 0))
+{
+}
+
+RxChunk &RxChunk::operator=(const RxChunk &other)
+{
+    if (this != &other) {
+        RxChunk copy(other);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+RxChunk &RxChunk::operator=(RxChunk &&other) noexcept
+{
+    if (this != &other) {
+        release();
+        m_slab = std::exchange(other.m_slab, nullptr);
+        m_offset = std::exchange(other.m_offset, 0);
+        m_size = std::exchange(other.m_size, 0);
+        m_timestampNs = std::exchange(other.m_timestampNs, 0);
+    }
+    return *this;
+}
+
+RxChunk::~RxChunk()
+{
+    release();
+}
+
+void RxChunk::release()
+{
+    if (m_slab && m_slab->ref.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        SlabPool::instance()->recycle(m_slab);
+    }
+    m_slab = nullptr;
+    m_offset = 0;
+    m_size = 0;
+    m_timestampNs = 0;
+}
+
+const char *RxChunk::data() const
+{
+    return m_slab ? m_slab->data + m_offset : nullptr;
+}
+
+RxChunk RxChunk::mid(qsizetype pos, qsizetype length) const
+{
+    pos = qBound<qsizetype>(0, pos, m_size);
+    length = qBound<qsizetype>(0, length, m_size - pos);
+    RxChunk chunk(m_slab, m_offset + pos, length);
+    chunk.m_timestampNs = m_timestampNs;
+    return chunk;
+}
+
+QByteArray RxChunk::toByteArray() const
+{
+    return QByteArray(data(), m_size);
+}
+
+char *RxChunk::tail()
+{
+    return m_slab ? m_slab->data + m_slab->filled : nullptr;
+}
+
+qsizetype RxChunk::tailCapacity() const
+{
+    // 只有引用延伸到已写入末尾时才能继续写入
+    if (!m_slab || m_offset + m_size != m_slab->filled) {
+        return 0;
+    }
+    return SlabPool::SLAB_SIZE - m_slab->filled;
+}
+
+void RxChunk::commit(qsizetype n)
+{
+    Q_ASSERT(n >= 0 && n <= tailCapacity());
+    m_slab->filled += n;
+    m_size += n;
+}
+
+SlabPool *SlabPool::instance()
+{
+    // 不析构：退出时仍在排队的 RxChunk 释放时需要访问池
+    static SlabPool *pool = new SlabPool;
+    return pool;
+}
+
+RxChunk SlabPool::acquire()
+{
+    RxChunk::Slab *slab = nullptr;
+    {
+        QMutexLocker locker(&m_mutex);
+        if (!m_free.isEmpty()) {
+            slab = m_free.takeLast();
+        }
+    }
+    if (!slab) {
+        slab = new RxChunk::Slab;
+        m_allocations.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    slab->filled = 0;
+    m_acquires.fetch_add(1, std::memory_order_relaxed);
+    m_inUse.fetch_add(1, std::memory_order_relaxed);
+    return RxChunk(slab, 0, 0);
+}
+
+void SlabPool::recycle(RxChunk::Slab *slab)
+{
+    m_inUse.fetch_sub(1, std::memory_order_relaxed);
+
+    QMutexLocker locker(&m_mutex);
+    if (m_free.size() < MAX_POOLED) {
+        m_free.append(slab);
+        return;
+    }
+    locker.unlock();
+    delete slab;
+}
+
+SlabStats SlabPool::stats() const
+{
+    SlabStats stats;
+    stats.allocations = m_allocations.load(std::memory_order_relaxed);
+    stats.acquires = m_acquires.load(std::memory_order_relaxed);
+    stats.inUse = m_inUse.load(std::memory_order_relaxed);
+    QMutexLocker locker(&m_mutex);
+    stats.pooled = m_free.size();
+    return stats;
+}
@@ -0,0 +1,169 @@
+#ifndef RXCHUNK_H
+#define RXCHUNK_H
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QMetaType>
+#include <QMutex>
+#include <QVector>
+#include <atomic>
+
+/**
+ * @brief SlabStats - 接收块池统计
+ *
+ * 所有计数从程序启动时开始累计，UI 按差值换算为每秒次数。
+ */
+struct SlabStats {
+    quint64 allocations = 0;   ///< 从堆上新分配的块数
+    quint64 acquires = 0;      ///< 取块次数（新分配 + 复用）
+    qint64 inUse = 0;          ///< 仍被引用的块数
+    qint64 pooled = 0;         ///< 池中空闲的块数
+};
+
+class SlabPool;
+
+/**
+ * @brief RxChunk - 接收块中一段数据的引用
+ *
+ * 串口数据直接读入固定大小的接收块（slab），下游（原始数据缓冲区、
+ * DataProcessor 等）持有 RxChunk 引用而不是拷贝。RxChunk 可以像值一样复制和
+ * 跨线程传递，复制只增加块的引用计数；最后一个引用释放时块回到 SlabPool。
+ *
+ * 引用的数据只读。tail()/commit() 用于向块末尾写入新数据，只能由取得该块的
+ * 线程（SerialWorker）调用，写入区域与已发出的引用互不重叠。
+ * 每个引用还携带数据到达时的单调时钟时间戳（TimestampFormatter::monotonicNs()）。
+ */
+class RxChunk
+{
+public:
+    RxChunk() = default;
+    RxChunk(const RxChunk &other);
+    RxChunk(RxChunk &&other) noexcept;
+    RxChunk &operator=(const RxChunk &other);
+    RxChunk &operator=(RxChunk &&other) noexcept;
+    ~RxChunk();
+
+    /**
+     * @brief 检查是否未引用任何块
+     * @return true 如果为空引用
+     */
+    bool isNull() const { return m_slab == nullptr; }
+
+    bool isEmpty() const { return m_size == 0; }
+    qsizetype size() const { return m_size; }
+    const char *data() const;
+    QByteArrayView view() const { return QByteArrayView(data(), m_size); }
+
+    /**
+     * @brief 引用其中一段数据（不拷贝）
+     * @param pos 起始位置
+     * @param length 长度
+     * @return 新的引用
+     */
+    RxChunk mid(qsizetype pos, qsizetype length) const;
+
+    /**
+     * @brief 获取数据到达时间
+     * @return 单调时钟纳秒，0 表示未记录
+     */
+    qint64 timestampNs() const { return m_timestampNs; }
+
+    /**
+     * @brief 设置数据到达时间
+     * @param ns 单调时钟纳秒
+     */
+    void setTimestampNs(qint64 ns) { m_timestampNs = ns; }
+
+    /**
+     * @brief 拷贝为 QByteArray（仅在需要长期保存或修改时使用）
+     * @return 数据副本
+     */
+    QByteArray toByteArray() const;
+
+    /**
+     * @brief 获取块末尾可写入的位置（写入方使用）
+     * @return 写入位置
+     */
+    char *tail();
+
+    /**
+     * @brief 获取块末尾剩余的可写字节数（写入方使用）
+     * @return 剩余字节数
+     */
+    qsizetype tailCapacity() const;
+
+    /**
+     * @brief 确认已写入 tail() 的 n 个字节，使其成为本引用的一部分（写入方使用）
+     * @param n 写入的字节数
+     */
+    void commit(qsizetype n);
+
+private:
+    friend class SlabPool;
+
+    struct Slab;
+
+    RxChunk(Slab *slab, qsizetype offset, qsizetype size);
+
+    /**
+     * @brief 释放对当前块的引用
+     */
+    void release();
+
+    Slab *m_slab = nullptr;   ///< 引用的块
+    qsizetype m_offset = 0;   ///< 数据在块中的起始位置
+    qsizetype m_size = 0;     ///< 数据长度
+    qint64 m_timestampNs = 0; ///< 到达时间（单调时钟纳秒）
+};
+
+Q_DECLARE_METATYPE(RxChunk)
+
+/**
+ * @brief SlabPool - 固定大小接收块的复用池
+ *
+ * 进程内共享一个实例。块用完后回到空闲列表，稳定接收时不再从堆上分配；
+ * 空闲块超过 MAX_POOLED 时直接释放。线程安全：取块和还块只在块边界发生，
+ * 每块一次加锁，代价远小于按读取次数分配。
+ */
+class SlabPool
+{
+public:
+    static constexpr qsizetype SLAB_SIZE = 64 * 1024;   ///< 单块大小（字节）
+    static constexpr int MAX_POOLED = 64;               ///< 最多保留的空闲块数
+
+    /**
+     * @brief 获取全局实例
+     * @return 接收块池
+     */
+    static SlabPool *instance();
+
+    /**
+     * @brief 取一个空块
+     * @return 引用整块、长度为 0 的 RxChunk，通过 tail()/commit() 写入
+     */
+    RxChunk acquire();
+
+    /**
+     * @brief 获取统计快照
+     * @return 统计信息
+     */
+    SlabStats stats() const;
+
+private:
+    friend class RxChunk;
+
+    SlabPool() = default;
+
+    /**
+     * @brief 最后一个引用释放后回收块
+     */
+    void recycle(RxChunk::Slab *slab);
+
+    mutable QMutex m_mutex;                   ///< 保护 m_free
+    QVector<RxChunk::Slab *> m_free;          ///< 空闲块
+    std::atomic<quint64> m_allocations{0};
+    std::atomic<quint64> m_acquires{0};
+    std::atomic<qint64> m_inUse{0};
+};
+
+#endif // RXCHUNK_H
@@ -0,0 +1,91 @@
+#ifndef SEARCHQUERY_H
+#define SEARCHQUERY_H
+
+#include <QRegularExpression>
+#include <QString>
+
+/**
+ * @brief SearchQuery - 接收历史搜索条件
+ *
+ * 普通文本或正则表达式，可选区分大小写，提供条件验证功能。
+ */
+struct SearchQuery {
+    static constexpr int MAX_TEXT_LENGTH = 1024;    ///< 搜索文本最大长度（同 HistoryStore::MAX_LINE_BYTES）
+
+    QString text;                 ///< 搜索文本或正则表达式
+    bool regex = false;           ///< 按正则表达式匹配
+    bool caseSensitive = false;   ///< 区分大小写
+
+    /**
+     * @brief 是否可以直接按字节查找
+     *
+     * 普通文本区分大小写时总是可以；不区分大小写时只按 ASCII 规则折叠字母，
+     * 文本中含有其他有大小写之分的字符（如 é、Ä、希腊字母）时需要经过正则表达式。
+     *
+     * @return true 如果不需要经过正则表达式
+     */
+    bool isLiteral() const {
+        if (regex) {
+            return false;
+        }
+        if (caseSensitive) {
+            return true;
+        }
+        for (const QChar ch : text) {
+            if (ch.unicode() >= 0x80 && (ch.isSurrogate() || ch.toLower() != ch || ch.toUpper() != ch)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief 生成对应的正则表达式（普通文本会被转义）
+     * @return 正则表达式
+     */
+    QRegularExpression toRegularExpression() const {
+        QRegularExpression::PatternOptions options = QRegularExpression::UseUnicodePropertiesOption;
+        if (!caseSensitive) {
+            options |= QRegularExpression::CaseInsensitiveOption;
+        }
+        return QRegularExpression(regex ? text : QRegularExpression::escape(text), options);
+    }
+
+    /**
+     * @brief 验证搜索条件是否有效
+     * @return true 如果条件有效，否则返回 false
+     */
+    bool isValid() const {
+        return validationError().isEmpty();
+    }
+
+    /**
+     * @brief 获取搜索条件验证错误信息
+     * @return 错误描述字符串，如果条件有效则返回空字符串
+     */
+    QString validationError() const {
+        if (text.isEmpty()) {
+            return QStringLiteral("Search text must not be empty");
+        }
+        if (text.size() > MAX_TEXT_LENGTH) {
+            return QStringLiteral("Search text must not be longer than %1 characters").arg(MAX_TEXT_LENGTH);
+        }
+        if (regex) {
+            const QRegularExpression expression = toRegularExpression();
+            if (!expression.isValid()) {
+                return QStringLiteral("Invalid regular expression: %1").arg(expression.errorString());
+            }
+        }
+        return QString();
+    }
+
+    bool operator==(const SearchQuery &other) const {
+        return text == other.text && regex == other.regex && caseSensitive == other.caseSensitive;
+    }
+
+    bool operator!=(const SearchQuery &other) const {
+        return !(*this == other);
+    }
+};
+
+#endif // SEARCHQUERY_H
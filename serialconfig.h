@@ -11,6 +11,17 @@
  * Requirements: 4.1, 4.2, 4.3
  */
 struct SerialConfig {
+    /**
+     * @brief 串口后端
+     */
+    enum Backend {
+        QtBackend,       ///< QSerialPort（所有平台，标准波特率）
+        NativeBackend    ///< Linux termios2/epoll（任意波特率、低延迟）
+    };
+
+    static constexpr qint32 MIN_NATIVE_BAUD_RATE = 50;          ///< 原生后端最小波特率
+    static constexpr qint32 MAX_NATIVE_BAUD_RATE = 16000000;    ///< 原生后端最大波特率
+
     QString portName;
     qint32 baudRate = 115200;
     QSerialPort::DataBits dataBits = QSerialPort::Data8;
@@ -18,6 +29,42 @@ struct SerialConfig {
     QSerialPort::Parity parity = QSerialPort::NoParity;
     QSerialPort::FlowControl flowControl = QSerialPort::NoFlowControl;
     int readBufferSize = 4096;
+    int batchLatencyMs = 2;       ///< 读取合并的最大延迟（毫秒），0 表示每次 readyRead 立即发出
+    int batchMaxBytes = 16384;    ///< 单个合并批次的最大字节数
+    Backend backend = QtBackend;  ///< 串口后端
+    int nativeVmin = 1;           ///< 原生后端的 VMIN：内核累积到多少字节才唤醒读取（1~255），剩余字节由定时读取取走
+
+    /**
+     * @brief 检查波特率是否被所选后端支持
+     *
+     * QSerialPort 后端只接受常用波特率；原生后端通过 BOTHER 支持任意波特率。
+     *
+     * @return true 如果支持
+     */
+    bool isBaudRateSupported() const {
+        if (backend == NativeBackend) {
+            return baudRate >= MIN_NATIVE_BAUD_RATE && baudRate <= MAX_NATIVE_BAUD_RATE;
+        }
+
+        static const QList<qint32> validBaudRates = {
+            1200, 2400, 4800, 9600, 19200, 38400, 57600, 115200,
+            230400, 460800, 921600, 1000000, 1500000, 2000000, 3000000, 4000000
+        };
+        return validBaudRates.contains(baudRate);
+    }
+
+    /**
+     * @brief 检查所选后端在当前平台是否可用
+     * @return true 如果可用
+     */
+    static bool isBackendAvailable(Backend backend) {
+#ifdef Q_OS_LINUX
+        Q_UNUSED(backend);
+        return true;
+#else
+        return backend == QtBackend;
+#endif
+    }
 
     /**
      * @brief 验证配置参数是否有效
@@ -34,12 +81,12 @@ struct SerialConfig {
             return false;
         }
 
-        // 验证波特率是否为常用值
-        static const QList<qint32> validBaudRates = {
-            1200, 2400, 4800, 9600, 19200, 38400, 57600, 115200, 
-            230400, 460800, 921600
-        };
-        if (!validBaudRates.contains(baudRate)) {
+        // 验证后端可用，且波特率被后端支持
+        if (!isBackendAvailable(backend) || !isBaudRateSupported()) {
+            return false;
+        }
+
+        if (backend == NativeBackend && (nativeVmin < 1 || nativeVmin > 255)) {
             return false;
         }
 
@@ -48,6 +95,11 @@ struct SerialConfig {
             return false;
         }
 
+        // 验证读取合并参数
+        if (batchLatencyMs < 0 || batchMaxBytes <= 0) {
+            return false;
+        }
+
         return true;
     }
 
@@ -64,18 +116,34 @@ struct SerialConfig {
             return QStringLiteral("Baud rate must be a positive number");
         }
 
-        static const QList<qint32> validBaudRates = {
-            1200, 2400, 4800, 9600, 19200, 38400, 57600, 115200,
-            230400, 460800, 921600
-        };
-        if (!validBaudRates.contains(baudRate)) {
-            return QStringLiteral("Invalid baud rate: %1. Supported rates: 1200, 2400, 4800, 9600, 19200, 38400, 57600, 115200, 230400, 460800, 921600").arg(baudRate);
+        if (!isBackendAvailable(backend)) {
+            return QStringLiteral("The native serial backend is only available on Linux");
+        }
+
+        if (!isBaudRateSupported()) {
+            if (backend == NativeBackend) {
+                return QStringLiteral("Invalid baud rate: %1. Supported range: %2 - %3")
+                    .arg(baudRate).arg(MIN_NATIVE_BAUD_RATE).arg(MAX_NATIVE_BAUD_RATE);
+            }
+            return QStringLiteral("Invalid baud rate: %1. Supported rates: 1200, 2400, 4800, 9600, 19200, 38400, 57600, 115200, 230400, 460800, 921600, 1000000, 1500000, 2000000, 3000000, 4000000").arg(baudRate);
+        }
+
+        if (backend == NativeBackend && (nativeVmin < 1 || nativeVmin > 255)) {
+            return QStringLiteral("VMIN must be between 1 and 255");
         }
 
         if (readBufferSize <= 0) {
             return QStringLiteral("Read buffer size must be a positive number");
         }
 
+        if (batchLatencyMs < 0) {
+            return QStringLiteral("Batch latency must not be negative");
+        }
+
+        if (batchMaxBytes <= 0) {
+            return QStringLiteral("Batch size must be a positive number");
+        }
+
         return QString();
     }
 };
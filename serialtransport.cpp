@@ -0,0 +1,33 @@
+#include "serialtransport.h"
+#include "qtserialtransport.h"
+#ifdef Q_OS_LINUX
+#include "nativeserialtransport.h"
+#endif
+
+/**
+ * @brief SerialTransport 实现
+ */
+
+SerialTransport::SerialTransport(QObject *parent)
+    : QObject(parent)
+{
+}
+
+SerialTransport::~SerialTransport()
+{
+}
+
+SerialTransport *SerialTransport::create(SerialConfig::Backend backend, QObject *parent)
+{
+    switch (backend) {
+    case SerialConfig::NativeBackend:
+#ifdef Q_OS_LINUX
+        return new NativeSerialTransport(parent);
+#else
+        return nullptr;
+#endif
+    case SerialConfig::QtBackend:
+        break;
+    }
+    return new QtSerialTransport(parent);
+}
@@ -0,0 +1,105 @@
+#ifndef SERIALTRANSPORT_H
+#define SERIALTRANSPORT_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QString>
+
+#include "serialconfig.h"
+
+/**
+ * @brief SerialTransport - 串口传输层接口
+ *
+ * SerialWorker 通过该接口收发数据，不直接依赖具体实现：
+ * - QtSerialTransport：基于 QSerialPort，所有平台可用
+ * - NativeSerialTransport：Linux 下直接操作 tty（termios2/BOTHER、epoll），
+ *   支持任意波特率和低延迟模式
+ * 由 SerialConfig::backend 选择，对象在工作线程中创建和使用。
+ */
+class SerialTransport : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief 构造函数
+     * @param parent 父对象
+     */
+    explicit SerialTransport(QObject *parent = nullptr);
+
+    /**
+     * @brief 析构函数
+     */
+    ~SerialTransport() override;
+
+    /**
+     * @brief 创建指定后端的传输层
+     * @param backend 串口后端
+     * @param parent 父对象
+     * @return 传输层对象；后端在当前平台不可用时返回 nullptr
+     */
+    static SerialTransport *create(SerialConfig::Backend backend, QObject *parent = nullptr);
+
+    /**
+     * @brief 按配置打开串口
+     *
+     * 失败时发出 errorOccurred 信号。
+     *
+     * @param config 串口配置
+     * @return true 如果打开成功
+     */
+    virtual bool open(const SerialConfig &config) = 0;
+
+    /**
+     * @brief 关闭串口
+     */
+    virtual void close() = 0;
+
+    /**
+     * @brief 检查串口是否已打开
+     * @return true 如果已打开
+     */
+    virtual bool isOpen() const = 0;
+
+    /**
+     * @brief 把已接收的数据读入调用者提供的内存
+     *
+     * 不阻塞；调用者（SerialWorker）直接读入接收块，避免中间拷贝。
+     *
+     * @param data 目标内存
+     * @param maxSize 目标内存大小
+     * @return 读取的字节数，没有数据时返回 0，出错返回 -1
+     */
+    virtual qint64 read(char *data, qint64 maxSize) = 0;
+
+    /**
+     * @brief 写入数据
+     *
+     * 不阻塞；设备暂时不可写的部分由实现排队，稍后在事件循环中发出，
+     * 之后的发送失败通过 errorOccurred 报告。
+     *
+     * @param data 要发送的数据
+     * @return 接受的字节数，失败返回 -1
+     */
+    virtual qint64 write(const QByteArray &data) = 0;
+
+    /**
+     * @brief 获取最近一次错误的描述
+     * @return 错误描述
+     */
+    virtual QString errorString() const = 0;
+
+signals:
+    /**
+     * @brief 有新数据可读
+     */
+    void readyRead();
+
+    /**
+     * @brief 发生错误（打开失败、读写错误、设备断开等）
+     * @param error 错误描述
+     */
+    void errorOccurred(const QString &error);
+};
+
+#endif // SERIALTRANSPORT_H
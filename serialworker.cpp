@@ -1,4 +1,7 @@
 #include "serialworker.h"
+#include "serialtransport.h"
+#include "iothreadpool.h"
+#include "timestampformatter.h"
 
 /**
  * @brief SerialWorker - 串口工作线程实现
@@ -7,7 +10,7 @@
  */
 
 SerialWorker::SerialWorker(QObject *parent)
-    : QObject(parent)
+    : DataSource(parent)
 {
     initThread();
 }
@@ -20,10 +23,10 @@ SerialWorker::~SerialWorker()
         QMetaObject::invokeMethod(this, "doStop", Qt::BlockingQueuedConnection);
     }
     
-    // 确保 m_serial 被清理（防御性编程）
-    if (m_serial) {
-        delete m_serial;
-        m_serial = nullptr;
+    // 确保 m_transport 被清理（防御性编程）
+    if (m_transport) {
+        delete m_transport;
+        m_transport = nullptr;
     }
     
     cleanupThread();
@@ -39,29 +42,42 @@ Qt::HANDLE SerialWorker::workerThreadId() const
     return m_workerThreadId;
 }
 
+BatchStats SerialWorker::batchStats() const
+{
+    BatchStats stats;
+    stats.batches = m_statBatches.load(std::memory_order_relaxed);
+    stats.reads = m_statReads.load(std::memory_order_relaxed);
+    stats.bytes = m_statBytes.load(std::memory_order_relaxed);
+    stats.sizeFlushes = m_statSizeFlushes.load(std::memory_order_relaxed);
+    stats.latencyFlushes = m_statLatencyFlushes.load(std::memory_order_relaxed);
+    return stats;
+}
+
 void SerialWorker::initThread()
 {
-    m_thread = new QThread();
+    m_thread = IoThreadPool::instance(IoThreadPool::SerialIo)->acquire();
     
-    // 将 SerialWorker 移动到工作线程
+    // 将 SerialWorker 移动到工作线程（可能与其他会话共享）
     this->moveToThread(m_thread);
     
-    // 线程启动时记录线程ID
-    connect(m_thread, &QThread::started, this, [this]() {
+    // 记录线程ID
+    QMetaObject::invokeMethod(this, [this]() {
         m_workerThreadId = QThread::currentThreadId();
     });
-    
-    // 启动工作线程
-    m_thread->start();
 }
 
 void SerialWorker::cleanupThread()
 {
     if (m_thread) {
-        m_thread->quit();
-        m_thread->wait();
-        delete m_thread;
+        // 共享线程不能停止：在工作线程中把自己移回调用线程，之后才能安全析构
+        QThread *target = QThread::currentThread();
+        QMetaObject::invokeMethod(this, [this, target]() {
+            this->moveToThread(target);
+        }, Qt::BlockingQueuedConnection);
+
+        IoThreadPool::instance(IoThreadPool::SerialIo)->release(m_thread);
         m_thread = nullptr;
+        m_workerThreadId = nullptr;
     }
 }
 
@@ -117,30 +133,47 @@ void SerialWorker::doStart()
     // 此方法在工作线程中执行
     // Requirements: 1.1 - 串口在独立线程中创建和运行
     
-    m_serial = new QSerialPort();
-    
-    // 应用配置
-    m_serial->setPortName(m_pendingConfig.portName);
-    m_serial->setBaudRate(m_pendingConfig.baudRate);
-    m_serial->setDataBits(m_pendingConfig.dataBits);
-    m_serial->setStopBits(m_pendingConfig.stopBits);
-    m_serial->setParity(m_pendingConfig.parity);
-    m_serial->setFlowControl(m_pendingConfig.flowControl);
-    m_serial->setReadBufferSize(m_pendingConfig.readBufferSize);
-
-    // 连接信号
-    connect(m_serial, &QSerialPort::readyRead, this, &SerialWorker::onReadyRead);
-    connect(m_serial, &QSerialPort::errorOccurred, this, &SerialWorker::onSerialError);
+    m_transport = SerialTransport::create(m_pendingConfig.backend);
+    if (!m_transport) {
+        emit errorOccurred(QStringLiteral("The selected serial backend is not available on this platform"));
+        return;
+    }
+
+    // 连接信号，传输层的错误直接转发
+    connect(m_transport, &SerialTransport::readyRead, this, &SerialWorker::onReadyRead);
+    connect(m_transport, &SerialTransport::errorOccurred, this, &SerialWorker::errorOccurred);
 
     // 尝试打开串口
-    // 注意：open() 失败时 Qt 会自动触发 errorOccurred 信号，
+    // 注意：open() 失败时传输层会发出 errorOccurred 信号，
     // 所以这里不需要手动 emit，只需清理资源
-    if (!m_serial->open(QIODevice::ReadWrite)) {
-        delete m_serial;
-        m_serial = nullptr;
+    if (!m_transport->open(m_pendingConfig)) {
+        delete m_transport;
+        m_transport = nullptr;
         return;
     }
 
+    // 读取合并定时器，超过最大延迟后发出当前批次
+    m_batchTimer = new QTimer();
+    m_batchTimer->setSingleShot(true);
+    m_batchTimer->setTimerType(Qt::PreciseTimer);
+    m_batchTimer->setInterval(m_pendingConfig.batchLatencyMs);
+    connect(m_batchTimer, &QTimer::timeout, this, [this]() {
+        if (m_batchSize > 0) {
+            m_statLatencyFlushes.fetch_add(1, std::memory_order_relaxed);
+        }
+        flushBatch();
+    });
+
+    m_slab = RxChunk();
+    m_batchSize = 0;
+    m_batchLimit = qBound<qsizetype>(1, m_pendingConfig.batchMaxBytes, SlabPool::SLAB_SIZE);
+    m_batchReads = 0;
+    m_statBatches = 0;
+    m_statReads = 0;
+    m_statBytes = 0;
+    m_statSizeFlushes = 0;
+    m_statLatencyFlushes = 0;
+
     m_running = true;
     emit started();
 }
@@ -148,11 +181,19 @@ void SerialWorker::doStart()
 void SerialWorker::doStop()
 {
     // 此方法在工作线程中执行
+
+    // 关闭前发出尚未到期的批次
+    flushBatch();
+    m_slab = RxChunk();
+    if (m_batchTimer) {
+        delete m_batchTimer;
+        m_batchTimer = nullptr;
+    }
     
-    if (m_serial) {
-        m_serial->close();
-        delete m_serial;
-        m_serial = nullptr;
+    if (m_transport) {
+        m_transport->close();
+        delete m_transport;
+        m_transport = nullptr;
     }
 
     m_running = false;
@@ -163,14 +204,14 @@ void SerialWorker::doSendData(const QByteArray &data)
 {
     // 此方法在工作线程中执行
     
-    if (!m_serial || !m_serial->isOpen()) {
+    if (!m_transport || !m_transport->isOpen()) {
         emit errorOccurred(QStringLiteral("Serial port is not open"));
         return;
     }
 
-    qint64 bytesWritten = m_serial->write(data);
+    qint64 bytesWritten = m_transport->write(data);
     if (bytesWritten == -1) {
-        emit errorOccurred(QStringLiteral("Failed to write data: %1").arg(m_serial->errorString()));
+        emit errorOccurred(QStringLiteral("Failed to write data: %1").arg(m_transport->errorString()));
     } else if (bytesWritten != data.size()) {
         emit errorOccurred(QStringLiteral("Incomplete write: %1 of %2 bytes written")
                           .arg(bytesWritten).arg(data.size()));
@@ -182,52 +223,75 @@ void SerialWorker::onReadyRead()
     // 此方法在工作线程中执行
     // Requirements: 1.2 - 在工作线程中读取数据，不阻塞UI线程
     
-    if (!m_serial) {
+    if (!m_transport) {
         return;
     }
 
-    QByteArray data = m_serial->readAll();
-    if (!data.isEmpty()) {
-        emit dataReceived(data);
+    // 直接读入接收块；批次不跨块，新批次开始时剩余空间不足一个批次就换新块
+    bool gotData = false;
+    for (;;) {
+        if (m_batchSize == 0 && m_slab.tailCapacity() < m_batchLimit) {
+            m_slab = SlabPool::instance()->acquire();
+        }
+
+        const qsizetype room = m_batchLimit - m_batchSize;
+        const qint64 n = m_transport->read(m_slab.tail(), room);
+        if (n <= 0) {
+            break;
+        }
+        // 到达时间在读取时记录，不受后续排队延迟影响
+        if (m_batchSize == 0) {
+            m_batchTimestampNs = TimestampFormatter::monotonicNs();
+        }
+        m_slab.commit(n);
+        m_batchSize += n;
+        if (!gotData) {
+            ++m_batchReads;
+            gotData = true;
+        }
+
+        // 达到大小上限时立即发出，继续读取剩余数据
+        if (m_batchSize >= m_batchLimit) {
+            m_statSizeFlushes.fetch_add(1, std::memory_order_relaxed);
+            flushBatch();
+            continue;
+        }
+        if (n < room) {
+            break;
+        }
+    }
+
+    // 未启用合并时立即发出，否则等待合并定时器
+    if (m_batchSize == 0) {
+        return;
+    }
+    if (m_pendingConfig.batchLatencyMs == 0) {
+        flushBatch();
+    } else if (m_batchTimer && !m_batchTimer->isActive()) {
+        m_batchTimer->start();
     }
 }
 
-void SerialWorker::onSerialError(QSerialPort::SerialPortError error)
+void SerialWorker::flushBatch()
 {
     // 此方法在工作线程中执行
-    // Requirements: 1.4 - 发生错误时发出信号通知主线程
-    
-    if (error == QSerialPort::NoError) {
+
+    if (m_batchTimer) {
+        m_batchTimer->stop();
+    }
+    if (m_batchSize == 0) {
         return;
     }
 
-    QString errorString;
-    switch (error) {
-    case QSerialPort::DeviceNotFoundError:
-        errorString = QStringLiteral("Device not found");
-        break;
-    case QSerialPort::PermissionError:
-        errorString = QStringLiteral("Permission denied");
-        break;
-    case QSerialPort::OpenError:
-        errorString = QStringLiteral("Failed to open port");
-        break;
-    case QSerialPort::WriteError:
-        errorString = QStringLiteral("Write error");
-        break;
-    case QSerialPort::ReadError:
-        errorString = QStringLiteral("Read error");
-        break;
-    case QSerialPort::ResourceError:
-        errorString = QStringLiteral("Resource error (device may have been disconnected)");
-        break;
-    case QSerialPort::TimeoutError:
-        errorString = QStringLiteral("Timeout error");
-        break;
-    default:
-        errorString = m_serial ? m_serial->errorString() : QStringLiteral("Unknown error");
-        break;
-    }
-
-    emit errorOccurred(errorString);
+    m_statBatches.fetch_add(1, std::memory_order_relaxed);
+    m_statReads.fetch_add(m_batchReads, std::memory_order_relaxed);
+    m_statBytes.fetch_add(static_cast<quint64>(m_batchSize), std::memory_order_relaxed);
+
+    // 批次只引用接收块中的一段，不拷贝
+    RxChunk batch = m_slab.mid(m_slab.size() - m_batchSize, m_batchSize);
+    batch.setTimestampNs(m_batchTimestampNs);
+    m_batchSize = 0;
+    m_batchReads = 0;
+
+    emit dataReceived(batch);
 }
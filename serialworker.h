@@ -1,22 +1,43 @@
 #ifndef SERIALWORKER_H
 #define SERIALWORKER_H
 
-#include <QObject>
-#include <QSerialPort>
 #include <QThread>
+#include <QTimer>
 #include <atomic>
 
+#include "datasource.h"
 #include "serialconfig.h"
 
+class SerialTransport;
+
+/**
+ * @brief BatchStats - 读取合并统计
+ *
+ * 反映 readyRead 合并为批次的效果，所有计数从串口打开时开始累计。
+ */
+struct BatchStats {
+    quint64 batches = 0;         ///< 已发出的批次数
+    quint64 reads = 0;           ///< 合并进批次的 readyRead 次数
+    quint64 bytes = 0;           ///< 已发出的总字节数
+    quint64 sizeFlushes = 0;     ///< 因达到 batchMaxBytes 而发出的批次数
+    quint64 latencyFlushes = 0;  ///< 因达到 batchLatencyMs 而发出的批次数
+
+    double readsPerBatch() const { return batches ? double(reads) / double(batches) : 0.0; }
+    double bytesPerBatch() const { return batches ? double(bytes) / double(batches) : 0.0; }
+};
+
 /**
  * @brief SerialWorker - 串口工作线程
  * 
  * 在独立线程中处理串口数据的接收和发送，避免阻塞主UI线程。
- * 使用 QThread 封装，串口在工作线程中运行。
+ * 串口在工作线程中运行；工作线程取自 IoThreadPool，多个串口会话共享少量线程。
+ * 串口读写经由 SerialTransport，后端由 SerialConfig::backend 选择。
+ * 启用读取合并时，一次 dataReceived 发出的是 batchLatencyMs / batchMaxBytes 范围内
+ * 累积的一批数据，时间戳为批次第一个字节读到的时间。
  * 
  * Requirements: 1.1, 1.2, 1.4
  */
-class SerialWorker : public QObject
+class SerialWorker : public DataSource
 {
     Q_OBJECT
 
@@ -38,7 +59,7 @@ public:
      * @brief 检查串口是否正在运行
      * @return true 如果串口已打开且工作线程正在运行
      */
-    bool isRunning() const;
+    bool isRunning() const override;
 
     /**
      * @brief 获取当前工作线程ID（用于测试验证线程隔离）
@@ -46,6 +67,12 @@ public:
      */
     Qt::HANDLE workerThreadId() const;
 
+    /**
+     * @brief 获取读取合并统计（线程安全）
+     * @return 当前统计快照
+     */
+    BatchStats batchStats() const;
+
 public slots:
     /**
      * @brief 启动串口通信
@@ -64,7 +91,7 @@ public slots:
      * 关闭串口并停止工作线程。
      * 完成后发出 stopped 信号。
      */
-    void stop();
+    void stop() override;
 
     /**
      * @brief 发送数据到串口
@@ -76,59 +103,22 @@ public slots:
      */
     void sendData(const QByteArray &data);
 
-signals:
-    /**
-     * @brief 串口已成功启动
-     * 
-     * 当串口成功打开并开始接收数据时发出。
-     */
-    void started();
-
-    /**
-     * @brief 串口已停止
-     * 
-     * 当串口关闭并停止工作时发出。
-     */
-    void stopped();
-
-    /**
-     * @brief 接收到数据
-     * 
-     * 当从串口读取到数据时发出。
-     * Requirements: 1.2
-     * 
-     * @param data 接收到的原始数据
-     */
-    void dataReceived(const QByteArray &data);
-
-    /**
-     * @brief 发生错误
-     * 
-     * 当发生任何错误时发出（配置无效、打开失败、读取错误等）。
-     * Requirements: 1.4
-     * 
-     * @param error 错误描述
-     */
-    void errorOccurred(const QString &error);
-
 private slots:
     /**
      * @brief 处理串口数据就绪
      * 
-     * 当串口有数据可读时调用，读取所有可用数据并发出 dataReceived 信号。
+     * 当串口有数据可读时调用，把所有可用数据直接读入当前接收块，追加到当前批次；
+     * 批次达到大小上限时立即发出，否则由合并定时器在最大延迟后发出。
      * Requirements: 1.2
      */
     void onReadyRead();
 
     /**
-     * @brief 处理串口错误
-     * 
-     * 当串口发生错误时调用。
-     * Requirements: 1.4
-     * 
-     * @param error 串口错误类型
+     * @brief 发出当前累积的批次
+     *
+     * 由合并定时器、大小上限或关闭串口触发。
      */
-    void onSerialError(QSerialPort::SerialPortError error);
+    void flushBatch();
 
     /**
      * @brief 在工作线程中初始化串口
@@ -155,20 +145,33 @@ private slots:
 
 private:
     /**
-     * @brief 初始化工作线程
+     * @brief 从 IoThreadPool 取工作线程并移动过去
      */
     void initThread();
 
     /**
-     * @brief 清理工作线程
+     * @brief 移回调用线程并把工作线程归还 IoThreadPool
      */
     void cleanupThread();
 
-    QSerialPort *m_serial = nullptr;      ///< 串口对象（在工作线程中创建）
-    QThread *m_thread = nullptr;          ///< 工作线程
+    SerialTransport *m_transport = nullptr; ///< 串口传输层（在工作线程中创建）
+    QTimer *m_batchTimer = nullptr;       ///< 读取合并定时器（在工作线程中创建）
+    RxChunk m_slab;                       ///< 当前接收块（已写入部分），批次位于其末尾
+    qsizetype m_batchSize = 0;            ///< 当前批次的字节数
+    qint64 m_batchTimestampNs = 0;        ///< 当前批次第一次读到数据的时间（单调时钟）
+    qsizetype m_batchLimit = 0;           ///< 单批次上限（batchMaxBytes，不超过接收块大小）
+    quint64 m_batchReads = 0;             ///< 当前批次包含的 readyRead 次数
+    QThread *m_thread = nullptr;          ///< 工作线程（IoThreadPool 所有）
     SerialConfig m_pendingConfig;         ///< 待应用的配置
     std::atomic<bool> m_running{false};   ///< 运行状态标志
     Qt::HANDLE m_workerThreadId = nullptr; ///< 工作线程ID
+
+    // 读取合并统计（工作线程写，任意线程读）
+    std::atomic<quint64> m_statBatches{0};
+    std::atomic<quint64> m_statReads{0};
+    std::atomic<quint64> m_statBytes{0};
+    std::atomic<quint64> m_statSizeFlushes{0};
+    std::atomic<quint64> m_statLatencyFlushes{0};
 };
 
 #endif // SERIALWORKER_H
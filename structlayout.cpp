@@ -0,0 +1,338 @@
+#include "structlayout.h"
+#include "frameconfig.h"
+
+#include <QList>
+#include <QtEndian>
+#include <cctype>
+
+/**
+ * @brief StructLayout 实现
+ */
+
+namespace {
+
+constexpr int MAX_ARRAY_LENGTH = StructLayout::MAX_FIELDS;    ///< 数组字段最多元素数
+
+/**
+ * @brief 分派码：类型 * 2 + 是否大端
+ */
+constexpr int code(StructLayout::Type type, bool bigEndian)
+{
+    return int(type) * 2 + (bigEndian ? 1 : 0);
+}
+
+template <typename T>
+inline double loadLittle(const uchar *p)
+{
+    return double(qFromLittleEndian<T>(p));
+}
+
+template <typename T>
+inline double loadBig(const uchar *p)
+{
+    return double(qFromBigEndian<T>(p));
+}
+
+bool isIdentifier(const QByteArray &name)
+{
+    if (name.isEmpty() || !(std::isalpha(uchar(name.at(0))) || name.at(0) == '_')) {
+        return false;
+    }
+    for (char c : name) {
+        if (!(std::isalnum(uchar(c)) || c == '_')) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief 去掉 '#' 或 "//" 之后的注释
+ */
+QByteArray stripComment(const QByteArray &line)
+{
+    qsizetype end = line.indexOf('#');
+    const qsizetype slash = line.indexOf("//");
+    if (slash >= 0 && (end < 0 || slash < end)) {
+        end = slash;
+    }
+    return end >= 0 ? line.left(end) : line;
+}
+
+} // namespace
+
+bool StructLayout::compile(const QString &text, QString *error)
+{
+    auto fail = [error](int lineNo, const QString &message) {
+        if (error) {
+            *error = QString("第 %1 行: %2").arg(lineNo).arg(message);
+        }
+        return false;
+    };
+
+    QVector<Extractor> extractors;
+    QVector<QByteArray> names;
+    int offset = 0;
+    bool defaultBig = false;
+
+    const QList<QByteArray> lines = text.toUtf8().split('\n');
+    for (qsizetype i = 0; i < lines.size(); ++i) {
+        const int lineNo = int(i + 1);
+        const QList<QByteArray> statements = stripComment(lines.at(i)).split(';');
+        for (const QByteArray &raw : statements) {
+            const QByteArray statement = raw.simplified();
+            if (statement.isEmpty()) {
+                continue;
+            }
+
+            // 第一个词决定语句类型
+            qsizetype space = statement.indexOf(' ');
+            QByteArray word = statement.left(space < 0 ? statement.size() : space);
+            QByteArray rest = space < 0 ? QByteArray() : statement.mid(space + 1);
+
+            if (word == "little" || word == "big") {
+                if (!rest.isEmpty()) {
+                    return fail(lineNo, QString("\"%1\" 之后不应有内容").arg(QString::fromUtf8(word)));
+                }
+                defaultBig = word == "big";
+                continue;
+            }
+
+            if (word == "pad") {
+                bool ok = false;
+                const int bytes = rest.trimmed().toInt(&ok);
+                if (!ok || bytes <= 0) {
+                    return fail(lineNo, "pad 需要一个正整数字节数");
+                }
+                offset += bytes;
+                if (offset > FrameConfig::MAX_FRAME_SIZE) {
+                    return fail(lineNo, QString("结构体超过 %1 字节").arg(FrameConfig::MAX_FRAME_SIZE));
+                }
+                continue;
+            }
+
+            bool bigEndian = defaultBig;
+            if (word == "le" || word == "be") {
+                bigEndian = word == "be";
+                space = rest.indexOf(' ');
+                word = rest.left(space < 0 ? rest.size() : space);
+                rest = space < 0 ? QByteArray() : rest.mid(space + 1);
+            }
+
+            Type type;
+            if (!parseType(word, &type)) {
+                return fail(lineNo, QString("未知类型 \"%1\"").arg(QString::fromUtf8(word)));
+            }
+            if (rest.trimmed().isEmpty()) {
+                return fail(lineNo, "缺少字段名");
+            }
+
+            const int bytes = typeSize(type);
+            for (const QByteArray &item : rest.split(',')) {
+                QByteArray name = item.trimmed();
+                int count = 1;
+                bool isArray = false;
+
+                const qsizetype bracket = name.indexOf('[');
+                if (bracket >= 0) {
+                    if (!name.endsWith(']')) {
+                        return fail(lineNo, QString("数组声明 \"%1\" 格式错误").arg(QString::fromUtf8(name)));
+                    }
+                    bool ok = false;
+                    count = name.mid(bracket + 1, name.size() - bracket - 2).trimmed().toInt(&ok);
+                    if (!ok || count <= 0 || count > MAX_ARRAY_LENGTH) {
+                        return fail(lineNo, QString("数组长度须为 1~%1").arg(MAX_ARRAY_LENGTH));
+                    }
+                    name = name.left(bracket).trimmed();
+                    isArray = true;
+                }
+                if (!isIdentifier(name)) {
+                    return fail(lineNo, QString("字段名 \"%1\" 无效").arg(QString::fromUtf8(name)));
+                }
+
+                for (int element = 0; element < count; ++element) {
+                    const QByteArray fieldName = isArray ? name + '[' + QByteArray::number(element) + ']' : name;
+                    if (names.contains(fieldName)) {
+                        return fail(lineNo, QString("字段 \"%1\" 重复").arg(QString::fromUtf8(fieldName)));
+                    }
+                    if (names.size() >= MAX_FIELDS) {
+                        return fail(lineNo, QString("字段数超过 %1").arg(MAX_FIELDS));
+                    }
+                    if (offset + bytes > FrameConfig::MAX_FRAME_SIZE) {
+                        return fail(lineNo, QString("结构体超过 %1 字节").arg(FrameConfig::MAX_FRAME_SIZE));
+                    }
+
+                    Extractor extractor;
+                    extractor.offset = offset;
+                    extractor.code = code(type, bigEndian && bytes > 1);
+                    extractors.append(extractor);
+                    names.append(fieldName);
+                    offset += bytes;
+                }
+            }
+        }
+    }
+
+    m_extractors = extractors;
+    m_names = names;
+    m_size = offset;
+    if (error) {
+        error->clear();
+    }
+    return true;
+}
+
+bool StructLayout::isEmpty() const
+{
+    return m_extractors.isEmpty();
+}
+
+int StructLayout::size() const
+{
+    return m_size;
+}
+
+int StructLayout::fieldCount() const
+{
+    return int(m_extractors.size());
+}
+
+QByteArray StructLayout::fieldName(int field) const
+{
+    return m_names.value(field);
+}
+
+const QVector<QByteArray> &StructLayout::fieldNames() const
+{
+    return m_names;
+}
+
+int StructLayout::fieldOffset(int field) const
+{
+    return m_extractors.at(field).offset;
+}
+
+StructLayout::Type StructLayout::fieldType(int field) const
+{
+    return static_cast<Type>(m_extractors.at(field).code / 2);
+}
+
+bool StructLayout::fieldBigEndian(int field) const
+{
+    return (m_extractors.at(field).code & 1) != 0;
+}
+
+QString StructLayout::fieldTypeName(int field) const
+{
+    static const char *const names[] = {
+        "int8", "uint8", "int16", "uint16", "int32", "uint32", "int64", "uint64", "float", "double"
+    };
+    const Type type = fieldType(field);
+    QString name = QString::fromLatin1(names[type]);
+    if (typeSize(type) > 1) {
+        name += fieldBigEndian(field) ? QStringLiteral(" BE") : QStringLiteral(" LE");
+    }
+    return name;
+}
+
+bool StructLayout::decode(const char *data, qsizetype size, double *values) const
+{
+    if (m_extractors.isEmpty() || size < m_size) {
+        return false;
+    }
+
+    const uchar *base = reinterpret_cast<const uchar *>(data);
+    for (const Extractor &extractor : m_extractors) {
+        const uchar *p = base + extractor.offset;
+        double value = 0;
+        switch (extractor.code) {
+        case code(Int8, false):     value = double(qint8(*p)); break;
+        case code(UInt8, false):    value = double(*p); break;
+        case code(Int16, false):    value = loadLittle<qint16>(p); break;
+        case code(Int16, true):     value = loadBig<qint16>(p); break;
+        case code(UInt16, false):   value = loadLittle<quint16>(p); break;
+        case code(UInt16, true):    value = loadBig<quint16>(p); break;
+        case code(Int32, false):    value = loadLittle<qint32>(p); break;
+        case code(Int32, true):     value = loadBig<qint32>(p); break;
+        case code(UInt32, false):   value = loadLittle<quint32>(p); break;
+        case code(UInt32, true):    value = loadBig<quint32>(p); break;
+        case code(Int64, false):    value = loadLittle<qint64>(p); break;
+        case code(Int64, true):     value = loadBig<qint64>(p); break;
+        case code(UInt64, false):   value = loadLittle<quint64>(p); break;
+        case code(UInt64, true):    value = loadBig<quint64>(p); break;
+        case code(Float32, false):  value = loadLittle<float>(p); break;
+        case code(Float32, true):   value = loadBig<float>(p); break;
+        case code(Float64, false):  value = loadLittle<double>(p); break;
+        case code(Float64, true):   value = loadBig<double>(p); break;
+        default: break;
+        }
+        *values++ = value;
+    }
+    return true;
+}
+
+bool StructLayout::operator==(const StructLayout &other) const
+{
+    if (m_size != other.m_size || m_names != other.m_names || m_extractors.size() != other.m_extractors.size()) {
+        return false;
+    }
+    for (qsizetype i = 0; i < m_extractors.size(); ++i) {
+        if (m_extractors.at(i).offset != other.m_extractors.at(i).offset
+            || m_extractors.at(i).code != other.m_extractors.at(i).code) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool StructLayout::operator!=(const StructLayout &other) const
+{
+    return !(*this == other);
+}
+
+int StructLayout::typeSize(Type type)
+{
+    switch (type) {
+    case Int8:
+    case UInt8:
+        return 1;
+    case Int16:
+    case UInt16:
+        return 2;
+    case Int32:
+    case UInt32:
+    case Float32:
+        return 4;
+    case Int64:
+    case UInt64:
+    case Float64:
+        return 8;
+    }
+    return 1;
+}
+
+bool StructLayout::parseType(const QByteArray &name, Type *type)
+{
+    static const struct {
+        const char *name;
+        Type type;
+    } types[] = {
+        {"int8", Int8}, {"i8", Int8}, {"int8_t", Int8}, {"char", Int8},
+        {"uint8", UInt8}, {"u8", UInt8}, {"uint8_t", UInt8}, {"byte", UInt8},
+        {"int16", Int16}, {"i16", Int16}, {"int16_t", Int16}, {"short", Int16},
+        {"uint16", UInt16}, {"u16", UInt16}, {"uint16_t", UInt16},
+        {"int32", Int32}, {"i32", Int32}, {"int32_t", Int32}, {"int", Int32},
+        {"uint32", UInt32}, {"u32", UInt32}, {"uint32_t", UInt32},
+        {"int64", Int64}, {"i64", Int64}, {"int64_t", Int64},
+        {"uint64", UInt64}, {"u64", UInt64}, {"uint64_t", UInt64},
+        {"float", Float32}, {"f32", Float32}, {"float32", Float32},
+        {"double", Float64}, {"f64", Float64}, {"float64", Float64}
+    };
+    for (const auto &entry : types) {
+        if (name == entry.name) {
+            *type = entry.type;
+            return true;
+        }
+    }
+    return false;
+}
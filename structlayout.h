@@ -0,0 +1,162 @@
+#ifndef STRUCTLAYOUT_H
+#define STRUCTLAYOUT_H
+
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+
+/**
+ * @brief StructLayout - 紧凑排列的二进制结构体布局
+ *
+ * 用类似 C 的文本描述帧内的定长结构体，例如：
+ * @code
+ * little;                    // 默认字节序（little / big），默认小端
+ * uint16 seq;
+ * int16 ax, ay, az;
+ * pad 2;                     // 跳过 2 个字节
+ * be uint32 id;              // 单独指定字节序
+ * float temp;
+ * uint8 flags[2];            // 展开为 flags[0]、flags[1]
+ * @endcode
+ * 语句以 ';' 或换行结束，'#' 和 "//" 之后为注释。字段按顺序紧凑排列，没有对齐填充。
+ * 类型：int8/uint8、int16/uint16、int32/uint32、int64/uint64、float、double
+ * （也接受 i8/u8/i16/u16/i32/u32/i64/u64/f32/f64/float32/float64 等别名）。
+ *
+ * compile() 一次性把文本转换为扁平的提取器列表（偏移 + 类型/字节序），
+ * decode() 对每帧只遍历这张表，每个字段一次按类型分派的定长读取，不逐字节解释。
+ *
+ * 值类型，可在线程间拷贝。
+ */
+class StructLayout
+{
+public:
+    /**
+     * @brief 字段类型
+     */
+    enum Type {
+        Int8,
+        UInt8,
+        Int16,
+        UInt16,
+        Int32,
+        UInt32,
+        Int64,
+        UInt64,
+        Float32,
+        Float64
+    };
+
+    static constexpr int MAX_FIELDS = 64;    ///< 最多字段数（与波形通道上限一致）
+
+    /**
+     * @brief 编译布局描述
+     *
+     * 失败时保持原来的布局不变。
+     *
+     * @param text 布局描述
+     * @param error 输出错误信息（含行号），可为 nullptr
+     * @return true 如果编译成功
+     */
+    bool compile(const QString &text, QString *error = nullptr);
+
+    /**
+     * @brief 是否没有字段
+     * @return true 如果没有字段
+     */
+    bool isEmpty() const;
+
+    /**
+     * @brief 获取结构体字节数（最后一个字段或填充的结尾）
+     * @return 字节数
+     */
+    int size() const;
+
+    /**
+     * @brief 获取字段数
+     * @return 字段数
+     */
+    int fieldCount() const;
+
+    /**
+     * @brief 获取字段名
+     * @param field 字段下标
+     * @return 字段名
+     */
+    QByteArray fieldName(int field) const;
+
+    /**
+     * @brief 获取所有字段名
+     * @return 字段名，下标即字段下标
+     */
+    const QVector<QByteArray> &fieldNames() const;
+
+    /**
+     * @brief 获取字段在结构体中的偏移
+     * @param field 字段下标
+     * @return 字节偏移
+     */
+    int fieldOffset(int field) const;
+
+    /**
+     * @brief 获取字段类型
+     * @param field 字段下标
+     * @return 类型
+     */
+    Type fieldType(int field) const;
+
+    /**
+     * @brief 字段是否为大端
+     * @param field 字段下标
+     * @return true 如果为大端
+     */
+    bool fieldBigEndian(int field) const;
+
+    /**
+     * @brief 获取字段类型的显示名（如 "uint16 BE"）
+     * @param field 字段下标
+     * @return 显示名
+     */
+    QString fieldTypeName(int field) const;
+
+    /**
+     * @brief 解码一帧
+     *
+     * 帧比结构体短时不解码；更长时忽略多余的字节。
+     * 浮点字段按原样输出，可能是 NaN 或无穷大，由调用方过滤。
+     *
+     * @param data 帧数据
+     * @param size 帧字节数
+     * @param values 输出，至少 fieldCount() 个
+     * @return true 如果已解码
+     */
+    bool decode(const char *data, qsizetype size, double *values) const;
+
+    bool operator==(const StructLayout &other) const;
+    bool operator!=(const StructLayout &other) const;
+
+private:
+    /**
+     * @brief 提取器：类型与字节序合并为一个分派码
+     */
+    struct Extractor {
+        int offset = 0;     ///< 字节偏移
+        int code = 0;       ///< Type * 2 + 是否大端
+    };
+
+    /**
+     * @brief 获取类型字节数
+     */
+    static int typeSize(Type type);
+
+    /**
+     * @brief 按名称查找类型
+     * @return false 如果不是类型名
+     */
+    static bool parseType(const QByteArray &name, Type *type);
+
+    QVector<Extractor> m_extractors;    ///< 每字段一个提取器
+    QVector<QByteArray> m_names;        ///< 字段名
+    int m_size = 0;                     ///< 结构体字节数
+};
+
+#endif // STRUCTLAYOUT_H
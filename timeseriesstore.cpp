@@ -0,0 +1,543 @@
+#include "timeseriesstore.h"
+
+#include <QMutexLocker>
+#include <QTemporaryFile>
+#include <algorithm>
+#include <cstring>
+
+/**
+ * @brief TimeSeriesStore 实现
+ */
+
+namespace {
+
+constexpr size_t MAX_FREE_BLOCKS = 64;    ///< 最多保留的空块数
+constexpr qint64 SEGMENT_BLOCKS = 256;    ///< 溢出文件每次扩展并映射的块数（约 13 MB）
+
+} // namespace
+
+TimeSeriesStore::TimeSeriesStore(qint64 memoryBudget, qint64 diskBudget)
+    : m_memoryBudget(qMax<qint64>(0, memoryBudget))
+    , m_diskBudget(qMax<qint64>(0, diskBudget))
+{
+}
+
+// 关闭溢出文件时自动解除映射
+TimeSeriesStore::~TimeSeriesStore() = default;
+
+void TimeSeriesStore::setBudget(qint64 memoryBudget, qint64 diskBudget)
+{
+    QMutexLocker locker(&m_mutex);
+    m_memoryBudget = qMax<qint64>(0, memoryBudget);
+    m_diskBudget = qMax<qint64>(0, diskBudget);
+
+    while (m_spilledBlocks * BLOCK_BYTES > m_diskBudget && dropOldest(true)) {
+    }
+    enforceBudget(0);
+    if (m_spilledBlocks == 0) {
+        resetSpill();
+    }
+    ++m_revision;
+}
+
+void TimeSeriesStore::setChannelNames(const QVector<QByteArray> &names)
+{
+    QMutexLocker locker(&m_mutex);
+    for (qsizetype i = qsizetype(m_channels.size()); i < names.size(); ++i) {
+        Channel channel;
+        channel.name = QString::fromUtf8(names.at(i));
+        m_channels.push_back(std::move(channel));
+    }
+}
+
+void TimeSeriesStore::append(const QVector<ChannelSample> &samples)
+{
+    if (samples.isEmpty()) {
+        return;
+    }
+
+    QMutexLocker locker(&m_mutex);
+    for (const ChannelSample &sample : samples) {
+        if (sample.channel < 0 || sample.channel >= int(m_channels.size()) || !qIsFinite(sample.value)) {
+            continue;
+        }
+
+        Channel &channel = m_channels[size_t(sample.channel)];
+        if (channel.blocks.empty() || channel.blocks.back().data->count == BLOCK_SAMPLES) {
+            // 先为新块腾出预算（溢出或丢弃其他已满的块）
+            enforceBudget(1);
+            BlockRef ref;
+            ref.owned = takeBlock();
+            ref.data = ref.owned.get();
+            channel.blocks.push_back(std::move(ref));
+            ++m_memoryBlocks;
+        }
+
+        // 最后一块始终在内存中
+        Block &block = *channel.blocks.back().owned;
+        block.times[block.count] = sample.timestampNs;
+        block.values[block.count] = sample.value;
+        block.pyramid.update(block.count, sample.value);
+        ++block.count;
+        ++channel.count;
+    }
+
+    m_totalSamples += samples.size();
+    ++m_revision;
+}
+
+void TimeSeriesStore::clear()
+{
+    QMutexLocker locker(&m_mutex);
+    for (Channel &channel : m_channels) {
+        releaseBlocks(channel);
+    }
+    resetSpill();
+    ++m_revision;
+}
+
+void TimeSeriesStore::reset()
+{
+    QMutexLocker locker(&m_mutex);
+    for (Channel &channel : m_channels) {
+        releaseBlocks(channel);
+    }
+    m_channels.clear();
+    resetSpill();
+    ++m_revision;
+}
+
+int TimeSeriesStore::channelCount() const
+{
+    QMutexLocker locker(&m_mutex);
+    return int(m_channels.size());
+}
+
+QString TimeSeriesStore::channelName(int channel) const
+{
+    QMutexLocker locker(&m_mutex);
+    if (channel < 0 || channel >= int(m_channels.size())) {
+        return QString();
+    }
+    return m_channels[size_t(channel)].name;
+}
+
+qint64 TimeSeriesStore::sampleCount(int channel) const
+{
+    QMutexLocker locker(&m_mutex);
+    if (channel < 0 || channel >= int(m_channels.size())) {
+        return 0;
+    }
+    return m_channels[size_t(channel)].count;
+}
+
+qint64 TimeSeriesStore::totalSamples() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_totalSamples;
+}
+
+qint64 TimeSeriesStore::memoryBytes() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_memoryBlocks * BLOCK_BYTES;
+}
+
+qint64 TimeSeriesStore::spilledBytes() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_spilledBlocks * BLOCK_BYTES;
+}
+
+qint64 TimeSeriesStore::droppedSamples() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_droppedSamples;
+}
+
+quint64 TimeSeriesStore::revision() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_revision;
+}
+
+qsizetype TimeSeriesStore::visit(int channel, qint64 fromNs, qint64 toNs,
+                                 const std::function<void(const SampleSpan &)> &visitor) const
+{
+    QMutexLocker locker(&m_mutex);
+    if (channel < 0 || channel >= int(m_channels.size()) || fromNs > toNs) {
+        return 0;
+    }
+
+    const Channel &ch = m_channels[size_t(channel)];
+    const qint64 first = lowerIndex(ch, fromNs);
+    const qint64 end = upperIndex(ch, toNs);
+
+    for (qint64 i = first; i < end;) {
+        const qint64 blockIndex = i / BLOCK_SAMPLES;
+        const Block &block = *ch.blocks[size_t(blockIndex)].data;
+        const int begin = int(i - blockIndex * BLOCK_SAMPLES);
+        const int stop = int(qMin<qint64>(end - blockIndex * BLOCK_SAMPLES, block.count));
+
+        SampleSpan span;
+        span.times = block.times + begin;
+        span.values = block.values + begin;
+        span.count = stop - begin;
+        visitor(span);
+
+        i = blockIndex * BLOCK_SAMPLES + stop;
+    }
+    return qMax<qint64>(0, end - first);
+}
+
+qsizetype TimeSeriesStore::read(int channel, qint64 fromNs, qint64 toNs,
+                                QVector<qint64> *times, QVector<float> *values) const
+{
+    return visit(channel, fromNs, toNs, [times, values](const SampleSpan &span) {
+        if (times) {
+            const qsizetype offset = times->size();
+            times->resize(offset + span.count);
+            std::copy(span.times, span.times + span.count, times->data() + offset);
+        }
+        if (values) {
+            const qsizetype offset = values->size();
+            values->resize(offset + span.count);
+            std::copy(span.values, span.values + span.count, values->data() + offset);
+        }
+    });
+}
+
+bool TimeSeriesStore::timeRange(int channel, qint64 *firstNs, qint64 *lastNs) const
+{
+    QMutexLocker locker(&m_mutex);
+    if (channel < 0 || channel >= int(m_channels.size())) {
+        return false;
+    }
+
+    const Channel &ch = m_channels[size_t(channel)];
+    if (ch.count == 0) {
+        return false;
+    }
+
+    const Block &front = *ch.blocks.front().data;
+    const Block &back = *ch.blocks.back().data;
+    if (firstNs) {
+        *firstNs = front.times[0];
+    }
+    if (lastNs) {
+        *lastNs = back.times[back.count - 1];
+    }
+    return true;
+}
+
+bool TimeSeriesStore::lastSample(int channel, qint64 *timestampNs, float *value) const
+{
+    QMutexLocker locker(&m_mutex);
+    if (channel < 0 || channel >= int(m_channels.size())) {
+        return false;
+    }
+
+    const Channel &ch = m_channels[size_t(channel)];
+    if (ch.count == 0) {
+        return false;
+    }
+
+    const Block &back = *ch.blocks.back().data;
+    if (timestampNs) {
+        *timestampNs = back.times[back.count - 1];
+    }
+    if (value) {
+        *value = back.values[back.count - 1];
+    }
+    return true;
+}
+
+qint64 TimeSeriesStore::lastTimestampNs() const
+{
+    QMutexLocker locker(&m_mutex);
+    qint64 last = 0;
+    for (const Channel &channel : m_channels) {
+        if (channel.count > 0) {
+            const Block &back = *channel.blocks.back().data;
+            last = qMax(last, back.times[back.count - 1]);
+        }
+    }
+    return last;
+}
+
+qsizetype TimeSeriesStore::plot(int channel, qint64 fromNs, qint64 toNs, int columns,
+                                QVector<PlotColumn> *out) const
+{
+    out->fill(PlotColumn(), qMax(0, columns));
+    if (columns <= 0 || fromNs >= toNs) {
+        return 0;
+    }
+
+    QMutexLocker locker(&m_mutex);
+    if (channel < 0 || channel >= int(m_channels.size())) {
+        return 0;
+    }
+
+    const Channel &ch = m_channels[size_t(channel)];
+    const qint64 first = lowerIndex(ch, fromNs);
+    const qint64 end = upperIndex(ch, toNs);
+    if (end <= first) {
+        return 0;
+    }
+
+    // 选择每像素至少 2 个桶的最粗一层；采样不够多时逐个采样
+    const qint64 visible = end - first;
+    int level = -1;
+    for (int l = MinMaxPyramid::LEVELS - 1; l >= 0; --l) {
+        if (visible / MinMaxPyramid::bucketSize(l) >= qint64(columns) * 2) {
+            level = l;
+            break;
+        }
+    }
+
+    const double scale = double(columns) / double(toNs - fromNs);
+    PlotColumn *result = out->data();
+    auto columnAt = [&](qint64 t) {
+        return qBound(0, int(double(t - fromNs) * scale), columns - 1);
+    };
+
+    qsizetype visited = 0;
+    for (qint64 i = first; i < end;) {
+        const qint64 blockIndex = i / BLOCK_SAMPLES;
+        const Block &block = *ch.blocks[size_t(blockIndex)].data;
+        const int begin = int(i - blockIndex * BLOCK_SAMPLES);
+        const int stop = int(qMin<qint64>(end - blockIndex * BLOCK_SAMPLES, block.count));
+
+        if (level < 0) {
+            for (int p = begin; p < stop; ++p) {
+                if (!qIsFinite(block.values[p])) {
+                    continue;
+                }
+                PlotColumn &column = result[columnAt(block.times[p])];
+                column.min = qMin(column.min, block.values[p]);
+                column.max = qMax(column.max, block.values[p]);
+            }
+            visited += stop - begin;
+        } else {
+            // 边缘的桶可能包含少量范围外的采样，对显示没有影响
+            const int size = MinMaxPyramid::bucketSize(level);
+            for (int bucket = begin / size; bucket * size < stop; ++bucket) {
+                const float minimum = block.pyramid.minimum(level, bucket);
+                const float maximum = block.pyramid.maximum(level, bucket);
+                if (qIsFinite(minimum) && qIsFinite(maximum)) {
+                    PlotColumn &column = result[columnAt(block.times[qMax(bucket * size, begin)])];
+                    column.min = qMin(column.min, minimum);
+                    column.max = qMax(column.max, maximum);
+                }
+                ++visited;
+            }
+        }
+
+        i = blockIndex * BLOCK_SAMPLES + stop;
+    }
+    return visited;
+}
+
+qint64 TimeSeriesStore::lowerIndex(const Channel &channel, qint64 t)
+{
+    // 除最后一块外每块都是满的，线性下标 = 块序号 * BLOCK_SAMPLES + 块内位置
+    auto it = std::upper_bound(channel.blocks.begin(), channel.blocks.end(), t,
+                               [](qint64 value, const BlockRef &ref) {
+        return value <= ref.data->times[0];
+    });
+    if (it == channel.blocks.begin()) {
+        return 0;
+    }
+    --it;
+    const Block &block = *it->data;
+    const qint64 pos = std::lower_bound(block.times, block.times + block.count, t) - block.times;
+    return qint64(it - channel.blocks.begin()) * BLOCK_SAMPLES + pos;
+}
+
+qint64 TimeSeriesStore::upperIndex(const Channel &channel, qint64 t)
+{
+    auto it = std::upper_bound(channel.blocks.begin(), channel.blocks.end(), t,
+                               [](qint64 value, const BlockRef &ref) {
+        return value < ref.data->times[0];
+    });
+    if (it == channel.blocks.begin()) {
+        return 0;
+    }
+    --it;
+    const Block &block = *it->data;
+    const qint64 pos = std::upper_bound(block.times, block.times + block.count, t) - block.times;
+    return qint64(it - channel.blocks.begin()) * BLOCK_SAMPLES + pos;
+}
+
+std::unique_ptr<TimeSeriesStore::Block> TimeSeriesStore::takeBlock()
+{
+    if (!m_free.empty()) {
+        std::unique_ptr<Block> block = std::move(m_free.back());
+        m_free.pop_back();
+        block->count = 0;
+        return block;
+    }
+    // 不做值初始化，块内容由 count 界定
+    return std::unique_ptr<Block>(new Block);
+}
+
+void TimeSeriesStore::recycleBlock(std::unique_ptr<Block> block)
+{
+    if (block && m_free.size() < MAX_FREE_BLOCKS) {
+        m_free.push_back(std::move(block));
+    }
+}
+
+void TimeSeriesStore::releaseBlocks(Channel &channel)
+{
+    for (BlockRef &ref : channel.blocks) {
+        if (ref.slot >= 0) {
+            m_freeSlots.push_back(ref.slot);
+            --m_spilledBlocks;
+        } else {
+            recycleBlock(std::move(ref.owned));
+            --m_memoryBlocks;
+        }
+    }
+    channel.blocks.clear();
+    channel.memoryBegin = 0;
+    channel.count = 0;
+}
+
+void TimeSeriesStore::dropFront(Channel &channel)
+{
+    BlockRef &ref = channel.blocks.front();
+    channel.count -= ref.data->count;
+    m_droppedSamples += ref.data->count;
+    if (ref.slot >= 0) {
+        m_freeSlots.push_back(ref.slot);
+        --m_spilledBlocks;
+        --channel.memoryBegin;
+    } else {
+        recycleBlock(std::move(ref.owned));
+        --m_memoryBlocks;
+    }
+    channel.blocks.pop_front();
+}
+
+void TimeSeriesStore::enforceBudget(qint64 reserve)
+{
+    while ((m_memoryBlocks + reserve) * BLOCK_BYTES > m_memoryBudget) {
+        if (!spillOldest() && !dropOldest(false)) {
+            // 只剩各通道正在写入的块，允许暂时超出预算
+            break;
+        }
+    }
+}
+
+bool TimeSeriesStore::spillOldest()
+{
+    // 各通道第一个内存块中最旧的一个，正在写入的最后一块除外
+    Channel *oldest = nullptr;
+    for (Channel &channel : m_channels) {
+        if (channel.memoryBegin + 1 < channel.blocks.size()
+            && (!oldest || channel.blocks[channel.memoryBegin].data->times[0]
+                               < oldest->blocks[oldest->memoryBegin].data->times[0])) {
+            oldest = &channel;
+        }
+    }
+    if (!oldest) {
+        return false;
+    }
+
+    // 分配槽位可能丢弃已溢出的块，之后 memoryBegin 仍指向同一个内存块
+    const qint64 slot = allocateSlot();
+    if (slot < 0) {
+        return false;
+    }
+
+    BlockRef &ref = oldest->blocks[oldest->memoryBegin];
+    Block *target = slotAddress(slot);
+    std::memcpy(static_cast<void *>(target), ref.owned.get(), sizeof(Block));
+    recycleBlock(std::move(ref.owned));
+    ref.data = target;
+    ref.slot = slot;
+    ++oldest->memoryBegin;
+    --m_memoryBlocks;
+    ++m_spilledBlocks;
+    return true;
+}
+
+bool TimeSeriesStore::dropOldest(bool spilledOnly)
+{
+    Channel *oldest = nullptr;
+    for (Channel &channel : m_channels) {
+        if (channel.blocks.size() > 1 && (!spilledOnly || channel.memoryBegin > 0)
+            && (!oldest || channel.blocks.front().data->times[0] < oldest->blocks.front().data->times[0])) {
+            oldest = &channel;
+        }
+    }
+    if (!oldest) {
+        return false;
+    }
+    dropFront(*oldest);
+    return true;
+}
+
+qint64 TimeSeriesStore::allocateSlot()
+{
+    if (m_spillFailed || m_diskBudget < BLOCK_BYTES) {
+        return -1;
+    }
+
+    while ((m_spilledBlocks + 1) * BLOCK_BYTES > m_diskBudget) {
+        if (!dropOldest(true)) {
+            return -1;
+        }
+    }
+
+    if (!m_freeSlots.empty()) {
+        const qint64 slot = m_freeSlots.back();
+        m_freeSlots.pop_back();
+        return slot;
+    }
+
+    if (m_slotCount == qint64(m_segments.size()) * SEGMENT_BLOCKS) {
+        if (!m_spillFile) {
+            m_spillFile = std::make_unique<QTemporaryFile>();
+            if (!m_spillFile->open()) {
+                m_spillFile.reset();
+                m_spillFailed = true;
+                return -1;
+            }
+        }
+
+        // 文件按段扩展，每段单独映射，已映射的段地址不变
+        const qint64 offset = m_slotCount * BLOCK_BYTES;
+        const qint64 size = SEGMENT_BLOCKS * BLOCK_BYTES;
+        uchar *address = nullptr;
+        if (m_spillFile->resize(offset + size)) {
+            address = m_spillFile->map(offset, size);
+        }
+        if (!address) {
+            m_spillFailed = true;
+            return -1;
+        }
+        m_segments.push_back(address);
+    }
+    return m_slotCount++;
+}
+
+TimeSeriesStore::Block *TimeSeriesStore::slotAddress(qint64 slot) const
+{
+    uchar *segment = m_segments[size_t(slot / SEGMENT_BLOCKS)];
+    return reinterpret_cast<Block *>(segment + (slot % SEGMENT_BLOCKS) * BLOCK_BYTES);
+}
+
+void TimeSeriesStore::resetSpill()
+{
+    if (m_spilledBlocks > 0) {
+        return;
+    }
+    // 关闭时解除映射并删除文件
+    m_spillFile.reset();
+    m_segments.clear();
+    m_freeSlots.clear();
+    m_slotCount = 0;
+    m_spillFailed = false;
+}
@@ -0,0 +1,339 @@
+#ifndef TIMESERIESSTORE_H
+#define TIMESERIESSTORE_H
+
+#include <QByteArray>
+#include <QMutex>
+#include <QString>
+#include <QVector>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "channelparser.h"
+#include "minmaxpyramid.h"
+
+class QTemporaryFile;
+
+/**
+ * @brief PlotColumn - 一个像素列内的数值范围
+ */
+struct PlotColumn {
+    float min = std::numeric_limits<float>::infinity();     ///< 最小值
+    float max = -std::numeric_limits<float>::infinity();    ///< 最大值（小于 min 表示该列没有数据）
+
+    bool isEmpty() const {
+        return max < min;
+    }
+};
+
+/**
+ * @brief SampleSpan - 一段连续存放的采样（指向存储内部，不拷贝）
+ */
+struct SampleSpan {
+    const qint64 *times = nullptr;    ///< 采样时间（单调时钟纳秒）
+    const float *values = nullptr;    ///< 采样值
+    qsizetype count = 0;              ///< 采样数
+};
+
+/**
+ * @brief TimeSeriesStore - 按通道列式存储的时间序列
+ *
+ * 每个通道由若干定长块组成，块内时间和数值各自连续存放（列式），
+ * 追加只写入块尾，块满后取一个新块，丢弃的块回收复用。
+ * 每块附带一个 MinMaxPyramid，随追加增量更新，plot() 据此按像素宽度抽取最小/最大值，
+ * 代价与历史长度无关。
+ *
+ * 所有通道共享一个内存预算：内存中的块超过预算时，把最旧的已满块原样写入
+ * 一个内存映射的临时文件（冷数据交给操作系统换页），块指针改为指向映射区，
+ * 读取和绘图不区分块在内存还是在文件中；文件超过磁盘预算时丢弃最旧的块。
+ * 每个通道正在写入的最后一块始终留在内存中。
+ *
+ * 处理线程追加（每个接收块加锁一次），UI 线程按时间范围读取。线程安全。
+ */
+class TimeSeriesStore
+{
+public:
+    static constexpr int BLOCK_SAMPLES = 4096;                              ///< 每块采样数
+    static constexpr qint64 DEFAULT_MEMORY_BUDGET = qint64(256) << 20;     ///< 默认内存预算（256 MB）
+    static constexpr qint64 DEFAULT_DISK_BUDGET = qint64(4096) << 20;      ///< 默认磁盘预算（4 GB）
+
+    /**
+     * @brief 构造函数
+     * @param memoryBudget 内存中数据块的总字节数上限
+     * @param diskBudget 溢出文件的字节数上限，0 表示不溢出（超过内存预算直接丢弃）
+     */
+    explicit TimeSeriesStore(qint64 memoryBudget = DEFAULT_MEMORY_BUDGET,
+                             qint64 diskBudget = DEFAULT_DISK_BUDGET);
+
+    ~TimeSeriesStore();
+
+    TimeSeriesStore(const TimeSeriesStore &) = delete;
+    TimeSeriesStore &operator=(const TimeSeriesStore &) = delete;
+
+    /**
+     * @brief 设置内存和磁盘预算，立即按新预算溢出或丢弃
+     * @param memoryBudget 内存预算（字节）
+     * @param diskBudget 磁盘预算（字节），0 表示不溢出
+     */
+    void setBudget(qint64 memoryBudget, qint64 diskBudget);
+
+    /**
+     * @brief 同步通道名（只会增加通道）
+     * @param names 通道名，下标即通道下标
+     */
+    void setChannelNames(const QVector<QByteArray> &names);
+
+    /**
+     * @brief 追加一批采样
+     *
+     * 同一通道的采样必须按时间顺序追加。
+     *
+     * @param samples 采样
+     */
+    void append(const QVector<ChannelSample> &samples);
+
+    /**
+     * @brief 清空所有采样，保留通道
+     */
+    void clear();
+
+    /**
+     * @brief 清空所有采样和通道
+     */
+    void reset();
+
+    /**
+     * @brief 获取通道数
+     * @return 通道数
+     */
+    int channelCount() const;
+
+    /**
+     * @brief 获取通道名
+     * @param channel 通道下标
+     * @return 通道名
+     */
+    QString channelName(int channel) const;
+
+    /**
+     * @brief 获取通道当前保存的采样数
+     * @param channel 通道下标
+     * @return 采样数
+     */
+    qint64 sampleCount(int channel) const;
+
+    /**
+     * @brief 获取累计追加的采样数（所有通道）
+     * @return 采样数
+     */
+    qint64 totalSamples() const;
+
+    /**
+     * @brief 获取内存中数据块占用的字节数
+     * @return 字节数
+     */
+    qint64 memoryBytes() const;
+
+    /**
+     * @brief 获取溢出到文件的数据块字节数
+     * @return 字节数
+     */
+    qint64 spilledBytes() const;
+
+    /**
+     * @brief 获取超出预算被丢弃的采样数（所有通道）
+     * @return 采样数
+     */
+    qint64 droppedSamples() const;
+
+    /**
+     * @brief 获取修改计数，每次追加或清空后增加
+     * @return 修改计数
+     */
+    quint64 revision() const;
+
+    /**
+     * @brief 按时间范围遍历采样，不拷贝
+     *
+     * 按时间顺序对每一块中落在范围内的部分调用一次 visitor。遍历期间持有锁，
+     * span 只在回调内有效；回调中不能再调用本对象的方法。
+     *
+     * @param channel 通道下标
+     * @param fromNs 起始时间（含）
+     * @param toNs 结束时间（含）
+     * @param visitor 回调
+     * @return 遍历的采样数
+     */
+    qsizetype visit(int channel, qint64 fromNs, qint64 toNs,
+                    const std::function<void(const SampleSpan &)> &visitor) const;
+
+    /**
+     * @brief 读取时间范围内的采样（拷贝）
+     * @param channel 通道下标
+     * @param fromNs 起始时间（含）
+     * @param toNs 结束时间（含）
+     * @param times 输出时间（追加）
+     * @param values 输出数值（追加）
+     * @return 读取的采样数
+     */
+    qsizetype read(int channel, qint64 fromNs, qint64 toNs,
+                   QVector<qint64> *times, QVector<float> *values) const;
+
+    /**
+     * @brief 获取通道保存的时间范围
+     * @param channel 通道下标
+     * @param firstNs 输出最早采样时间
+     * @param lastNs 输出最新采样时间
+     * @return false 如果通道为空
+     */
+    bool timeRange(int channel, qint64 *firstNs, qint64 *lastNs) const;
+
+    /**
+     * @brief 获取通道的最新采样
+     * @param channel 通道下标
+     * @param timestampNs 输出采样时间，可为 nullptr
+     * @param value 输出采样值，可为 nullptr
+     * @return false 如果通道为空
+     */
+    bool lastSample(int channel, qint64 *timestampNs, float *value) const;
+
+    /**
+     * @brief 获取所有通道中最新采样的时间
+     * @return 时间（单调时钟纳秒），没有采样时返回 0
+     */
+    qint64 lastTimestampNs() const;
+
+    /**
+     * @brief 按像素列抽取时间范围内的最小/最大值
+     *
+     * 可见采样很多时使用金字塔中每像素约 2~16 个桶的层，否则逐个采样，
+     * 遍历的桶/采样数约为 columns 的常数倍。
+     *
+     * @param channel 通道下标
+     * @param fromNs 左边缘时间
+     * @param toNs 右边缘时间
+     * @param columns 像素列数
+     * @param out 输出，大小被设为 columns
+     * @return 遍历的桶/采样数
+     */
+    qsizetype plot(int channel, qint64 fromNs, qint64 toNs, int columns, QVector<PlotColumn> *out) const;
+
+private:
+    /**
+     * @brief 数据块（列式）
+     */
+    struct Block {
+        qint64 times[BLOCK_SAMPLES];   ///< 采样时间（单调时钟纳秒）
+        float values[BLOCK_SAMPLES];   ///< 采样值
+        MinMaxPyramid pyramid;         ///< 最小/最大值金字塔
+        int count = 0;                 ///< 已写入的采样数
+    };
+    static_assert(BLOCK_SAMPLES == MinMaxPyramid::CAPACITY, "one pyramid per block");
+
+    static constexpr qint64 BLOCK_BYTES = qint64(sizeof(Block));   ///< 每块字节数
+
+    /**
+     * @brief 块引用：内存中的块由 owned 持有，溢出的块指向映射区
+     */
+    struct BlockRef {
+        std::unique_ptr<Block> owned;    ///< 内存中的块，溢出后为空
+        const Block *data = nullptr;     ///< 块数据（内存或映射区）
+        qint64 slot = -1;                ///< 溢出文件中的槽位，-1 表示在内存中
+    };
+
+    /**
+     * @brief 通道
+     */
+    struct Channel {
+        QString name;                   ///< 通道名
+        std::deque<BlockRef> blocks;    ///< 数据块，按时间排序；已溢出的块都在前面
+        size_t memoryBegin = 0;         ///< 第一个内存中的块的下标
+        qint64 count = 0;               ///< 保存的采样数
+    };
+
+    /**
+     * @brief 取一个空块（优先复用）
+     */
+    std::unique_ptr<Block> takeBlock();
+
+    /**
+     * @brief 回收一个内存块
+     */
+    void recycleBlock(std::unique_ptr<Block> block);
+
+    /**
+     * @brief 丢弃通道的所有块
+     */
+    void releaseBlocks(Channel &channel);
+
+    /**
+     * @brief 丢弃通道最旧的块
+     */
+    void dropFront(Channel &channel);
+
+    /**
+     * @brief 按预算溢出或丢弃，使内存中还能再放 reserve 个块
+     */
+    void enforceBudget(qint64 reserve);
+
+    /**
+     * @brief 把最旧的已满内存块写入溢出文件
+     * @return false 如果没有可溢出的块或文件不可用
+     */
+    bool spillOldest();
+
+    /**
+     * @brief 丢弃所有通道中最旧的块（不丢弃正在写入的块）
+     * @param spilledOnly 只考虑已溢出的块
+     * @return false 如果没有可丢弃的块
+     */
+    bool dropOldest(bool spilledOnly);
+
+    /**
+     * @brief 分配一个溢出槽位，必要时扩展并映射文件
+     * @return 槽位，失败返回 -1
+     */
+    qint64 allocateSlot();
+
+    /**
+     * @brief 获取槽位在映射区中的地址
+     */
+    Block *slotAddress(qint64 slot) const;
+
+    /**
+     * @brief 没有已溢出的块时删除溢出文件
+     */
+    void resetSpill();
+
+    /**
+     * @brief 查找第一个时间不早于 t 的采样
+     * @return 从第一块开始的线性下标，全部早于 t 时返回 count
+     */
+    static qint64 lowerIndex(const Channel &channel, qint64 t);
+
+    /**
+     * @brief 查找第一个时间晚于 t 的采样
+     * @return 从第一块开始的线性下标，全部不晚于 t 时返回 count
+     */
+    static qint64 upperIndex(const Channel &channel, qint64 t);
+
+    mutable QMutex m_mutex;                         ///< 保护以下成员
+    std::deque<Channel> m_channels;                 ///< 通道（deque：追加时不移动已有通道）
+    std::vector<std::unique_ptr<Block>> m_free;     ///< 回收的空块
+    qint64 m_memoryBudget;                          ///< 内存预算（字节）
+    qint64 m_diskBudget;                            ///< 磁盘预算（字节）
+    qint64 m_memoryBlocks = 0;                      ///< 内存中的块数
+    qint64 m_spilledBlocks = 0;                     ///< 已溢出的块数
+    std::unique_ptr<QTemporaryFile> m_spillFile;    ///< 溢出文件（按需创建）
+    std::vector<uchar *> m_segments;                ///< 溢出文件的映射段
+    std::vector<qint64> m_freeSlots;                ///< 空闲槽位
+    qint64 m_slotCount = 0;                         ///< 已分配的槽位数
+    bool m_spillFailed = false;                     ///< 溢出文件不可用，不再尝试
+    qint64 m_totalSamples = 0;                      ///< 累计采样数
+    qint64 m_droppedSamples = 0;                    ///< 丢弃的采样数
+    quint64 m_revision = 0;                         ///< 修改计数
+};
+
+#endif // TIMESERIESSTORE_H
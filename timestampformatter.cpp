@@ -0,0 +1,86 @@
+#include "timestampformatter.h"
+
+#include <QDateTime>
+#include <algorithm>
+#include <chrono>
+
+/**
+ * @brief TimestampFormatter 实现
+ *
+ * Requirements: 3.2
+ */
+
+namespace {
+
+constexpr qint64 NS_PER_MS = 1000000;
+constexpr qint64 NS_PER_SEC = 1000000000;
+constexpr qint64 SECS_PER_DAY = 86400;
+constexpr qint64 CALIBRATE_INTERVAL_NS = 60 * NS_PER_SEC;
+
+inline void writeTwoDigits(char16_t *dst, int value)
+{
+    dst[0] = char16_t(u'0' + value / 10);
+    dst[1] = char16_t(u'0' + value % 10);
+}
+
+} // namespace
+
+qint64 TimestampFormatter::monotonicNs()
+{
+    // Linux 上 steady_clock 即 CLOCK_MONOTONIC
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+TimestampFormatter::TimestampFormatter()
+{
+    const char16_t initial[TEXT_LENGTH] = {u'0', u'0', u':', u'0', u'0', u':', u'0', u'0', u'.', u'0', u'0', u'0'};
+    std::copy(initial, initial + TEXT_LENGTH, m_text);
+    calibrate();
+}
+
+void TimestampFormatter::calibrate()
+{
+    // 系统时间只有毫秒精度：等到毫秒跳变的瞬间再读单调时钟，使换算误差远小于 1 ms
+    QDateTime now = QDateTime::currentDateTime();
+    const qint64 startMs = now.toMSecsSinceEpoch();
+    qint64 mono = monotonicNs();
+    const qint64 deadline = mono + 2 * NS_PER_MS;
+    while (mono < deadline) {
+        now = QDateTime::currentDateTime();
+        mono = monotonicNs();
+        if (now.toMSecsSinceEpoch() != startMs) {
+            break;
+        }
+    }
+    const qint64 localMs = now.toMSecsSinceEpoch() + qint64(now.offsetFromUtc()) * 1000;
+    m_localOffsetNs = localMs * NS_PER_MS - mono;
+    m_calibratedAtNs = mono;
+    m_cachedSecond = -1;
+}
+
+QString TimestampFormatter::format(qint64 monotonicNs)
+{
+    if (monotonicNs - m_calibratedAtNs > CALIBRATE_INTERVAL_NS) {
+        calibrate();
+    }
+
+    const qint64 localNs = monotonicNs + m_localOffsetNs;
+    const qint64 second = localNs / NS_PER_SEC;
+
+    // 跨秒时才重写时分秒
+    if (second != m_cachedSecond) {
+        const int secondOfDay = int(((second % SECS_PER_DAY) + SECS_PER_DAY) % SECS_PER_DAY);
+        writeTwoDigits(m_text, secondOfDay / 3600);
+        writeTwoDigits(m_text + 3, (secondOfDay / 60) % 60);
+        writeTwoDigits(m_text + 6, secondOfDay % 60);
+        m_cachedSecond = second;
+    }
+
+    const int ms = int((localNs % NS_PER_SEC) / NS_PER_MS);
+    m_text[9] = char16_t(u'0' + ms / 100);
+    m_text[10] = char16_t(u'0' + (ms / 10) % 10);
+    m_text[11] = char16_t(u'0' + ms % 10);
+
+    return QString(reinterpret_cast<const QChar *>(m_text), TEXT_LENGTH);
+}
@@ -0,0 +1,50 @@
+#ifndef TIMESTAMPFORMATTER_H
+#define TIMESTAMPFORMATTER_H
+
+#include <QString>
+
+/**
+ * @brief TimestampFormatter - 单调时钟时间戳的格式化
+ *
+ * SerialWorker 在读取数据时用 monotonicNs()（CLOCK_MONOTONIC）记录到达时间，
+ * 随数据块经过流水线；显示时由本类换算为本地时间 HH:mm:ss.zzz。
+ *
+ * 换算基准（单调时钟与本地时间之差）每分钟校准一次，跟随系统时间和时区变化；
+ * 校准时对齐系统时间的毫秒跳变，换算误差在微秒级。
+ * 同一秒内只改写毫秒的 3 位数字，时分秒部分按秒缓存，不经过 QDateTime::toString。
+ *
+ * 非线程安全，每个 DataProcessor 持有一个实例。
+ */
+class TimestampFormatter
+{
+public:
+    static constexpr int TEXT_LENGTH = 12;   ///< "HH:mm:ss.zzz" 的长度
+
+    /**
+     * @brief 读取单调时钟
+     * @return 纳秒，起点不确定，只用于求差和换算
+     */
+    static qint64 monotonicNs();
+
+    TimestampFormatter();
+
+    /**
+     * @brief 格式化一个单调时钟时间戳
+     * @param monotonicNs monotonicNs() 返回的时间
+     * @return 本地时间 "HH:mm:ss.zzz"
+     */
+    QString format(qint64 monotonicNs);
+
+    /**
+     * @brief 重新计算单调时钟与本地时间的差
+     */
+    void calibrate();
+
+private:
+    qint64 m_localOffsetNs = 0;       ///< 本地时间（自 1970 起，含时区）减单调时钟
+    qint64 m_calibratedAtNs = 0;      ///< 上次校准时的单调时钟
+    qint64 m_cachedSecond = -1;       ///< m_text 中时分秒对应的本地秒数
+    char16_t m_text[TEXT_LENGTH];     ///< 上次输出的文本
+};
+
+#endif // TIMESTAMPFORMATTER_H
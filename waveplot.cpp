@@ -0,0 +1,333 @@
+#include "waveplot.h"
+
+#include <QElapsedTimer>
+#include <QFontMetrics>
+#include <QMouseEvent>
+#include <QPainter>
+#include <QTimer>
+#include <QWheelEvent>
+#include <cmath>
+#include <iterator>
+
+/**
+ * @brief WavePlot 实现
+ */
+
+namespace {
+
+constexpr qint64 MIN_SPAN_NS = 1000000;                     ///< 最小时间跨度（1 毫秒）
+constexpr qint64 MAX_SPAN_NS = qint64(3600) * 1000000000;   ///< 最大时间跨度（1 小时）
+
+/**
+ * @brief 取不小于 raw 的 1/2/5 × 10^n 步长
+ */
+double niceStep(double raw)
+{
+    if (raw <= 0) {
+        return 1;
+    }
+    const double magnitude = std::pow(10.0, std::floor(std::log10(raw)));
+    const double fraction = raw / magnitude;
+    if (fraction <= 1) {
+        return magnitude;
+    }
+    if (fraction <= 2) {
+        return 2 * magnitude;
+    }
+    if (fraction <= 5) {
+        return 5 * magnitude;
+    }
+    return 10 * magnitude;
+}
+
+} // namespace
+
+WavePlot::WavePlot(QWidget *parent)
+    : QWidget(parent)
+    , m_frameTimer(new QTimer(this))
+{
+    setMinimumWidth(160);
+    setAttribute(Qt::WA_OpaquePaintEvent);
+
+    m_frameTimer->setInterval(FRAME_INTERVAL_MS);
+    connect(m_frameTimer, &QTimer::timeout, this, &WavePlot::onFrameTimeout);
+}
+
+void WavePlot::setStore(TimeSeriesStore *store)
+{
+    if (m_store != store) {
+        m_store = store;
+        m_follow = true;
+        m_dragging = false;
+        m_lastRevision = 0;
+        update();
+    }
+}
+
+TimeSeriesStore *WavePlot::store() const
+{
+    return m_store;
+}
+
+qint64 WavePlot::lastPaintNs() const
+{
+    return m_lastPaintNs;
+}
+
+void WavePlot::onFrameTimeout()
+{
+    // 只在有新数据时重绘；交互引起的变化直接调用 update()
+    if (m_store && m_store->revision() != m_lastRevision) {
+        update();
+    }
+}
+
+QRect WavePlot::plotRect() const
+{
+    return rect().adjusted(LEFT_MARGIN, MARGIN, -MARGIN, -BOTTOM_MARGIN);
+}
+
+qint64 WavePlot::rightEdgeNs() const
+{
+    if (m_follow && m_store) {
+        return m_store->lastTimestampNs();
+    }
+    return m_rightNs;
+}
+
+void WavePlot::paintEvent(QPaintEvent *event)
+{
+    Q_UNUSED(event);
+
+    QElapsedTimer timer;
+    timer.start();
+
+    QPainter painter(this);
+    const QPalette pal = palette();
+    painter.fillRect(rect(), pal.color(QPalette::Base));
+
+    const QRect area = plotRect();
+    const int channels = m_store ? m_store->channelCount() : 0;
+    if (channels == 0 || area.width() <= 0 || area.height() <= 0) {
+        painter.setPen(pal.color(QPalette::PlaceholderText));
+        painter.drawText(rect(), Qt::AlignCenter, "无波形数据\n（在设置中启用波形通道）");
+        m_lastRevision = m_store ? m_store->revision() : 0;
+        m_lastPaintNs = timer.nsecsElapsed();
+        return;
+    }
+
+    // 先读修改计数：之后追加的数据会在下一帧重绘
+    m_lastRevision = m_store->revision();
+
+    const qint64 right = rightEdgeNs();
+    const qint64 left = right - m_spanNs;
+    const int columns = area.width();
+
+    // 每个通道取出像素列，同时求纵轴范围
+    m_columns.resize(channels);
+    float minValue = std::numeric_limits<float>::infinity();
+    float maxValue = -std::numeric_limits<float>::infinity();
+    for (int channel = 0; channel < channels; ++channel) {
+        m_store->plot(channel, left, right, columns, &m_columns[channel]);
+        for (const PlotColumn &column : std::as_const(m_columns[channel])) {
+            if (!column.isEmpty() && qIsFinite(column.min) && qIsFinite(column.max)) {
+                minValue = qMin(minValue, column.min);
+                maxValue = qMax(maxValue, column.max);
+            }
+        }
+    }
+    if (minValue > maxValue) {
+        minValue = 0;
+        maxValue = 1;
+    } else {
+        // 限制范围，跨度和留白在 float 内不会溢出成无穷大
+        const float limit = std::numeric_limits<float>::max() / 4;
+        minValue = qBound(-limit, minValue, limit);
+        maxValue = qBound(-limit, maxValue, limit);
+        const float span = maxValue - minValue;
+        const float padding = span < qMax(1e-6f, std::abs(maxValue) * 1e-6f)
+            ? qMax(0.5f, std::abs(maxValue) * 0.05f)
+            : span * 0.05f;
+        minValue -= padding;
+        maxValue += padding;
+    }
+
+    drawGrid(painter, area, minValue, maxValue);
+
+    // 每列画一段从最小值到最大值的竖线，相邻列首尾相连
+    const double yScale = double(area.height()) / double(maxValue - minValue);
+    painter.setClipRect(area);
+    for (int channel = 0; channel < channels; ++channel) {
+        const QVector<PlotColumn> &data = m_columns.at(channel);
+        m_points.clear();
+        for (int x = 0; x < data.size(); ++x) {
+            const PlotColumn &column = data.at(x);
+            if (column.isEmpty()) {
+                continue;
+            }
+            const double px = area.left() + x + 0.5;
+            m_points.append(QPointF(px, area.bottom() - (double(column.min) - minValue) * yScale));
+            if (column.max != column.min) {
+                m_points.append(QPointF(px, area.bottom() - (double(column.max) - minValue) * yScale));
+            }
+        }
+
+        painter.setPen(QPen(channelColor(channel), 1));
+        if (m_points.size() == 1) {
+            painter.drawPoint(m_points.first());
+        } else if (!m_points.isEmpty()) {
+            painter.drawPolyline(m_points.constData(), int(m_points.size()));
+        }
+    }
+    painter.setClipping(false);
+
+    drawLegend(painter, area, channels);
+
+    m_lastPaintNs = timer.nsecsElapsed();
+}
+
+void WavePlot::drawGrid(QPainter &painter, const QRect &area, float minValue, float maxValue)
+{
+    const QPalette pal = palette();
+    QColor gridColor = pal.color(QPalette::Text);
+    gridColor.setAlpha(40);
+    const QColor labelColor = pal.color(QPalette::Text);
+    const QFontMetrics metrics(font());
+
+    painter.setPen(gridColor);
+    painter.drawRect(area.adjusted(0, 0, -1, -1));
+
+    // 纵轴：约每 40 像素一条
+    const double valueStep = niceStep((maxValue - minValue) / qMax(1, area.height() / 40));
+    const double yScale = double(area.height()) / double(maxValue - minValue);
+    for (double v = std::ceil(minValue / valueStep) * valueStep; v <= maxValue; v += valueStep) {
+        const int y = area.bottom() - int((v - minValue) * yScale);
+        painter.setPen(gridColor);
+        painter.drawLine(area.left(), y, area.right(), y);
+        painter.setPen(labelColor);
+        painter.drawText(QRect(0, y - metrics.height() / 2, LEFT_MARGIN - 4, metrics.height()),
+                         Qt::AlignRight | Qt::AlignVCenter, QString::number(v, 'g', 4));
+    }
+
+    // 横轴：相对右边缘的时间，约每 100 像素一条
+    const double spanSeconds = double(m_spanNs) / 1e9;
+    const double timeStep = niceStep(spanSeconds / qMax(1, area.width() / 100));
+    const int decimals = qMax(0, -int(std::floor(std::log10(timeStep))));
+    for (double t = 0; t <= spanSeconds; t += timeStep) {
+        const int x = area.right() - int(t / spanSeconds * area.width());
+        painter.setPen(gridColor);
+        painter.drawLine(x, area.top(), x, area.bottom());
+        painter.setPen(labelColor);
+        const QString label = t == 0 ? (m_follow ? QStringLiteral("现在") : QStringLiteral("0s"))
+                                     : QString("-%1s").arg(t, 0, 'f', decimals);
+        painter.drawText(QRect(x - 40, area.bottom() + 2, 80, BOTTOM_MARGIN - 2),
+                         Qt::AlignHCenter | Qt::AlignTop, label);
+    }
+}
+
+void WavePlot::drawLegend(QPainter &painter, const QRect &area, int channels)
+{
+    const QFontMetrics metrics(font());
+    int x = area.left() + 6;
+    const int y = area.top() + 4;
+    for (int channel = 0; channel < channels; ++channel) {
+        const QString name = m_store->channelName(channel);
+        const int width = metrics.horizontalAdvance(name);
+        if (x + 14 + width > area.right()) {
+            break;
+        }
+        painter.fillRect(QRect(x, y + metrics.height() / 2 - 4, 8, 8), channelColor(channel));
+        painter.setPen(palette().color(QPalette::Text));
+        painter.drawText(QPoint(x + 12, y + metrics.ascent()), name);
+        x += 12 + width + 12;
+    }
+}
+
+QColor WavePlot::channelColor(int channel)
+{
+    static const QColor colors[] = {
+        QColor(0x1f, 0x77, 0xb4), QColor(0xff, 0x7f, 0x0e), QColor(0x2c, 0xa0, 0x2c),
+        QColor(0xd6, 0x27, 0x28), QColor(0x94, 0x67, 0xbd), QColor(0x8c, 0x56, 0x4b),
+        QColor(0xe3, 0x77, 0xc2), QColor(0x7f, 0x7f, 0x7f), QColor(0xbc, 0xbd, 0x22),
+        QColor(0x17, 0xbe, 0xcf)
+    };
+    return colors[channel % int(std::size(colors))];
+}
+
+void WavePlot::showEvent(QShowEvent *event)
+{
+    QWidget::showEvent(event);
+    m_frameTimer->start();
+}
+
+void WavePlot::hideEvent(QHideEvent *event)
+{
+    QWidget::hideEvent(event);
+    m_frameTimer->stop();
+}
+
+void WavePlot::wheelEvent(QWheelEvent *event)
+{
+    const int delta = event->angleDelta().y();
+    if (delta == 0) {
+        event->ignore();
+        return;
+    }
+
+    // 向上滚动放大；不跟随时以鼠标位置为中心
+    const double factor = std::pow(1.25, -delta / 120.0);
+    const qint64 span = qBound(MIN_SPAN_NS, qint64(double(m_spanNs) * factor), MAX_SPAN_NS);
+    if (!m_follow) {
+        const QRect area = plotRect();
+        const double ratio = qBound(0.0, double(area.right() - event->position().x()) / qMax(1, area.width()), 1.0);
+        const qint64 anchor = m_rightNs - qint64(ratio * double(m_spanNs));
+        m_rightNs = anchor + qint64(ratio * double(span));
+    }
+    m_spanNs = span;
+    update();
+    event->accept();
+}
+
+void WavePlot::mousePressEvent(QMouseEvent *event)
+{
+    if (event->button() == Qt::LeftButton) {
+        m_dragging = true;
+        m_dragStartX = int(event->position().x());
+        m_dragStartRightNs = rightEdgeNs();
+    }
+    QWidget::mousePressEvent(event);
+}
+
+void WavePlot::mouseMoveEvent(QMouseEvent *event)
+{
+    if (m_dragging) {
+        const int dx = int(event->position().x()) - m_dragStartX;
+        if (dx != 0) {
+            m_follow = false;
+            m_rightNs = m_dragStartRightNs - qint64(double(dx) * double(m_spanNs) / qMax(1, plotRect().width()));
+            update();
+        }
+    }
+    QWidget::mouseMoveEvent(event);
+}
+
+void WavePlot::mouseReleaseEvent(QMouseEvent *event)
+{
+    if (event->button() == Qt::LeftButton && m_dragging) {
+        m_dragging = false;
+        // 拖回最新数据之后则恢复跟随
+        if (!m_follow && m_store && m_rightNs >= m_store->lastTimestampNs()) {
+            m_follow = true;
+            update();
+        }
+    }
+    QWidget::mouseReleaseEvent(event);
+}
+
+void WavePlot::mouseDoubleClickEvent(QMouseEvent *event)
+{
+    m_follow = true;
+    m_spanNs = DEFAULT_SPAN_NS;
+    update();
+    QWidget::mouseDoubleClickEvent(event);
+}
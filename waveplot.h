@@ -0,0 +1,114 @@
+#ifndef WAVEPLOT_H
+#define WAVEPLOT_H
+
+#include <QWidget>
+#include <QVector>
+#include <QPointF>
+
+#include "timeseriesstore.h"
+
+class QTimer;
+
+/**
+ * @brief WavePlot - 实时波形显示
+ *
+ * 显示一个 TimeSeriesStore 中的所有通道。每帧按像素宽度从 MinMaxPyramid 中取出每列的
+ * 最小/最大值，每个通道只绘制约 2 × 宽度个点，与历史长度无关；使用 QPainter 光栅绘制，
+ * 不依赖 GPU。
+ *
+ * 默认跟随最新数据；滚轮缩放时间轴，拖动平移（停止跟随），双击恢复跟随。
+ * 纵轴按可见数据自动缩放。
+ */
+class WavePlot : public QWidget
+{
+    Q_OBJECT
+
+public:
+    static constexpr int FRAME_INTERVAL_MS = 33;                     ///< 刷新间隔（约 30 FPS）
+    static constexpr qint64 DEFAULT_SPAN_NS = qint64(10) * 1000000000;   ///< 默认时间跨度（10 秒）
+
+    /**
+     * @brief 构造函数
+     * @param parent 父控件
+     */
+    explicit WavePlot(QWidget *parent = nullptr);
+
+    /**
+     * @brief 设置数据源
+     * @param store 时间序列存储，可为 nullptr（不显示）
+     */
+    void setStore(TimeSeriesStore *store);
+
+    /**
+     * @brief 获取数据源
+     * @return 时间序列存储
+     */
+    TimeSeriesStore *store() const;
+
+    /**
+     * @brief 获取最近一次绘制的耗时
+     * @return 耗时（纳秒）
+     */
+    qint64 lastPaintNs() const;
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void showEvent(QShowEvent *event) override;
+    void hideEvent(QHideEvent *event) override;
+    void wheelEvent(QWheelEvent *event) override;
+    void mousePressEvent(QMouseEvent *event) override;
+    void mouseMoveEvent(QMouseEvent *event) override;
+    void mouseReleaseEvent(QMouseEvent *event) override;
+    void mouseDoubleClickEvent(QMouseEvent *event) override;
+
+private slots:
+    /**
+     * @brief 刷新定时器：数据有变化时重绘
+     */
+    void onFrameTimeout();
+
+private:
+    /**
+     * @brief 获取绘图区域（扣除坐标轴标签）
+     */
+    QRect plotRect() const;
+
+    /**
+     * @brief 获取当前显示范围的右边缘时间
+     */
+    qint64 rightEdgeNs() const;
+
+    /**
+     * @brief 绘制网格和坐标轴标签
+     */
+    void drawGrid(QPainter &painter, const QRect &area, float minValue, float maxValue);
+
+    /**
+     * @brief 绘制图例
+     */
+    void drawLegend(QPainter &painter, const QRect &area, int channels);
+
+    /**
+     * @brief 获取通道颜色
+     */
+    static QColor channelColor(int channel);
+
+    TimeSeriesStore *m_store = nullptr;       ///< 数据源
+    QTimer *m_frameTimer = nullptr;           ///< 刷新定时器
+    quint64 m_lastRevision = 0;               ///< 上次绘制时的数据修改计数
+    bool m_follow = true;                     ///< 跟随最新数据
+    qint64 m_spanNs = DEFAULT_SPAN_NS;        ///< 时间跨度
+    qint64 m_rightNs = 0;                     ///< 不跟随时的右边缘时间
+    bool m_dragging = false;                  ///< 正在拖动
+    int m_dragStartX = 0;                     ///< 拖动起点
+    qint64 m_dragStartRightNs = 0;            ///< 拖动开始时的右边缘时间
+    QVector<QVector<PlotColumn>> m_columns;   ///< 各通道的像素列（复用）
+    QVector<QPointF> m_points;                ///< 折线点（复用）
+    qint64 m_lastPaintNs = 0;                 ///< 最近一次绘制耗时（纳秒）
+
+    static constexpr int LEFT_MARGIN = 52;    ///< 纵轴标签宽度
+    static constexpr int BOTTOM_MARGIN = 18;  ///< 横轴标签高度
+    static constexpr int MARGIN = 6;          ///< 其余边距
+};
+
+#endif // WAVEPLOT_H
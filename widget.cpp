@@ -2,8 +2,20 @@
 #include "ui_widget.h"
 #include "appsettings.h"
 #include "keywordhighlighter.h"
-
+#include "receiveview.h"
+#include "iothreadpool.h"
+#include "waveplot.h"
+#include "fieldtable.h"
+#include "captureformat.h"
+
+#include <QEvent>
+#include <QGridLayout>
 #include <QMessageBox>
+#include <QPointer>
+#include <QSplitter>
+#include <QStackedWidget>
+#include <QTabWidget>
+#include <QToolButton>
 #include <QSerialPortInfo>
 #include <QRegularExpression>
 #include <QDialog>
@@ -14,7 +26,17 @@
 #include <QCheckBox>
 #include <QPushButton>
 #include <QSpinBox>
+#include <QIntValidator>
 #include <QAbstractItemView>
+#include <QStandardItemModel>
+#include <QFormLayout>
+#include <QLineEdit>
+#include <QPlainTextEdit>
+#include <QFileDialog>
+#include <QFile>
+#include <QTime>
+#include <QShortcut>
+#include <QKeySequence>
 
 /**
  * @brief Widget 构造函数
@@ -25,51 +47,151 @@
 Widget::Widget(QWidget *parent)
     : QWidget(parent)
     , ui(new Ui::Widget)
-    , m_worker(new SerialWorker())
-    , m_processor(new DataProcessor(this))
-    , m_buffer(new DataBuffer(65536, this))
-    , m_refreshTimer(new QTimer(this))
+    , m_sessionStack(new QStackedWidget(this))
+    , m_sessionTabs(new QTabWidget(this))
+    , m_tileArea(new QWidget(this))
+    , m_tileLayout(new QGridLayout(m_tileArea))
+    , m_tileCheck(new QCheckBox("平铺", this))
+    , m_waveSplitter(new QSplitter(Qt::Horizontal, this))
+    , m_wavePanel(new QSplitter(Qt::Vertical, this))
+    , m_wavePlot(new WavePlot(this))
+    , m_fieldTable(new FieldTable(this))
+    , m_searchBar(new QWidget(this))
+    , m_searchEdit(new QLineEdit(m_searchBar))
+    , m_searchRegex(new QCheckBox("正则", m_searchBar))
+    , m_searchCase(new QCheckBox("区分大小写", m_searchBar))
+    , m_searchStatus(new QLabel(m_searchBar))
     , m_highlighter(nullptr)
-    , m_speedMonitor(new SpeedMonitor(this))
-    , m_autoScroll(true)
 {
     ui->setupUi(this);
 
     ui->open->setStyleSheet("color: red;");
+    // 波特率可手动输入（原生后端支持任意波特率）
+    ui->cbBaudRate->setValidator(new QIntValidator(1, SerialConfig::MAX_NATIVE_BAUD_RATE, ui->cbBaudRate));
     ui->cbBaudRate->setCurrentText("115200");
 
     QList<int> sizes;
     sizes << 30000 << 50000;
     ui->splitter->setSizes(sizes);
-    
-
-
-    updatePortList();
-    setupConnections();
 
-    // Initialize AppSettings and connect signals to DataProcessor
-    // Requirements: 4.1
-    AppSettings *settings = AppSettings::instance();
-    
-    // Apply initial settings to DataProcessor
-    m_processor->setEncoding(settings->encoding());
-    m_processor->setHexNewlineEnabled(settings->hexNewlineEnabled());
-    
-    // Connect AppSettings signals to DataProcessor setters
-    connect(settings, &AppSettings::encodingChanged, 
-            m_processor, &DataProcessor::setEncoding);
-    connect(settings, &AppSettings::hexNewlineEnabledChanged, 
-            m_processor, &DataProcessor::setHexNewlineEnabled);
+    // 会话区：界面中的 receiveEdit 作为第一个会话，标签页右侧可新建会话和切换平铺
+    m_sessionTabs->setTabsClosable(true);
+    m_sessionTabs->setMovable(false);
+    m_sessionTabs->setDocumentMode(true);
+    QWidget *corner = new QWidget(m_sessionTabs);
+    QHBoxLayout *cornerLayout = new QHBoxLayout(corner);
+    cornerLayout->setContentsMargins(0, 0, 0, 0);
+    QToolButton *addButton = new QToolButton(corner);
+    addButton->setText("+");
+    addButton->setToolTip("新建串口会话");
+    QToolButton *replayButton = new QToolButton(corner);
+    replayButton->setText("回放");
+    replayButton->setToolTip("在当前会话中回放捕获文件");
+    QToolButton *logButton = new QToolButton(corner);
+    logButton->setText("日志");
+    logButton->setToolTip("在当前会话的接收区中查看日志文件（右键菜单关闭）");
+    cornerLayout->addWidget(m_tileCheck);
+    cornerLayout->addWidget(logButton);
+    cornerLayout->addWidget(replayButton);
+    cornerLayout->addWidget(addButton);
+    m_sessionTabs->setCornerWidget(corner, Qt::TopRightCorner);
+    m_tileLayout->setContentsMargins(0, 0, 0, 0);
+    m_sessionStack->addWidget(m_sessionTabs);
+    m_sessionStack->addWidget(m_tileArea);
+    // 搜索栏在会话区上方，作用于当前会话的接收历史
+    QHBoxLayout *searchLayout = new QHBoxLayout(m_searchBar);
+    searchLayout->setContentsMargins(0, 0, 0, 0);
+    m_searchEdit->setPlaceholderText("搜索接收历史");
+    m_searchEdit->setClearButtonEnabled(true);
+    QToolButton *previousButton = new QToolButton(m_searchBar);
+    previousButton->setText("上一个");
+    QToolButton *nextButton = new QToolButton(m_searchBar);
+    nextButton->setText("下一个");
+    QToolButton *closeSearchButton = new QToolButton(m_searchBar);
+    closeSearchButton->setText("×");
+    closeSearchButton->setToolTip("关闭搜索 (Esc)");
+    searchLayout->addWidget(m_searchEdit, 1);
+    searchLayout->addWidget(m_searchRegex);
+    searchLayout->addWidget(m_searchCase);
+    searchLayout->addWidget(previousButton);
+    searchLayout->addWidget(nextButton);
+    searchLayout->addWidget(m_searchStatus);
+    searchLayout->addWidget(closeSearchButton);
+    m_searchBar->setVisible(false);
+    QWidget *sessionPanel = new QWidget(this);
+    QVBoxLayout *sessionPanelLayout = new QVBoxLayout(sessionPanel);
+    sessionPanelLayout->setContentsMargins(0, 0, 0, 0);
+    sessionPanelLayout->setSpacing(2);
+    sessionPanelLayout->addWidget(m_searchBar);
+    sessionPanelLayout->addWidget(m_sessionStack);
+    // 波形区在接收区右侧，只在启用波形通道时显示；结构体字段表在波形下方
+    m_wavePanel->addWidget(m_wavePlot);
+    m_wavePanel->addWidget(m_fieldTable);
+    m_wavePanel->setStretchFactor(0, 3);
+    m_wavePanel->setStretchFactor(1, 1);
+    m_wavePanel->setChildrenCollapsible(false);
+    m_waveSplitter->addWidget(sessionPanel);
+    m_waveSplitter->addWidget(m_wavePanel);
+    m_waveSplitter->setStretchFactor(0, 1);
+    m_waveSplitter->setStretchFactor(1, 1);
+    m_waveSplitter->setChildrenCollapsible(false);
+    ui->gridLayout_2->replaceWidget(ui->receiveEdit, m_waveSplitter);
+
+    connect(addButton, &QToolButton::clicked, this, [this]() {
+        addSession();
+        setCurrentSession(m_sessions.size() - 1);
+    });
+    connect(replayButton, &QToolButton::clicked, this, &Widget::showReplayDialog);
+    connect(logButton, &QToolButton::clicked, this, &Widget::openLogFile);
+    connect(new QShortcut(QKeySequence::Find, this), &QShortcut::activated, this, &Widget::showSearchBar);
+    connect(new QShortcut(Qt::Key_Escape, m_searchBar, nullptr, nullptr, Qt::WidgetWithChildrenShortcut),
+            &QShortcut::activated, this, &Widget::closeSearchBar);
+    connect(m_searchEdit, &QLineEdit::returnPressed, this, [this]() {
+        findInHistory(false);
+    });
+    connect(nextButton, &QToolButton::clicked, this, [this]() {
+        findInHistory(false);
+    });
+    connect(previousButton, &QToolButton::clicked, this, [this]() {
+        findInHistory(true);
+    });
+    connect(closeSearchButton, &QToolButton::clicked, this, &Widget::closeSearchBar);
+    connect(m_tileCheck, &QCheckBox::toggled, this, [this]() {
+        relayoutSessions();
+    });
+    connect(m_sessionTabs, &QTabWidget::tabCloseRequested, this, &Widget::closeSession);
+    connect(m_sessionTabs, &QTabWidget::currentChanged, this, [this](int index) {
+        if (!m_tileCheck->isChecked() && index >= 0) {
+            setCurrentSession(index);
+        }
+    });
 
-    // Create and attach KeywordHighlighter to receiveEdit
+    // Create KeywordHighlighter shared by all receive views
     // Requirements: 3.2, 3.3
-    m_highlighter = new KeywordHighlighter(ui->receiveEdit->document());
+    AppSettings *settings = AppSettings::instance();
+    m_highlighter = new KeywordHighlighter(this);
     m_highlighter->setEnabled(settings->keywordHighlightEnabled());
     
     // Connect AppSettings signal to highlighter
     connect(settings, &AppSettings::keywordHighlightEnabledChanged, 
             m_highlighter, &KeywordHighlighter::setEnabled);
 
+    addSession(ui->receiveEdit);
+    StructLayout layout;
+    layout.compile(settings->structLayout());
+    m_fieldTable->setStructLayout(layout);
+    setWaveStore(currentSession()->pipeline()->series());
+    updateWavePanel(settings->channelMode());
+    connect(settings, &AppSettings::channelModeChanged, this, &Widget::updateWavePanel);
+    connect(settings, &AppSettings::structLayoutChanged, this, [this](const QString &text) {
+        StructLayout layout;
+        layout.compile(text);
+        m_fieldTable->setStructLayout(layout);
+    });
+
+    updatePortList();
+    setupConnections();
+
     // Apply initial font settings from AppSettings
     // Requirements: 5.2
     QFont font = ui->receiveEdit->font();
@@ -80,17 +202,21 @@ Widget::Widget(QWidget *parent)
     
     // Connect fontSizeChanged signal
     connect(settings, &AppSettings::fontSizeChanged, this, [this](int size) {
-        QFont font = ui->receiveEdit->font();
+        QFont font = ui->sendEdit->font();
         font.setPointSize(size);
-        ui->receiveEdit->setFont(font);
+        for (const SessionPage &page : std::as_const(m_sessions)) {
+            page.session->view()->setFont(font);
+        }
         ui->sendEdit->setFont(font);
     });
     
     // Connect fontFamilyChanged signal
     connect(settings, &AppSettings::fontFamilyChanged, this, [this](const QString &family) {
-        QFont font = ui->receiveEdit->font();
+        QFont font = ui->sendEdit->font();
         font.setFamily(family);
-        ui->receiveEdit->setFont(font);
+        for (const SessionPage &page : std::as_const(m_sessions)) {
+            page.session->view()->setFont(font);
+        }
         ui->sendEdit->setFont(font);
     });
 
@@ -112,9 +238,6 @@ Widget::Widget(QWidget *parent)
             this, &Widget::applyDarkMode);
     applyDarkMode(settings->darkModeEnabled());
 
-    m_refreshTimer->setTimerType(Qt::PreciseTimer);
-    m_refreshTimer->setInterval(REFRESH_INTERVAL_MS);
-
     // Restore window size and splitter state from settings
     QSize savedSize = settings->windowSize();
     if (savedSize.isValid()) {
@@ -138,6 +261,21 @@ Widget::Widget(QWidget *parent)
     ui->chk0x16Send->setChecked(settings->hexSendEnabled());
     ui->chkNewLine->setChecked(settings->newLineEnabled());
 
+    // Display format and timestamp apply to all sessions, on their pipeline threads
+    m_sessions.first().session->pipeline()->setFormat(ui->chk0x16Show->isChecked() ? DataProcessor::Hexadecimal : DataProcessor::ASCII);
+    m_sessions.first().session->pipeline()->setTimestampEnabled(ui->chkTimeShow->isChecked());
+    connect(ui->chk0x16Show, &QCheckBox::toggled, this, [this](bool checked) {
+        for (const SessionPage &page : std::as_const(m_sessions)) {
+            page.session->pipeline()->setFormat(checked ? DataProcessor::Hexadecimal : DataProcessor::ASCII);
+            page.session->setLogHexMode(checked);
+        }
+    });
+    connect(ui->chkTimeShow, &QCheckBox::toggled, this, [this](bool checked) {
+        for (const SessionPage &page : std::as_const(m_sessions)) {
+            page.session->pipeline()->setTimestampEnabled(checked);
+        }
+    });
+
     // Connect signals to save settings when changed
     connect(ui->cbBaudRate, &QComboBox::currentTextChanged, settings, &AppSettings::setBaudRate);
     connect(ui->cbStopBits, QOverload<int>::of(&QComboBox::currentIndexChanged), settings, &AppSettings::setStopBitsIndex);
@@ -158,11 +296,11 @@ Widget::~Widget()
     settings->setWindowSize(size());
     settings->setSplitterState(ui->splitter->saveState());
 
-    m_refreshTimer->stop();
-    if (m_worker->isRunning()) {
-        m_worker->stop();
+    // 会话析构时关闭串口并归还共享线程
+    for (const SessionPage &page : std::as_const(m_sessions)) {
+        delete page.session;
     }
-    delete m_worker;
+    m_sessions.clear();
     delete ui;
 }
 
@@ -171,24 +309,277 @@ Widget::~Widget()
  */
 void Widget::setupConnections()
 {
-    connect(m_worker, &SerialWorker::dataReceived, this, &Widget::onDataReceived);
-    connect(m_worker, &SerialWorker::errorOccurred, this, &Widget::onSerialError);
-    connect(m_worker, &SerialWorker::started, this, &Widget::onSerialStarted);
-    connect(m_worker, &SerialWorker::stopped, this, &Widget::onSerialStopped);
+    // 监听 splitter 移动，当左边面板消失时同时隐藏发送区
+    connect(ui->splitter, &QSplitter::splitterMoved, this, &Widget::onSplitterMoved);
+}
 
-    connect(m_processor, &DataProcessor::dataProcessed, this, &Widget::onDataProcessed);
+/**
+ * @brief 新建一个会话
+ *
+ * 新会话沿用当前的显示格式、时间戳和字体设置。
+ *
+ * @param view 已有的接收显示区，为 nullptr 时新建
+ * @return 新会话
+ */
+PortSession *Widget::addSession(ReceiveView *view)
+{
+    if (!view) {
+        view = new ReceiveView();
+        view->setFont(m_sessions.isEmpty() ? font() : m_sessions.first().session->view()->font());
+    }
+    view->setHighlighter(m_highlighter);
+    view->installEventFilter(this);
+    view->viewport()->installEventFilter(this);
+
+    SessionPage page;
+    page.session = new PortSession(view, this);
+    page.page = new QWidget();
+    QVBoxLayout *layout = new QVBoxLayout(page.page);
+    layout->setContentsMargins(0, 0, 0, 0);
+    layout->setSpacing(2);
+    page.header = new QLabel(page.page);
+    page.header->setVisible(false);
+    layout->addWidget(page.header);
+    layout->addWidget(view);
+
+    PortSession *session = page.session;
+    if (!m_sessions.isEmpty()) {
+        session->pipeline()->setFormat(ui->chk0x16Show->isChecked() ? DataProcessor::Hexadecimal : DataProcessor::ASCII);
+        session->pipeline()->setTimestampEnabled(ui->chkTimeShow->isChecked());
+    }
 
-    connect(m_refreshTimer, &QTimer::timeout, this, &Widget::onRefreshTimeout);
+    connect(session, &PortSession::errorOccurred, this, [this, session](const QString &error) {
+        QMessageBox::warning(this, QString("串口错误 - %1").arg(session->title()), error, QMessageBox::Ok);
+    });
+    connect(session, &PortSession::started, this, [this, session]() {
+        onSessionStarted(session);
+    });
+    connect(session, &PortSession::stopped, this, [this, session]() {
+        onSessionStopped(session);
+    });
+    connect(session, &PortSession::speedUpdated, this, [this, session](double bytesPerSecond, qint64 totalBytes) {
+        onSessionSpeedUpdated(session, bytesPerSecond, totalBytes);
+    });
+    connect(session->search(), &HistorySearch::hitsChanged, this, [this, session]() {
+        if (session == currentSession()) {
+            updateSearchStatus();
+        }
+    });
+    connect(session, &PortSession::titleChanged, this, [this, session]() {
+        const int index = indexOfSession(session);
+        if (index >= 0) {
+            updateSessionTitle(index);
+        }
+    });
 
-    QScrollBar *scrollBar = ui->receiveEdit->verticalScrollBar();
-    connect(scrollBar, &QScrollBar::valueChanged, this, &Widget::onScrollValueChanged);
+    m_sessions.append(page);
+    relayoutSessions();
+    return session;
+}
+
+/**
+ * @brief 关闭会话
+ * @param index 会话下标
+ */
+void Widget::closeSession(int index)
+{
+    if (m_sessions.size() <= 1 || index < 0 || index >= m_sessions.size()) {
+        return;
+    }
 
-    connect(m_speedMonitor, &SpeedMonitor::speedUpdated, this, &Widget::onSpeedUpdated);
+    SessionPage page = m_sessions.takeAt(index);
+    if (m_wavePlot->store() == page.session->pipeline()->series()) {
+        setWaveStore(nullptr);
+    }
+    delete page.session;
+    delete page.page;
 
-    // 监听 splitter 移动，当左边面板消失时同时隐藏发送区
-    connect(ui->splitter, &QSplitter::splitterMoved, this, &Widget::onSplitterMoved);
+    m_current = qBound(0, m_current > index ? m_current - 1 : m_current, int(m_sessions.size()) - 1);
+    relayoutSessions();
+    setWaveStore(currentSession()->pipeline()->series());
+}
+
+/**
+ * @brief 切换当前会话
+ * @param index 会话下标
+ */
+void Widget::setCurrentSession(int index)
+{
+    if (index < 0 || index >= m_sessions.size()) {
+        return;
+    }
+
+    m_current = index;
+    m_jumpToFirstHit = false;
+    if (!m_tileCheck->isChecked()) {
+        if (m_sessionTabs->currentIndex() != index) {
+            m_sessionTabs->setCurrentIndex(index);
+        }
+        // 标签页模式下只有当前会话可见，其余会话转为后台刷新
+        for (int i = 0; i < m_sessions.size(); ++i) {
+            m_sessions.at(i).session->setActive(i == index);
+        }
+    }
+    for (int i = 0; i < m_sessions.size(); ++i) {
+        updateSessionTitle(i);
+    }
+
+    setWaveStore(currentSession()->pipeline()->series());
+    ui->groupBox_2->setTitle("接收区");
+    updateSessionControls();
+}
+
+/**
+ * @brief 让波形区显示某个会话的数据
+ * @param store 时间序列存储
+ */
+void Widget::setWaveStore(TimeSeriesStore *store)
+{
+    m_wavePlot->setStore(store);
+    m_fieldTable->setStore(store);
+}
+
+/**
+ * @brief 按波形通道来源显示或隐藏波形区和字段表
+ * @param mode ChannelParser::Mode
+ */
+void Widget::updateWavePanel(int mode)
+{
+    m_wavePanel->setVisible(mode != ChannelParser::Off);
+    m_fieldTable->setVisible(mode == ChannelParser::Struct);
+}
+
+PortSession *Widget::currentSession() const
+{
+    return m_sessions.at(m_current).session;
+}
+
+int Widget::indexOfSession(PortSession *session) const
+{
+    for (int i = 0; i < m_sessions.size(); ++i) {
+        if (m_sessions.at(i).session == session) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief 按标签页或平铺方式排列会话
+ */
+void Widget::relayoutSessions()
+{
+    const bool tiled = m_tileCheck->isChecked();
+
+    // 先把所有页面从两种容器中取出
+    m_sessionTabs->blockSignals(true);
+    while (m_sessionTabs->count() > 0) {
+        m_sessionTabs->removeTab(0);
+    }
+    for (const SessionPage &page : std::as_const(m_sessions)) {
+        m_tileLayout->removeWidget(page.page);
+    }
+
+    if (tiled) {
+        // 接近正方形的网格
+        int columns = 1;
+        while (columns * columns < m_sessions.size()) {
+            ++columns;
+        }
+        for (int i = 0; i < m_sessions.size(); ++i) {
+            m_tileLayout->addWidget(m_sessions.at(i).page, i / columns, i % columns);
+            m_sessions.at(i).page->show();
+            m_sessions.at(i).header->setVisible(true);
+            m_sessions.at(i).session->setActive(true);
+        }
+        m_sessionStack->setCurrentWidget(m_tileArea);
+    } else {
+        for (int i = 0; i < m_sessions.size(); ++i) {
+            m_sessions.at(i).header->setVisible(false);
+            m_sessionTabs->addTab(m_sessions.at(i).page, QString());
+        }
+        m_sessionStack->setCurrentWidget(m_sessionTabs);
+    }
+    m_sessionTabs->setTabsClosable(m_sessions.size() > 1);
+    m_sessionTabs->blockSignals(false);
+
+    setCurrentSession(qBound(0, m_current, int(m_sessions.size()) - 1));
+}
+
+/**
+ * @brief 刷新会话标题
+ * @param index 会话下标
+ */
+void Widget::updateSessionTitle(int index)
+{
+    const SessionPage &page = m_sessions.at(index);
+    const QString title = QString("%1 %2").arg(index + 1).arg(page.session->title());
+    const QString state = page.session->isRunning() ? "●" : "○";
+    if (!m_tileCheck->isChecked()) {
+        m_sessionTabs->setTabText(index, state + " " + title);
+    }
+    page.header->setText(state + " " + title);
+    QFont headerFont = page.header->font();
+    headerFont.setBold(index == m_current);
+    page.header->setFont(headerFont);
+}
+
+/**
+ * @brief 按当前会话刷新左侧控件
+ */
+void Widget::updateSessionControls()
+{
+    PortSession *session = currentSession();
+    const bool running = session->isRunning();
+
+    // 已打开过的会话恢复其端口配置
+    const SerialConfig config = session->config();
+    if (!config.portName.isEmpty()) {
+        for (int i = 0; i < ui->cbPortName->count(); ++i) {
+            if (ui->cbPortName->itemData(i).toString() == config.portName) {
+                ui->cbPortName->setCurrentIndex(i);
+                break;
+            }
+        }
+        ui->cbBaudRate->setCurrentText(QString::number(config.baudRate));
+    }
+
+    setPortControlsEnabled(!running);
+    if (running && session->isReplaying()) {
+        ui->open->setText("停止回放");
+        ui->open->setStyleSheet("color: orange;");
+        ui->lbConnected->setText("正在回放");
+        ui->lbConnected->setStyleSheet("color: green;");
+    } else if (running) {
+        ui->open->setText("关闭串口");
+        ui->open->setStyleSheet("color: orange;");
+        ui->lbConnected->setText("当前已连接");
+        ui->lbConnected->setStyleSheet("color: green;");
+    } else {
+        ui->open->setText("打开串口");
+        ui->open->setStyleSheet("color: red;");
+        ui->lbConnected->setText("当前未连接");
+        ui->lbConnected->setStyleSheet("color: rgb(0, 85, 255);");
+    }
+    updateSearchStatus();
 }
 
+/**
+ * @brief 平铺模式下点击或聚焦某个接收区时切换当前会话
+ */
+bool Widget::eventFilter(QObject *watched, QEvent *event)
+{
+    if (event->type() == QEvent::FocusIn || event->type() == QEvent::MouseButtonPress) {
+        for (int i = 0; i < m_sessions.size(); ++i) {
+            ReceiveView *view = m_sessions.at(i).session->view();
+            if ((watched == view || watched == view->viewport()) && i != m_current) {
+                setCurrentSession(i);
+                break;
+            }
+        }
+    }
+    return QWidget::eventFilter(watched, event);
+}
 
 /**
  * @brief 更新可用串口列表
@@ -279,6 +670,12 @@ SerialConfig Widget::buildConfig() const
 
     config.flowControl = QSerialPort::NoFlowControl;
     config.readBufferSize = 4096;
+    config.batchLatencyMs = AppSettings::instance()->batchLatencyMs();
+    config.batchMaxBytes = AppSettings::instance()->batchMaxKB() * 1024;
+
+    // 原生后端：高波特率下让内核累积 64 字节再唤醒，减少系统调用次数
+    config.backend = static_cast<SerialConfig::Backend>(AppSettings::instance()->serialBackend());
+    config.nativeVmin = config.baudRate >= 1000000 ? 64 : 1;
 
     return config;
 }
@@ -314,7 +711,7 @@ void Widget::applyDarkMode(bool enabled)
                 background-color: #383838;
                 color: #ffffff;
             }
-            QPlainTextEdit, QTextEdit {
+            QPlainTextEdit, QTextEdit, ReceiveView {
                 background-color: #1e1e1e;
                 color: #ffffff;
             }
@@ -341,171 +738,144 @@ void Widget::applyDarkMode(bool enabled)
 }
 
 /**
- * @brief 追加文本到显示区域
- * 
- * 根据自动滚动状态决定是否滚动到底部。
- * Requirements: 6.4
- * 
- * @param text 要追加的文本
+ * @brief 会话串口打开回调
+ * @param session 会话
  */
-void Widget::appendToDisplay(const QString &text)
+void Widget::onSessionStarted(PortSession *session)
 {
-    ui->receiveEdit->insertPlainText(text);
-
-    if (m_autoScroll) {
-        ui->receiveEdit->moveCursor(QTextCursor::End);
+    const int index = indexOfSession(session);
+    if (index >= 0) {
+        updateSessionTitle(index);
     }
-}
-
-
-/**
- * @brief 定时刷新回调
- * 
- * 批量处理缓冲区中的数据并更新UI。
- * Requirements: 6.1, 6.2, 6.3
- */
-void Widget::onRefreshTimeout()
-{
-    if (!m_pendingText.isEmpty()) {
-        appendToDisplay(m_pendingText);
-        m_pendingText.clear();
+    if (session != currentSession()) {
+        return;
     }
-}
 
-/**
- * @brief 处理接收到的串口数据
- * 
- * 将数据写入缓冲区并交给处理器处理。
- * 
- * @param data 接收到的原始数据
- */
-void Widget::onDataReceived(const QByteArray &data)
-{
-    m_buffer->write(data);
-    m_speedMonitor->recordBytes(data.size());
-
-    m_processor->setFormat(ui->chk0x16Show->isChecked() 
-        ? DataProcessor::Hexadecimal 
-        : DataProcessor::ASCII);
-    m_processor->setTimestampEnabled(ui->chkTimeShow->isChecked());
-    m_processor->process(data);
-}
-
-/**
- * @brief 处理已处理的数据
- * 
- * 将处理后的文本添加到待显示队列。
- * Requirements: 6.1, 6.2
- * 
- * @param text 处理后的文本
- */
-void Widget::onDataProcessed(const QString &text)
-{
-    m_pendingText.append(text);
-}
-
-/**
- * @brief 处理串口错误
- * @param error 错误描述
- */
-void Widget::onSerialError(const QString &error)
-{
-    QMessageBox::warning(this, "串口错误", error, QMessageBox::Ok);
-}
-
-/**
- * @brief 显示系统消息
- * 
- * 统一显示系统相关信息，添加"SystInfo >>"前缀
- * 
- * @param message 系统消息内容
- */
-void Widget::showSystemMessage(const QString &message)
-{
-    ui->receiveEdit->insertPlainText("SYSINFO >> " + message + "\r\n");
-    ui->receiveEdit->moveCursor(QTextCursor::End);
-}
-
-/**
- * @brief 串口启动成功回调
- */
-void Widget::onSerialStarted()
-{
-    setPortControlsEnabled(false);
-    ui->receiveEdit->setTextInteractionFlags(Qt::NoTextInteraction);
-    ui->open->setText("关闭串口");
-    ui->open->setStyleSheet("color: orange;");
-    ui->lbConnected->setText("当前已连接");
-    ui->lbConnected->setStyleSheet("color: green;");
-    showSystemMessage("串口已连接！");
+    updateSessionControls();
 
     // Save last used port name - Requirements: 6.4
-    AppSettings::instance()->setLastPortName(ui->cbPortName->currentData().toString());
-
-    // Start speed monitoring - Requirements: 1.3, 3.2
-    m_speedMonitor->reset();
-    m_speedMonitor->start();
-
-    m_refreshTimer->start();
+    if (!session->isReplaying()) {
+        AppSettings::instance()->setLastPortName(session->config().portName);
+    }
 }
 
 /**
- * @brief 串口停止回调
+ * @brief 会话串口关闭回调
+ * @param session 会话
  */
-void Widget::onSerialStopped()
+void Widget::onSessionStopped(PortSession *session)
 {
-    m_refreshTimer->stop();
-
-    // Stop speed monitoring - Requirements: 1.3
-    m_speedMonitor->stop();
-    ui->groupBox_2->setTitle("接收区");
-
-    if (!m_pendingText.isEmpty()) {
-        appendToDisplay(m_pendingText);
-        m_pendingText.clear();
+    const int index = indexOfSession(session);
+    if (index >= 0) {
+        updateSessionTitle(index);
+    }
+    if (session != currentSession()) {
+        return;
     }
 
-    setPortControlsEnabled(true);
-    ui->receiveEdit->setTextInteractionFlags(Qt::TextSelectableByMouse | Qt::TextSelectableByKeyboard);
-    ui->open->setText("打开串口");
-    ui->open->setStyleSheet("color: red;");
-    ui->lbConnected->setText("当前未连接");
-    ui->lbConnected->setStyleSheet("color: rgb(0, 85, 255);");
-    showSystemMessage("串口已关闭！");
+    ui->groupBox_2->setTitle("接收区");
+    updateSessionControls();
 }
 
 /**
  * @brief 速度更新回调
  * 
- * 更新接收区标题显示当前速度和累计字节数。
+ * 更新接收区标题显示当前会话的速度和累计字节数。
  * Requirements: 1.1, 1.2, 3.4
  * 
+ * @param session 会话
  * @param bytesPerSecond 当前速度（bytes/s）
  * @param totalBytes 累计总字节数
  */
-void Widget::onSpeedUpdated(double bytesPerSecond, qint64 totalBytes)
+void Widget::onSessionSpeedUpdated(PortSession *session, double bytesPerSecond, qint64 totalBytes)
 {
+    if (session != currentSession()) {
+        return;
+    }
+
+    // 原始数据捕获：写入速度、队列深度和丢弃（捕获时才显示）
+    const CaptureStats capture = session->capture()->stats();
+
     QString title = QString("接收区 [%1 | 总计: %2]")
         .arg(SpeedMonitor::formatSpeed(bytesPerSecond),
              SpeedMonitor::formatBytes(totalBytes));
+    if (capture.running) {
+        title.chop(1);
+        title += QString(" | 捕获: %1]").arg(SpeedMonitor::formatSpeed(capture.bytesPerSecond));
+    }
     ui->groupBox_2->setTitle(title);
-}
 
-/**
- * @brief 滚动条值变化回调
- * 
- * 实现自动滚动暂停/恢复逻辑。
- * Requirements: 6.4
- * 
- * @param value 当前滚动条值
- */
-void Widget::onScrollValueChanged(int value)
-{
-    QScrollBar *scrollBar = ui->receiveEdit->verticalScrollBar();
-    m_autoScroll = (value >= scrollBar->maximum() - 10);
+    // 读取合并效果：每批平均包含的 readyRead 次数和字节数
+    BatchStats stats = session->worker()->batchStats();
+    // 显示队列：排队、溢出到文件、丢弃和峰值内存
+    QueueStats queue = session->pipeline()->queueStats();
+    // 波形数据：内存中和溢出到映射文件的块
+    const TimeSeriesStore *series = session->pipeline()->series();
+    // 接收块池（所有会话共享）：每秒新分配/取块次数，稳定时新分配应为 0
+    SlabStats slabs = SlabPool::instance()->stats();
+    const quint64 slabAllocs = slabs.allocations - m_lastSlabStats.allocations;
+    const quint64 slabAcquires = slabs.acquires - m_lastSlabStats.acquires;
+    m_lastSlabStats = slabs;
+    QString tooltip = QString("批次: %1 | 平均每批读取: %2 次 / %3 字节\n"
+                                       "按大小发出: %4 | 按延迟发出: %5\n"
+                                       "显示队列: %6 | 临时文件: %7 | 已丢弃: %8 | 峰值: %9\n"
+                                       "接收块: 新分配 %10/s | 取用 %11/s | 使用中 %12 | 空闲 %13\n"
+                                       "会话: %14 | 串口线程: %15 | 处理线程: %16\n"
+                                       "波形通道: %17 | 累计采样: %18 | 已丢弃: %19\n"
+                                       "波形内存: %20 | 波形临时文件: %21")
+        .arg(stats.batches)
+        .arg(stats.readsPerBatch(), 0, 'f', 1)
+        .arg(stats.bytesPerBatch(), 0, 'f', 0)
+        .arg(stats.sizeFlushes)
+        .arg(stats.latencyFlushes)
+        .arg(SpeedMonitor::formatBytes(queue.queuedBytes),
+             SpeedMonitor::formatBytes(queue.spilledBytes),
+             SpeedMonitor::formatBytes(queue.droppedBytes),
+             SpeedMonitor::formatBytes(queue.peakBytes))
+        .arg(slabAllocs)
+        .arg(slabAcquires)
+        .arg(slabs.inUse)
+        .arg(slabs.pooled)
+        .arg(m_sessions.size())
+        .arg(IoThreadPool::instance(IoThreadPool::SerialIo)->threadCount())
+        .arg(IoThreadPool::instance(IoThreadPool::Processing)->threadCount())
+        .arg(series->channelCount())
+        .arg(series->totalSamples())
+        .arg(series->droppedSamples())
+        .arg(SpeedMonitor::formatBytes(series->memoryBytes()),
+             SpeedMonitor::formatBytes(series->spilledBytes()));
+    if (session->isReplaying() && session->isRunning()) {
+        const ReplayStats replay = session->replay()->stats();
+        tooltip += QString("\n回放: %1 / %2 | 已发出 %3 条记录")
+            .arg(SpeedMonitor::formatBytes(replay.position),
+                 SpeedMonitor::formatBytes(replay.fileSize))
+            .arg(replay.records);
+    }
+    if (session->log()->isOpen()) {
+        const LogIndexStats log = session->log()->stats();
+        tooltip += QString("\n日志: %1 行 | 已索引 %2 / %3 | 用时 %4 s | 索引内存 %5 | 扫描线程 %6")
+            .arg(log.lines)
+            .arg(SpeedMonitor::formatBytes(log.indexedBytes),
+                 SpeedMonitor::formatBytes(log.fileSize),
+                 QString::number(double(log.elapsedNs) / 1e9, 'f', 2),
+                 SpeedMonitor::formatBytes(log.indexBytes))
+            .arg(log.threads);
+    }
+    if (capture.running) {
+        tooltip += QString("\n捕获: 写入 %1 | 队列: %2 块 / %3 | 峰值: %4 | 已丢弃: %5 | 文件: %6")
+            .arg(SpeedMonitor::formatSpeed(capture.bytesPerSecond))
+            .arg(capture.queuedChunks)
+            .arg(SpeedMonitor::formatBytes(capture.queuedBytes),
+                 SpeedMonitor::formatBytes(capture.peakQueuedBytes),
+                 SpeedMonitor::formatBytes(capture.droppedBytes))
+            .arg(capture.files);
+        if (!capture.lastError.isEmpty()) {
+            tooltip += "\n捕获错误: " + capture.lastError;
+        }
+    }
+    ui->groupBox_2->setToolTip(tooltip);
 }
 
-
 /**
  * @brief splitter 移动回调
  * 
@@ -523,16 +893,11 @@ void Widget::onSplitterMoved(int pos, int index)
 }
 
 /**
- * @brief 清空接收区
+ * @brief 清空当前会话的接收区
  */
 void Widget::on_clear_clicked()
 {
-    ui->receiveEdit->clear();
-    m_pendingText.clear();
-    m_buffer->clear();
-    
-    // Reset speed monitor counters - Requirements: 3.3
-    m_speedMonitor->reset();
+    currentSession()->clear();
 }
 
 /**
@@ -541,15 +906,16 @@ void Widget::on_clear_clicked()
 void Widget::on_cbPortName_clicked()
 {
     updatePortList();
-    showSystemMessage("检测端口完毕");
+    currentSession()->showSystemMessage("检测端口完毕");
 }
 
 /**
- * @brief 打开/关闭串口按钮点击
+ * @brief 打开/关闭当前会话的串口
  */
 void Widget::on_open_clicked()
 {
-    if (!m_worker->isRunning()) {
+    PortSession *session = currentSession();
+    if (!session->isRunning()) {
         SerialConfig config = buildConfig();
 
         if (!config.isValid()) {
@@ -557,31 +923,32 @@ void Widget::on_open_clicked()
             return;
         }
 
-        m_worker->start(config);
+        session->start(config);
     } else {
-        m_worker->stop();
+        session->stop();
     }
 }
 
 /**
  * @brief 发送按钮点击
  * 
- * 如果串口未打开，自动尝试打开串口后再发送。
+ * 发送到当前会话；如果串口未打开，自动尝试打开串口后再发送。
  */
 void Widget::on_send_clicked()
 {
     // 如果串口未打开，自动尝试打开
-    if (!m_worker->isRunning()) {
+    QPointer<PortSession> session = currentSession();
+    if (!session->isRunning()) {
         SerialConfig config = buildConfig();
         if (!config.isValid()) {
             QMessageBox::warning(this, "配置错误", config.validationError(), QMessageBox::Ok);
             return;
         }
-        m_worker->start(config);
+        session->start(config);
         // 等待串口打开后再发送（通过 QTimer 延迟执行）
-        // 如果打开失败，onSerialError 会处理错误提示
-        QTimer::singleShot(100, this, [this]() {
-            if (m_worker->isRunning()) {
+        // 如果打开失败，errorOccurred 会处理错误提示；期间会话被关闭则放弃发送
+        QTimer::singleShot(100, this, [this, session]() {
+            if (session && session == currentSession() && session->isRunning()) {
                 performSend();
             }
         });
@@ -602,10 +969,6 @@ void Widget::performSend()
         return;
     }
 
-    QString showTheSend = "SEND >> " + ui->sendEdit->toPlainText();
-    ui->receiveEdit->insertPlainText(showTheSend + "\r\n");
-    ui->receiveEdit->moveCursor(QTextCursor::End);
-
     if (ui->chk0x16Send->isChecked()) {
         static QRegularExpression hexRegex("[A-Fa-f0-9]{2}");
         QString strData = ui->sendEdit->toPlainText();
@@ -620,7 +983,7 @@ void Widget::performSend()
         sendData.append("\r\n");
     }
 
-    m_worker->sendData(sendData);
+    currentSession()->send(sendData, "SEND >> " + ui->sendEdit->toPlainText());
 
     if (ui->chkClearAfterSend->isChecked()) {
         ui->sendEdit->clear();
@@ -648,7 +1011,7 @@ void Widget::on_openSetButton_clicked()
 {
     QDialog *settingsDialog = new QDialog(this);
     settingsDialog->setWindowTitle("设置");
-    settingsDialog->setFixedSize(320, 330);
+    settingsDialog->setFixedSize(320, 718);
 
     QVBoxLayout *mainLayout = new QVBoxLayout(settingsDialog);
     mainLayout->setSpacing(15);
@@ -750,6 +1113,152 @@ void Widget::on_openSetButton_clicked()
     QCheckBox *darkModeCheck = new QCheckBox("深色模式", settingsDialog);
     mainLayout->addWidget(darkModeCheck);
 
+    // 显示队列上限：界面来不及显示时最多缓存的数据量
+    QHBoxLayout *queueBudgetLayout = new QHBoxLayout();
+    QLabel *queueBudgetLabel = new QLabel("显示缓存上限:", settingsDialog);
+    QSpinBox *queueBudgetSpinBox = new QSpinBox(settingsDialog);
+    queueBudgetSpinBox->setRange(1, 1024);
+    queueBudgetSpinBox->setSuffix(" MB");
+    queueBudgetSpinBox->setFixedHeight(28);
+    queueBudgetLayout->addWidget(queueBudgetLabel);
+    queueBudgetLayout->addWidget(queueBudgetSpinBox);
+    queueBudgetLayout->addStretch();
+    mainLayout->addLayout(queueBudgetLayout);
+
+    // 显示队列溢出策略
+    QHBoxLayout *overflowLayout = new QHBoxLayout();
+    QLabel *overflowLabel = new QLabel("缓存溢出时:", settingsDialog);
+    QComboBox *overflowCombo = new QComboBox(settingsDialog);
+    overflowCombo->addItem("丢弃最旧数据", AppSettings::DropOldest);
+    overflowCombo->addItem("丢弃最新数据", AppSettings::DropNewest);
+    overflowCombo->addItem("写入临时文件", AppSettings::SpillToDisk);
+    overflowCombo->setFixedHeight(28);
+    overflowLayout->addWidget(overflowLabel);
+    overflowLayout->addWidget(overflowCombo);
+    overflowLayout->addStretch();
+    mainLayout->addLayout(overflowLayout);
+
+    // 时间戳模式下未结束的行等待多久后先行显示
+    QHBoxLayout *lineIdleLayout = new QHBoxLayout();
+    QLabel *lineIdleLabel = new QLabel("行尾等待:", settingsDialog);
+    QSpinBox *lineIdleSpinBox = new QSpinBox(settingsDialog);
+    lineIdleSpinBox->setRange(0, 10000);
+    lineIdleSpinBox->setSingleStep(50);
+    lineIdleSpinBox->setSuffix(" ms");
+    lineIdleSpinBox->setFixedHeight(28);
+    lineIdleLayout->addWidget(lineIdleLabel);
+    lineIdleLayout->addWidget(lineIdleSpinBox);
+    lineIdleLayout->addStretch();
+    mainLayout->addLayout(lineIdleLayout);
+
+    // 串口后端：原生后端只在 Linux 下可用，下次打开串口时生效
+    QHBoxLayout *backendLayout = new QHBoxLayout();
+    QLabel *backendLabel = new QLabel("串口后端:", settingsDialog);
+    QComboBox *backendCombo = new QComboBox(settingsDialog);
+    backendCombo->addItem("Qt (QSerialPort)", SerialConfig::QtBackend);
+    backendCombo->addItem("原生 (低延迟/任意波特率)", SerialConfig::NativeBackend);
+    if (!SerialConfig::isBackendAvailable(SerialConfig::NativeBackend)) {
+        qobject_cast<QStandardItemModel *>(backendCombo->model())->item(1)->setEnabled(false);
+    }
+    backendCombo->setFixedHeight(28);
+    backendLayout->addWidget(backendLabel);
+    backendLayout->addWidget(backendCombo);
+    backendLayout->addStretch();
+    mainLayout->addLayout(backendLayout);
+
+    // 读取合并：最大延迟和批次大小，下次打开串口时生效
+    QHBoxLayout *batchLayout = new QHBoxLayout();
+    QLabel *batchLabel = new QLabel("读取合并:", settingsDialog);
+    QSpinBox *batchLatencySpinBox = new QSpinBox(settingsDialog);
+    batchLatencySpinBox->setRange(0, 1000);
+    batchLatencySpinBox->setSuffix(" ms");
+    batchLatencySpinBox->setToolTip("最大延迟，0 表示每次读取立即发出");
+    batchLatencySpinBox->setFixedHeight(28);
+    QSpinBox *batchMaxSpinBox = new QSpinBox(settingsDialog);
+    batchMaxSpinBox->setRange(1, 1024);
+    batchMaxSpinBox->setSuffix(" KB");
+    batchMaxSpinBox->setToolTip("单个批次的最大字节数");
+    batchMaxSpinBox->setFixedHeight(28);
+    batchLayout->addWidget(batchLabel);
+    batchLayout->addWidget(batchLatencySpinBox);
+    batchLayout->addWidget(batchMaxSpinBox);
+    batchLayout->addStretch();
+    mainLayout->addLayout(batchLayout);
+
+    // 帧解析：二进制分帧协议，每帧显示为一行
+    QHBoxLayout *frameLayout = new QHBoxLayout();
+    QLabel *frameLabel = new QLabel("帧解析:", settingsDialog);
+    QPushButton *frameButton = new QPushButton("设置...", settingsDialog);
+    frameButton->setFixedHeight(28);
+    frameLayout->addWidget(frameLabel);
+    frameLayout->addWidget(frameButton);
+    frameLayout->addStretch();
+    mainLayout->addLayout(frameLayout);
+
+    // 波形通道：从文本遥测行中提取数值
+    QHBoxLayout *channelLayout = new QHBoxLayout();
+    QLabel *channelLabel = new QLabel("波形通道:", settingsDialog);
+    QComboBox *channelCombo = new QComboBox(settingsDialog);
+    channelCombo->addItem("关闭", ChannelParser::Off);
+    channelCombo->addItem("自动识别", ChannelParser::Auto);
+    channelCombo->addItem("CSV (1.2,3.4)", ChannelParser::Csv);
+    channelCombo->addItem("键值 (v=3.31)", ChannelParser::KeyValue);
+    channelCombo->addItem("结构体 (按帧)", ChannelParser::Struct);
+    channelCombo->setFixedHeight(28);
+    channelLayout->addWidget(channelLabel);
+    channelLayout->addWidget(channelCombo);
+    channelLayout->addStretch();
+    mainLayout->addLayout(channelLayout);
+
+    // 结构体布局：按帧解码的字段（波形通道选择"结构体"时使用）
+    QHBoxLayout *structLayoutRow = new QHBoxLayout();
+    QLabel *structLabel = new QLabel("结构体布局:", settingsDialog);
+    QPushButton *structButton = new QPushButton("设置...", settingsDialog);
+    structButton->setFixedHeight(28);
+    structLayoutRow->addWidget(structLabel);
+    structLayoutRow->addWidget(structButton);
+    structLayoutRow->addStretch();
+    mainLayout->addLayout(structLayoutRow);
+    connect(structButton, &QPushButton::clicked, settingsDialog, [this, settingsDialog]() {
+        showStructLayoutDialog(settingsDialog);
+    });
+
+    // 波形缓存：内存预算，超出后较旧的数据溢出到临时文件（0 表示直接丢弃）
+    QHBoxLayout *waveBudgetLayout = new QHBoxLayout();
+    QLabel *waveBudgetLabel = new QLabel("波形缓存:", settingsDialog);
+    QSpinBox *waveMemorySpinBox = new QSpinBox(settingsDialog);
+    waveMemorySpinBox->setRange(16, 16384);
+    waveMemorySpinBox->setSuffix(" MB");
+    waveMemorySpinBox->setFixedHeight(28);
+    QLabel *waveDiskLabel = new QLabel("磁盘:", settingsDialog);
+    QSpinBox *waveDiskSpinBox = new QSpinBox(settingsDialog);
+    waveDiskSpinBox->setRange(0, 262144);
+    waveDiskSpinBox->setSingleStep(1024);
+    waveDiskSpinBox->setSuffix(" MB");
+    waveDiskSpinBox->setFixedHeight(28);
+    waveBudgetLayout->addWidget(waveBudgetLabel);
+    waveBudgetLayout->addWidget(waveMemorySpinBox);
+    waveBudgetLayout->addWidget(waveDiskLabel);
+    waveBudgetLayout->addWidget(waveDiskSpinBox);
+    waveBudgetLayout->addStretch();
+    mainLayout->addLayout(waveBudgetLayout);
+
+    // 原始数据捕获：把接收到的字节原样写入文件（打开串口时开始）
+    QHBoxLayout *captureLayout = new QHBoxLayout();
+    QLabel *captureLabel = new QLabel("原始数据捕获:", settingsDialog);
+    QPushButton *captureButton = new QPushButton("设置...", settingsDialog);
+    captureButton->setFixedHeight(28);
+    captureLayout->addWidget(captureLabel);
+    captureLayout->addWidget(captureButton);
+    captureLayout->addStretch();
+    mainLayout->addLayout(captureLayout);
+    connect(captureButton, &QPushButton::clicked, settingsDialog, [this, settingsDialog]() {
+        showCaptureDialog(settingsDialog);
+    });
+    connect(frameButton, &QPushButton::clicked, settingsDialog, [this, settingsDialog]() {
+        showFrameDialog(settingsDialog);
+    });
+
     mainLayout->addStretch();
 
     // Confirm button
@@ -777,6 +1286,15 @@ void Widget::on_openSetButton_clicked()
     hexNewlineCheck->setChecked(settings->hexNewlineEnabled());
     keywordHighlightCheck->setChecked(settings->keywordHighlightEnabled());
     darkModeCheck->setChecked(settings->darkModeEnabled());
+    queueBudgetSpinBox->setValue(settings->displayQueueBudgetMB());
+    overflowCombo->setCurrentIndex(overflowCombo->findData(settings->overflowPolicy()));
+    lineIdleSpinBox->setValue(settings->lineIdleTimeoutMs());
+    channelCombo->setCurrentIndex(qMax(0, channelCombo->findData(settings->channelMode())));
+    waveMemorySpinBox->setValue(settings->waveMemoryMB());
+    waveDiskSpinBox->setValue(settings->waveDiskMB());
+    backendCombo->setCurrentIndex(qMax(0, backendCombo->findData(settings->serialBackend())));
+    batchLatencySpinBox->setValue(settings->batchLatencyMs());
+    batchMaxSpinBox->setValue(settings->batchMaxKB());
 
     // Connect confirm button to save settings and close dialog - Requirements: 4.3, 1.3, 1.4, 6.2
     QObject::connect(confirmButton, &QPushButton::clicked, settingsDialog, [=]() {
@@ -787,6 +1305,15 @@ void Widget::on_openSetButton_clicked()
         settings->setHexNewlineEnabled(hexNewlineCheck->isChecked());
         settings->setKeywordHighlightEnabled(keywordHighlightCheck->isChecked());
         settings->setDarkModeEnabled(darkModeCheck->isChecked());
+        settings->setDisplayQueueBudgetMB(queueBudgetSpinBox->value());
+        settings->setOverflowPolicy(static_cast<AppSettings::OverflowPolicy>(overflowCombo->currentData().toInt()));
+        settings->setLineIdleTimeoutMs(lineIdleSpinBox->value());
+        settings->setChannelMode(channelCombo->currentData().toInt());
+        settings->setWaveMemoryMB(waveMemorySpinBox->value());
+        settings->setWaveDiskMB(waveDiskSpinBox->value());
+        settings->setSerialBackend(backendCombo->currentData().toInt());
+        settings->setBatchLatencyMs(batchLatencySpinBox->value());
+        settings->setBatchMaxKB(batchMaxSpinBox->value());
         settingsDialog->accept();
     });
 
@@ -794,3 +1321,527 @@ void Widget::on_openSetButton_clicked()
     delete settingsDialog;
 }
 
+/**
+ * @brief 打开帧解析设置对话框
+ *
+ * 选择帧格式及其参数，确定后立即保存并应用到所有会话。
+ */
+void Widget::showFrameDialog(QWidget *parent)
+{
+    QDialog *frameDialog = new QDialog(parent);
+    frameDialog->setWindowTitle("帧解析");
+
+    QVBoxLayout *mainLayout = new QVBoxLayout(frameDialog);
+    mainLayout->setSpacing(15);
+    mainLayout->setContentsMargins(20, 20, 20, 20);
+
+    QFormLayout *formLayout = new QFormLayout();
+    QComboBox *typeCombo = new QComboBox(frameDialog);
+    typeCombo->addItem("不分帧", FrameConfig::None);
+    typeCombo->addItem("分隔符", FrameConfig::Delimiter);
+    typeCombo->addItem("固定长度", FrameConfig::FixedLength);
+    typeCombo->addItem("长度字段", FrameConfig::LengthPrefix);
+    typeCombo->addItem("SLIP", FrameConfig::Slip);
+    typeCombo->addItem("COBS", FrameConfig::Cobs);
+    typeCombo->addItem("空闲间隔", FrameConfig::IdleGap);
+    formLayout->addRow("帧格式:", typeCombo);
+
+    // 分隔符以十六进制输入，如 "0D 0A"
+    QLineEdit *delimiterEdit = new QLineEdit(frameDialog);
+    delimiterEdit->setPlaceholderText("0D 0A");
+    QCheckBox *keepDelimiterCheck = new QCheckBox("显示分隔符", frameDialog);
+    formLayout->addRow("分隔符(HEX):", delimiterEdit);
+    formLayout->addRow("", keepDelimiterCheck);
+
+    QSpinBox *fixedLengthSpinBox = new QSpinBox(frameDialog);
+    fixedLengthSpinBox->setRange(1, FrameConfig::MAX_FRAME_SIZE);
+    fixedLengthSpinBox->setSuffix(" 字节");
+    formLayout->addRow("帧长度:", fixedLengthSpinBox);
+
+    QSpinBox *lengthOffsetSpinBox = new QSpinBox(frameDialog);
+    lengthOffsetSpinBox->setRange(0, 255);
+    lengthOffsetSpinBox->setSuffix(" 字节");
+    QComboBox *lengthSizeCombo = new QComboBox(frameDialog);
+    lengthSizeCombo->addItem("1 字节", 1);
+    lengthSizeCombo->addItem("2 字节", 2);
+    lengthSizeCombo->addItem("4 字节", 4);
+    QCheckBox *bigEndianCheck = new QCheckBox("大端", frameDialog);
+    QSpinBox *lengthAdjustSpinBox = new QSpinBox(frameDialog);
+    lengthAdjustSpinBox->setRange(-255, 255);
+    lengthAdjustSpinBox->setToolTip("长度字段之后的字节数 = 字段值 + 修正值（如包含校验和）");
+    formLayout->addRow("长度字段偏移:", lengthOffsetSpinBox);
+    formLayout->addRow("长度字段宽度:", lengthSizeCombo);
+    formLayout->addRow("", bigEndianCheck);
+    formLayout->addRow("长度修正:", lengthAdjustSpinBox);
+
+    QSpinBox *idleGapSpinBox = new QSpinBox(frameDialog);
+    idleGapSpinBox->setRange(1, 10000);
+    idleGapSpinBox->setSuffix(" ms");
+    formLayout->addRow("空闲间隔:", idleGapSpinBox);
+
+    QSpinBox *maxSizeSpinBox = new QSpinBox(frameDialog);
+    maxSizeSpinBox->setRange(1, FrameConfig::MAX_FRAME_SIZE);
+    maxSizeSpinBox->setSuffix(" 字节");
+    formLayout->addRow("最大帧长:", maxSizeSpinBox);
+    mainLayout->addLayout(formLayout);
+
+    QHBoxLayout *buttonLayout = new QHBoxLayout();
+    buttonLayout->addStretch();
+    QPushButton *confirmButton = new QPushButton("确定", frameDialog);
+    confirmButton->setFixedWidth(80);
+    buttonLayout->addWidget(confirmButton);
+    buttonLayout->addStretch();
+    mainLayout->addLayout(buttonLayout);
+
+    // 只启用当前帧格式用到的参数
+    auto updateEnabled = [=]() {
+        const int type = typeCombo->currentData().toInt();
+        delimiterEdit->setEnabled(type == FrameConfig::Delimiter);
+        keepDelimiterCheck->setEnabled(type == FrameConfig::Delimiter);
+        fixedLengthSpinBox->setEnabled(type == FrameConfig::FixedLength);
+        lengthOffsetSpinBox->setEnabled(type == FrameConfig::LengthPrefix);
+        lengthSizeCombo->setEnabled(type == FrameConfig::LengthPrefix);
+        bigEndianCheck->setEnabled(type == FrameConfig::LengthPrefix);
+        lengthAdjustSpinBox->setEnabled(type == FrameConfig::LengthPrefix);
+        idleGapSpinBox->setEnabled(type == FrameConfig::IdleGap);
+        maxSizeSpinBox->setEnabled(type != FrameConfig::None && type != FrameConfig::FixedLength);
+    };
+    connect(typeCombo, &QComboBox::currentIndexChanged, frameDialog, updateEnabled);
+
+    const FrameConfig current = AppSettings::instance()->frameConfig();
+    typeCombo->setCurrentIndex(qMax(0, typeCombo->findData(current.type)));
+    delimiterEdit->setText(QString::fromLatin1(current.delimiter.toHex(' ').toUpper()));
+    keepDelimiterCheck->setChecked(current.keepDelimiter);
+    fixedLengthSpinBox->setValue(current.fixedLength);
+    lengthOffsetSpinBox->setValue(current.lengthOffset);
+    lengthSizeCombo->setCurrentIndex(qMax(0, lengthSizeCombo->findData(current.lengthSize)));
+    bigEndianCheck->setChecked(current.lengthBigEndian);
+    lengthAdjustSpinBox->setValue(current.lengthAdjust);
+    idleGapSpinBox->setValue(current.idleGapMs);
+    maxSizeSpinBox->setValue(current.maxFrameSize);
+    updateEnabled();
+
+    connect(confirmButton, &QPushButton::clicked, frameDialog, [=]() {
+        FrameConfig config;
+        config.type = static_cast<FrameConfig::Type>(typeCombo->currentData().toInt());
+        config.delimiter = QByteArray::fromHex(delimiterEdit->text().toLatin1());
+        config.keepDelimiter = keepDelimiterCheck->isChecked();
+        config.fixedLength = fixedLengthSpinBox->value();
+        config.lengthOffset = lengthOffsetSpinBox->value();
+        config.lengthSize = lengthSizeCombo->currentData().toInt();
+        config.lengthBigEndian = bigEndianCheck->isChecked();
+        config.lengthAdjust = lengthAdjustSpinBox->value();
+        config.idleGapMs = idleGapSpinBox->value();
+        config.maxFrameSize = qMax(maxSizeSpinBox->value(), config.type == FrameConfig::FixedLength
+                                                                ? config.fixedLength : 1);
+
+        if (!config.isValid()) {
+            QMessageBox::warning(frameDialog, "帧解析", config.validationError());
+            return;
+        }
+
+        AppSettings::instance()->setFrameConfig(config);
+        frameDialog->accept();
+    });
+
+    frameDialog->exec();
+    delete frameDialog;
+}
+
+/**
+ * @brief 打开结构体布局编辑对话框
+ *
+ * 布局可直接编辑或从文件载入，确定时先编译校验，成功后保存并应用到所有会话。
+ */
+void Widget::showStructLayoutDialog(QWidget *parent)
+{
+    QDialog *structDialog = new QDialog(parent);
+    structDialog->setWindowTitle("结构体布局");
+    structDialog->resize(420, 360);
+
+    QVBoxLayout *mainLayout = new QVBoxLayout(structDialog);
+    mainLayout->setSpacing(10);
+    mainLayout->setContentsMargins(20, 20, 20, 20);
+
+    QLabel *hintLabel = new QLabel("每帧按以下布局解码（紧凑排列，默认小端），字段作为波形通道。\n"
+                                   "例：uint16 seq; int16 ax, ay, az; float temp;", structDialog);
+    hintLabel->setWordWrap(true);
+    mainLayout->addWidget(hintLabel);
+
+    QPlainTextEdit *layoutEdit = new QPlainTextEdit(structDialog);
+    QFont editFont("Consolas");
+    editFont.setStyleHint(QFont::Monospace);
+    layoutEdit->setFont(editFont);
+    layoutEdit->setPlaceholderText("little;\nuint16 seq;\nint16 ax, ay, az;\nfloat temp;");
+    layoutEdit->setPlainText(AppSettings::instance()->structLayout());
+    mainLayout->addWidget(layoutEdit);
+
+    // 编译结果：字段数和结构体大小，或第一处错误
+    QLabel *statusLabel = new QLabel(structDialog);
+    statusLabel->setWordWrap(true);
+    mainLayout->addWidget(statusLabel);
+    auto updateStatus = [layoutEdit, statusLabel]() {
+        StructLayout layout;
+        QString error;
+        if (layout.compile(layoutEdit->toPlainText(), &error)) {
+            statusLabel->setStyleSheet(QString());
+            statusLabel->setText(QString("%1 个字段，共 %2 字节").arg(layout.fieldCount()).arg(layout.size()));
+        } else {
+            statusLabel->setStyleSheet("color: red;");
+            statusLabel->setText(error);
+        }
+    };
+    connect(layoutEdit, &QPlainTextEdit::textChanged, structDialog, updateStatus);
+    updateStatus();
+
+    QHBoxLayout *buttonLayout = new QHBoxLayout();
+    QPushButton *loadButton = new QPushButton("从文件载入...", structDialog);
+    buttonLayout->addWidget(loadButton);
+    buttonLayout->addStretch();
+    QPushButton *confirmButton = new QPushButton("确定", structDialog);
+    confirmButton->setFixedWidth(80);
+    buttonLayout->addWidget(confirmButton);
+    mainLayout->addLayout(buttonLayout);
+
+    connect(loadButton, &QPushButton::clicked, structDialog, [structDialog, layoutEdit]() {
+        const QString fileName = QFileDialog::getOpenFileName(structDialog, "载入结构体布局", QString(),
+                                                              "布局文件 (*.txt *.h *.layout);;所有文件 (*)");
+        if (fileName.isEmpty()) {
+            return;
+        }
+        QFile file(fileName);
+        if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+            QMessageBox::warning(structDialog, "结构体布局", QString("无法打开文件: %1").arg(file.errorString()));
+            return;
+        }
+        layoutEdit->setPlainText(QString::fromUtf8(file.readAll()));
+    });
+
+    connect(confirmButton, &QPushButton::clicked, structDialog, [=]() {
+        StructLayout layout;
+        QString error;
+        if (!layout.compile(layoutEdit->toPlainText(), &error)) {
+            QMessageBox::warning(structDialog, "结构体布局", error);
+            return;
+        }
+        AppSettings::instance()->setStructLayout(layoutEdit->toPlainText());
+        structDialog->accept();
+    });
+
+    structDialog->exec();
+    delete structDialog;
+}
+
+/**
+ * @brief 打开原始数据捕获设置对话框
+ *
+ * 确定后立即保存；已打开的会话按新设置重新开始捕获或停止。
+ */
+void Widget::showCaptureDialog(QWidget *parent)
+{
+    QDialog *captureDialog = new QDialog(parent);
+    captureDialog->setWindowTitle("原始数据捕获");
+
+    QVBoxLayout *mainLayout = new QVBoxLayout(captureDialog);
+    mainLayout->setSpacing(15);
+    mainLayout->setContentsMargins(20, 20, 20, 20);
+
+    QFormLayout *formLayout = new QFormLayout();
+    QCheckBox *enabledCheck = new QCheckBox("打开串口时开始捕获", captureDialog);
+    formLayout->addRow("", enabledCheck);
+
+    QHBoxLayout *directoryLayout = new QHBoxLayout();
+    QLineEdit *directoryEdit = new QLineEdit(captureDialog);
+    QPushButton *browseButton = new QPushButton("浏览...", captureDialog);
+    directoryLayout->addWidget(directoryEdit);
+    directoryLayout->addWidget(browseButton);
+    formLayout->addRow("目录:", directoryLayout);
+
+    // 带索引格式记录到达时间、方向和端口号，可按时间定位和回放
+    QComboBox *formatCombo = new QComboBox(captureDialog);
+    formatCombo->addItem("带时间索引 (.sswcap)", CaptureConfig::IndexedFormat);
+    formatCombo->addItem("原样字节 (.bin)", CaptureConfig::RawFormat);
+    formLayout->addRow("格式:", formatCombo);
+
+    // 单个文件的大小和时长上限，任一达到即切换到新文件
+    QSpinBox *fileSizeSpinBox = new QSpinBox(captureDialog);
+    fileSizeSpinBox->setRange(0, 1048576);
+    fileSizeSpinBox->setSingleStep(64);
+    fileSizeSpinBox->setSuffix(" MB");
+    fileSizeSpinBox->setSpecialValueText("不限");
+    formLayout->addRow("文件大小上限:", fileSizeSpinBox);
+
+    QSpinBox *fileMinutesSpinBox = new QSpinBox(captureDialog);
+    fileMinutesSpinBox->setRange(0, 10080);
+    fileMinutesSpinBox->setSuffix(" 分钟");
+    fileMinutesSpinBox->setSpecialValueText("不限");
+    formLayout->addRow("文件时长上限:", fileMinutesSpinBox);
+
+    QComboBox *syncCombo = new QComboBox(captureDialog);
+    syncCombo->addItem("不主动同步", CaptureConfig::NoSync);
+    syncCombo->addItem("定期同步 (每秒)", CaptureConfig::PeriodicSync);
+    syncCombo->addItem("每次写入后同步", CaptureConfig::SyncEveryWrite);
+    syncCombo->setToolTip("同步越频繁，断电时丢失的数据越少，写入吞吐越低");
+    formLayout->addRow("落盘:", syncCombo);
+
+    QSpinBox *queueSpinBox = new QSpinBox(captureDialog);
+    queueSpinBox->setRange(1, 4096);
+    queueSpinBox->setSuffix(" MB");
+    queueSpinBox->setToolTip("磁盘跟不上时最多积压多少数据，超出后丢弃新数据（不影响接收和显示）");
+    formLayout->addRow("写入队列上限:", queueSpinBox);
+    mainLayout->addLayout(formLayout);
+
+    QHBoxLayout *buttonLayout = new QHBoxLayout();
+    buttonLayout->addStretch();
+    QPushButton *confirmButton = new QPushButton("确定", captureDialog);
+    confirmButton->setFixedWidth(80);
+    buttonLayout->addWidget(confirmButton);
+    buttonLayout->addStretch();
+    mainLayout->addLayout(buttonLayout);
+
+    const CaptureConfig current = AppSettings::instance()->captureConfig();
+    enabledCheck->setChecked(current.enabled);
+    directoryEdit->setText(current.directory);
+    formatCombo->setCurrentIndex(qMax(0, formatCombo->findData(current.format)));
+    fileSizeSpinBox->setValue(int(current.maxFileBytes >> 20));
+    fileMinutesSpinBox->setValue(current.maxFileSeconds / 60);
+    syncCombo->setCurrentIndex(qMax(0, syncCombo->findData(current.syncPolicy)));
+    queueSpinBox->setValue(int(current.queueBytes >> 20));
+
+    connect(browseButton, &QPushButton::clicked, captureDialog, [captureDialog, directoryEdit]() {
+        const QString directory = QFileDialog::getExistingDirectory(captureDialog, "选择捕获目录", directoryEdit->text());
+        if (!directory.isEmpty()) {
+            directoryEdit->setText(directory);
+        }
+    });
+
+    connect(confirmButton, &QPushButton::clicked, captureDialog, [=]() {
+        CaptureConfig config = current;
+        config.enabled = enabledCheck->isChecked();
+        config.directory = directoryEdit->text().trimmed();
+        config.format = static_cast<CaptureConfig::Format>(formatCombo->currentData().toInt());
+        config.maxFileBytes = qint64(fileSizeSpinBox->value()) << 20;
+        config.maxFileSeconds = fileMinutesSpinBox->value() * 60;
+        config.syncPolicy = static_cast<CaptureConfig::SyncPolicy>(syncCombo->currentData().toInt());
+        config.queueBytes = qint64(queueSpinBox->value()) << 20;
+
+        if (!config.isValid()) {
+            QMessageBox::warning(captureDialog, "原始数据捕获", config.validationError());
+            return;
+        }
+
+        AppSettings::instance()->setCaptureConfig(config);
+        captureDialog->accept();
+    });
+
+    captureDialog->exec();
+    delete captureDialog;
+}
+
+/**
+ * @brief 选择捕获文件并在当前会话中回放
+ *
+ * 回放数据经当前会话的处理和显示链路；"尽可能快"用于测量显示链路的端到端吞吐。
+ */
+void Widget::showReplayDialog()
+{
+    PortSession *session = currentSession();
+    if (session->isRunning()) {
+        QMessageBox::warning(this, "回放", "请先关闭当前会话的串口或停止回放");
+        return;
+    }
+
+    QDialog *replayDialog = new QDialog(this);
+    replayDialog->setWindowTitle("回放捕获文件");
+
+    QVBoxLayout *mainLayout = new QVBoxLayout(replayDialog);
+    mainLayout->setSpacing(15);
+    mainLayout->setContentsMargins(20, 20, 20, 20);
+
+    QFormLayout *formLayout = new QFormLayout();
+    QHBoxLayout *fileLayout = new QHBoxLayout();
+    QLineEdit *fileEdit = new QLineEdit(replayDialog);
+    fileEdit->setMinimumWidth(240);
+    fileEdit->setText(session->replay()->config().path);
+    QPushButton *browseButton = new QPushButton("浏览...", replayDialog);
+    fileLayout->addWidget(fileEdit);
+    fileLayout->addWidget(browseButton);
+    formLayout->addRow("文件:", fileLayout);
+
+    QComboBox *speedCombo = new QComboBox(replayDialog);
+    speedCombo->addItem("原始速度", 1.0);
+    speedCombo->addItem("×10", 10.0);
+    speedCombo->addItem("×100", 100.0);
+    speedCombo->addItem("尽可能快 (吞吐测试)", 0.0);
+    formLayout->addRow("速度:", speedCombo);
+
+    // 只填时刻，如 14:03:22.500；留空从头开始
+    QLineEdit *startEdit = new QLineEdit(replayDialog);
+    startEdit->setPlaceholderText("从头开始，或 HH:mm:ss[.zzz]");
+    formLayout->addRow("起始时间:", startEdit);
+    mainLayout->addLayout(formLayout);
+
+    QHBoxLayout *buttonLayout = new QHBoxLayout();
+    buttonLayout->addStretch();
+    QPushButton *confirmButton = new QPushButton("开始", replayDialog);
+    confirmButton->setFixedWidth(80);
+    buttonLayout->addWidget(confirmButton);
+    buttonLayout->addStretch();
+    mainLayout->addLayout(buttonLayout);
+
+    connect(browseButton, &QPushButton::clicked, replayDialog, [replayDialog, fileEdit]() {
+        const QString directory = fileEdit->text().isEmpty() ? AppSettings::instance()->captureConfig().directory
+                                                             : fileEdit->text();
+        const QString fileName = QFileDialog::getOpenFileName(replayDialog, "选择捕获文件", directory,
+                                                              QString("捕获文件 (*%1)").arg(CaptureFormat::DATA_SUFFIX));
+        if (!fileName.isEmpty()) {
+            fileEdit->setText(fileName);
+        }
+    });
+
+    connect(confirmButton, &QPushButton::clicked, replayDialog, [=]() {
+        ReplayConfig config;
+        config.path = fileEdit->text().trimmed();
+        config.speed = speedCombo->currentData().toDouble();
+
+        const QString startText = startEdit->text().trimmed();
+        if (!startText.isEmpty()) {
+            config.startTime = QTime::fromString(startText, "HH:mm:ss.zzz");
+            if (!config.startTime.isValid()) {
+                config.startTime = QTime::fromString(startText, "HH:mm:ss");
+            }
+            if (!config.startTime.isValid()) {
+                QMessageBox::warning(replayDialog, "回放", "起始时间格式应为 HH:mm:ss 或 HH:mm:ss.zzz");
+                return;
+            }
+        }
+
+        if (!config.isValid()) {
+            QMessageBox::warning(replayDialog, "回放", config.validationError());
+            return;
+        }
+
+        replayDialog->accept();
+        session->startReplay(config);
+    });
+
+    replayDialog->exec();
+    delete replayDialog;
+}
+
+/**
+ * @brief 选择日志文件并在当前会话的接收区中查看
+ *
+ * 文件只做内存映射，行索引在后台建立，数 GB 的文件也能立即显示首屏。
+ */
+void Widget::openLogFile()
+{
+    PortSession *session = currentSession();
+    const QString fileName = QFileDialog::getOpenFileName(this, "打开日志文件", session->log()->path(),
+                                                          "日志文件 (*.log *.txt);;所有文件 (*)");
+    if (fileName.isEmpty()) {
+        return;
+    }
+    session->openLog(fileName);
+}
+
+/**
+ * @brief 显示搜索栏并聚焦输入框（Ctrl+F）
+ */
+void Widget::showSearchBar()
+{
+    m_searchBar->setVisible(true);
+    m_searchEdit->setFocus();
+    m_searchEdit->selectAll();
+    updateSearchStatus();
+}
+
+/**
+ * @brief 隐藏搜索栏并取消所有会话的搜索
+ */
+void Widget::closeSearchBar()
+{
+    m_jumpToFirstHit = false;
+    for (const SessionPage &page : std::as_const(m_sessions)) {
+        page.session->search()->cancel();
+    }
+    m_searchBar->setVisible(false);
+    m_searchStatus->clear();
+    currentSession()->view()->setFocus();
+}
+
+/**
+ * @brief 在当前会话的接收历史中定位下一处/上一处匹配
+ *
+ * 搜索在搜索线程中进行，结果分批到达；接收继续时新的行会被加入搜索。
+ *
+ * @param backward true 为上一处
+ */
+void Widget::findInHistory(bool backward)
+{
+    PortSession *session = currentSession();
+    HistorySearch *search = session->search();
+
+    SearchQuery query;
+    query.text = m_searchEdit->text();
+    query.regex = m_searchRegex->isChecked();
+    query.caseSensitive = m_searchCase->isChecked();
+    if (query.text.isEmpty()) {
+        search->cancel();
+        updateSearchStatus();
+        return;
+    }
+    if (!search->isActive() || search->query() != query) {
+        QString error;
+        if (!search->start(query, session->view()->store(), &error)) {
+            m_searchStatus->setText(error);
+            return;
+        }
+    }
+
+    // 搜索的是接收历史，正在查看日志时先切回历史
+    session->closeLog();
+
+    SearchHit hit;
+    const bool found = backward ? search->previous(&hit) : search->next(&hit);
+    if (found) {
+        session->view()->selectRange(hit.line, hit.start, hit.length);
+    }
+    m_jumpToFirstHit = !found && search->isSearching();
+    updateSearchStatus();
+}
+
+/**
+ * @brief 按当前会话的搜索状态刷新匹配计数
+ */
+void Widget::updateSearchStatus()
+{
+    HistorySearch *search = currentSession()->search();
+    if (!search->isActive()) {
+        m_searchStatus->clear();
+        return;
+    }
+
+    const qsizetype count = search->hitCount();
+    QString status;
+    if (count == 0) {
+        status = search->isSearching() ? "搜索中..." : "无匹配";
+    } else {
+        const qsizetype current = search->currentIndex();
+        status = current >= 0 ? QString("%1 / %2").arg(current + 1).arg(count)
+                              : QString("%1 处").arg(count);
+        if (search->isTruncated()) {
+            status += "+";
+        }
+        if (search->isSearching()) {
+            status += " 搜索中...";
+        }
+    }
+    m_searchStatus->setText(status);
+
+    // 定位时还没有结果：第一批结果到达后定位
+    if (m_jumpToFirstHit && count > 0) {
+        m_jumpToFirstHit = false;
+        findInHistory(false);
+    }
+}
@@ -2,15 +2,23 @@
 #define WIDGET_H
 
 #include <QWidget>
-#include <QTimer>
-#include <QScrollBar>
+#include <QVector>
 
-#include "serialworker.h"
-#include "dataprocessor.h"
-#include "databuffer.h"
+#include "portsession.h"
+#include "rxchunk.h"
 #include "serialconfig.h"
 #include "keywordhighlighter.h"
-#include "speedmonitor.h"
+
+class FieldTable;
+class QCheckBox;
+class QGridLayout;
+class QLabel;
+class QLineEdit;
+class QSplitter;
+class QStackedWidget;
+class QTabWidget;
+class ReceiveView;
+class WavePlot;
 
 QT_BEGIN_NAMESPACE
 namespace Ui { class Widget; }
@@ -19,8 +27,9 @@ QT_END_NAMESPACE
 /**
  * @brief Widget - 主界面控件
  * 
- * 负责UI显示和用户交互，集成 SerialWorker、DataProcessor、DataBuffer 组件。
- * 实现定时批量刷新机制和自动滚动暂停/恢复逻辑。
+ * 负责UI显示和用户交互。每个串口是一个 PortSession（SerialWorker、DataPipeline、
+ * 接收显示区），多个会话以标签页或平铺方式显示；左侧的串口配置、发送区和按钮
+ * 作用于当前会话。数据处理在处理线程中完成，UI 线程只在定时刷新时插入文本。
  * 
  * Requirements: 1.3, 6.1, 6.2, 6.3, 6.4
  */
@@ -32,7 +41,8 @@ public:
     explicit Widget(QWidget *parent = nullptr);
     ~Widget();
 
-    static constexpr int REFRESH_INTERVAL_MS = 33; // ~30 FPS
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override;
 
 private slots:
     void on_clear_clicked();
@@ -41,37 +51,163 @@ private slots:
     void on_send_clicked();
     void on_clearSend_clicked();
 
-    void onRefreshTimeout();
-    void onDataReceived(const QByteArray &data);
-    void onDataProcessed(const QString &text);
-    void onSerialError(const QString &error);
-    void onSerialStarted();
-    void onSerialStopped();
-    void onScrollValueChanged(int value);
-    void onSpeedUpdated(double bytesPerSecond, qint64 totalBytes);
     void onSplitterMoved(int pos, int index);
 
     void on_openSetButton_clicked();
 
 private:
+    /**
+     * @brief 会话及其在界面中的页面
+     */
+    struct SessionPage {
+        PortSession *session = nullptr;
+        QWidget *page = nullptr;      ///< 包含标题和接收显示区的页面
+        QLabel *header = nullptr;     ///< 平铺时显示的会话标题
+    };
+
     void setupConnections();
     void updatePortList();
     void setPortControlsEnabled(bool enabled);
-    void appendToDisplay(const QString &text);
-    void showSystemMessage(const QString &message);
-    void performSend();
     SerialConfig buildConfig() const;
     void applyDarkMode(bool enabled);
+    void performSend();
+
+    /**
+     * @brief 打开帧解析设置对话框
+     * @param parent 父窗口（设置对话框）
+     */
+    void showFrameDialog(QWidget *parent);
+
+    /**
+     * @brief 打开结构体布局编辑对话框
+     * @param parent 父窗口（设置对话框）
+     */
+    void showStructLayoutDialog(QWidget *parent);
+
+    /**
+     * @brief 打开原始数据捕获设置对话框
+     * @param parent 父窗口（设置对话框）
+     */
+    void showCaptureDialog(QWidget *parent);
+
+    /**
+     * @brief 选择捕获文件并在当前会话中回放
+     */
+    void showReplayDialog();
+
+    /**
+     * @brief 选择日志文件并在当前会话的接收区中查看
+     */
+    void openLogFile();
+
+    /**
+     * @brief 显示搜索栏并聚焦输入框（Ctrl+F）
+     */
+    void showSearchBar();
+
+    /**
+     * @brief 隐藏搜索栏并取消所有会话的搜索
+     */
+    void closeSearchBar();
+
+    /**
+     * @brief 在当前会话的接收历史中定位下一处/上一处匹配
+     *
+     * 条件改变后先重新开始搜索；结果还没送回时，第一批结果到达后再定位。
+     *
+     * @param backward true 为上一处
+     */
+    void findInHistory(bool backward);
+
+    /**
+     * @brief 按当前会话的搜索状态刷新匹配计数
+     */
+    void updateSearchStatus();
+
+    /**
+     * @brief 让波形区显示某个会话的数据
+     * @param store 时间序列存储，可为 nullptr
+     */
+    void setWaveStore(TimeSeriesStore *store);
+
+    /**
+     * @brief 按波形通道来源显示或隐藏波形区和字段表
+     * @param mode ChannelParser::Mode
+     */
+    void updateWavePanel(int mode);
+
+    /**
+     * @brief 新建一个会话
+     * @param view 使用已有的接收显示区（第一个会话使用界面中的 receiveEdit），为 nullptr 时新建
+     * @return 新会话
+     */
+    PortSession *addSession(ReceiveView *view = nullptr);
+
+    /**
+     * @brief 关闭并释放一个会话（至少保留一个）
+     * @param index 会话下标
+     */
+    void closeSession(int index);
+
+    /**
+     * @brief 切换当前会话，刷新左侧控件状态
+     * @param index 会话下标
+     */
+    void setCurrentSession(int index);
+
+    /**
+     * @brief 获取当前会话
+     * @return 当前会话
+     */
+    PortSession *currentSession() const;
+
+    /**
+     * @brief 查找会话下标
+     * @param session 会话
+     * @return 下标，不存在时返回 -1
+     */
+    int indexOfSession(PortSession *session) const;
+
+    /**
+     * @brief 按标签页或平铺方式重新排列所有会话页面
+     */
+    void relayoutSessions();
+
+    /**
+     * @brief 刷新会话的标签文本和平铺标题
+     * @param index 会话下标
+     */
+    void updateSessionTitle(int index);
+
+    /**
+     * @brief 按当前会话的状态刷新左侧控件（打开按钮、连接状态、配置）
+     */
+    void updateSessionControls();
+
+    void onSessionStarted(PortSession *session);
+    void onSessionStopped(PortSession *session);
+    void onSessionSpeedUpdated(PortSession *session, double bytesPerSecond, qint64 totalBytes);
 
     Ui::Widget *ui;
-    SerialWorker *m_worker;
-    DataProcessor *m_processor;
-    DataBuffer *m_buffer;
-    QTimer *m_refreshTimer;
+    QVector<SessionPage> m_sessions;     ///< 所有会话（至少一个）
+    int m_current = 0;                   ///< 当前会话下标
+    QStackedWidget *m_sessionStack;      ///< 标签页 / 平铺两种排列
+    QTabWidget *m_sessionTabs;           ///< 标签页排列
+    QWidget *m_tileArea;                 ///< 平铺排列
+    QGridLayout *m_tileLayout;
+    QCheckBox *m_tileCheck;              ///< 平铺开关
+    QSplitter *m_waveSplitter;           ///< 会话区与波形区
+    QSplitter *m_wavePanel;              ///< 波形与字段表（上下排列）
+    WavePlot *m_wavePlot;                ///< 当前会话的波形（启用波形通道时显示）
+    FieldTable *m_fieldTable;            ///< 结构体字段的最新值（通道来源为结构体时显示）
+    QWidget *m_searchBar;                ///< 接收历史搜索栏（Ctrl+F）
+    QLineEdit *m_searchEdit;             ///< 搜索文本
+    QCheckBox *m_searchRegex;            ///< 按正则表达式搜索
+    QCheckBox *m_searchCase;             ///< 区分大小写
+    QLabel *m_searchStatus;              ///< 匹配计数
+    bool m_jumpToFirstHit = false;       ///< 结果到达后定位到第一处
+    SlabStats m_lastSlabStats;           ///< 上一秒的接收块池统计（换算每秒分配次数）
     KeywordHighlighter *m_highlighter;
-    SpeedMonitor *m_speedMonitor;
-    QString m_pendingText;
-    bool m_autoScroll = true;
 };
 
 #endif // WIDGET_H